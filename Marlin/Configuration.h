@@ -210,6 +210,7 @@
  #endif
   #define PID_INTEGRAL_DRIVE_MAX PID_MAX  //limit for the integral term
   #define K1 0.95 //smoothing factor within the PID
+  #define PID_FIXED_POINT // Run the hotend and bed PID loops in Q16.16 fixed point instead of float. The gains are converted by updatePID().
   #define PID_dT ((OVERSAMPLENR * 4.0)/(F_CPU / 64.0 / 256.0)) //sampling period of the temperature routine
 
 // If you are using a preconfigured hotend then you can use one of the value sets by uncommenting it
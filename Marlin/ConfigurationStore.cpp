@@ -4,25 +4,18 @@
 #include "ultralcd.h"
 #include "UltiLCD2.h"
 #include "ConfigurationStore.h"
+#include "eeprom_journal.h"
 
 void _EEPROM_writeData(int &pos, uint8_t* value, uint8_t size)
 {
-    do
-    {
-        eeprom_write_byte((unsigned char*)pos, *value);
-        pos++;
-        value++;
-    }while(--size);
+    eeprom_journal_write_block(value, (void*)pos, size);
+    pos += size;
 }
 #define EEPROM_WRITE_VAR(pos, value) _EEPROM_writeData(pos, (uint8_t*)&value, sizeof(value))
 void _EEPROM_readData(int &pos, uint8_t* value, uint8_t size)
 {
-    do
-    {
-        *value = eeprom_read_byte((unsigned char*)pos);
-        pos++;
-        value++;
-    }while(--size);
+    eeprom_journal_read_block(value, (const void*)pos, size);
+    pos += size;
 }
 #define EEPROM_READ_VAR(pos, value) _EEPROM_readData(pos, (uint8_t*)&value, sizeof(value))
 //======================================================================================
@@ -40,9 +33,17 @@ void _EEPROM_readData(int &pos, uint8_t* value, uint8_t size)
 // ALSO:  always make sure the variables in the Store and retrieve sections are in the same order.
 #ifndef EEPROM_VERSION
   #ifdef UM2PLUS
-    #define EEPROM_VERSION "V12"
+    #define EEPROM_VERSION "V14"
+  #else
+    #define EEPROM_VERSION "V13"
+  #endif
+#endif
+// The version before Kc was added to the end. Those settings are read, Kc gets its default and they are stored again.
+#ifndef EEPROM_VERSION_WITHOUT_KC
+  #ifdef UM2PLUS
+    #define EEPROM_VERSION_WITHOUT_KC "V12"
   #else
-    #define EEPROM_VERSION "V11"
+    #define EEPROM_VERSION_WITHOUT_KC "V11"
   #endif
 #endif
 
@@ -96,6 +97,12 @@ void Config_StoreSettings()
   #endif
   EEPROM_WRITE_VAR(i,retract_length);
   EEPROM_WRITE_VAR(i,retract_feedrate);
+  #if defined(PIDTEMP) && defined(PID_ADD_EXTRUSION_RATE)
+    EEPROM_WRITE_VAR(i,Kc);
+  #else
+    float dummyKc = 0.0f;
+    EEPROM_WRITE_VAR(i,dummyKc);
+  #endif
   char ver2[4]=EEPROM_VERSION;
   i=EEPROM_OFFSET;
   EEPROM_WRITE_VAR(i,ver2); // validate data
@@ -166,6 +173,9 @@ void Config_PrintSettings()
     SERIAL_ECHOPAIR("   M301 P",Kp);
     SERIAL_ECHOPAIR(" I" ,unscalePID_i(Ki));
     SERIAL_ECHOPAIR(" D" ,unscalePID_d(Kd));
+#ifdef PID_ADD_EXTRUSION_RATE
+    SERIAL_ECHOPAIR(" C" ,Kc);
+#endif
     SERIAL_EOL;
 #endif
 }
@@ -178,9 +188,11 @@ void Config_RetrieveSettings()
     int i=EEPROM_OFFSET;
     char stored_ver[4];
     char ver[4]=EEPROM_VERSION;
+    char ver_without_kc[4]=EEPROM_VERSION_WITHOUT_KC;
     EEPROM_READ_VAR(i,stored_ver); //read stored version
     //  SERIAL_ECHOLN("Version: [" << ver << "] Stored version: [" << stored_ver << "]");
-    if (strncmp(ver,stored_ver,3) == 0)
+    bool without_kc = (strncmp(ver_without_kc,stored_ver,3) == 0);
+    if (strncmp(ver,stored_ver,3) == 0 || without_kc)
     {
         // version number match
         EEPROM_READ_VAR(i,axis_steps_per_unit);
@@ -227,11 +239,20 @@ void Config_RetrieveSettings()
         #endif
         EEPROM_READ_VAR(i,retract_length);
         EEPROM_READ_VAR(i,retract_feedrate);
+        #if defined(PIDTEMP) && defined(PID_ADD_EXTRUSION_RATE)
+        if (!without_kc)
+            EEPROM_READ_VAR(i,Kc);
+        // Not stored yet, or bytes that were never written (0xFF is NaN)
+        if (without_kc || !(Kc >= 0 && Kc <= PID_MAX))
+            Kc = DEFAULT_Kc;
+        #endif
 
 		// Call updatePID (similar to when we have processed M301)
 		updatePID();
         SERIAL_ECHO_START;
         SERIAL_ECHOLNPGM("Stored settings retrieved");
+        if (without_kc)
+            Config_StoreSettings();
     }
     else
     {
@@ -286,9 +307,9 @@ void Config_ResetDefault()
     // call updatePID (similar to when we have processed M301)
     updatePID();
 
-//#ifdef PID_ADD_EXTRUSION_RATE
-//    Kc = DEFAULT_Kc;
-//#endif//PID_ADD_EXTRUSION_RATE
+#ifdef PID_ADD_EXTRUSION_RATE
+    Kc = DEFAULT_Kc;
+#endif//PID_ADD_EXTRUSION_RATE
 #endif//PIDTEMP
     float tmp_motor_current_setting[]=DEFAULT_PWM_MOTOR_CURRENT;
     motor_current_setting[0] = tmp_motor_current_setting[0];
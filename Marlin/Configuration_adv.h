@@ -29,9 +29,11 @@
 #ifdef PIDTEMP
   // this adds an experimental additional term to the heatingpower, proportional to the extrusion speed.
   // if Kc is choosen well, the additional required power due to increased melting should be compensated.
+  // The extrusion speed is the filament feed (mm/s) averaged over the moves queued in the planner, so the
+  // heater output rises before a fast section starts. Set Kc with M301 C, M500 stores it.
   #define PID_ADD_EXTRUSION_RATE
   #ifdef PID_ADD_EXTRUSION_RATE
-    #define  DEFAULT_Kc (1) //heatingpower=Kc*(e_speed)
+    #define  DEFAULT_Kc (20) //heatingpower=Kc*(e_speed), in PID output (0..PID_MAX) per mm/s of 2.85mm filament, about 2.7W on a 35W heater
   #endif
 #endif
 
@@ -165,6 +167,10 @@
 
 #define MAX_STEP_FREQUENCY 40000 // Max step frequency for Ultimaker (5000 pps / half step)
 
+// Measure how long the stepper interrupt takes, to see how close MAX_STEP_FREQUENCY is to the limit of the cpu.
+// M122 reports the durations, missed interrupt times and step loops, M122 R also clears the counters.
+//#define STEPPER_ISR_PROFILE
+
 //By default pololu step drivers require an active high signal. However, some high power drivers require an active low signal as step.
 #define INVERT_X_STEP_PIN false
 #define INVERT_Y_STEP_PIN false
@@ -193,6 +199,11 @@
 // if unwanted behavior is observed on a user's machine when running at very slow speeds.
 #define MINIMUM_PLANNER_SPEED 0.05// (mm/sec)
 
+// Calculate the acceleration and deceleration steps of a block with the step rates squared in integer math and a
+// single reciprocal of the acceleration, instead of float squares and a float division per distance.
+// The step counts can differ by one step from the float calculation. Comment out to use the float calculation.
+#define FAST_TRAPEZOID
+
 // MS1 MS2 Stepper Driver Microstepping mode table
 #define MICROSTEP1 LOW,LOW
 #define MICROSTEP2 HIGH,LOW
@@ -216,6 +227,21 @@
 #define SD_FINISHED_STEPPERRELEASE false  //if sd support and the file is finished: disable steppers?
 #define SD_FINISHED_RELEASECOMMAND "M84" // You might want to keep the z enabled so your bed stays in place.
 
+// Keep the print time and material of the g-code files the print menu has shown in a hidden file (_DETAILS.IDX) per directory,
+// so browsing a card only reads the header of a file once. Off by default, as it writes to the card while browsing.
+//#define SD_DETAIL_INDEX
+#define SD_DETAIL_INDEX_MAX 128 // Records in a detail index before it starts over
+
+// Remember where the layers of the SD print start in the file, so "Recover print" of the same file continues reading
+// at the last layer below the recover height instead of reading the whole file up to it. Entries take 33 bytes RAM
+// plus 2 per extruder (16 more with BINARY_GCODE), every other one is dropped when the index is full.
+#define RECOVER_LAYER_INDEX 8
+
+// Settings saved from the menus and M500 are staged in a RAM journal and written to the EEPROM one byte at a time from idle(),
+// instead of waiting ~3.4ms for every byte. Bytes that already hold the value are not written again. Entries take 3 bytes RAM,
+// a full journal writes its oldest entry right away. Comment out to write synchronously.
+#define EEPROM_JOURNAL_SIZE 32
+
 // The hardware watchdog should reset the Microcontroller disabling all outputs, in case the firmware gets stuck and doesn't do temperature regulation.
 #define USE_WATCHDOG
 
@@ -236,6 +262,7 @@
 #if defined(BABYSTEPPING)
   #define BABYSTEP_XY  //not only z, but also XY in the menu. more clutter, more functions
   #define BABYSTEP_INVERT_Z false  //true for inverse movements in Z
+  #define BABYSTEP_MIN_TICKS 1000  //the stepper interrupt takes the babysteps in between the step events, at most one per axis every 1000 timer ticks (0.5us each), 2kHz
 
   #ifdef COREXY
     #error BABYSTEPPING not implemented for COREXY yet.
@@ -268,6 +295,21 @@
 
 #endif // ADVANCE
 
+// Linear pressure advance: the stepper pushes K seconds of the extrusion rate ahead of the nominal E position, so the
+// pressure in the bowden and nozzle follows the speed changes of the trapezoid. K is stored per material (0 is off)
+// and set with M900. The E steps go out from the stepper interrupt, in between the step events when there are
+// more than one per step event, TIMER0 is not used.
+#define LIN_ADVANCE
+
+#ifdef LIN_ADVANCE
+  #ifdef ADVANCE
+    #error LIN_ADVANCE and ADVANCE can not be used together.
+  #endif
+  #define LIN_ADVANCE_K_MAX 2.0 // s
+  #define LIN_ADVANCE_SHIFT 12  // Fixed point fraction bits of block_t::advance_lead
+  #define LIN_ADVANCE_MIN_TICKS 100 // Shortest time between the E steps in between the step events, in 0.5us (20kHz)
+#endif // LIN_ADVANCE
+
 // Arc interpretation settings:
 #define MM_PER_ARC_SEGMENT 1
 #define N_ARC_CORRECTION 25
@@ -307,9 +349,9 @@ const int8_t dropsegments=5; //everything with less than this number of steps wi
 // The number of linear motions that can be in the plan at any give time.
 // THE BLOCK_BUFFER_SIZE NEEDS TO BE A POWER OF 2, i.g. 8,16,32 because shifts and ors are used to do the ringbuffering.
 #if defined SDSUPPORT
-  #define BLOCK_BUFFER_SIZE 16   // SD,LCD,Buttons take more memory, block buffer needs to be smaller
+  #define BLOCK_BUFFER_SIZE 32   // SD,LCD,Buttons take more memory, the compact block_t keeps 32 blocks affordable
 #else
-  #define BLOCK_BUFFER_SIZE 16 // maximize block buffer
+  #define BLOCK_BUFFER_SIZE 32 // maximize block buffer
 #endif
 
 
@@ -318,6 +360,15 @@ const int8_t dropsegments=5; //everything with less than this number of steps wi
 #define BUFSIZE 8
 #define BUFMASK 0x07
 
+// Serial output is queued in a buffer of this many bytes and sent from the UDRE interrupt, so an "ok" or a temperature
+// report does not hold up the main loop for every character. Writes wait when the buffer is full.
+// Needs to be a power of 2 up to 256, or 0 to send every byte right away.
+#define TX_BUFFER_SIZE 32
+
+// Accept the compact binary G1 records of binary_gcode.h (made by binary_gcode.py) over serial and from SD files,
+// mixed with normal g-code lines. They take a fraction of the bytes and do not need strtod() for every axis.
+#define BINARY_GCODE
+
 // Firmware based and LCD controlled retract
 // M207 and M208 can be used to define parameters for the retraction.
 // The retraction can be called by the slicer using G10 and G11
@@ -183,6 +183,12 @@ uint8_t StoppedReason();
 void clear_command_queue();
 void enquecommand(const char *cmd); //put an ascii command at the end of the current buffer.
 void enquecommand_P(const char *cmd); //put an ascii command at the end of the current buffer, read from flash
+#ifdef SDCARD_BENCHMARK
+void sdcard_bench_read(void (*command)(const char* cmd)); //read the next commands from the card, see MarlinSimulator/sdcardbench.cpp
+#endif
+#ifdef RECOVER_LAYER_INDEX
+void recover_layer_select(float height); //let the next recover replay skip to the last indexed layer below height
+#endif
 uint8_t commands_queued();
 void cmd_synchronize();
 void clamp_to_software_endstops(float target[3]);
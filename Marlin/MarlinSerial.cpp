@@ -30,6 +30,9 @@
 
 #if UART_PRESENT(SERIAL_PORT)
   ring_buffer rx_buffer  =  { { 0 }, 0, 0 };
+#if TX_BUFFER_SIZE > 0
+  tx_ring_buffer tx_buffer  =  { { 0 }, 0, 0 };
+#endif
 #endif
 
 FORCE_INLINE void store_char(unsigned char c)
@@ -58,6 +61,26 @@ FORCE_INLINE void store_char(unsigned char c)
   }
 #endif
 
+#if TX_BUFFER_SIZE > 0
+// Hand the oldest byte of the tx buffer to the UART, and stop the UDRE interrupt when that was the last one.
+FORCE_INLINE void send_tx_char()
+{
+  uint8_t t = tx_buffer.tail;
+  M_UDRx = tx_buffer.buffer[t];
+  t = (t + 1) & (TX_BUFFER_SIZE - 1);
+  tx_buffer.tail = t;
+  if (t == tx_buffer.head)
+    cbi(M_UCSRxB, M_UDRIEx);
+}
+
+#if defined(M_USARTx_UDRE_vect)
+  SIGNAL(M_USARTx_UDRE_vect)
+  {
+    send_tx_char();
+  }
+#endif
+#endif
+
 // Constructors ////////////////////////////////////////////////////////////////
 
 MarlinSerial::MarlinSerial()
@@ -100,11 +123,46 @@ void MarlinSerial::begin(long baud)
 
 void MarlinSerial::end()
 {
+  flushTx();
   cbi(M_UCSRxB, M_RXENx);
   cbi(M_UCSRxB, M_TXENx);
   cbi(M_UCSRxB, M_RXCIEx);
 }
 
+#if TX_BUFFER_SIZE > 0
+void MarlinSerial::write(uint8_t c)
+{
+  // With nothing queued and the data register free the byte can go out right away, the interrupt would only add overhead.
+  if (tx_buffer.head == tx_buffer.tail && (M_UCSRxA & (1 << M_UDREx))) {
+    M_UDRx = c;
+    return;
+  }
+
+  uint8_t i = (tx_buffer.head + 1) & (TX_BUFFER_SIZE - 1);
+  // When the buffer is full wait for the interrupt to make room. With interrupts disabled (in an ISR or kill()) it
+  // cannot, so send the oldest byte from here as soon as the UART takes it.
+  while (i == tx_buffer.tail) {
+    if (!(SREG & _BV(SREG_I)) && (M_UCSRxA & (1 << M_UDREx)))
+      send_tx_char();
+  }
+
+  tx_buffer.buffer[tx_buffer.head] = c;
+  uint8_t oldSREG = SREG;
+  cli();
+  tx_buffer.head = i;
+  sbi(M_UCSRxB, M_UDRIEx);
+  SREG = oldSREG;
+}
+
+void MarlinSerial::flushTx()
+{
+  while (tx_buffer.head != tx_buffer.tail) {
+    if (!(SREG & _BV(SREG_I)) && (M_UCSRxA & (1 << M_UDREx)))
+      send_tx_char();
+  }
+}
+#endif
+
 
 
 int MarlinSerial::peek(void)
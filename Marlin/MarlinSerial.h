@@ -49,11 +49,13 @@
 #define M_TXENx SERIAL_REGNAME(TXEN,SERIAL_PORT,)
 #define M_RXCIEx SERIAL_REGNAME(RXCIE,SERIAL_PORT,)
 #define M_UDREx SERIAL_REGNAME(UDRE,SERIAL_PORT,)
+#define M_UDRIEx SERIAL_REGNAME(UDRIE,SERIAL_PORT,)
 #define M_UDRx SERIAL_REGNAME(UDR,SERIAL_PORT,)
 #define M_UBRRxH SERIAL_REGNAME(UBRR,SERIAL_PORT,H)
 #define M_UBRRxL SERIAL_REGNAME(UBRR,SERIAL_PORT,L)
 #define M_RXCx SERIAL_REGNAME(RXC,SERIAL_PORT,)
 #define M_USARTx_RX_vect SERIAL_REGNAME(USART,SERIAL_PORT,_RX_vect)
+#define M_USARTx_UDRE_vect SERIAL_REGNAME(USART,SERIAL_PORT,_UDRE_vect)
 #define M_U2Xx SERIAL_REGNAME(U2X,SERIAL_PORT,)
 
 
@@ -84,6 +86,21 @@ struct ring_buffer
   extern ring_buffer rx_buffer;
 #endif
 
+#if TX_BUFFER_SIZE > 0
+// Bytes waiting to be sent, written by write() at the head and sent from the UDRE interrupt at the tail.
+// The UDRE interrupt is enabled as long as the buffer is not empty.
+struct tx_ring_buffer
+{
+  unsigned char buffer[TX_BUFFER_SIZE];
+  volatile uint8_t head;
+  volatile uint8_t tail;
+};
+
+#if UART_PRESENT(SERIAL_PORT)
+  extern tx_ring_buffer tx_buffer;
+#endif
+#endif
+
 class MarlinSerial //: public Stream
 {
 
@@ -100,6 +117,11 @@ class MarlinSerial //: public Stream
       return (unsigned int)(RX_BUFFER_SIZE + rx_buffer.head - rx_buffer.tail) % RX_BUFFER_SIZE;
     }
 
+#if TX_BUFFER_SIZE > 0
+    void write(uint8_t c);
+    // Wait till everything in the tx buffer is handed to the UART, for when the main loop stops after a message.
+    void flushTx(void);
+#else
     FORCE_INLINE void write(uint8_t c)
     {
       while (!((M_UCSRxA) & (1 << M_UDREx)))
@@ -108,6 +130,9 @@ class MarlinSerial //: public Stream
       M_UDRx = c;
     }
 
+    FORCE_INLINE void flushTx(void) {}
+#endif
+
 
     FORCE_INLINE void checkRx(void)
     {
@@ -39,6 +39,8 @@
 #include "watchdog.h"
 #include "ConfigurationStore.h"
 #include "lifetime_stats.h"
+#include "eeprom_journal.h"
+#include "binary_gcode.h"
 #include "electronics_test.h"
 #include "language.h"
 #include "pins_arduino.h"
@@ -113,6 +115,7 @@
 // M115 - Capabilities string
 // M117 - display message
 // M119 - Output Endstop status to serial port
+// M122 - Report the stepper interrupt timing (needs STEPPER_ISR_PROFILE), R to clear it
 // M126 - Solenoid Air Valve Open (BariCUDA support by jmil)
 // M127 - Solenoid Air Valve Closed (BariCUDA vent to atmospheric pressure by jmil)
 // M128 - EtoP Open (BariCUDA EtoP = electricity to air pressure transducer by jmil)
@@ -135,7 +138,7 @@
 // M240 - Trigger a camera to take a photograph
 // M280 - set servo position absolute. P: servo index, S: angle or microseconds
 // M300 - Play beepsound S<frequency Hz> P<duration ms>
-// M301 - Set PID parameters P I and D
+// M301 - Set PID parameters P I and D, and C for the extrusion feed forward (PID_ADD_EXTRUSION_RATE)
 // M302 - Allow cold extrudes, or set the minimum extrude S<temperature>.
 // M303 - PID relay autotune S<temperature> sets the target temperature. (default target temperature = 150C)
 // M304 - Set bed PID parameters P I and D
@@ -147,6 +150,7 @@
 // M503 - print the current settings (from memory not from eeprom)
 // M540 - Use S[0|1] to enable or disable the stop SD card print on endstop hit (requires ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED)
 // M600 - Pause for filament change X[pos] Y[pos] Z[relative lift] E[initial retract] L[later retract distance for removal]
+// M900 - Set the linear advance K[seconds] of T[extruder], for the moves planned after it (requires LIN_ADVANCE)
 // M907 - Set digital trimpot motor current using axis codes.
 // M908 - Control digital trimpot directly.
 // M350 - Set microstepping mode.
@@ -240,9 +244,56 @@ uint8_t serialCmd = 0;
 static uint8_t bufindr = 0;
 static uint8_t bufindw = 0;
 static uint8_t buflen = 0;
+
+#define NO_FILE_POS 0xFFFFFFFF
+#ifdef RECOVER_LAYER_INDEX
+static uint32_t cmdFilePos[BUFSIZE];//SD file position of each buffered command, NO_FILE_POS for other commands
+static uint32_t processFilePos = NO_FILE_POS;//Of the command process_command() is working on
+
+//Printer state at the start of a layer of the SD print. The recover replay can continue from there.
+struct recoverLayer
+{
+  uint32_t filePos;//Start of the first extruding move of the layer
+  float position[NUM_AXIS];//current_position before that command
+  float maxZ;//Highest Z of all extruding moves before that command
+  float feedrate;
+  int feedmultiply;
+  int extrudemultiply[EXTRUDERS];
+  uint8_t extruder;
+  uint8_t relativeState;
+  uint8_t fanSpeed;
+#ifdef BINARY_GCODE
+  int32_t bgcodePosition[4];//Base of the changes in the binary record at filePos
+#endif
+};
+static recoverLayer recoverLayers[RECOVER_LAYER_INDEX];
+static uint8_t recoverLayerCount = 0;
+static uint8_t recoverLayerStride = 1;//Layers between index entries, doubles every time the index is full
+static uint8_t recoverLayerSkip = 0;
+static uint8_t recoverLayerJump = 0;//Entry+1 where the recover replay continues, 0 for none
+static float recoverLayerMaxZ;
+static uint32_t recoverLayerFileSize = 0;
+static uint32_t recoverLayerFileCluster = 0;
+#endif
 static int serial_count = 0;
 static boolean comment_mode = false;
 static char *strchr_pointer = 0; // just a pointer to find chars in the cmd string like X, Y, Z, E, etc
+#define CODE_PARAMS_MAX 8
+typedef struct {
+  char code;
+  uint8_t offset; // position of the letter in code_cmd
+  float value;
+} code_param_t;
+static const char *code_cmd = NULL; // the command code_params[] was parsed from
+static code_param_t code_params[CODE_PARAMS_MAX]; // the first of every A-Z in code_cmd, with its value
+static uint8_t code_param_count = 0;
+static bool code_params_full = false; // code_cmd has more letters than fit in code_params[]
+static const code_param_t *code_param = NULL; // found by the last code_seen(), NULL when it searched the string
+
+// Result of a G or M code handler, tells process_command() how to finish the command
+#define GCODE_DONE    0 // reset the printing state and acknowledge
+#define GCODE_MOVE    1 // only acknowledge, a move leaves the printing state alone
+#define GCODE_REPLIED 2 // the handler answered the host itself
 
 const int sensitive_pins[] = SENSITIVE_PINS; // Sensitive pin list for M42
 
@@ -292,6 +343,7 @@ void serial_echopair_P(const char *s_P, unsigned int v)
 void serial_action_P(const char *s_P)
     { serialprintPGM(PSTR("//action:")); serialprintPGM(s_P); SERIAL_EOL; }
 
+#ifdef __AVR
 extern "C"{
   extern unsigned int __bss_end;
   extern unsigned int __heap_start;
@@ -308,13 +360,20 @@ extern "C"{
     return free_memory;
   }
 }
+#else
+// The stack and heap addresses of the simulator say nothing about the AVR. A fixed value keeps simulated runs repeatable.
+int freeMemory() { return 1024; }
+#endif
 
 /**
  * Once a new command is in the ring buffer, call this to commit it
  */
-static void commit_command(bool isSerialCmd)
+static void commit_command(bool isSerialCmd, uint32_t filePos = NO_FILE_POS)
 {
   ++buflen;
+#ifdef RECOVER_LAYER_INDEX
+  cmdFilePos[bufindw] = filePos;
+#endif
   if (isSerialCmd)
   {
     //set serial flag for new command
@@ -351,11 +410,115 @@ void clear_command_queue()
     serialCmd = 0;
 }
 
+#ifdef RECOVER_LAYER_INDEX
+//Called for every move once its destination is known, only extruding moves of the SD print count. The first one
+// above all extruding moves before it starts a new layer. The recover replay triggers on the first extruding move at
+// the recover height, so it can start at any layer with maxZ below that height and get to the same move with the same state.
+static void recover_layer_record(const int32_t* bgcodePosition = NULL)
+{
+  if (processFilePos == NO_FILE_POS || destination[E_AXIS] == current_position[E_AXIS] || printing_state == PRINT_STATE_RECOVER)
+    return;
+  if (recoverLayerFileSize != card.getFileSize() || recoverLayerFileCluster != card.getFileCluster())
+  {
+    //Another file, start a new index
+    recoverLayerFileSize = card.getFileSize();
+    recoverLayerFileCluster = card.getFileCluster();
+    recoverLayerCount = 0;
+    recoverLayerStride = 1;
+    recoverLayerSkip = 0;
+    recoverLayerMaxZ = min_pos[Z_AXIS] - 1.0f;
+  }
+  if (destination[Z_AXIS] <= recoverLayerMaxZ)
+    return;
+  float maxZ = recoverLayerMaxZ;
+  recoverLayerMaxZ = destination[Z_AXIS];
+  if (recoverLayerSkip)
+  {
+    --recoverLayerSkip;
+    return;
+  }
+  if (recoverLayerCount == RECOVER_LAYER_INDEX)
+  {
+    //Keep every other layer, and index only every other layer from now on
+    for(uint8_t n=1; n<RECOVER_LAYER_INDEX/2; n++)
+      recoverLayers[n] = recoverLayers[n*2];
+    recoverLayerCount = RECOVER_LAYER_INDEX/2;
+    if (recoverLayerStride < 128)
+      recoverLayerStride *= 2;
+  }
+  recoverLayer &layer = recoverLayers[recoverLayerCount++];
+  layer.filePos = processFilePos;
+  memcpy(layer.position, current_position, sizeof(layer.position));
+  layer.maxZ = maxZ;
+  layer.feedrate = feedrate;
+  layer.feedmultiply = feedmultiply;
+  memcpy(layer.extrudemultiply, extrudemultiply, sizeof(layer.extrudemultiply));
+  layer.extruder = active_extruder;
+  layer.relativeState = axis_relative_state;
+  layer.fanSpeed = fanSpeed;
+#ifdef BINARY_GCODE
+  if (bgcodePosition)
+    memcpy(layer.bgcodePosition, bgcodePosition, sizeof(layer.bgcodePosition));
+  else
+    bgcode_get_position(layer.bgcodePosition);
+#endif
+  recoverLayerSkip = recoverLayerStride - 1;
+}
+
+void recover_layer_select(float height)
+{
+  recoverLayerJump = 0;
+  if (recoverLayerFileSize != card.getFileSize() || recoverLayerFileCluster != card.getFileCluster())
+    return;
+  //The first layer is where the replay gets to anyway
+  for(uint8_t n=recoverLayerCount; n>1; n--)
+  {
+    if (recoverLayers[n-1].maxZ < height - 0.01f)
+    {
+      recoverLayerJump = n;
+      return;
+    }
+  }
+}
+
+//Once the recover replay has done the commands before the first layer (temperatures, fan, modes),
+// continue at the selected layer with the state the print had there.
+static bool recover_layer_jump()
+{
+  if (!recoverLayerJump || processFilePos == NO_FILE_POS || processFilePos < recoverLayers[0].filePos || printing_state != PRINT_STATE_RECOVER)
+    return false;
+  const recoverLayer &layer = recoverLayers[recoverLayerJump - 1];
+  recoverLayerJump = 0;
+  memcpy(current_position, layer.position, sizeof(current_position));
+  feedrate = layer.feedrate;
+  feedmultiply = layer.feedmultiply;
+  memcpy(extrudemultiply, layer.extrudemultiply, sizeof(extrudemultiply));
+  active_extruder = layer.extruder;
+  axis_relative_state = layer.relativeState;
+  fanSpeed = layer.fanSpeed;
+#ifdef BINARY_GCODE
+  bgcode_set_position(layer.bgcodePosition);
+#endif
+  clear_command_queue();
+  card.setIndex(layer.filePos);
+  processFilePos = NO_FILE_POS;
+  return true;
+}
+#endif//RECOVER_LAYER_INDEX
+
 static void next_command()
 {
   #ifdef SDSUPPORT
     if(card.saving())
     {
+#ifdef BINARY_GCODE
+        if(cmdbuffer[bufindr][0] & BGCODE_MARKER)
+        {
+          card.write_record((uint8_t*)cmdbuffer[bufindr], bgcode_length((uint8_t*)cmdbuffer[bufindr], BGCODE_MAX_LENGTH));
+          SERIAL_PROTOCOLLNPGM(MSG_OK);
+        }
+        else
+#endif
         if(strstr_P(cmdbuffer[bufindr], PSTR("M29")) == NULL)
         {
           card.write_command(cmdbuffer[bufindr]);
@@ -376,7 +539,15 @@ static void next_command()
     }
     else
     {
+    #ifdef RECOVER_LAYER_INDEX
+    processFilePos = cmdFilePos[bufindr];
+    if (recover_layer_jump())
+        return;
+    #endif
     process_command(cmdbuffer[bufindr], serialCmd & (1 << bufindr));
+    #ifdef RECOVER_LAYER_INDEX
+    processFilePos = NO_FILE_POS;
+    #endif
     }
   #else
     process_command(cmdbuffer[bufindr], serialCmd & (1 << bufindr));
@@ -589,7 +760,7 @@ void loop()
 
 FORCE_INLINE float code_value()
 {
-  return (strtod(strchr_pointer + 1, NULL));
+  return code_param ? code_param->value : (strtod(strchr_pointer + 1, NULL));
 }
 
 FORCE_INLINE long code_value_long()
@@ -597,8 +768,56 @@ FORCE_INLINE long code_value_long()
   return (strtol(strchr_pointer + 1, NULL, 10));
 }
 
+// Tokenize the command in one pass: the first of every letter goes into code_params[] with its value, so code_seen()
+// and code_value() do not search and convert the command again for every parameter. Same result as strchr(), letters
+// inside a filename count as well.
+static void parse_command(const char *cmd)
+{
+  code_param_count = 0;
+  code_params_full = false;
+  for(uint8_t n=0; cmd[n] && n < 0xFF; ++n)
+  {
+    char code = cmd[n];
+    if (code < 'A' || code > 'Z')
+      continue;
+    uint8_t i = 0;
+    while (i < code_param_count && code_params[i].code != code)
+      ++i;
+    if (i < code_param_count)
+      continue;
+    if (code_param_count == CODE_PARAMS_MAX)
+    {
+      code_params_full = true;
+      break;
+    }
+    code_params[i].code = code;
+    code_params[i].offset = n;
+    code_params[i].value = strtod(cmd + n + 1, NULL);
+    ++code_param_count;
+  }
+  code_cmd = cmd;
+}
+
 static bool code_seen(const char *cmd, char code)
 {
+  code_param = NULL;
+  if (cmd == code_cmd)
+  {
+    for(uint8_t i=0; i < code_param_count; ++i)
+    {
+      if (code_params[i].code == code)
+      {
+        code_param = &code_params[i];
+        strchr_pointer = (char *)cmd + code_param->offset;
+        return true;
+      }
+    }
+    if (!code_params_full && code >= 'A' && code <= 'Z')
+    {
+      strchr_pointer = NULL;
+      return false;
+    }
+  }
   strchr_pointer = strchr(cmd, code);
   return (strchr_pointer != NULL);  //Return True if a character was found
 }
@@ -607,13 +826,22 @@ static bool code_seen(const char *cmd, char code)
  * Copy a command directly into the main command buffer, from RAM.
  * Returns true if successfully adds the command
  */
-static bool insertcommand(const char* cmd, bool isSerialCmd) {
+static bool insertcommand(const char* cmd, bool isSerialCmd, uint32_t filePos = NO_FILE_POS) {
   if (*cmd == ';' || buflen >= BUFSIZE) return false;
   strcpy(cmdbuffer[bufindw], cmd);
-  commit_command(isSerialCmd);
+  commit_command(isSerialCmd, filePos);
   return true;
 }
 
+#ifdef BINARY_GCODE
+static bool insertrecord(const uint8_t* record, uint8_t length, bool isSerialCmd, uint32_t filePos = NO_FILE_POS) {
+  if (buflen >= BUFSIZE) return false;
+  memcpy(cmdbuffer[bufindw], record, length);
+  commit_command(isSerialCmd, filePos);
+  return true;
+}
+#endif
+
 static void gcode_line_error(const char* err, bool doFlush) {
   SERIAL_ERROR_START;
   serialprintPGM(err);
@@ -628,6 +856,41 @@ inline void get_serial_commands()
   while( buflen < BUFSIZE && MYSERIAL.available() > 0)
   {
     char serial_char = MYSERIAL.read();
+#ifdef BINARY_GCODE
+    /**
+     * Binary records end at their length instead of a line end
+     */
+    if (serial_count ? (cmd_line_buffer[0] & BGCODE_MARKER) : (!comment_mode && (serial_char & BGCODE_MARKER)))
+    {
+      cmd_line_buffer[serial_count++] = serial_char;
+      uint8_t length = bgcode_length((uint8_t*)cmd_line_buffer, serial_count);
+      if (!length)
+      {
+        if (serial_count >= BGCODE_MAX_LENGTH)
+          gcode_line_error(PSTR(MSG_ERR_CHECKSUM_MISMATCH), true);
+        continue;
+      }
+      serial_count = 0;
+      if (!bgcode_checksum_ok((uint8_t*)cmd_line_buffer, length)) {
+        gcode_line_error(PSTR(MSG_ERR_CHECKSUM_MISMATCH), true);
+        return;
+      }
+      if (cmd_line_buffer[0] & BGCODE_NUMBERED) {
+        gcode_N = bgcode_line_number((uint8_t*)cmd_line_buffer);
+        if (gcode_N != gcode_LastN + 1) {
+          gcode_line_error(PSTR(MSG_ERR_LINE_NO), true);
+          return;
+        }
+        gcode_LastN = gcode_N;
+      }
+      if (IsStopped()) {
+        SERIAL_ERRORLNPGM(MSG_ERR_STOPPED);
+        LCD_MESSAGEPGM(MSG_STOPPED);
+      }
+      insertrecord((uint8_t*)cmd_line_buffer, length, true);
+      continue;
+    }
+#endif
     /**
      * If the character ends the line
      */
@@ -751,14 +1014,10 @@ inline void get_sdcard_commands()
 {
     if (!card.sdprinting() || card.pause() || (printing_state == PRINT_STATE_ABORT)) return;
 
-    uint16_t sd_count = 0;
-    char sd_char = '\0';
-    static uint32_t endOfLineFilePosition = 0;
-
-    bool card_eof = card.eof();
-    while (buflen < BUFSIZE && !card_eof)
+    while (buflen < BUFSIZE)
     {
-        int16_t n = card.get();
+        uint32_t startOfLineFilePosition = card.getFilePos();
+        int16_t len = card.getLine(cmd_line_buffer, MAX_CMD_SIZE);
         if (card.errorCode())
         {
             if (!card.sdInserted())
@@ -770,73 +1029,66 @@ inline void get_sdcard_commands()
             //On an error, reset the error, reset the file position and try again.
             card.clearError();
             //Screw it, if we are near the end of a file with an error, act if the file is finished. Hopefully preventing the hang at the end.
-            if (endOfLineFilePosition > card.getFileSize() - 512)
+            if (startOfLineFilePosition > card.getFileSize() - 512)
                 card.stopPrinting();
             else
-                card.setIndex(endOfLineFilePosition);
+                card.setIndex(startOfLineFilePosition);
 
             return;
         }
 
-        if (n<=0)
-        {
-            card_eof = true;
-            sd_char = '\0';
-        }
-        else
+        if (len < 0)
         {
-            card_eof = card.eof();
-            sd_char = (char)n;
-        }
-        if (card_eof
-            || sd_char == '\n' || sd_char == '\r'
-            || ((sd_char == '#' || sd_char == ':') && !comment_mode))
-        {
-            if (card_eof) {
-                SERIAL_PROTOCOLLNPGM(MSG_FILE_PRINTED);
-
-                stoptime=millis();
-                char time[30];
-                unsigned long t=(stoptime-starttime)/1000;
-                int minutes=(t/60)%60;
-                int hours=t/60/60;
-                sprintf_P(time, PSTR("%i hours %i minutes"),hours, minutes);
-                SERIAL_ECHO_START;
-                SERIAL_ECHOLN(time);
-                lcd_setstatus(time);
-
-                card.printingHasFinished();
-                card.checkautostart(true);
-            }
-
-            comment_mode = false; //for new command
-
-            if (!sd_count) continue; //skip empty lines
-
-            cmd_line_buffer[sd_count] = '\0'; //terminate string
-            sd_count = 0; //clear buffer
-            endOfLineFilePosition = card.getFilePos();
+            SERIAL_PROTOCOLLNPGM(MSG_FILE_PRINTED);
+
+            stoptime=millis();
+            char time[30];
+            unsigned long t=(stoptime-starttime)/1000;
+            int minutes=(t/60)%60;
+            int hours=t/60/60;
+            sprintf_P(time, PSTR("%i hours %i minutes"),hours, minutes);
+            SERIAL_ECHO_START;
+            SERIAL_ECHOLN(time);
+            lcd_setstatus(time);
 
-            insertcommand(cmd_line_buffer, false);
+            card.printingHasFinished();
+            card.checkautostart(true);
+            return;
         }
-        else if (sd_count < MAX_CMD_SIZE - 1)
+
+#ifdef BINARY_GCODE
+        if (cmd_line_buffer[0] & BGCODE_MARKER)
         {
-            if (sd_char == ';')
+            if (bgcode_length((uint8_t*)cmd_line_buffer, len) == len && bgcode_checksum_ok((uint8_t*)cmd_line_buffer, len))
             {
-                comment_mode = true;
+                insertrecord((uint8_t*)cmd_line_buffer, len, false, startOfLineFilePosition);
             }
-            else if (!comment_mode)
+            else
             {
-                // add char to line buffer
-                cmd_line_buffer[sd_count++] = sd_char;
+                SERIAL_ERROR_START;
+                SERIAL_ERRORPGM(MSG_ERR_CHECKSUM_MISMATCH);
+                SERIAL_ERRORLN(startOfLineFilePosition);
             }
+            continue;
         }
-        /**
-         * Keep fetching, but ignore normal characters beyond the max length
-         * The command will be injected when EOL is reached
-         */
+#endif
+        if (len > 0) //skip empty lines
+            insertcommand(cmd_line_buffer, false, startOfLineFilePosition);
+    }
+}
+
+#ifdef SDCARD_BENCHMARK
+//Fill the command buffer from the card like the main loop does, and hand the commands to the benchmark instead of executing them.
+void sdcard_bench_read(void (*command)(const char* cmd))
+{
+    get_sdcard_commands();
+    while (buflen)
+    {
+        command(cmdbuffer[bufindr]);
+        remove_command();
     }
 }
+#endif //SDCARD_BENCHMARK
 #endif //SDSUPPORT
 
 static void get_command()
@@ -1081,9 +1333,9 @@ static void homeaxis(int axis) {
 /**
  * M105: Read hot end and bed temperature
  */
-inline void gcode_M105(const char *cmd)
+static uint8_t gcode_M105(const char *cmd)
 {
-  if (setTargetedHotend(cmd, 105)) return;
+  if (setTargetedHotend(cmd, 105)) return GCODE_REPLIED;
   #if (TEMP_SENSOR_0 != 0) || (TEMP_SENSOR_BED != 0) || defined(HEATER_0_USES_MAX6675)
     SERIAL_PROTOCOLPGM(MSG_OK);
     print_heaterstates();
@@ -1092,12 +1344,13 @@ inline void gcode_M105(const char *cmd)
     SERIAL_ERROR_START;
     SERIAL_ERRORLNPGM(MSG_ERR_NO_THERMISTORS);
   #endif
+  return GCODE_REPLIED; // "ok" already printed
 }
 
 /**
  * G92: Set current position to given X Y Z E
  */
-inline void gcode_G92(const char *cmd)
+static uint8_t gcode_G92(const char *cmd)
 {
   // bool didE = code_seen(cmd, axis_codes[E_AXIS]);
   // if (!didE) st_synchronize();
@@ -1123,6 +1376,7 @@ inline void gcode_G92(const char *cmd)
     plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
   else if (didE)
     plan_set_e_position(current_position[E_AXIS], active_extruder, false);
+  return GCODE_DONE;
 }
 
 static char * truncate_checksum(char *str)
@@ -1139,1694 +1393,2238 @@ static char * truncate_checksum(char *str)
     return 0;
 }
 
-void process_command(const char *strCmd, bool sendAck)
+#ifdef BINARY_GCODE
+// G1 from a record of binary_gcode.h. The record holds absolute positions, relative modes and firmware retraction
+// do not apply to it.
+static void process_binary_move(const char *record)
 {
-  unsigned long codenum; //throw away variable
-
-  if ((printing_state != PRINT_STATE_RECOVER) && (printing_state != PRINT_STATE_START) && (printing_state != PRINT_STATE_ABORT))
-    printing_state = PRINT_STATE_NORMAL;
-
-  if(code_seen(strCmd, 'G'))
+#ifdef RECOVER_LAYER_INDEX
+  int32_t recordBase[4];
+  bgcode_get_position(recordBase);
+#endif
+  memcpy(destination, current_position, sizeof(destination));
+  if (bgcode_decode((const uint8_t*)record, destination, next_feedrate) & BGCODE_F)
+  {
+    if(next_feedrate > 0.0) feedrate = next_feedrate;
+  }
+#ifdef RECOVER_LAYER_INDEX
+  recover_layer_record(recordBase);
+#endif
+  if (printing_state == PRINT_STATE_RECOVER)
   {
-    switch((int)code_value())
+    // The recover replay keeps the move that continues the print as text
+    char cmd[MAX_CMD_SIZE];
+    char *c = cmd + sprintf_P(cmd, PSTR("G1 F%ld"), long(feedrate));
+    for(uint8_t i=0; i < NUM_AXIS; ++i)
     {
-    case 0: // G0 -> G1
-    case 1: // G1
-      if(!Stopped) {
-        get_coordinates(strCmd); // For X Y Z E F
-        prepare_move(strCmd);
-        if (sendAck) ClearToSend();
-        return;
-      }
-      //break;
-    case 2: // G2  - CW ARC
-      if(!Stopped) {
-        get_arc_coordinates(strCmd);
-        prepare_arc_move(true);
-        if (sendAck) ClearToSend();
-        return;
-      }
-    case 3: // G3  - CCW ARC
-      if(!Stopped) {
-        get_arc_coordinates(strCmd);
-        prepare_arc_move(false);
-        if (sendAck) ClearToSend();
-        return;
-      }
-    case 4: // G4 dwell
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
+      long value = lround(destination[i] * BGCODE_SCALE);
+      c += sprintf_P(c, PSTR(" %c%s%ld.%03ld"), axis_codes[i], (value < 0) ? "-" : "", labs(value) / BGCODE_SCALE, labs(value) % BGCODE_SCALE);
+    }
+    prepare_move(cmd);
+  }
+  else
+  {
+    prepare_move(record);
+  }
+}
+#endif
 
-      serial_action_P(PSTR("pause"));
-      LCD_MESSAGEPGM(MSG_DWELL);
-      codenum = 0;
-      if(code_seen(strCmd, 'P')) codenum = code_value(); // milliseconds to wait
-      if(code_seen(strCmd, 'S')) codenum = code_value() * 1000; // seconds to wait
+// G and M code handlers, process_command() finds them in gcode_G_table[] and gcode_M_table[]. strchr_pointer
+// points at the G or M of the command when a handler is called.
+typedef uint8_t (*gcode_handler_t)(const char *strCmd);
 
-      st_synchronize();
-      codenum += millis();  // keep track of when we started waiting
-      previous_millis_cmd = millis();
-      printing_state = PRINT_STATE_DWELL;
-      while(millis() < codenum )
-      {
-          idle();
-      }
-      serial_action_P(PSTR("resume"));
+typedef struct {
+  uint16_t code;
+  gcode_handler_t handler;
+} gcode_entry_t;
 
-      break;
-      #ifdef FWRETRACT
-      case 10: // G10 retract
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
-      if(!retracted)
-      {
-        destination[X_AXIS]=current_position[X_AXIS];
-        destination[Y_AXIS]=current_position[Y_AXIS];
-        destination[Z_AXIS]=current_position[Z_AXIS];
-        #if EXTRUDERS > 1
-        if (code_seen(strCmd, 'S') && code_value_long() == 1)
-            destination[E_AXIS]=current_position[E_AXIS]-extruder_swap_retract_length/volume_to_filament_length[active_extruder];
-        else
-            destination[E_AXIS]=current_position[E_AXIS]-retract_length/volume_to_filament_length[active_extruder];
-        #else
-        destination[E_AXIS]=current_position[E_AXIS]-retract_length/volume_to_filament_length[active_extruder];
-        #endif
-        float oldFeedrate = feedrate;
-        feedrate=retract_feedrate;
-        retract_recover_length = current_position[E_AXIS]-destination[E_AXIS];//Set the recover length to whatever distance we retracted so we recover properly.
-        retracted=true;
-        prepare_move(strCmd);
-        feedrate = oldFeedrate;
-      }
+// G0 -> G1, G1 - Coordinated Movement X Y Z E
+static uint8_t gcode_G1(const char *strCmd)
+{
+  if(Stopped)
+    return GCODE_DONE;
+  get_coordinates(strCmd); // For X Y Z E F
+#ifdef RECOVER_LAYER_INDEX
+  recover_layer_record();
+#endif
+  prepare_move(strCmd);
+  return GCODE_MOVE;
+}
 
-      break;
-      case 11: // G11 retract_recover
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
-      if(retracted)
-      {
-        destination[X_AXIS]=current_position[X_AXIS];
-        destination[Y_AXIS]=current_position[Y_AXIS];
-        destination[Z_AXIS]=current_position[Z_AXIS];
-        destination[E_AXIS]=current_position[E_AXIS]+retract_recover_length;
-        float oldFeedrate = feedrate;
-        feedrate=retract_recover_feedrate;
-        retracted=false;
-        prepare_move(strCmd);
-        feedrate = oldFeedrate;
-      }
-      break;
-      #endif //FWRETRACT
-    case 28: //G28 Home all Axis one at a time
-      if ((printing_state == PRINT_STATE_RECOVER) || (printing_state == PRINT_STATE_HOMING))
-        break;
+// G2 - CW ARC
+static uint8_t gcode_G2(const char *strCmd)
+{
+  if(Stopped)
+    return GCODE_DONE;
+  get_arc_coordinates(strCmd);
+#ifdef RECOVER_LAYER_INDEX
+  recover_layer_record();
+#endif
+  prepare_arc_move(true);
+  return GCODE_MOVE;
+}
 
-      if ((printing_state != PRINT_STATE_START) && (printing_state != PRINT_STATE_ABORT))
-        printing_state = PRINT_STATE_HOMING;
+// G3 - CCW ARC
+static uint8_t gcode_G3(const char *strCmd)
+{
+  if(Stopped)
+    return GCODE_DONE;
+  get_arc_coordinates(strCmd);
+#ifdef RECOVER_LAYER_INDEX
+  recover_layer_record();
+#endif
+  prepare_arc_move(false);
+  return GCODE_MOVE;
+}
 
-      st_synchronize();
-      saved_feedrate = feedrate;
-      saved_feedmultiply = feedmultiply;
-      feedmultiply = 100;
-      previous_millis_cmd = millis();
+// G4 dwell
+static uint8_t gcode_G4(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
 
-      enable_endstops(true);
+  serial_action_P(PSTR("pause"));
+  LCD_MESSAGEPGM(MSG_DWELL);
+  unsigned long codenum = 0;
+  if(code_seen(strCmd, 'P')) codenum = code_value(); // milliseconds to wait
+  if(code_seen(strCmd, 'S')) codenum = code_value() * 1000; // seconds to wait
 
-      memcpy(destination, current_position, sizeof(destination));
-      feedrate = 0.0;
+  st_synchronize();
+  codenum += millis();  // keep track of when we started waiting
+  previous_millis_cmd = millis();
+  printing_state = PRINT_STATE_DWELL;
+  while(millis() < codenum )
+  {
+      idle();
+  }
+  serial_action_P(PSTR("resume"));
 
-#ifdef DELTA
-          // A delta can only safely home all axis at the same time
-          // all axis have to home at the same time
-
-          // Move all carriages up together until the first endstop is hit.
-          current_position[X_AXIS] = 0;
-          current_position[Y_AXIS] = 0;
-          current_position[Z_AXIS] = 0;
-          plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
-
-          destination[X_AXIS] = 3 * AXIS_LENGTH(Z_AXIS);
-          destination[Y_AXIS] = 3 * AXIS_LENGTH(Z_AXIS);
-          destination[Z_AXIS] = 3 * AXIS_LENGTH(Z_AXIS);
-          feedrate = 1.732 * homing_feedrate[X_AXIS];
-          plan_buffer_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], feedrate/60, active_extruder);
-          st_synchronize();
-          endstops_hit_on_purpose();
-
-          current_position[X_AXIS] = destination[X_AXIS];
-          current_position[Y_AXIS] = destination[Y_AXIS];
-          current_position[Z_AXIS] = destination[Z_AXIS];
-
-          // take care of back off and rehome now we are all at the top
-          HOMEAXIS(X);
-          HOMEAXIS(Y);
-          HOMEAXIS(Z);
-
-          calculate_delta(current_position);
-          plan_set_position(delta[X_AXIS], delta[Y_AXIS], delta[Z_AXIS], current_position[E_AXIS], active_extruder, true);
+  return GCODE_DONE;
+}
 
-#else // NOT DELTA
+#ifdef FWRETRACT
+// G10 retract
+static uint8_t gcode_G10(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  if(!retracted)
+  {
+    destination[X_AXIS]=current_position[X_AXIS];
+    destination[Y_AXIS]=current_position[Y_AXIS];
+    destination[Z_AXIS]=current_position[Z_AXIS];
+    #if EXTRUDERS > 1
+    if (code_seen(strCmd, 'S') && code_value_long() == 1)
+        destination[E_AXIS]=current_position[E_AXIS]-extruder_swap_retract_length/volume_to_filament_length[active_extruder];
+    else
+        destination[E_AXIS]=current_position[E_AXIS]-retract_length/volume_to_filament_length[active_extruder];
+    #else
+    destination[E_AXIS]=current_position[E_AXIS]-retract_length/volume_to_filament_length[active_extruder];
+    #endif
+    float oldFeedrate = feedrate;
+    feedrate=retract_feedrate;
+    retract_recover_length = current_position[E_AXIS]-destination[E_AXIS];//Set the recover length to whatever distance we retracted so we recover properly.
+    retracted=true;
+    prepare_move(strCmd);
+    feedrate = oldFeedrate;
+  }
 
-          home_all_axis = !((code_seen(strCmd, axis_codes[X_AXIS])) || (code_seen(strCmd, axis_codes[Y_AXIS])) || (code_seen(strCmd, axis_codes[Z_AXIS])));
+  return GCODE_DONE;
+}
 
-      #if Z_HOME_DIR > 0                      // If homing away from BED do Z first
-      #if defined(QUICK_HOME)
-      if(home_all_axis)
-      {
-        current_position[X_AXIS] = 0; current_position[Y_AXIS] = 0; current_position[Z_AXIS] = 0;
+// G11 retract_recover
+static uint8_t gcode_G11(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  if(retracted)
+  {
+    destination[X_AXIS]=current_position[X_AXIS];
+    destination[Y_AXIS]=current_position[Y_AXIS];
+    destination[Z_AXIS]=current_position[Z_AXIS];
+    destination[E_AXIS]=current_position[E_AXIS]+retract_recover_length;
+    float oldFeedrate = feedrate;
+    feedrate=retract_recover_feedrate;
+    retracted=false;
+    prepare_move(strCmd);
+    feedrate = oldFeedrate;
+  }
+  return GCODE_DONE;
+}
 
-        plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
+#endif //FWRETRACT
+// G28 Home all Axis one at a time
+static uint8_t gcode_G28(const char *strCmd)
+{
+  if ((printing_state == PRINT_STATE_RECOVER) || (printing_state == PRINT_STATE_HOMING))
+    return GCODE_DONE;
 
-        destination[X_AXIS] = 1.5 * AXIS_LENGTH(X_AXIS) * X_HOME_DIR;
-        destination[Y_AXIS] = 1.5 * AXIS_LENGTH(Y_AXIS) * Y_HOME_DIR;
-        destination[Z_AXIS] = 1.5 * AXIS_LENGTH(Z_AXIS) * Z_HOME_DIR;
-        feedrate = homing_feedrate[X_AXIS];
-        plan_buffer_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], feedrate/60, active_extruder);
-        st_synchronize();
-        endstops_hit_on_purpose();
+  if ((printing_state != PRINT_STATE_START) && (printing_state != PRINT_STATE_ABORT))
+    printing_state = PRINT_STATE_HOMING;
 
-        axis_is_at_home(X_AXIS);
-        axis_is_at_home(Y_AXIS);
-        axis_is_at_home(Z_AXIS);
-        plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
-        destination[X_AXIS] = current_position[X_AXIS];
-        destination[Y_AXIS] = current_position[Y_AXIS];
-        destination[Z_AXIS] = current_position[Z_AXIS];
-        plan_buffer_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], feedrate/60, active_extruder);
-        feedrate = 0.0;
-        st_synchronize();
-        endstops_hit_on_purpose();
+  st_synchronize();
+  saved_feedrate = feedrate;
+  saved_feedmultiply = feedmultiply;
+  feedmultiply = 100;
+  previous_millis_cmd = millis();
 
-        current_position[X_AXIS] = destination[X_AXIS];
-        current_position[Y_AXIS] = destination[Y_AXIS];
-        current_position[Z_AXIS] = destination[Z_AXIS];
-      }
-      #endif
-      if((home_all_axis) || (code_seen(strCmd, axis_codes[Z_AXIS]))) {
-        HOMEAXIS(Z);
-      }
-      #endif
+  enable_endstops(true);
 
-      #if defined(QUICK_HOME)
-      if((home_all_axis)||( code_seen(strCmd, axis_codes[X_AXIS]) && code_seen(strCmd, axis_codes[Y_AXIS])) )  //first diagonal move
-      {
-        current_position[X_AXIS] = 0;current_position[Y_AXIS] = 0;
+  memcpy(destination, current_position, sizeof(destination));
+  feedrate = 0.0;
 
-        plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
-        destination[X_AXIS] = 1.5 * AXIS_LENGTH(X_AXIS) * X_HOME_DIR;
-		destination[Y_AXIS] = 1.5 * AXIS_LENGTH(Y_AXIS) * Y_HOME_DIR;
-        feedrate = homing_feedrate[X_AXIS];
-        if(homing_feedrate[Y_AXIS]<feedrate)
-          feedrate =homing_feedrate[Y_AXIS];
-        plan_buffer_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], feedrate/60, active_extruder);
-        st_synchronize();
+#ifdef DELTA
+      // A delta can only safely home all axis at the same time
+      // all axis have to home at the same time
 
-        axis_is_at_home(X_AXIS);
-        axis_is_at_home(Y_AXIS);
-        plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
-        destination[X_AXIS] = current_position[X_AXIS];
-        destination[Y_AXIS] = current_position[Y_AXIS];
-        plan_buffer_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], feedrate/60, active_extruder);
-        feedrate = 0.0;
-        st_synchronize();
-        endstops_hit_on_purpose();
+      // Move all carriages up together until the first endstop is hit.
+      current_position[X_AXIS] = 0;
+      current_position[Y_AXIS] = 0;
+      current_position[Z_AXIS] = 0;
+      plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
 
-        current_position[X_AXIS] = destination[X_AXIS];
-        current_position[Y_AXIS] = destination[Y_AXIS];
-        current_position[Z_AXIS] = destination[Z_AXIS];
-      }
-      #endif
+      destination[X_AXIS] = 3 * AXIS_LENGTH(Z_AXIS);
+      destination[Y_AXIS] = 3 * AXIS_LENGTH(Z_AXIS);
+      destination[Z_AXIS] = 3 * AXIS_LENGTH(Z_AXIS);
+      feedrate = 1.732 * homing_feedrate[X_AXIS];
+      plan_buffer_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], feedrate/60, active_extruder);
+      st_synchronize();
+      endstops_hit_on_purpose();
 
-      if((home_all_axis) || (code_seen(strCmd, axis_codes[X_AXIS])))
-      {
-        HOMEAXIS(X);
-      }
+      current_position[X_AXIS] = destination[X_AXIS];
+      current_position[Y_AXIS] = destination[Y_AXIS];
+      current_position[Z_AXIS] = destination[Z_AXIS];
 
-      if((home_all_axis) || (code_seen(strCmd, axis_codes[Y_AXIS]))) {
-        HOMEAXIS(Y);
-      }
+      // take care of back off and rehome now we are all at the top
+      HOMEAXIS(X);
+      HOMEAXIS(Y);
+      HOMEAXIS(Z);
 
-      #if Z_HOME_DIR < 0                      // If homing towards BED do Z last
-      if((home_all_axis) || (code_seen(strCmd, axis_codes[Z_AXIS]))) {
-        HOMEAXIS(Z);
-      }
-      #endif
+      calculate_delta(current_position);
+      plan_set_position(delta[X_AXIS], delta[Y_AXIS], delta[Z_AXIS], current_position[E_AXIS], active_extruder, true);
 
-      if(code_seen(strCmd, axis_codes[X_AXIS]))
-      {
-        if(code_value_long() != 0) {
-          current_position[X_AXIS]=code_value()+add_homeing[X_AXIS];
-        }
-      }
+#else // NOT DELTA
 
-      if(code_seen(strCmd, axis_codes[Y_AXIS])) {
-        if(code_value_long() != 0) {
-          current_position[Y_AXIS]=code_value()+add_homeing[Y_AXIS];
-        }
-      }
+      home_all_axis = !((code_seen(strCmd, axis_codes[X_AXIS])) || (code_seen(strCmd, axis_codes[Y_AXIS])) || (code_seen(strCmd, axis_codes[Z_AXIS])));
 
-      if(code_seen(strCmd, axis_codes[Z_AXIS])) {
-        if(code_value_long() != 0) {
-          current_position[Z_AXIS]=code_value()+add_homeing[Z_AXIS];
-        }
-      }
-      plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
-#endif // DELTA
+  #if Z_HOME_DIR > 0                      // If homing away from BED do Z first
+  #if defined(QUICK_HOME)
+  if(home_all_axis)
+  {
+    current_position[X_AXIS] = 0; current_position[Y_AXIS] = 0; current_position[Z_AXIS] = 0;
 
-      #ifdef ENDSTOPS_ONLY_FOR_HOMING
-        enable_endstops(false);
-      #endif
+    plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
 
-      feedrate = saved_feedrate;
-      feedmultiply = saved_feedmultiply;
-      previous_millis_cmd = millis();
-      endstops_hit_on_purpose();
-      break;
-    case 90: // G90
-      // relative_mode = false;
-      axis_relative_state &= ~RELATIVE_MODE;
-      break;
-    case 91: // G91
-      // relative_mode = true;
-      axis_relative_state |= RELATIVE_MODE;
-      break;
-    case 92: // G92
-      gcode_G92(strCmd);
-      break;
-    }
+    destination[X_AXIS] = 1.5 * AXIS_LENGTH(X_AXIS) * X_HOME_DIR;
+    destination[Y_AXIS] = 1.5 * AXIS_LENGTH(Y_AXIS) * Y_HOME_DIR;
+    destination[Z_AXIS] = 1.5 * AXIS_LENGTH(Z_AXIS) * Z_HOME_DIR;
+    feedrate = homing_feedrate[X_AXIS];
+    plan_buffer_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], feedrate/60, active_extruder);
+    st_synchronize();
+    endstops_hit_on_purpose();
+
+    axis_is_at_home(X_AXIS);
+    axis_is_at_home(Y_AXIS);
+    axis_is_at_home(Z_AXIS);
+    plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
+    destination[X_AXIS] = current_position[X_AXIS];
+    destination[Y_AXIS] = current_position[Y_AXIS];
+    destination[Z_AXIS] = current_position[Z_AXIS];
+    plan_buffer_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], feedrate/60, active_extruder);
+    feedrate = 0.0;
+    st_synchronize();
+    endstops_hit_on_purpose();
+
+    current_position[X_AXIS] = destination[X_AXIS];
+    current_position[Y_AXIS] = destination[Y_AXIS];
+    current_position[Z_AXIS] = destination[Z_AXIS];
+  }
+  #endif
+  if((home_all_axis) || (code_seen(strCmd, axis_codes[Z_AXIS]))) {
+    HOMEAXIS(Z);
   }
+  #endif
 
-  else if(code_seen(strCmd, 'M'))
+  #if defined(QUICK_HOME)
+  if((home_all_axis)||( code_seen(strCmd, axis_codes[X_AXIS]) && code_seen(strCmd, axis_codes[Y_AXIS])) )  //first diagonal move
   {
-    switch( (int)code_value() )
-    {
-#ifdef ULTIPANEL
-    case 0: // M0 - Unconditional stop - Wait for user button press on LCD
-    case 1: // M1 - Conditional stop - Wait for user button press on LCD
-    {
-      if ((printing_state == PRINT_STATE_RECOVER) || (printing_state == PRINT_STATE_ABORT))
-        break;
+    current_position[X_AXIS] = 0;current_position[Y_AXIS] = 0;
 
-      printing_state = PRINT_STATE_WAIT_USER;
-      LCD_MESSAGEPGM(MSG_USERWAIT);
+    plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
+    destination[X_AXIS] = 1.5 * AXIS_LENGTH(X_AXIS) * X_HOME_DIR;
+    destination[Y_AXIS] = 1.5 * AXIS_LENGTH(Y_AXIS) * Y_HOME_DIR;
+    feedrate = homing_feedrate[X_AXIS];
+    if(homing_feedrate[Y_AXIS]<feedrate)
+      feedrate =homing_feedrate[Y_AXIS];
+    plan_buffer_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], feedrate/60, active_extruder);
+    st_synchronize();
 
-//      serial_action_P(PSTR("pause"));
+    axis_is_at_home(X_AXIS);
+    axis_is_at_home(Y_AXIS);
+    plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
+    destination[X_AXIS] = current_position[X_AXIS];
+    destination[Y_AXIS] = current_position[Y_AXIS];
+    plan_buffer_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], feedrate/60, active_extruder);
+    feedrate = 0.0;
+    st_synchronize();
+    endstops_hit_on_purpose();
 
-      codenum = 0;
-      if(code_seen(strCmd, 'P')) codenum = code_value(); // milliseconds to wait
-      if(code_seen(strCmd, 'S')) codenum = code_value() * 1000; // seconds to wait
+    current_position[X_AXIS] = destination[X_AXIS];
+    current_position[Y_AXIS] = destination[Y_AXIS];
+    current_position[Z_AXIS] = destination[Z_AXIS];
+  }
+  #endif
 
-      st_synchronize();
-      previous_millis_cmd = millis();
-      if (codenum > 0)
-      {
-        codenum += millis();  // keep track of when we started waiting
-        while(millis()  < codenum && !lcd_clicked()){
-          idle();
-        }
-      }
-      else
-      {
-        while(!lcd_clicked())
-        {
-          idle();
-        }
-      }
-//      serial_action_P(PSTR("resume"));
-      LCD_MESSAGEPGM(MSG_RESUMING);
+  if((home_all_axis) || (code_seen(strCmd, axis_codes[X_AXIS])))
+  {
+    HOMEAXIS(X);
+  }
+
+  if((home_all_axis) || (code_seen(strCmd, axis_codes[Y_AXIS]))) {
+    HOMEAXIS(Y);
+  }
+
+  #if Z_HOME_DIR < 0                      // If homing towards BED do Z last
+  if((home_all_axis) || (code_seen(strCmd, axis_codes[Z_AXIS]))) {
+    HOMEAXIS(Z);
+  }
+  #endif
+
+  if(code_seen(strCmd, axis_codes[X_AXIS]))
+  {
+    if(code_value_long() != 0) {
+      current_position[X_AXIS]=code_value()+add_homeing[X_AXIS];
+    }
+  }
+
+  if(code_seen(strCmd, axis_codes[Y_AXIS])) {
+    if(code_value_long() != 0) {
+      current_position[Y_AXIS]=code_value()+add_homeing[Y_AXIS];
+    }
+  }
+
+  if(code_seen(strCmd, axis_codes[Z_AXIS])) {
+    if(code_value_long() != 0) {
+      current_position[Z_AXIS]=code_value()+add_homeing[Z_AXIS];
+    }
+  }
+  plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
+#endif // DELTA
+
+  #ifdef ENDSTOPS_ONLY_FOR_HOMING
+    enable_endstops(false);
+  #endif
+
+  feedrate = saved_feedrate;
+  feedmultiply = saved_feedmultiply;
+  previous_millis_cmd = millis();
+  endstops_hit_on_purpose();
+  return GCODE_DONE;
+}
+
+// G90
+static uint8_t gcode_G90(const char *strCmd)
+{
+  // relative_mode = false;
+  axis_relative_state &= ~RELATIVE_MODE;
+  return GCODE_DONE;
+}
+
+// G91
+static uint8_t gcode_G91(const char *strCmd)
+{
+  // relative_mode = true;
+  axis_relative_state |= RELATIVE_MODE;
+  return GCODE_DONE;
+}
+
+#ifdef ULTIPANEL
+// M0 - Unconditional stop - Wait for user button press on LCD, also M1
+static uint8_t gcode_M0(const char *strCmd)
+{
+  if ((printing_state == PRINT_STATE_RECOVER) || (printing_state == PRINT_STATE_ABORT))
+    return GCODE_DONE;
+
+  printing_state = PRINT_STATE_WAIT_USER;
+  LCD_MESSAGEPGM(MSG_USERWAIT);
+
+  //      serial_action_P(PSTR("pause"));
+
+  unsigned long codenum = 0;
+  if(code_seen(strCmd, 'P')) codenum = code_value(); // milliseconds to wait
+  if(code_seen(strCmd, 'S')) codenum = code_value() * 1000; // seconds to wait
+
+  st_synchronize();
+  previous_millis_cmd = millis();
+  if (codenum > 0)
+  {
+    codenum += millis();  // keep track of when we started waiting
+    while(millis()  < codenum && !lcd_clicked()){
+      idle();
     }
-    break;
+  }
+  else
+  {
+    while(!lcd_clicked())
+    {
+      idle();
+    }
+  }
+  //      serial_action_P(PSTR("resume"));
+  LCD_MESSAGEPGM(MSG_RESUMING);
+  return GCODE_DONE;
+}
+
 #endif
 #ifdef ENABLE_ULTILCD2
-    case 0: // M0 - Unconditional stop - Wait for user button press on LCD
-    case 1: // M1 - Conditional stop - Wait for user button press on LCD
-    {
-        if (printing_state == PRINT_STATE_RECOVER)
-          break;
+// M0 - Unconditional stop - Wait for user button press on LCD, also M1
+static uint8_t gcode_M0(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+
+  //        serial_action_P(PSTR("pause"));
+  card.pauseSDPrint();
+  while(card.pause())
+  {
+    idle();
+  }
+  plan_set_e_position(current_position[E_AXIS], active_extruder, true);
+  //        serial_action_P(PSTR("resume"));
+  return GCODE_DONE;
+}
 
-//        serial_action_P(PSTR("pause"));
-        card.pauseSDPrint();
-        while(card.pause())
-        {
-          idle();
-        }
-        plan_set_e_position(current_position[E_AXIS], active_extruder, true);
-//        serial_action_P(PSTR("resume"));
-    }
-    break;
 #endif
-    case 17:
-        if (printing_state == PRINT_STATE_RECOVER)
-          break;
-        LCD_MESSAGEPGM(MSG_NO_MOVE);
-        enable_x();
-        enable_y();
-        enable_z();
-        enable_e0();
-        enable_e1();
-        enable_e2();
-      break;
+// M17
+static uint8_t gcode_M17(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  LCD_MESSAGEPGM(MSG_NO_MOVE);
+  enable_x();
+  enable_y();
+  enable_z();
+  enable_e0();
+  enable_e1();
+  enable_e2();
+  return GCODE_DONE;
+}
 
 #ifdef SDSUPPORT
-    case 20: // M20 - list SD card
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
-      SERIAL_PROTOCOLLNPGM(MSG_BEGIN_FILE_LIST);
-      card.ls();
-      SERIAL_PROTOCOLLNPGM(MSG_END_FILE_LIST);
-      ClearToSend();
-      return;
-    case 21: // M21 - init SD card
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
+// M20 - list SD card
+static uint8_t gcode_M20(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  SERIAL_PROTOCOLLNPGM(MSG_BEGIN_FILE_LIST);
+  card.ls();
+  SERIAL_PROTOCOLLNPGM(MSG_END_FILE_LIST);
+  ClearToSend();
+  return GCODE_REPLIED;
+}
 
-      card.initsd();
-      ClearToSend();
-      return;
-    case 22: //M22 - release SD card
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
-      card.release();
-      ClearToSend();
-      return;
-    case 23: //M23 - Select file
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
-      strchr_pointer += 4;
-      truncate_checksum(strchr_pointer);
-      card.openFile(strchr_pointer, true);
-      break;
-    case 24: //M24 - Start SD print
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
-      card.startFileprint();
-      starttime=millis();
-      stoptime=starttime;
-      break;
-    case 25: //M25 - Pause SD print
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
-      //card.pauseSDPrint();
-      card.closefile();
-      break;
-    case 26: //M26 - Set SD index
-      if(card.isOk() && code_seen(strCmd, 'S')) {
-        card.setIndex(code_value_long());
-      }
-      break;
-    case 27: //M27 - Get SD status
-      card.getStatus();
-      ClearToSend();
-      return;
-    case 28: //M28 - Start SD write
-      strchr_pointer += 4;
-      if(truncate_checksum(strchr_pointer)){
-        char* npos = strchr(strCmd, 'N');
-        strchr_pointer = strchr(npos,' ') + 1;
-      }
-      card.openFile(strchr_pointer, false);
-      break;
-    case 29: //M29 - Stop SD write
-      //processed in write to file routine above
-      //card,saving = false;
-      break;
-    case 30: //M30 <filename> Delete File
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
-      if (card.isOk()){
-        card.closefile();
-        strchr_pointer += 4;
-        if(truncate_checksum(strchr_pointer)){
-          char* npos = strchr(strCmd, 'N');
-          strchr_pointer = strchr(npos,' ') + 1;
-        }
-        card.removeFile(strchr_pointer);
-      }
-      break;
-    case 923: //M923 - Select file and start printing
-      strchr_pointer += 5;
-      truncate_checksum(strchr_pointer);
-      card.openFile(strchr_pointer,true);
-      card.startFileprint();
-      starttime=millis();
-      stoptime=starttime;
-      break;
-    case 928: //M928 - Start SD write
-      strchr_pointer += 5;
-      if(truncate_checksum(strchr_pointer)){
-        char* npos = strchr(strCmd, 'N');
-        strchr_pointer = strchr(npos,' ') + 1;
-      }
-      card.openLogFile(strchr_pointer);
-      break;
+// M21 - init SD card
+static uint8_t gcode_M21(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+
+  card.initsd();
+  ClearToSend();
+  return GCODE_REPLIED;
+}
+
+// M22 - release SD card
+static uint8_t gcode_M22(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  card.release();
+  ClearToSend();
+  return GCODE_REPLIED;
+}
+
+// M23 - Select file
+static uint8_t gcode_M23(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  strchr_pointer += 4;
+  truncate_checksum(strchr_pointer);
+  card.openFile(strchr_pointer, true);
+  return GCODE_DONE;
+}
+
+// M24 - Start SD print
+static uint8_t gcode_M24(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  card.startFileprint();
+  starttime=millis();
+  stoptime=starttime;
+  return GCODE_DONE;
+}
+
+// M25 - Pause SD print
+static uint8_t gcode_M25(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  //card.pauseSDPrint();
+  card.closefile();
+  return GCODE_DONE;
+}
+
+// M26 - Set SD index
+static uint8_t gcode_M26(const char *strCmd)
+{
+  if(card.isOk() && code_seen(strCmd, 'S')) {
+    card.setIndex(code_value_long());
+  }
+  return GCODE_DONE;
+}
+
+// M27 - Get SD status
+static uint8_t gcode_M27(const char *strCmd)
+{
+  card.getStatus();
+  ClearToSend();
+  return GCODE_REPLIED;
+}
+
+// M28 - Start SD write
+static uint8_t gcode_M28(const char *strCmd)
+{
+  strchr_pointer += 4;
+  if(truncate_checksum(strchr_pointer)){
+    char* npos = strchr(strCmd, 'N');
+    strchr_pointer = strchr(npos,' ') + 1;
+  }
+  card.openFile(strchr_pointer, false);
+  return GCODE_DONE;
+}
+
+// M29 - Stop SD write
+static uint8_t gcode_M29(const char *strCmd)
+{
+  //processed in write to file routine above
+  //card,saving = false;
+  return GCODE_DONE;
+}
+
+// M30 <filename> Delete File
+static uint8_t gcode_M30(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  if (card.isOk()){
+    card.closefile();
+    strchr_pointer += 4;
+    if(truncate_checksum(strchr_pointer)){
+      char* npos = strchr(strCmd, 'N');
+      strchr_pointer = strchr(npos,' ') + 1;
+    }
+    card.removeFile(strchr_pointer);
+  }
+  return GCODE_DONE;
+}
+
+// M923 - Select file and start printing
+static uint8_t gcode_M923(const char *strCmd)
+{
+  strchr_pointer += 5;
+  truncate_checksum(strchr_pointer);
+  card.openFile(strchr_pointer,true);
+  card.startFileprint();
+  starttime=millis();
+  stoptime=starttime;
+  return GCODE_DONE;
+}
+
+// M928 - Start SD write
+static uint8_t gcode_M928(const char *strCmd)
+{
+  strchr_pointer += 5;
+  if(truncate_checksum(strchr_pointer)){
+    char* npos = strchr(strCmd, 'N');
+    strchr_pointer = strchr(npos,' ') + 1;
+  }
+  card.openLogFile(strchr_pointer);
+  return GCODE_DONE;
+}
 
 #endif //SDSUPPORT
+// M31 take time since the start of the SD print or an M109 command
+static uint8_t gcode_M31(const char *strCmd)
+{
+  stoptime=millis();
+  char time[30];
+  unsigned long t=(stoptime-starttime)/1000;
+  int sec,min;
+  min=t/60;
+  sec=t%60;
+  sprintf_P(time, PSTR("%i min, %i sec"), min, sec);
+  SERIAL_ECHO_START;
+  SERIAL_ECHOLN(time);
+  lcd_setstatus(time);
+  autotempShutdown();
+  return GCODE_DONE;
+}
 
-    case 31: //M31 take time since the start of the SD print or an M109 command
-      {
-      stoptime=millis();
-      char time[30];
-      unsigned long t=(stoptime-starttime)/1000;
-      int sec,min;
-      min=t/60;
-      sec=t%60;
-      sprintf_P(time, PSTR("%i min, %i sec"), min, sec);
-      SERIAL_ECHO_START;
-      SERIAL_ECHOLN(time);
-      lcd_setstatus(time);
-      autotempShutdown();
-      }
-      break;
-    case 42: //M42 -Change pin status via gcode
-      if (code_seen(strCmd, 'S'))
-      {
-        int pin_status = code_value();
-        int pin_number = LED_PIN;
-        if (code_seen(strCmd, 'P') && pin_status >= 0 && pin_status <= 255)
-          pin_number = code_value();
+// M42 -Change pin status via gcode
+static uint8_t gcode_M42(const char *strCmd)
+{
+  if (code_seen(strCmd, 'S'))
+  {
+    int pin_status = code_value();
+    int pin_number = LED_PIN;
+    if (code_seen(strCmd, 'P') && pin_status >= 0 && pin_status <= 255)
+      pin_number = code_value();
 
-        for(uint8_t i = 0; i < COUNT(sensitive_pins); ++i)
-        {
-          if (sensitive_pins[i] == pin_number)
-          {
-            pin_number = -1;
-            break;
-          }
-        }
-      #if defined(FAN_PIN) && FAN_PIN > -1
-        if (pin_number == FAN_PIN)
-          fanSpeed = pin_status;
-      #endif
-        if (pin_number > -1)
-        {
-          analogWrite(pin_number, pin_status);
-        }
-      }
-     break;
-    case 104: // M104
-      if(setTargetedHotend(strCmd, 104)){
-        break;
-      }
-      if (code_seen(strCmd, 'S'))
-      {
-        float newTemperature = code_value();
-        setTargetHotend(roundTemperature(newTemperature), tmp_extruder);
-      }
-      if (printing_state != PRINT_STATE_RECOVER)
+    for(uint8_t i = 0; i < COUNT(sensitive_pins); ++i)
+    {
+      if (sensitive_pins[i] == pin_number)
       {
-        setWatch();
+        pin_number = -1;
+        break;
       }
-      break;
-    case 140: // M140 set bed temp
+    }
+  #if defined(FAN_PIN) && FAN_PIN > -1
+    if (pin_number == FAN_PIN)
+      fanSpeed = pin_status;
+  #endif
+    if (pin_number > -1)
+    {
+      analogWrite(pin_number, pin_status);
+    }
+  }
+  return GCODE_DONE;
+}
+
+// M104
+static uint8_t gcode_M104(const char *strCmd)
+{
+  if(setTargetedHotend(strCmd, 104)){
+    return GCODE_DONE;
+  }
+  if (code_seen(strCmd, 'S'))
+  {
+    float newTemperature = code_value();
+    setTargetHotend(roundTemperature(newTemperature), tmp_extruder);
+  }
+  if (printing_state != PRINT_STATE_RECOVER)
+  {
+    setWatch();
+  }
+  return GCODE_DONE;
+}
+
+// M140 set bed temp
+static uint8_t gcode_M140(const char *strCmd)
+{
 #if TEMP_SENSOR_BED != 0
-      if (code_seen(strCmd, 'S')) setTargetBed(code_value());
+  if (code_seen(strCmd, 'S')) setTargetBed(code_value());
 #endif // TEMP_SENSOR_BED
-      break;
-    case 105 : // M105
-        gcode_M105(strCmd);
-        return; // "ok" already printed
-      break;
-    case 109:
-    {// M109 - Wait for extruder heater to reach target.
-      if (printing_state == PRINT_STATE_ABORT)
-      {
-        break;
-      }
-      if(setTargetedHotend(strCmd, 109))
-	  {
-        break;
-      }
-      #ifdef AUTOTEMP
-        autotemp_enabled=false;
-      #endif
-      if (code_seen(strCmd, 'S'))
-      {
-        float newTemperature = code_value();
-        setTargetHotend(roundTemperature(newTemperature), tmp_extruder);
-      }
+  return GCODE_DONE;
+}
 
-      #ifdef AUTOTEMP
-        if (code_seen(strCmd, 'S')) autotemp_min=code_value();
-        if (code_seen(strCmd, 'B')) autotemp_max=code_value();
-        if (code_seen(strCmd, 'F'))
-        {
-          autotemp_factor=code_value();
-          autotemp_enabled=true;
-        }
-      #endif
-      if (printing_state == PRINT_STATE_RECOVER)
-          break;
+// M109
+static uint8_t gcode_M109(const char *strCmd)
+{
+  // M109 - Wait for extruder heater to reach target.
+  if (printing_state == PRINT_STATE_ABORT)
+  {
+    return GCODE_DONE;
+  }
+  if(setTargetedHotend(strCmd, 109))
+  {
+    return GCODE_DONE;
+  }
+  #ifdef AUTOTEMP
+    autotemp_enabled=false;
+  #endif
+  if (code_seen(strCmd, 'S'))
+  {
+    float newTemperature = code_value();
+    setTargetHotend(roundTemperature(newTemperature), tmp_extruder);
+  }
 
-      printing_state = PRINT_STATE_HEATING;
-      LCD_MESSAGEPGM(MSG_HEATING);
+  #ifdef AUTOTEMP
+    if (code_seen(strCmd, 'S')) autotemp_min=code_value();
+    if (code_seen(strCmd, 'B')) autotemp_max=code_value();
+    if (code_seen(strCmd, 'F'))
+    {
+      autotemp_factor=code_value();
+      autotemp_enabled=true;
+    }
+  #endif
+  if (printing_state == PRINT_STATE_RECOVER)
+      return GCODE_DONE;
 
-      setWatch();
-      codenum = millis();
+  printing_state = PRINT_STATE_HEATING;
+  LCD_MESSAGEPGM(MSG_HEATING);
 
-      /* See if we are heating up or cooling down */
-      bool target_direction = isHeatingHotend(tmp_extruder); // true if heating, false if cooling
+  setWatch();
+  unsigned long codenum = millis();
 
-      #ifdef TEMP_RESIDENCY_TIME
-        long residencyStart = -1;
-        /* continue to loop until we have reached the target temp
-          _and_ until TEMP_RESIDENCY_TIME hasn't passed since we reached it */
-        while((residencyStart == -1) ||
-              (residencyStart >= 0 && (((unsigned int) (millis() - residencyStart)) < (TEMP_RESIDENCY_TIME * 1000UL))) )
-        {
-      #else
-        while ( target_direction ? (isHeatingHotend(tmp_extruder)) : (isCoolingHotend(tmp_extruder)&&(CooldownNoWait==false)) )
-        {
-      #endif //TEMP_RESIDENCY_TIME
-          if( (millis() - codenum) > 1000UL )
-          { //Print Temp Reading and remaining time every 1 second while heating up/cooling down
-            #if (TEMP_SENSOR_0 != 0) || (TEMP_SENSOR_BED != 0) || defined(HEATER_0_USES_MAX6675)
-              print_heaterstates();
-            #endif
-            #ifdef TEMP_RESIDENCY_TIME
-              SERIAL_PROTOCOLPGM(" W:");
-              if(residencyStart > -1)
-              {
-                 codenum = ((TEMP_RESIDENCY_TIME * 1000UL) - (millis() - residencyStart)) / 1000UL;
-                 SERIAL_PROTOCOLLN( codenum );
-              }
-              else
-              {
-                 SERIAL_PROTOCOLLNPGM( "?" );
-              }
-            #else
-              SERIAL_EOL;
-            #endif
-            codenum = millis();
-          }
-          idle();
+  /* See if we are heating up or cooling down */
+  bool target_direction = isHeatingHotend(tmp_extruder); // true if heating, false if cooling
+
+  #ifdef TEMP_RESIDENCY_TIME
+    long residencyStart = -1;
+    /* continue to loop until we have reached the target temp
+      _and_ until TEMP_RESIDENCY_TIME hasn't passed since we reached it */
+    while((residencyStart == -1) ||
+          (residencyStart >= 0 && (((unsigned int) (millis() - residencyStart)) < (TEMP_RESIDENCY_TIME * 1000UL))) )
+    {
+  #else
+    while ( target_direction ? (isHeatingHotend(tmp_extruder)) : (isCoolingHotend(tmp_extruder)&&(CooldownNoWait==false)) )
+    {
+  #endif //TEMP_RESIDENCY_TIME
+      if( (millis() - codenum) > 1000UL )
+      { //Print Temp Reading and remaining time every 1 second while heating up/cooling down
+        #if (TEMP_SENSOR_0 != 0) || (TEMP_SENSOR_BED != 0) || defined(HEATER_0_USES_MAX6675)
+          print_heaterstates();
+        #endif
         #ifdef TEMP_RESIDENCY_TIME
-            /* start/restart the TEMP_RESIDENCY_TIME timer whenever we reach target temp for the first time
-              or when current temp falls outside the hysteresis after target temp was reached */
-          if ((residencyStart == -1 &&  target_direction && (degHotend(tmp_extruder) >= (degTargetHotend(tmp_extruder)-TEMP_WINDOW))) ||
-              (residencyStart == -1 && !target_direction && (degHotend(tmp_extruder) <= (degTargetHotend(tmp_extruder)+TEMP_WINDOW))) ||
-              (residencyStart > -1 && labs(degHotend(tmp_extruder) - degTargetHotend(tmp_extruder)) > TEMP_HYSTERESIS && (!target_direction || !CooldownNoWait)) )
+          SERIAL_PROTOCOLPGM(" W:");
+          if(residencyStart > -1)
           {
-            residencyStart = millis();
+             codenum = ((TEMP_RESIDENCY_TIME * 1000UL) - (millis() - residencyStart)) / 1000UL;
+             SERIAL_PROTOCOLLN( codenum );
           }
-        #endif //TEMP_RESIDENCY_TIME
-          if (printing_state != PRINT_STATE_HEATING)
+          else
           {
-              // print aborted
-              break;
+             SERIAL_PROTOCOLLNPGM( "?" );
           }
-        }
-        LCD_MESSAGEPGM(MSG_HEATING_COMPLETE);
-        previous_millis_cmd = millis();
+        #else
+          SERIAL_EOL;
+        #endif
+        codenum = millis();
       }
-      break;
-    case 190: // M190 - Wait for bed heater to reach target.
+      idle();
+    #ifdef TEMP_RESIDENCY_TIME
+        /* start/restart the TEMP_RESIDENCY_TIME timer whenever we reach target temp for the first time
+          or when current temp falls outside the hysteresis after target temp was reached */
+      if ((residencyStart == -1 &&  target_direction && (degHotend(tmp_extruder) >= (degTargetHotend(tmp_extruder)-TEMP_WINDOW))) ||
+          (residencyStart == -1 && !target_direction && (degHotend(tmp_extruder) <= (degTargetHotend(tmp_extruder)+TEMP_WINDOW))) ||
+          (residencyStart > -1 && labs(degHotend(tmp_extruder) - degTargetHotend(tmp_extruder)) > TEMP_HYSTERESIS && (!target_direction || !CooldownNoWait)) )
+      {
+        residencyStart = millis();
+      }
+    #endif //TEMP_RESIDENCY_TIME
+      if (printing_state != PRINT_STATE_HEATING)
+      {
+          // print aborted
+          break;
+      }
+    }
+    LCD_MESSAGEPGM(MSG_HEATING_COMPLETE);
+    previous_millis_cmd = millis();
+  return GCODE_DONE;
+}
+
+// M190 - Wait for bed heater to reach target.
+static uint8_t gcode_M190(const char *strCmd)
+{
     #if defined(TEMP_BED_PIN) && TEMP_BED_PIN > -1 && TEMP_SENSOR_BED != 0
-        if (code_seen(strCmd, 'S')) setTargetBed(code_value());
+  if (code_seen(strCmd, 'S')) setTargetBed(code_value());
 
-        if ((printing_state == PRINT_STATE_RECOVER) || (printing_state == PRINT_STATE_ABORT))
-            break;
+  if ((printing_state == PRINT_STATE_RECOVER) || (printing_state == PRINT_STATE_ABORT))
+      return GCODE_DONE;
 
-        printing_state = PRINT_STATE_HEATING_BED;
-        LCD_MESSAGEPGM(MSG_BED_HEATING);
+  printing_state = PRINT_STATE_HEATING_BED;
+  LCD_MESSAGEPGM(MSG_BED_HEATING);
 
-        codenum = millis();
-        unsigned long m;
+  unsigned long codenum = millis();
+  unsigned long m;
 
-        #if EXTRUDERS > 1
-        // set targeted hotend for serial output
-        tmp_extruder = active_extruder;
-        if (swapExtruders() && (tmp_extruder < 2))
-        {
-          tmp_extruder ^= 0x01;
-        }
-        #endif // EXTRUDERS
+  #if EXTRUDERS > 1
+  // set targeted hotend for serial output
+  tmp_extruder = active_extruder;
+  if (swapExtruders() && (tmp_extruder < 2))
+  {
+    tmp_extruder ^= 0x01;
+  }
+  #endif // EXTRUDERS
 
-        while(current_temperature_bed < target_temperature_bed - TEMP_WINDOW)
-        {
-          m = millis();
-          if((m - codenum) > 1000 ) //Print Temp Reading every 1 second while heating up.
-          {
-            codenum = m;
-            // float tt=degHotend(active_extruder);
-          #if (TEMP_SENSOR_0 != 0) || (TEMP_SENSOR_BED != 0) || defined(HEATER_0_USES_MAX6675)
-            print_heaterstates();
-            SERIAL_EOL;
-          #endif
-          }
-          idle();
-          if (printing_state != PRINT_STATE_HEATING_BED)
-          {
-              // print aborted
-              break;
-          }
-        }
-        LCD_MESSAGEPGM(MSG_BED_DONE);
-        previous_millis_cmd = millis();
+  while(current_temperature_bed < target_temperature_bed - TEMP_WINDOW)
+  {
+    m = millis();
+    if((m - codenum) > 1000 ) //Print Temp Reading every 1 second while heating up.
+    {
+      codenum = m;
+      // float tt=degHotend(active_extruder);
+    #if (TEMP_SENSOR_0 != 0) || (TEMP_SENSOR_BED != 0) || defined(HEATER_0_USES_MAX6675)
+      print_heaterstates();
+      SERIAL_EOL;
     #endif
+    }
+    idle();
+    if (printing_state != PRINT_STATE_HEATING_BED)
+    {
+        // print aborted
         break;
-
-    #if defined(FAN_PIN) && FAN_PIN > -1
-      case 106: //M106 Fan On
-        if (code_seen(strCmd, 'S')){
-           fanSpeed=constrain((int)code_value() * fanSpeedPercent / 100, 0, 255);
-        }
-        else {
-          fanSpeed = 255 * int(fanSpeedPercent) / 100;
-        }
-        break;
-      case 107: //M107 Fan Off
-        fanSpeed = 0;
-        break;
-    #endif //FAN_PIN
-    #ifdef BARICUDA
-      // PWM for HEATER_1_PIN
-      #if defined(HEATER_1_PIN) && HEATER_1_PIN > -1
-        case 126: //M126 valve open
-          if (printing_state == PRINT_STATE_RECOVER)
-            break;
-          if (code_seen(strCmd, 'S')){
-             ValvePressure=constrain((int)code_value(),0,255);
-          }
-          else {
-            ValvePressure=255;
-          }
-          break;
-        case 127: //M127 valve closed
-          if (printing_state == PRINT_STATE_RECOVER)
-            break;
-          ValvePressure = 0;
-          break;
-      #endif //HEATER_1_PIN
-
-      // PWM for HEATER_2_PIN
-      #if defined(HEATER_2_PIN) && HEATER_2_PIN > -1
-        case 128: //M128 valve open
-          if (printing_state == PRINT_STATE_RECOVER)
-            break;
-          if (code_seen(strCmd, 'S')){
-             EtoPPressure=constrain((int)code_value(),0,255);
-          }
-          else {
-            EtoPPressure=255;
-          }
-          break;
-        case 129: //M129 valve closed
-          if (printing_state == PRINT_STATE_RECOVER)
-            break;
-          EtoPPressure = 0;
-          break;
-      #endif //HEATER_2_PIN
+    }
+  }
+  LCD_MESSAGEPGM(MSG_BED_DONE);
+  previous_millis_cmd = millis();
     #endif
+  return GCODE_DONE;
+}
 
-    #if defined(PS_ON_PIN) && PS_ON_PIN > -1
-      case 80: // M80 - ATX Power On
-        SET_OUTPUT(PS_ON_PIN); //GND
-        WRITE(PS_ON_PIN, PS_ON_AWAKE);
-        break;
-      #endif
+#if defined(FAN_PIN) && FAN_PIN > -1
+// M106 Fan On
+static uint8_t gcode_M106(const char *strCmd)
+{
+  if (code_seen(strCmd, 'S')){
+     fanSpeed=constrain((int)code_value() * fanSpeedPercent / 100, 0, 255);
+  }
+  else {
+    fanSpeed = 255 * int(fanSpeedPercent) / 100;
+  }
+  return GCODE_DONE;
+}
+
+// M107 Fan Off
+static uint8_t gcode_M107(const char *strCmd)
+{
+  fanSpeed = 0;
+  return GCODE_DONE;
+}
+
+#endif //FAN_PIN
+#ifdef BARICUDA
+// PWM for HEATER_1_PIN
+#if defined(HEATER_1_PIN) && HEATER_1_PIN > -1
+// M126 valve open
+static uint8_t gcode_M126(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  if (code_seen(strCmd, 'S')){
+     ValvePressure=constrain((int)code_value(),0,255);
+  }
+  else {
+    ValvePressure=255;
+  }
+  return GCODE_DONE;
+}
 
-      case 81: // M81 - ATX Power Off
+// M127 valve closed
+static uint8_t gcode_M127(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  ValvePressure = 0;
+  return GCODE_DONE;
+}
+
+#endif //HEATER_1_PIN
+// PWM for HEATER_2_PIN
+#if defined(HEATER_2_PIN) && HEATER_2_PIN > -1
+// M128 valve open
+static uint8_t gcode_M128(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  if (code_seen(strCmd, 'S')){
+     EtoPPressure=constrain((int)code_value(),0,255);
+  }
+  else {
+    EtoPPressure=255;
+  }
+  return GCODE_DONE;
+}
+
+// M129 valve closed
+static uint8_t gcode_M129(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  EtoPPressure = 0;
+  return GCODE_DONE;
+}
+
+#endif //HEATER_2_PIN
+#endif
+#if defined(PS_ON_PIN) && PS_ON_PIN > -1
+// M80 - ATX Power On
+static uint8_t gcode_M80(const char *strCmd)
+{
+  SET_OUTPUT(PS_ON_PIN); //GND
+  WRITE(PS_ON_PIN, PS_ON_AWAKE);
+  return GCODE_DONE;
+}
 
+#endif
+// M81 - ATX Power Off
+static uint8_t gcode_M81(const char *strCmd)
+{
       #if defined(SUICIDE_PIN) && SUICIDE_PIN > -1
-        st_synchronize();
-        suicide();
+  st_synchronize();
+  suicide();
       #elif defined(PS_ON_PIN) && PS_ON_PIN > -1
-        SET_OUTPUT(PS_ON_PIN);
-        WRITE(PS_ON_PIN, PS_ON_ASLEEP);
+  SET_OUTPUT(PS_ON_PIN);
+  WRITE(PS_ON_PIN, PS_ON_ASLEEP);
       #endif
-        break;
+  return GCODE_DONE;
+}
 
-    case 82:
-      // axis_relative_modes[E_AXIS] = false;
-      axis_relative_state &= ~(1 << E_AXIS);
-      break;
-    case 83:
-      // axis_relative_modes[E_AXIS] = true;
-      axis_relative_state |= (1 << E_AXIS);
-      break;
-    case 18: //compatibility
-    case 84: // M84
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
-      if(code_seen(strCmd, 'S')){
+// M82
+static uint8_t gcode_M82(const char *strCmd)
+{
+  // axis_relative_modes[E_AXIS] = false;
+  axis_relative_state &= ~(1 << E_AXIS);
+  return GCODE_DONE;
+}
+
+// M83
+static uint8_t gcode_M83(const char *strCmd)
+{
+  // axis_relative_modes[E_AXIS] = true;
+  axis_relative_state |= (1 << E_AXIS);
+  return GCODE_DONE;
+}
+
+// M84, also M18
+static uint8_t gcode_M84(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  if(code_seen(strCmd, 'S')){
 #if DISABLE_X || DISABLE_Y || DISABLE_Z || DISABLE_E
-        stepper_inactive_time = code_value() * 1000;
+    stepper_inactive_time = code_value() * 1000;
 #endif
-      }
-      else
-      {
-        bool all_axis = !((code_seen(strCmd, axis_codes[0])) || (code_seen(strCmd, axis_codes[1])) || (code_seen(strCmd, axis_codes[2]))|| (code_seen(strCmd, axis_codes[3])));
-        if(all_axis)
-        {
-          finishAndDisableSteppers();
-        }
-        else
-        {
-          st_synchronize();
-          if(code_seen(strCmd, 'X')) disable_x();
-          if(code_seen(strCmd, 'Y')) disable_y();
-          if(code_seen(strCmd, 'Z')) disable_z();
-          #if ((E0_ENABLE_PIN != X_ENABLE_PIN) && (E1_ENABLE_PIN != Y_ENABLE_PIN)) // Only enable on boards that have seperate ENABLE_PINS
-            if(code_seen(strCmd, 'E')) {
-              disable_e0();
-              disable_e1();
-              disable_e2();
-          #if EXTRUDERS > 1
-              last_extruder = 0xFF;
-          #endif
-            }
-          #endif
+  }
+  else
+  {
+    bool all_axis = !((code_seen(strCmd, axis_codes[0])) || (code_seen(strCmd, axis_codes[1])) || (code_seen(strCmd, axis_codes[2]))|| (code_seen(strCmd, axis_codes[3])));
+    if(all_axis)
+    {
+      finishAndDisableSteppers();
+    }
+    else
+    {
+      st_synchronize();
+      if(code_seen(strCmd, 'X')) disable_x();
+      if(code_seen(strCmd, 'Y')) disable_y();
+      if(code_seen(strCmd, 'Z')) disable_z();
+      #if ((E0_ENABLE_PIN != X_ENABLE_PIN) && (E1_ENABLE_PIN != Y_ENABLE_PIN)) // Only enable on boards that have seperate ENABLE_PINS
+        if(code_seen(strCmd, 'E')) {
+          disable_e0();
+          disable_e1();
+          disable_e2();
+      #if EXTRUDERS > 1
+          last_extruder = 0xFF;
+      #endif
         }
-      }
-      break;
-    case 85: // M85
-      if (code_seen(strCmd, 'S')) max_inactive_time = code_value() * 1000;
-      break;
-    case 92: // M92
-      for(int8_t i=0; i < NUM_AXIS; i++)
-      {
-        if(code_seen(strCmd, axis_codes[i]))
-        {
-          if(i == 3) { // E
-            float value = code_value();
-            if(value < 20.0) {
-              float factor = e_steps_per_unit(active_extruder) / value; // increase e constants if M92 E14 is given for netfab.
-              max_e_jerk *= factor;
-              max_feedrate[i] *= factor;
-              axis_steps_per_sqr_second[i] *= factor;
+      #endif
+    }
+  }
+  return GCODE_DONE;
+}
+
+// M85
+static uint8_t gcode_M85(const char *strCmd)
+{
+  if (code_seen(strCmd, 'S')) max_inactive_time = code_value() * 1000;
+  return GCODE_DONE;
+}
+
+// M92
+static uint8_t gcode_M92(const char *strCmd)
+{
+  for(int8_t i=0; i < NUM_AXIS; i++)
+  {
+    if(code_seen(strCmd, axis_codes[i]))
+    {
+      if(i == 3) { // E
+        float value = code_value();
+        if(value < 20.0) {
+          float factor = e_steps_per_unit(active_extruder) / value; // increase e constants if M92 E14 is given for netfab.
+          max_e_jerk *= factor;
+          max_feedrate[i] *= factor;
+          axis_steps_per_sqr_second[i] *= factor;
 #if EXTRUDERS > 1
-              axis_steps_per_sqr_second[i+1] *= factor;
+          axis_steps_per_sqr_second[i+1] *= factor;
 #endif // EXTRUDERS
-            }
+        }
 #if EXTRUDERS > 1
-            if (active_extruder) {
-                e2_steps_per_unit = value;
-            }
-            else{
-                axis_steps_per_unit[i] = value;
-            }
-#else
+        if (active_extruder) {
+            e2_steps_per_unit = value;
+        }
+        else{
             axis_steps_per_unit[i] = value;
-#endif // EXTRUDERS
-          }
-          else {
-            axis_steps_per_unit[i] = code_value();
-          }
         }
+#else
+        axis_steps_per_unit[i] = value;
+#endif // EXTRUDERS
       }
-      plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
-      break;
-    case 115: // M115
-      SERIAL_PROTOCOLPGM(MSG_M115_REPORT);
-      break;
-    case 117: // M117 display message
-      truncate_checksum(strchr_pointer);
-      if (strlen(strchr_pointer) > 5)
-      {
-        lcd_setstatus(strchr_pointer+5);
-      }
-      else
-      {
-        lcd_clearstatus();
+      else {
+        axis_steps_per_unit[i] = code_value();
       }
-      break;
-    case 114: // M114
-      SERIAL_PROTOCOLPGM("X:");
-      SERIAL_PROTOCOL(current_position[X_AXIS]);
-      SERIAL_PROTOCOLPGM("Y:");
-      SERIAL_PROTOCOL(current_position[Y_AXIS]);
-      SERIAL_PROTOCOLPGM("Z:");
-      SERIAL_PROTOCOL(current_position[Z_AXIS]);
-      SERIAL_PROTOCOLPGM("E:");
-      SERIAL_PROTOCOL(current_position[E_AXIS]);
-
-      SERIAL_PROTOCOLPGM(MSG_COUNT_X);
-      SERIAL_PROTOCOL(float(st_get_position(X_AXIS))/axis_steps_per_unit[X_AXIS]);
-      SERIAL_PROTOCOLPGM("Y:");
-      SERIAL_PROTOCOL(float(st_get_position(Y_AXIS))/axis_steps_per_unit[Y_AXIS]);
-      SERIAL_PROTOCOLPGM("Z:");
-      SERIAL_PROTOCOL(float(st_get_position(Z_AXIS))/axis_steps_per_unit[Z_AXIS]);
-      SERIAL_PROTOCOLPGM("E:");
-      SERIAL_PROTOCOL(float(st_get_position(E_AXIS))/e_steps_per_unit(active_extruder));
+    }
+  }
+  plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
+  return GCODE_DONE;
+}
 
-      SERIAL_EOL;
-      break;
-    case 120: // M120
-      enable_endstops(false) ;
-      break;
-    case 121: // M121
-      enable_endstops(true) ;
-      break;
-    case 119: // M119
-    SERIAL_PROTOCOLLNPGM(MSG_M119_REPORT);
-      #if defined(X_MIN_PIN) && X_MIN_PIN > -1
-        SERIAL_PROTOCOLPGM(MSG_X_MIN);
-        if (READ(X_MIN_PIN)^X_ENDSTOPS_INVERTING)
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
-        }
-        else
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
-        }
-      #endif
-      #if defined(X_MAX_PIN) && X_MAX_PIN > -1
-        SERIAL_PROTOCOLPGM(MSG_X_MAX);
-        if (READ(X_MAX_PIN)^X_ENDSTOPS_INVERTING)
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
-        }
-        else
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
-        }
-      #endif
-      #if defined(Y_MIN_PIN) && Y_MIN_PIN > -1
-        SERIAL_PROTOCOLPGM(MSG_Y_MIN);
-        if (READ(Y_MIN_PIN)^Y_ENDSTOPS_INVERTING)
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
-        }
-        else
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
-        }
-      #endif
-      #if defined(Y_MAX_PIN) && Y_MAX_PIN > -1
-        SERIAL_PROTOCOLPGM(MSG_Y_MAX);
-        if (READ(Y_MAX_PIN)^Y_ENDSTOPS_INVERTING)
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
-        }
-        else
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
-        }
-      #endif
-      #if defined(Z_MIN_PIN) && Z_MIN_PIN > -1
-        SERIAL_PROTOCOLPGM(MSG_Z_MIN);
-        if (READ(Z_MIN_PIN)^Z_ENDSTOPS_INVERTING)
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
-        }
-        else
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
-        }
-      #endif
-      #if defined(Z_MAX_PIN) && Z_MAX_PIN > -1
-        SERIAL_PROTOCOLPGM(MSG_Z_MAX);
-        if (READ(Z_MAX_PIN)^Z_ENDSTOPS_INVERTING)
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
-        }
-        else
-        {
-            SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
-        }
-      #endif
-      break;
-      //TODO: update for all axis, use for loop
-    case 200: // M200 - set filament diameter
-      if(setTargetedHotend(strCmd, 200)){
-        break;
-      }
-      if(code_seen(strCmd, 'D'))
+// M115
+static uint8_t gcode_M115(const char *strCmd)
+{
+  SERIAL_PROTOCOLPGM(MSG_M115_REPORT);
+  return GCODE_DONE;
+}
+
+// M117 display message
+static uint8_t gcode_M117(const char *strCmd)
+{
+  truncate_checksum(strchr_pointer);
+  if (strlen(strchr_pointer) > 5)
+  {
+    lcd_setstatus(strchr_pointer+5);
+  }
+  else
+  {
+    lcd_clearstatus();
+  }
+  return GCODE_DONE;
+}
+
+// M114
+static uint8_t gcode_M114(const char *strCmd)
+{
+  SERIAL_PROTOCOLPGM("X:");
+  SERIAL_PROTOCOL(current_position[X_AXIS]);
+  SERIAL_PROTOCOLPGM("Y:");
+  SERIAL_PROTOCOL(current_position[Y_AXIS]);
+  SERIAL_PROTOCOLPGM("Z:");
+  SERIAL_PROTOCOL(current_position[Z_AXIS]);
+  SERIAL_PROTOCOLPGM("E:");
+  SERIAL_PROTOCOL(current_position[E_AXIS]);
+
+  SERIAL_PROTOCOLPGM(MSG_COUNT_X);
+  SERIAL_PROTOCOL(float(st_get_position(X_AXIS))/axis_steps_per_unit[X_AXIS]);
+  SERIAL_PROTOCOLPGM("Y:");
+  SERIAL_PROTOCOL(float(st_get_position(Y_AXIS))/axis_steps_per_unit[Y_AXIS]);
+  SERIAL_PROTOCOLPGM("Z:");
+  SERIAL_PROTOCOL(float(st_get_position(Z_AXIS))/axis_steps_per_unit[Z_AXIS]);
+  SERIAL_PROTOCOLPGM("E:");
+  SERIAL_PROTOCOL(float(st_get_position(E_AXIS))/e_steps_per_unit(active_extruder));
+
+  SERIAL_EOL;
+  return GCODE_DONE;
+}
+
+// M120
+static uint8_t gcode_M120(const char *strCmd)
+{
+  enable_endstops(false) ;
+  return GCODE_DONE;
+}
+
+// M121
+static uint8_t gcode_M121(const char *strCmd)
+{
+  enable_endstops(true) ;
+  return GCODE_DONE;
+}
+
+// M119
+static uint8_t gcode_M119(const char *strCmd)
+{
+  SERIAL_PROTOCOLLNPGM(MSG_M119_REPORT);
+    #if defined(X_MIN_PIN) && X_MIN_PIN > -1
+      SERIAL_PROTOCOLPGM(MSG_X_MIN);
+      if (READ(X_MIN_PIN)^X_ENDSTOPS_INVERTING)
       {
-          float radius = code_value() / 2;
-          if (abs(radius) < 0.01f)
-          {
-              volume_to_filament_length[tmp_extruder] = 1.0f;
-          }
-          else
-          {
-              volume_to_filament_length[tmp_extruder] = 1.0f / (M_PI * radius * radius);
-          }
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
       }
-      break;
-    case 201: // M201
-      for(int8_t i=0; i < NUM_AXIS; i++)
+      else
       {
-        if(code_seen(strCmd, axis_codes[i]))
-        {
-          max_acceleration_units_per_sq_second[i] = code_value();
-        }
-      }
-      // steps per sq second need to be updated to agree with the units per sq second (as they are what is used in the planner)
-      reset_acceleration_rates();
-      break;
-    #if 0 // Not used for Sprinter/grbl gen6
-    case 202: // M202
-      for(int8_t i=0; i < NUM_AXIS; i++) {
-        if(code_seen(strCmd, axis_codes[i])) axis_travel_steps_per_sqr_second[i] = code_value() * axis_steps_per_unit[i];
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
       }
-      break;
     #endif
-    case 203: // M203 max feedrate mm/sec
-      for(int8_t i=0; i < NUM_AXIS; i++) {
-        if(code_seen(strCmd, axis_codes[i])) max_feedrate[i] = code_value();
-      }
-      break;
-    case 204: // M204 acceleration: S - normal moves;  T - filament only moves
-      {
-        if(code_seen(strCmd, 'S')) acceleration = code_value() ;
-        if(code_seen(strCmd, 'T')) retract_acceleration = code_value() ;
-      }
-      break;
-    case 205: //M205 advanced settings:  minimum travel speed S=while printing T=travel only,  B=minimum segment time X= maximum xy jerk, Z=maximum Z jerk
-    {
-      if(code_seen(strCmd, 'S')) minimumfeedrate = code_value();
-      if(code_seen(strCmd, 'T')) mintravelfeedrate = code_value();
-      if(code_seen(strCmd, 'B')) minsegmenttime = code_value() ;
-      if(code_seen(strCmd, 'X')) max_xy_jerk = code_value() ;
-      if(code_seen(strCmd, 'Z')) max_z_jerk = code_value() ;
-      if(code_seen(strCmd, 'E')) max_e_jerk = code_value() ;
-    }
-    break;
-    case 206: // M206 additional homing offset
-      for(int8_t i=0; i < 3; i++)
-      {
-        if(code_seen(strCmd, axis_codes[i])) add_homeing[i] = code_value();
-      }
-      break;
-    #ifdef FWRETRACT
-    case 207: //M207 - set retract length S[positive mm] F[feedrate mm/min] Z[additional zlift/hop]
-    {
-      if(code_seen(strCmd, 'S'))
+    #if defined(X_MAX_PIN) && X_MAX_PIN > -1
+      SERIAL_PROTOCOLPGM(MSG_X_MAX);
+      if (READ(X_MAX_PIN)^X_ENDSTOPS_INVERTING)
       {
-        retract_length = code_value() ;
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
       }
-      if(code_seen(strCmd, 'F'))
-      {
-        retract_feedrate = code_value() ;
-      }
-      if(code_seen(strCmd, 'Z'))
+      else
       {
-        retract_zlift = code_value() ;
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
       }
-    }break;
-    case 208: // M208 - set retract recover length S[positive mm surplus to the M207 S*] F[feedrate mm/min]
-    {
-      if(code_seen(strCmd, 'S'))
+    #endif
+    #if defined(Y_MIN_PIN) && Y_MIN_PIN > -1
+      SERIAL_PROTOCOLPGM(MSG_Y_MIN);
+      if (READ(Y_MIN_PIN)^Y_ENDSTOPS_INVERTING)
       {
-        retract_recover_length = code_value() ;
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
       }
-      if(code_seen(strCmd, 'F'))
+      else
       {
-        retract_recover_feedrate = code_value() ;
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
       }
-    }break;
-    case 209: // M209 - S<1=true/0=false> enable automatic retract detect if the slicer did not support G10/11: every normal extrude-only move will be classified as retract depending on the direction.
-    {
-      if(code_seen(strCmd, 'S'))
+    #endif
+    #if defined(Y_MAX_PIN) && Y_MAX_PIN > -1
+      SERIAL_PROTOCOLPGM(MSG_Y_MAX);
+      if (READ(Y_MAX_PIN)^Y_ENDSTOPS_INVERTING)
       {
-        int t= code_value() ;
-        switch(t)
-        {
-          case 0: autoretract_enabled=false;retracted=false;break;
-          case 1: autoretract_enabled=true;retracted=false;break;
-          default:
-            SERIAL_ECHO_START;
-            SERIAL_ECHOPGM(MSG_UNKNOWN_COMMAND);
-            SERIAL_ECHO(strCmd);
-            SERIAL_ECHOLNPGM("\"");
-        }
-      }
-
-    }break;
-    #endif // FWRETRACT
-    #if EXTRUDERS > 1
-    case 218: // M218 - set hotend offset (in mm), T<extruder_number> X<offset_on_X> Y<offset_on_Y>
-    {
-      if(setTargetedHotend(strCmd, 218)){
-        break;
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
       }
-      if(code_seen(strCmd, 'X'))
+      else
       {
-        extruder_offset[X_AXIS][tmp_extruder] = code_value();
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
       }
-      if(code_seen(strCmd, 'Y'))
+    #endif
+    #if defined(Z_MIN_PIN) && Z_MIN_PIN > -1
+      SERIAL_PROTOCOLPGM(MSG_Z_MIN);
+      if (READ(Z_MIN_PIN)^Z_ENDSTOPS_INVERTING)
       {
-        extruder_offset[Y_AXIS][tmp_extruder] = code_value();
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
       }
-      SERIAL_ECHO_START;
-      SERIAL_ECHOPGM(MSG_HOTEND_OFFSET);
-      for(tmp_extruder = 0; tmp_extruder < EXTRUDERS; tmp_extruder++)
+      else
       {
-         SERIAL_ECHOPGM(" ");
-         SERIAL_ECHO(extruder_offset[X_AXIS][tmp_extruder]);
-         SERIAL_ECHOPGM(",");
-         SERIAL_ECHO(extruder_offset[Y_AXIS][tmp_extruder]);
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
       }
-      SERIAL_EOL;
-    }break;
     #endif
-    case 220: // M220 S<factor in percent>- set speed factor override percentage
-    {
-      if(code_seen(strCmd, 'S'))
-      {
-        feedmultiply = code_value() ;
-      }
-    }
-    break;
-    case 221: // M221 S<factor in percent>- set extrude factor override percentage
-    {
-      if(code_seen(strCmd, 'S'))
+    #if defined(Z_MAX_PIN) && Z_MAX_PIN > -1
+      SERIAL_PROTOCOLPGM(MSG_Z_MAX);
+      if (READ(Z_MAX_PIN)^Z_ENDSTOPS_INVERTING)
       {
-        extrudemultiply[active_extruder] = code_value() ;
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_HIT);
       }
-    }
-    break;
-
-    #if NUM_SERVOS > 0
-    case 280: // M280 - set servo position absolute. P: servo index, S: angle or microseconds
+      else
       {
-        int servo_index = -1;
-        int servo_position = 0;
-        if (code_seen(strCmd, 'P'))
-          servo_index = code_value();
-        if (code_seen(strCmd, 'S')) {
-          servo_position = code_value();
-          if ((servo_index >= 0) && (servo_index < NUM_SERVOS)) {
-            servos[servo_index].write(servo_position);
-          }
-          else {
-            SERIAL_ECHO_START;
-            SERIAL_ECHOPGM("Servo ");
-            SERIAL_ECHO(servo_index);
-            SERIAL_ECHOLNPGM(" out of range");
-          }
-        }
-        else if (servo_index >= 0) {
-          SERIAL_PROTOCOLPGM(MSG_OK);
-          SERIAL_PROTOCOLPGM(" Servo ");
-          SERIAL_PROTOCOL(servo_index);
-          SERIAL_PROTOCOLPGM(": ");
-          SERIAL_PROTOCOL(servos[servo_index].read());
-          SERIAL_EOL;
-        }
+          SERIAL_PROTOCOLLNPGM(MSG_ENDSTOP_OPEN);
       }
-      break;
-    #endif // NUM_SERVOS > 0
+    #endif
+  return GCODE_DONE;
+}
 
-    #if LARGE_FLASH == true && ( BEEPER > 0 || defined(ULTRALCD) || defined(ENABLE_ULTILCD2) )
-    case 300: // M300
-    {
-      unsigned int beepS = code_seen(strCmd, 'S') ? code_value() : 110;  //frequency Hz
-      unsigned int beepP = code_seen(strCmd, 'P') ? code_value() : 1000; //duration ms
-      if (beepS > 0)
+//TODO: update for all axis, use for loop
+// M200 - set filament diameter
+static uint8_t gcode_M200(const char *strCmd)
+{
+  if(setTargetedHotend(strCmd, 200)){
+    return GCODE_DONE;
+  }
+  if(code_seen(strCmd, 'D'))
+  {
+      float radius = code_value() / 2;
+      if (abs(radius) < 0.01f)
       {
-        #if BEEPER > 0
-          // don't use tone libs that might mess with our timers
-          uint32_t notch = 500000 / beepS;
-          if(beepP > 4000) beepP = 4000; // prevent watchdog from tripping
-          uint32_t loops = ((((uint32_t) beepP) * 500) / notch);
-          for(uint32_t _i=0;_i<loops;_i++) { WRITE(BEEPER, HIGH); delayMicroseconds(notch); WRITE(BEEPER, LOW); delayMicroseconds(notch); }
-        #elif defined(ULTRALCD)
-          lcd_buzz(beepS, beepP);
-        #endif
+          volume_to_filament_length[tmp_extruder] = 1.0f;
       }
       else
       {
-        delay(beepP);
+          volume_to_filament_length[tmp_extruder] = 1.0f / (M_PI * radius * radius);
       }
-    }
-    break;
-    #endif // M300
+  }
+  return GCODE_DONE;
+}
 
-    #ifdef PIDTEMP
-    case 301: // M301
-      {
-        if(code_seen(strCmd, 'P'))
-        {
-            Kp = code_value();
-        #if EXTRUDERS > 1
-            if (active_extruder) pid2[0] = Kp;
-        #endif // EXTRUDERS
-        }
+// M201
+static uint8_t gcode_M201(const char *strCmd)
+{
+  for(int8_t i=0; i < NUM_AXIS; i++)
+  {
+    if(code_seen(strCmd, axis_codes[i]))
+    {
+      max_acceleration_units_per_sq_second[i] = code_value();
+    }
+  }
+  // steps per sq second need to be updated to agree with the units per sq second (as they are what is used in the planner)
+  reset_acceleration_rates();
+  return GCODE_DONE;
+}
 
-        if(code_seen(strCmd, 'I'))
-        {
-            Ki = scalePID_i(code_value());
-        #if EXTRUDERS > 1
-            if (active_extruder) pid2[1] = Ki;
-        #endif // EXTRUDERS
-        }
+#if 0 // Not used for Sprinter/grbl gen6
+// M202
+static uint8_t gcode_M202(const char *strCmd)
+{
+  for(int8_t i=0; i < NUM_AXIS; i++) {
+    if(code_seen(strCmd, axis_codes[i])) axis_travel_steps_per_sqr_second[i] = code_value() * axis_steps_per_unit[i];
+  }
+  return GCODE_DONE;
+}
 
-        if(code_seen(strCmd, 'D'))
-        {
-            Kd = scalePID_d(code_value());
-        #if EXTRUDERS > 1
-            if (active_extruder) pid2[2] = Kd;
-        #endif // EXTRUDERS
-        }
+#endif
+// M203 max feedrate mm/sec
+static uint8_t gcode_M203(const char *strCmd)
+{
+  for(int8_t i=0; i < NUM_AXIS; i++) {
+    if(code_seen(strCmd, axis_codes[i])) max_feedrate[i] = code_value();
+  }
+  return GCODE_DONE;
+}
 
-        updatePID();
-        SERIAL_PROTOCOLPGM(MSG_OK);
-        SERIAL_PROTOCOLPGM(" p:");
-        SERIAL_PROTOCOL(Kp);
-        SERIAL_PROTOCOLPGM(" i:");
-        SERIAL_PROTOCOL(unscalePID_i(Ki));
-        SERIAL_PROTOCOLPGM(" d:");
-        SERIAL_PROTOCOL(unscalePID_d(Kd));
-        SERIAL_EOL;
-      }
-      break;
-    #endif //PIDTEMP
-    #if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0)
-    case 304: // M304
-      {
-        if (pidTempBed())
-        {
-            if(code_seen(strCmd, 'P')) bedKp = code_value();
-            if(code_seen(strCmd, 'I')) bedKi = scalePID_i(code_value());
-            if(code_seen(strCmd, 'D')) bedKd = scalePID_d(code_value());
-
-            updatePID();
-            SERIAL_PROTOCOLPGM(MSG_OK);
-            SERIAL_PROTOCOLPGM(" p:");
-            SERIAL_PROTOCOL(bedKp);
-            SERIAL_PROTOCOLPGM(" i:");
-            SERIAL_PROTOCOL(unscalePID_i(bedKi));
-            SERIAL_PROTOCOLPGM(" d:");
-            SERIAL_PROTOCOL(unscalePID_d(bedKd));
-            SERIAL_EOL;
-        }
-      }
-      break;
-    #endif //PIDTEMP
-    case 240: // M240  Triggers a camera by emulating a Canon RC-1 : http://www.doc-diy.net/photo/rc-1_hacked/
-     {
-      #if defined(PHOTOGRAPH_PIN) && PHOTOGRAPH_PIN > -1
-        const uint8_t NUM_PULSES=16;
-        const float PULSE_LENGTH=0.01524;
-        for(int i=0; i < NUM_PULSES; i++) {
-          WRITE(PHOTOGRAPH_PIN, HIGH);
-          _delay_ms(PULSE_LENGTH);
-          WRITE(PHOTOGRAPH_PIN, LOW);
-          _delay_ms(PULSE_LENGTH);
-        }
-        delay(7.33);
-        for(int i=0; i < NUM_PULSES; i++) {
-          WRITE(PHOTOGRAPH_PIN, HIGH);
-          _delay_ms(PULSE_LENGTH);
-          WRITE(PHOTOGRAPH_PIN, LOW);
-          _delay_ms(PULSE_LENGTH);
-        }
-      #endif
-     }
-    break;
-    #ifdef PREVENT_DANGEROUS_EXTRUDE
-    case 302: // allow cold extrudes, or set the minimum extrude temperature
-    {
-	  float temp = .0;
-	  if (code_seen(strCmd, 'S')) temp=code_value();
-      set_extrude_min_temp(temp);
-    }
-    break;
-	#endif
-    case 303: // M303 PID autotune
-    {
-      float temp = 150.0;
-      int e=0;
-      int c=5;
-      if (code_seen(strCmd, 'E')) e=code_value();
-        if (e<0)
-          temp=70;
-      if (code_seen(strCmd, 'S')) temp=code_value();
-      if (code_seen(strCmd, 'C')) c=code_value();
-      PID_autotune(temp, e, c);
-    }
-    break;
-    case 400: // M400 finish all moves
-    {
-      st_synchronize();
-    }
-    break;
-    case 401:
-      quickStop();
-    break;
-    case 500: // M500 Store settings in EEPROM
-    {
-        Config_StoreSettings();
-    }
-    break;
-    case 501: // M501 Read settings from EEPROM
-    {
-        Config_RetrieveSettings();
-    }
-    break;
-    case 502: // M502 Revert to default settings
+// M204 acceleration: S - normal moves;  T - filament only moves
+static uint8_t gcode_M204(const char *strCmd)
+{
+  if(code_seen(strCmd, 'S')) acceleration = code_value() ;
+  if(code_seen(strCmd, 'T')) retract_acceleration = code_value() ;
+  return GCODE_DONE;
+}
+
+// M205 advanced settings:  minimum travel speed S=while printing T=travel only,  B=minimum segment time X= maximum xy jerk, Z=maximum Z jerk
+static uint8_t gcode_M205(const char *strCmd)
+{
+  if(code_seen(strCmd, 'S')) minimumfeedrate = code_value();
+  if(code_seen(strCmd, 'T')) mintravelfeedrate = code_value();
+  if(code_seen(strCmd, 'B')) minsegmenttime = code_value() ;
+  if(code_seen(strCmd, 'X')) max_xy_jerk = code_value() ;
+  if(code_seen(strCmd, 'Z')) max_z_jerk = code_value() ;
+  if(code_seen(strCmd, 'E')) max_e_jerk = code_value() ;
+  return GCODE_DONE;
+}
+
+// M206 additional homing offset
+static uint8_t gcode_M206(const char *strCmd)
+{
+  for(int8_t i=0; i < 3; i++)
+  {
+    if(code_seen(strCmd, axis_codes[i])) add_homeing[i] = code_value();
+  }
+  return GCODE_DONE;
+}
+
+#ifdef FWRETRACT
+// M207 - set retract length S[positive mm] F[feedrate mm/min] Z[additional zlift/hop]
+static uint8_t gcode_M207(const char *strCmd)
+{
+  if(code_seen(strCmd, 'S'))
+  {
+    retract_length = code_value() ;
+  }
+  if(code_seen(strCmd, 'F'))
+  {
+    retract_feedrate = code_value() ;
+  }
+  if(code_seen(strCmd, 'Z'))
+  {
+    retract_zlift = code_value() ;
+  }
+  return GCODE_DONE;
+}
+
+// M208 - set retract recover length S[positive mm surplus to the M207 S*] F[feedrate mm/min]
+static uint8_t gcode_M208(const char *strCmd)
+{
+  if(code_seen(strCmd, 'S'))
+  {
+    retract_recover_length = code_value() ;
+  }
+  if(code_seen(strCmd, 'F'))
+  {
+    retract_recover_feedrate = code_value() ;
+  }
+  return GCODE_DONE;
+}
+
+// M209 - S<1=true/0=false> enable automatic retract detect if the slicer did not support G10/11: every normal extrude-only move will be classified as retract depending on the direction.
+static uint8_t gcode_M209(const char *strCmd)
+{
+  if(code_seen(strCmd, 'S'))
+  {
+    int t= code_value() ;
+    switch(t)
     {
-        Config_ResetDefault();
+      case 0: autoretract_enabled=false;retracted=false;break;
+      case 1: autoretract_enabled=true;retracted=false;break;
+      default:
+        SERIAL_ECHO_START;
+        SERIAL_ECHOPGM(MSG_UNKNOWN_COMMAND);
+        SERIAL_ECHO(strCmd);
+        SERIAL_ECHOLNPGM("\"");
     }
-    break;
-    case 503: // M503 print settings currently in memory
-    {
-        Config_PrintSettings();
+  }
+
+  return GCODE_DONE;
+}
+
+#endif // FWRETRACT
+#if EXTRUDERS > 1
+// M218 - set hotend offset (in mm), T<extruder_number> X<offset_on_X> Y<offset_on_Y>
+static uint8_t gcode_M218(const char *strCmd)
+{
+  if(setTargetedHotend(strCmd, 218)){
+    return GCODE_DONE;
+  }
+  if(code_seen(strCmd, 'X'))
+  {
+    extruder_offset[X_AXIS][tmp_extruder] = code_value();
+  }
+  if(code_seen(strCmd, 'Y'))
+  {
+    extruder_offset[Y_AXIS][tmp_extruder] = code_value();
+  }
+  SERIAL_ECHO_START;
+  SERIAL_ECHOPGM(MSG_HOTEND_OFFSET);
+  for(tmp_extruder = 0; tmp_extruder < EXTRUDERS; tmp_extruder++)
+  {
+     SERIAL_ECHOPGM(" ");
+     SERIAL_ECHO(extruder_offset[X_AXIS][tmp_extruder]);
+     SERIAL_ECHOPGM(",");
+     SERIAL_ECHO(extruder_offset[Y_AXIS][tmp_extruder]);
+  }
+  SERIAL_EOL;
+  return GCODE_DONE;
+}
+
+#endif
+// M220 S<factor in percent>- set speed factor override percentage
+static uint8_t gcode_M220(const char *strCmd)
+{
+  if(code_seen(strCmd, 'S'))
+  {
+    feedmultiply = code_value() ;
+  }
+  return GCODE_DONE;
+}
+
+// M221 S<factor in percent>- set extrude factor override percentage
+static uint8_t gcode_M221(const char *strCmd)
+{
+  if(code_seen(strCmd, 'S'))
+  {
+    extrudemultiply[active_extruder] = code_value() ;
+  }
+  return GCODE_DONE;
+}
+
+#if NUM_SERVOS > 0
+// M280 - set servo position absolute. P: servo index, S: angle or microseconds
+static uint8_t gcode_M280(const char *strCmd)
+{
+  int servo_index = -1;
+  int servo_position = 0;
+  if (code_seen(strCmd, 'P'))
+    servo_index = code_value();
+  if (code_seen(strCmd, 'S')) {
+    servo_position = code_value();
+    if ((servo_index >= 0) && (servo_index < NUM_SERVOS)) {
+      servos[servo_index].write(servo_position);
     }
-    break;
-    #ifdef ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED
-    case 540:
-    {
-        if(code_seen(strCmd, 'S')) abort_on_endstop_hit = code_value() > 0;
+    else {
+      SERIAL_ECHO_START;
+      SERIAL_ECHOPGM("Servo ");
+      SERIAL_ECHO(servo_index);
+      SERIAL_ECHOLNPGM(" out of range");
     }
-    break;
+  }
+  else if (servo_index >= 0) {
+    SERIAL_PROTOCOLPGM(MSG_OK);
+    SERIAL_PROTOCOLPGM(" Servo ");
+    SERIAL_PROTOCOL(servo_index);
+    SERIAL_PROTOCOLPGM(": ");
+    SERIAL_PROTOCOL(servos[servo_index].read());
+    SERIAL_EOL;
+  }
+  return GCODE_DONE;
+}
+
+#endif // NUM_SERVOS > 0
+#if LARGE_FLASH == true && ( BEEPER > 0 || defined(ULTRALCD) || defined(ENABLE_ULTILCD2) )
+// M300
+static uint8_t gcode_M300(const char *strCmd)
+{
+  unsigned int beepS = code_seen(strCmd, 'S') ? code_value() : 110;  //frequency Hz
+  unsigned int beepP = code_seen(strCmd, 'P') ? code_value() : 1000; //duration ms
+  if (beepS > 0)
+  {
+    #if BEEPER > 0
+      // don't use tone libs that might mess with our timers
+      uint32_t notch = 500000 / beepS;
+      if(beepP > 4000) beepP = 4000; // prevent watchdog from tripping
+      uint32_t loops = ((((uint32_t) beepP) * 500) / notch);
+      for(uint32_t _i=0;_i<loops;_i++) { WRITE(BEEPER, HIGH); delayMicroseconds(notch); WRITE(BEEPER, LOW); delayMicroseconds(notch); }
+    #elif defined(ULTRALCD)
+      lcd_buzz(beepS, beepP);
     #endif
-    #ifdef FILAMENTCHANGEENABLE
-    case 600: //Pause for filament change X[pos] Y[pos] Z[relative lift] E[initial retract] L[later retract distance for removal]
-    {
-        if (printing_state == PRINT_STATE_RECOVER)
-          break;
+  }
+  else
+  {
+    delay(beepP);
+  }
+  return GCODE_DONE;
+}
 
-        float target[4];
-        float lastpos[4];
-        target[X_AXIS]=current_position[X_AXIS];
-        target[Y_AXIS]=current_position[Y_AXIS];
-        target[Z_AXIS]=current_position[Z_AXIS];
-        target[E_AXIS]=current_position[E_AXIS];
-        lastpos[X_AXIS]=current_position[X_AXIS];
-        lastpos[Y_AXIS]=current_position[Y_AXIS];
-        lastpos[Z_AXIS]=current_position[Z_AXIS];
-        lastpos[E_AXIS]=current_position[E_AXIS];
-        //retract by E
-        if(code_seen(strCmd, 'E'))
-        {
-          target[E_AXIS]+= code_value();
-        }
-        else
-        {
-          #ifdef FILAMENTCHANGE_FIRSTRETRACT
-            target[E_AXIS]+= FILAMENTCHANGE_FIRSTRETRACT ;
-          #endif
-        }
-        plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder);
+#endif // M300
+#ifdef PIDTEMP
+// M301
+static uint8_t gcode_M301(const char *strCmd)
+{
+  if(code_seen(strCmd, 'P'))
+  {
+      Kp = code_value();
+  #if EXTRUDERS > 1
+      if (active_extruder) pid2[0] = Kp;
+  #endif // EXTRUDERS
+  }
 
-        //lift Z
-        if(code_seen(strCmd, 'Z'))
-        {
-          target[Z_AXIS]+= code_value();
-        }
-        else
-        {
-          #ifdef FILAMENTCHANGE_ZADD
-            target[Z_AXIS]+= FILAMENTCHANGE_ZADD ;
-          #endif
-        }
-        plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder);
+  if(code_seen(strCmd, 'I'))
+  {
+      Ki = scalePID_i(code_value());
+  #if EXTRUDERS > 1
+      if (active_extruder) pid2[1] = Ki;
+  #endif // EXTRUDERS
+  }
 
-        //move xy
-        if(code_seen(strCmd, 'X'))
-        {
-          target[X_AXIS]+= code_value();
-        }
-        else
-        {
-          #ifdef FILAMENTCHANGE_XPOS
-            target[X_AXIS]= FILAMENTCHANGE_XPOS ;
-          #endif
-        }
-        if(code_seen(strCmd, 'Y'))
-        {
-          target[Y_AXIS]= code_value();
-        }
-        else
-        {
-          #ifdef FILAMENTCHANGE_YPOS
-            target[Y_AXIS]= FILAMENTCHANGE_YPOS ;
-          #endif
-        }
+  if(code_seen(strCmd, 'D'))
+  {
+      Kd = scalePID_d(code_value());
+  #if EXTRUDERS > 1
+      if (active_extruder) pid2[2] = Kd;
+  #endif // EXTRUDERS
+  }
+  #ifdef PID_ADD_EXTRUSION_RATE
+  if(code_seen(strCmd, 'C')) Kc = code_value();
+  #endif
 
-        plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder);
+  updatePID();
+  SERIAL_PROTOCOLPGM(MSG_OK);
+  SERIAL_PROTOCOLPGM(" p:");
+  SERIAL_PROTOCOL(Kp);
+  SERIAL_PROTOCOLPGM(" i:");
+  SERIAL_PROTOCOL(unscalePID_i(Ki));
+  SERIAL_PROTOCOLPGM(" d:");
+  SERIAL_PROTOCOL(unscalePID_d(Kd));
+  #ifdef PID_ADD_EXTRUSION_RATE
+  SERIAL_PROTOCOLPGM(" c:");
+  SERIAL_PROTOCOL(Kc);
+  #endif
+  SERIAL_EOL;
+  return GCODE_DONE;
+}
 
-        if(code_seen(strCmd, 'L'))
-        {
-          target[E_AXIS]+= code_value();
-        }
-        else
-        {
-          #ifdef FILAMENTCHANGE_FINALRETRACT
-            target[E_AXIS]+= FILAMENTCHANGE_FINALRETRACT ;
-          #endif
-        }
+#endif //PIDTEMP
+#if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0)
+// M304
+static uint8_t gcode_M304(const char *strCmd)
+{
+  if (pidTempBed())
+  {
+      if(code_seen(strCmd, 'P')) bedKp = code_value();
+      if(code_seen(strCmd, 'I')) bedKi = scalePID_i(code_value());
+      if(code_seen(strCmd, 'D')) bedKd = scalePID_d(code_value());
+
+      updatePID();
+      SERIAL_PROTOCOLPGM(MSG_OK);
+      SERIAL_PROTOCOLPGM(" p:");
+      SERIAL_PROTOCOL(bedKp);
+      SERIAL_PROTOCOLPGM(" i:");
+      SERIAL_PROTOCOL(unscalePID_i(bedKi));
+      SERIAL_PROTOCOLPGM(" d:");
+      SERIAL_PROTOCOL(unscalePID_d(bedKd));
+      SERIAL_EOL;
+  }
+  return GCODE_DONE;
+}
 
-        plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder);
+#endif //PIDTEMP
+// M240  Triggers a camera by emulating a Canon RC-1 : http://www.doc-diy.net/photo/rc-1_hacked/
+static uint8_t gcode_M240(const char *strCmd)
+{
+  #if defined(PHOTOGRAPH_PIN) && PHOTOGRAPH_PIN > -1
+  const uint8_t NUM_PULSES=16;
+  const float PULSE_LENGTH=0.01524;
+  for(int i=0; i < NUM_PULSES; i++) {
+    WRITE(PHOTOGRAPH_PIN, HIGH);
+    _delay_ms(PULSE_LENGTH);
+    WRITE(PHOTOGRAPH_PIN, LOW);
+    _delay_ms(PULSE_LENGTH);
+  }
+  delay(7.33);
+  for(int i=0; i < NUM_PULSES; i++) {
+    WRITE(PHOTOGRAPH_PIN, HIGH);
+    _delay_ms(PULSE_LENGTH);
+    WRITE(PHOTOGRAPH_PIN, LOW);
+    _delay_ms(PULSE_LENGTH);
+  }
+  #endif
+  return GCODE_DONE;
+}
 
-        //finish moves
-        st_synchronize();
-        //disable extruder steppers so filament can be removed
-        disable_e0();
-        disable_e1();
-        disable_e2();
-    #if EXTRUDERS > 1
-        last_extruder = 0xFF;
+#ifdef PREVENT_DANGEROUS_EXTRUDE
+// M302 - allow cold extrudes, or set the minimum extrude temperature
+static uint8_t gcode_M302(const char *strCmd)
+{
+  float temp = .0;
+  if (code_seen(strCmd, 'S')) temp=code_value();
+     set_extrude_min_temp(temp);
+   return GCODE_DONE;
+}
+
+#endif
+// M303 PID autotune
+static uint8_t gcode_M303(const char *strCmd)
+{
+  float temp = 150.0;
+  int e=0;
+  int c=5;
+  if (code_seen(strCmd, 'E')) e=code_value();
+    if (e<0)
+      temp=70;
+  if (code_seen(strCmd, 'S')) temp=code_value();
+  if (code_seen(strCmd, 'C')) c=code_value();
+  PID_autotune(temp, e, c);
+  return GCODE_DONE;
+}
+
+#ifdef STEPPER_ISR_PROFILE
+// M122 report stepper interrupt timing
+static uint8_t gcode_M122(const char *strCmd)
+{
+  st_profile_report();
+  if(code_seen(strCmd, 'R'))
+    st_profile_reset();
+  return GCODE_DONE;
+}
+
+#endif
+// M400 finish all moves
+static uint8_t gcode_M400(const char *strCmd)
+{
+  st_synchronize();
+  return GCODE_DONE;
+}
+
+// M401
+static uint8_t gcode_M401(const char *strCmd)
+{
+  quickStop();
+  return GCODE_DONE;
+}
+
+// M500 Store settings in EEPROM
+static uint8_t gcode_M500(const char *strCmd)
+{
+  Config_StoreSettings();
+  return GCODE_DONE;
+}
+
+// M501 Read settings from EEPROM
+static uint8_t gcode_M501(const char *strCmd)
+{
+  Config_RetrieveSettings();
+  return GCODE_DONE;
+}
+
+// M502 Revert to default settings
+static uint8_t gcode_M502(const char *strCmd)
+{
+  Config_ResetDefault();
+  return GCODE_DONE;
+}
+
+// M503 print settings currently in memory
+static uint8_t gcode_M503(const char *strCmd)
+{
+  Config_PrintSettings();
+  return GCODE_DONE;
+}
+
+#ifdef ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED
+// M540
+static uint8_t gcode_M540(const char *strCmd)
+{
+  if(code_seen(strCmd, 'S')) abort_on_endstop_hit = code_value() > 0;
+  return GCODE_DONE;
+}
+
+#endif
+#ifdef FILAMENTCHANGEENABLE
+// M600 - Pause for filament change X[pos] Y[pos] Z[relative lift] E[initial retract] L[later retract distance for removal]
+static uint8_t gcode_M600(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+
+  float target[4];
+  float lastpos[4];
+  target[X_AXIS]=current_position[X_AXIS];
+  target[Y_AXIS]=current_position[Y_AXIS];
+  target[Z_AXIS]=current_position[Z_AXIS];
+  target[E_AXIS]=current_position[E_AXIS];
+  lastpos[X_AXIS]=current_position[X_AXIS];
+  lastpos[Y_AXIS]=current_position[Y_AXIS];
+  lastpos[Z_AXIS]=current_position[Z_AXIS];
+  lastpos[E_AXIS]=current_position[E_AXIS];
+  //retract by E
+  if(code_seen(strCmd, 'E'))
+  {
+    target[E_AXIS]+= code_value();
+  }
+  else
+  {
+    #ifdef FILAMENTCHANGE_FIRSTRETRACT
+      target[E_AXIS]+= FILAMENTCHANGE_FIRSTRETRACT ;
     #endif
-        delay(100);
-        LCD_ALERTMESSAGEPGM(MSG_FILAMENTCHANGE);
-        uint8_t cnt=0;
-        while(!lcd_clicked())
-        {
-          cnt++;
-          idle();
-          if(cnt==0)
-          {
-          #if BEEPER > 0
-            SET_OUTPUT(BEEPER);
-
-            WRITE(BEEPER,HIGH);
-            delay(3);
-            WRITE(BEEPER,LOW);
-            delay(3);
-          #else
-            lcd_buzz(1000/6,100);
-          #endif
-          }
-        }
+  }
+  plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder);
+
+  //lift Z
+  if(code_seen(strCmd, 'Z'))
+  {
+    target[Z_AXIS]+= code_value();
+  }
+  else
+  {
+    #ifdef FILAMENTCHANGE_ZADD
+      target[Z_AXIS]+= FILAMENTCHANGE_ZADD ;
+    #endif
+  }
+  plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder);
+
+  //move xy
+  if(code_seen(strCmd, 'X'))
+  {
+    target[X_AXIS]+= code_value();
+  }
+  else
+  {
+    #ifdef FILAMENTCHANGE_XPOS
+      target[X_AXIS]= FILAMENTCHANGE_XPOS ;
+    #endif
+  }
+  if(code_seen(strCmd, 'Y'))
+  {
+    target[Y_AXIS]= code_value();
+  }
+  else
+  {
+    #ifdef FILAMENTCHANGE_YPOS
+      target[Y_AXIS]= FILAMENTCHANGE_YPOS ;
+    #endif
+  }
+
+  plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder);
+
+  if(code_seen(strCmd, 'L'))
+  {
+    target[E_AXIS]+= code_value();
+  }
+  else
+  {
+    #ifdef FILAMENTCHANGE_FINALRETRACT
+      target[E_AXIS]+= FILAMENTCHANGE_FINALRETRACT ;
+    #endif
+  }
+
+  plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder);
+
+  //finish moves
+  st_synchronize();
+  //disable extruder steppers so filament can be removed
+  disable_e0();
+  disable_e1();
+  disable_e2();
+  #if EXTRUDERS > 1
+  last_extruder = 0xFF;
+  #endif
+  delay(100);
+  LCD_ALERTMESSAGEPGM(MSG_FILAMENTCHANGE);
+  uint8_t cnt=0;
+  while(!lcd_clicked())
+  {
+    cnt++;
+    idle();
+    if(cnt==0)
+    {
+    #if BEEPER > 0
+      SET_OUTPUT(BEEPER);
+
+      WRITE(BEEPER,HIGH);
+      delay(3);
+      WRITE(BEEPER,LOW);
+      delay(3);
+    #else
+      lcd_buzz(1000/6,100);
+    #endif
+    }
+  }
+
+  //return to normal
+  if(code_seen(strCmd, 'L'))
+  {
+    target[E_AXIS]+= -code_value();
+  }
+  else
+  {
+    #ifdef FILAMENTCHANGE_FINALRETRACT
+      target[E_AXIS]+=(-1)*FILAMENTCHANGE_FINALRETRACT ;
+    #endif
+  }
+  current_position[E_AXIS]=target[E_AXIS]; //the long retract of L is compensated by manual filament feeding
+  plan_set_e_position(current_position[E_AXIS] / volume_to_filament_length[active_extruder], active_extruder, true);
+  plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder); //should do nothing
+  plan_buffer_line(lastpos[X_AXIS], lastpos[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder); //move xy back
+  plan_buffer_line(lastpos[X_AXIS], lastpos[Y_AXIS], lastpos[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder); //move z back
+  plan_buffer_line(lastpos[X_AXIS], lastpos[Y_AXIS], lastpos[Z_AXIS], lastpos[E_AXIS], feedrate/60, active_extruder); //final untretract
+  return GCODE_DONE;
+}
+
+#endif //FILAMENTCHANGEENABLE
+#ifdef ENABLE_ULTILCD2
+// M601 Pause in UltiLCD2, X[pos] Y[pos] Z[relative lift] L[later retract distance]
+static uint8_t gcode_M601(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+
+  //        serial_action_P(PSTR("pause"));
+  card.pauseSDPrint();
+
+  st_synchronize();
+  float target[NUM_AXIS];
+  float lastpos[NUM_AXIS];
+  // preserve current position
+  memcpy(lastpos, current_position, sizeof(lastpos));
+  memcpy(target, current_position, sizeof(target));
+  recover_height = lastpos[Z_AXIS];
+
+  //retract
+  //Set the recover length to whatever distance we retracted so we recover properly.
+  retract_recover_length = retract_length/volume_to_filament_length[active_extruder];
+  target[E_AXIS] -= retract_recover_length;
+  plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], retract_feedrate/60, active_extruder);
+  retracted=true;
+
+  //lift Z
+  if(code_seen(strCmd, 'Z'))
+  {
+    target[Z_AXIS]+= code_value();
+  }
+  plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], homing_feedrate[Z_AXIS]/60, active_extruder);
+
+  //move xy
+  if(code_seen(strCmd, 'X'))
+  {
+    target[X_AXIS] = code_value();
+  }
+  if(code_seen(strCmd, 'Y'))
+  {
+    target[Y_AXIS] = code_value();
+  }
+  plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], homing_feedrate[X_AXIS]/60, active_extruder);
+
+  // additional retract
+  float addRetractLength = 0.0f;
+  bool bAddRetract = code_seen(strCmd, 'L');
+  if(bAddRetract)
+  {
+    addRetractLength = code_value()/volume_to_filament_length[active_extruder];
+    retract_recover_length += addRetractLength;
+    target[E_AXIS] -= addRetractLength;
+  }
+  plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], retract_feedrate/60, active_extruder);
 
-        //return to normal
-        if(code_seen(strCmd, 'L'))
-        {
-          target[E_AXIS]+= -code_value();
-        }
-        else
-        {
-          #ifdef FILAMENTCHANGE_FINALRETRACT
-            target[E_AXIS]+=(-1)*FILAMENTCHANGE_FINALRETRACT ;
-          #endif
-        }
-        current_position[E_AXIS]=target[E_AXIS]; //the long retract of L is compensated by manual filament feeding
-        plan_set_e_position(current_position[E_AXIS] / volume_to_filament_length[active_extruder], active_extruder, true);
-        plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder); //should do nothing
-        plan_buffer_line(lastpos[X_AXIS], lastpos[Y_AXIS], target[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder); //move xy back
-        plan_buffer_line(lastpos[X_AXIS], lastpos[Y_AXIS], lastpos[Z_AXIS], target[E_AXIS], feedrate/60, active_extruder); //move z back
-        plan_buffer_line(lastpos[X_AXIS], lastpos[Y_AXIS], lastpos[Z_AXIS], lastpos[E_AXIS], feedrate/60, active_extruder); //final untretract
-    }
-    break;
-    #endif //FILAMENTCHANGEENABLE
-    #ifdef ENABLE_ULTILCD2
-    case 601: //M601 Pause in UltiLCD2, X[pos] Y[pos] Z[relative lift] L[later retract distance]
+  memcpy(current_position, target, sizeof(current_position));
+  memcpy(destination, current_position, sizeof(destination));
+
+  //finish moves
+  st_synchronize();
+  //disable extruder steppers so filament can be removed
+  disable_e0();
+  disable_e1();
+  disable_e2();
+  #if EXTRUDERS > 1
+  last_extruder = 0xFF;
+  #endif
+  // serial_action_P(PSTR("pause"));
+  card.pauseSDPrint();
+  while(card.pause()){
+    idle();
+    if (printing_state == PRINT_STATE_ABORT)
     {
-        if (printing_state == PRINT_STATE_RECOVER)
-          break;
+      break;
+    }
+  }
 
-//        serial_action_P(PSTR("pause"));
-        card.pauseSDPrint();
+  plan_set_e_position(target[E_AXIS], active_extruder, true);
 
-        st_synchronize();
-        float target[NUM_AXIS];
-        float lastpos[NUM_AXIS];
-        // preserve current position
-        memcpy(lastpos, current_position, sizeof(lastpos));
-        memcpy(target, current_position, sizeof(target));
-        recover_height = lastpos[Z_AXIS];
-
-        //retract
-        //Set the recover length to whatever distance we retracted so we recover properly.
-        retract_recover_length = retract_length/volume_to_filament_length[active_extruder];
-        target[E_AXIS] -= retract_recover_length;
-        plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], retract_feedrate/60, active_extruder);
-        retracted=true;
-
-        //lift Z
-        if(code_seen(strCmd, 'Z'))
-        {
-          target[Z_AXIS]+= code_value();
-        }
-        plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], homing_feedrate[Z_AXIS]/60, active_extruder);
+  if ((printing_state != PRINT_STATE_ABORT) && (card.sdprinting() || HAS_SERIAL_CMD))
+  {
+      //return to normal
+      if(bAddRetract)
+      {
+          // revert the additional retract
+          target[E_AXIS] += addRetractLength;
+          plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], retract_feedrate/60, active_extruder); //Move back the L feed.
+      }
 
-        //move xy
-        if(code_seen(strCmd, 'X'))
-        {
-          target[X_AXIS] = code_value();
-        }
-        if(code_seen(strCmd, 'Y'))
-        {
-          target[Y_AXIS] = code_value();
-        }
-        plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], homing_feedrate[X_AXIS]/60, active_extruder);
+      memcpy(current_position, lastpos, sizeof(current_position));
+      memcpy(destination, current_position, sizeof(destination));
 
-        // additional retract
-        float addRetractLength = 0.0f;
-        bool bAddRetract = code_seen(strCmd, 'L');
-        if(bAddRetract)
-        {
-          addRetractLength = code_value()/volume_to_filament_length[active_extruder];
-          retract_recover_length += addRetractLength;
-          target[E_AXIS] -= addRetractLength;
-        }
-        plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], retract_feedrate/60, active_extruder);
+      plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], target[Z_AXIS], target[E_AXIS], homing_feedrate[X_AXIS]/60, active_extruder); //move xy back
+      plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], target[E_AXIS], homing_feedrate[Z_AXIS]/60, active_extruder); //move z back
 
-        memcpy(current_position, target, sizeof(current_position));
-        memcpy(destination, current_position, sizeof(destination));
+      //final unretract
+      plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], retract_feedrate/60, active_extruder);
+      retracted = false;
+  }
+  else
+  {
+    memcpy(current_position, target, sizeof(current_position));
+    memcpy(destination, current_position, sizeof(destination));
+  }
+  serial_action_P(PSTR("resume"));
+  return GCODE_DONE;
+}
 
-        //finish moves
-        st_synchronize();
-        //disable extruder steppers so filament can be removed
-        disable_e0();
-        disable_e1();
-        disable_e2();
-    #if EXTRUDERS > 1
-        last_extruder = 0xFF;
-    #endif
-        // serial_action_P(PSTR("pause"));
-        card.pauseSDPrint();
-        while(card.pause()){
-          idle();
-          if (printing_state == PRINT_STATE_ABORT)
-          {
-            break;
-          }
-        }
+// M605 store current set values
+static uint8_t gcode_M605(const char *strCmd)
+{
+  uint8_t tmp_select;
+  if (code_seen(strCmd, 'S'))
+  {
+    tmp_select = code_value();
+    if (tmp_select>9) tmp_select=9;
+  }
+  else
+  {
+    tmp_select = 0;
+  }
 
-        plan_set_e_position(target[E_AXIS], active_extruder, true);
+  machinesettings.store(tmp_select);
+  return GCODE_DONE;
+}
 
-        if ((printing_state != PRINT_STATE_ABORT) && (card.sdprinting() || HAS_SERIAL_CMD))
-        {
-            //return to normal
-            if(bAddRetract)
-            {
-                // revert the additional retract
-                target[E_AXIS] += addRetractLength;
-                plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], retract_feedrate/60, active_extruder); //Move back the L feed.
-            }
+// M606 recall saved values
+static uint8_t gcode_M606(const char *strCmd)
+{
+  uint8_t tmp_select;
+  if (code_seen(strCmd, 'S'))
+  {
+    tmp_select = code_value();
+    if (tmp_select>9) tmp_select=9;
+  }
+  else
+  {
+    tmp_select = 0;
+  }
+  machinesettings.recall(tmp_select);
+  return GCODE_DONE;
+}
+
+#endif//ENABLE_ULTILCD2
+#ifdef LIN_ADVANCE
+// M900 K<seconds> T<extruder> - set the linear advance
+static uint8_t gcode_M900(const char *strCmd)
+{
+  uint8_t e = active_extruder;
+  if (code_seen(strCmd, 'T'))
+    e = code_value();
+  if (e < EXTRUDERS && code_seen(strCmd, 'K'))
+    extruder_advance_k[e] = constrain(code_value(), 0.0, LIN_ADVANCE_K_MAX);
+  SERIAL_ECHO_START;
+  SERIAL_ECHOPGM("Advance K:");
+  for(e = 0; e < EXTRUDERS; e++)
+  {
+    SERIAL_ECHOPGM(" ");
+    SERIAL_ECHO(extruder_advance_k[e]);
+  }
+  SERIAL_EOL;
+  return GCODE_DONE;
+}
 
-            memcpy(current_position, lastpos, sizeof(current_position));
-            memcpy(destination, current_position, sizeof(destination));
+#endif
+// M907 Set digital trimpot motor current using axis codes.
+static uint8_t gcode_M907(const char *strCmd)
+{
+  #if defined(DIGIPOTSS_PIN) && DIGIPOTSS_PIN > -1
+  for(int i=0;i<NUM_AXIS;i++) if(code_seen(strCmd, axis_codes[i])) digipot_current(i,code_value());
+  if(code_seen(strCmd, 'B')) digipot_current(4,code_value());
+  if(code_seen(strCmd, 'S')) for(int i=0;i<=4;i++) digipot_current(i,code_value());
+  #endif
+  #if defined(MOTOR_CURRENT_PWM_XY_PIN) && MOTOR_CURRENT_PWM_XY_PIN > -1
+  if(code_seen(strCmd, 'X')) digipot_current(0, code_value());
+  #endif
+  #if defined(MOTOR_CURRENT_PWM_Z_PIN) && MOTOR_CURRENT_PWM_Z_PIN > -1
+  if(code_seen(strCmd, 'Z')) digipot_current(1, code_value());
+  #endif
+  #if defined(MOTOR_CURRENT_PWM_E_PIN) && MOTOR_CURRENT_PWM_E_PIN > -1
+  if(code_seen(strCmd, 'E')) digipot_current(2, code_value());
+  #endif
+  return GCODE_DONE;
+}
 
-            plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], target[Z_AXIS], target[E_AXIS], homing_feedrate[X_AXIS]/60, active_extruder); //move xy back
-            plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], target[E_AXIS], homing_feedrate[Z_AXIS]/60, active_extruder); //move z back
+// M908 Control digital trimpot directly.
+static uint8_t gcode_M908(const char *strCmd)
+{
+  #if defined(DIGIPOTSS_PIN) && DIGIPOTSS_PIN > -1
+  uint8_t channel,current;
+  if(code_seen(strCmd, 'P')) channel=code_value();
+  if(code_seen(strCmd, 'S')) current=code_value();
+  digitalPotWrite(channel, current);
+  #endif
+  return GCODE_DONE;
+}
 
-            //final unretract
-            plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], retract_feedrate/60, active_extruder);
-            retracted = false;
-        }
-        else
-        {
-          memcpy(current_position, target, sizeof(current_position));
-          memcpy(destination, current_position, sizeof(destination));
-        }
-        serial_action_P(PSTR("resume"));
-    }
-    break;
+// M350 Set microstepping mode. Warning: Steps per unit remains unchanged. S code sets stepping mode for all drivers.
+static uint8_t gcode_M350(const char *strCmd)
+{
+  #if defined(X_MS1_PIN) && X_MS1_PIN > -1
+  if(code_seen(strCmd, 'S')) for(int i=0;i<=4;i++) microstep_mode(i,code_value());
+  for(int i=0;i<NUM_AXIS;i++) if(code_seen(strCmd, axis_codes[i])) microstep_mode(i,(uint8_t)code_value());
+  if(code_seen(strCmd, 'B')) microstep_mode(4,code_value());
+  microstep_readings();
+  #endif
+  return GCODE_DONE;
+}
 
-    case 605: // M605 store current set values
-    {
-      uint8_t tmp_select;
-      if (code_seen(strCmd, 'S'))
-      {
-        tmp_select = code_value();
-        if (tmp_select>9) tmp_select=9;
-      }
-      else
-      {
-        tmp_select = 0;
-      }
+// M351 Toggle MS1 MS2 pins directly, S# determines MS1 or MS2, X# sets the pin high/low.
+static uint8_t gcode_M351(const char *strCmd)
+{
+  #if defined(X_MS1_PIN) && X_MS1_PIN > -1
+  if(code_seen(strCmd, 'S')) switch((int)code_value())
+  {
+    case 1:
+      for(int i=0;i<NUM_AXIS;i++) if(code_seen(strCmd, axis_codes[i])) microstep_ms(i,code_value(),-1);
+      if(code_seen(strCmd, 'B')) microstep_ms(4,code_value(),-1);
+      break;
+    case 2:
+      for(int i=0;i<NUM_AXIS;i++) if(code_seen(strCmd, axis_codes[i])) microstep_ms(i,-1,code_value());
+      if(code_seen(strCmd, 'B')) microstep_ms(4,-1,code_value());
+      break;
+  }
+  microstep_readings();
+  #endif
+  return GCODE_DONE;
+}
 
-      machinesettings.store(tmp_select);
-    }
-    break;
+// M999 - Restart after being stopped
+static uint8_t gcode_M999(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  Stopped = 0x0;
+  lcd_reset_alert_level();
+  gcode_LastN = Stopped_gcode_LastN;
+  FlushSerialRequestResend();
+  return GCODE_DONE;
+}
 
-    case 606: // M606 recall saved values
-    {
-      uint8_t tmp_select;
-      if (code_seen(strCmd, 'S'))
-      {
-        tmp_select = code_value();
-        if (tmp_select>9) tmp_select=9;
-      }
-      else
-      {
-        tmp_select = 0;
-      }
-      machinesettings.recall(tmp_select);
-    }
-    break;
-    #endif//ENABLE_ULTILCD2
+#ifdef ENABLE_ULTILCD2
+// M10000 - Clear the whole LCD
+static uint8_t gcode_M10000(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  lcd_lib_clear();
+  return GCODE_DONE;
+}
 
-    case 907: // M907 Set digital trimpot motor current using axis codes.
-    {
-      #if defined(DIGIPOTSS_PIN) && DIGIPOTSS_PIN > -1
-        for(int i=0;i<NUM_AXIS;i++) if(code_seen(axis_codes[i])) digipot_current(i,code_value());
-        if(code_seen(strCmd, 'B')) digipot_current(4,code_value());
-        if(code_seen(strCmd, 'S')) for(int i=0;i<=4;i++) digipot_current(i,code_value());
-      #endif
-      #if defined(MOTOR_CURRENT_PWM_XY_PIN) && MOTOR_CURRENT_PWM_XY_PIN > -1
-        if(code_seen(strCmd, 'X')) digipot_current(0, code_value());
-      #endif
-      #if defined(MOTOR_CURRENT_PWM_Z_PIN) && MOTOR_CURRENT_PWM_Z_PIN > -1
-        if(code_seen(strCmd, 'Z')) digipot_current(1, code_value());
-      #endif
-      #if defined(MOTOR_CURRENT_PWM_E_PIN) && MOTOR_CURRENT_PWM_E_PIN > -1
-        if(code_seen(strCmd, 'E')) digipot_current(2, code_value());
-      #endif
-    }
-    break;
-    case 908: // M908 Control digital trimpot directly.
-    {
-      #if defined(DIGIPOTSS_PIN) && DIGIPOTSS_PIN > -1
-        uint8_t channel,current;
-        if(code_seen(strCmd, 'P')) channel=code_value();
-        if(code_seen(strCmd, 'S')) current=code_value();
-        digitalPotWrite(channel, current);
-      #endif
-    }
-    break;
-    case 350: // M350 Set microstepping mode. Warning: Steps per unit remains unchanged. S code sets stepping mode for all drivers.
+// M10001 - Draw text on LCD, M10002 X0 Y0 SText (when X is left out, it will draw centered)
+static uint8_t gcode_M10001(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  uint8_t x = 0, y = 0;
+  if (code_seen(strCmd, 'X'))
+  {
+    x = code_value_long();
+    if (code_seen(strCmd, 'Y')) y = code_value_long();
+    if (code_seen(strCmd, 'S')) lcd_lib_draw_string(x, y, strchr_pointer + 1);
+  }
+  else
+  {
+    if (code_seen(strCmd, 'Y')) y = code_value_long();
+    if (code_seen(strCmd, 'S'))
     {
-      #if defined(X_MS1_PIN) && X_MS1_PIN > -1
-        if(code_seen(strCmd, 'S')) for(int i=0;i<=4;i++) microstep_mode(i,code_value());
-        for(int i=0;i<NUM_AXIS;i++) if(code_seen(axis_codes[i])) microstep_mode(i,(uint8_t)code_value());
-        if(code_seen(strCmd, 'B')) microstep_mode(4,code_value());
-        microstep_readings();
-      #endif
+      truncate_checksum(++strchr_pointer);
+      lcd_lib_draw_string_center(y, strchr_pointer);
     }
-    break;
-    case 351: // M351 Toggle MS1 MS2 pins directly, S# determines MS1 or MS2, X# sets the pin high/low.
+  }
+  return GCODE_DONE;
+}
+
+// M10002 - Draw inverted text on LCD, M10002 X0 Y0 SText (when X is left out, it will draw centered)
+static uint8_t gcode_M10002(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  uint8_t x = 0, y = 0;
+  if (code_seen(strCmd, 'X'))
+  {
+    x = code_value_long();
+    if (code_seen(strCmd, 'Y')) y = code_value_long();
+    if (code_seen(strCmd, 'S')) lcd_lib_clear_string(x, y, strchr_pointer + 1);
+  }
+  else
+  {
+    if (code_seen(strCmd, 'Y')) y = code_value_long();
+    if (code_seen(strCmd, 'S'))
     {
-      #if defined(X_MS1_PIN) && X_MS1_PIN > -1
-      if(code_seen(strCmd, 'S')) switch((int)code_value())
-      {
-        case 1:
-          for(int i=0;i<NUM_AXIS;i++) if(code_seen(axis_codes[i])) microstep_ms(i,code_value(),-1);
-          if(code_seen(strCmd, 'B')) microstep_ms(4,code_value(),-1);
-          break;
-        case 2:
-          for(int i=0;i<NUM_AXIS;i++) if(code_seen(axis_codes[i])) microstep_ms(i,-1,code_value());
-          if(code_seen(strCmd, 'B')) microstep_ms(4,-1,code_value());
-          break;
-      }
-      microstep_readings();
-      #endif
+      truncate_checksum(++strchr_pointer);
+      lcd_lib_clear_string_center(y, strchr_pointer);
     }
-    break;
-    case 999: // M999: Restart after being stopped
-      if (printing_state == PRINT_STATE_RECOVER)
-        break;
-      Stopped = 0x0;
-      lcd_reset_alert_level();
-      gcode_LastN = Stopped_gcode_LastN;
-      FlushSerialRequestResend();
-    break;
-#ifdef ENABLE_ULTILCD2
-    case 10000://M10000 - Clear the whole LCD
-        if (printing_state == PRINT_STATE_RECOVER)
-          break;
-        lcd_lib_clear();
-        break;
-    case 10001://M10001 - Draw text on LCD, M10002 X0 Y0 SText (when X is left out, it will draw centered)
-        {
-          if (printing_state == PRINT_STATE_RECOVER)
-            break;
-          uint8_t x = 0, y = 0;
-          if (code_seen(strCmd, 'X'))
-          {
-            x = code_value_long();
-            if (code_seen(strCmd, 'Y')) y = code_value_long();
-            if (code_seen(strCmd, 'S')) lcd_lib_draw_string(x, y, strchr_pointer + 1);
-          }
-          else
-          {
-            if (code_seen(strCmd, 'Y')) y = code_value_long();
-            if (code_seen(strCmd, 'S'))
-            {
-              truncate_checksum(++strchr_pointer);
-              lcd_lib_draw_string_center(y, strchr_pointer);
-            }
-          }
-        }
-        break;
-    case 10002://M10002 - Draw inverted text on LCD, M10002 X0 Y0 SText (when X is left out, it will draw centered)
-        {
-          if (printing_state == PRINT_STATE_RECOVER)
-            break;
-          uint8_t x = 0, y = 0;
-          if (code_seen(strCmd, 'X'))
-          {
-            x = code_value_long();
-            if (code_seen(strCmd, 'Y')) y = code_value_long();
-            if (code_seen(strCmd, 'S')) lcd_lib_clear_string(x, y, strchr_pointer + 1);
-          }
-          else
-          {
-            if (code_seen(strCmd, 'Y')) y = code_value_long();
-            if (code_seen(strCmd, 'S'))
-            {
-              truncate_checksum(++strchr_pointer);
-              lcd_lib_clear_string_center(y, strchr_pointer);
-            }
-          }
-        }
-        break;
-    case 10003://M10003 - Draw square on LCD, M10003 X1 Y1 W10 H10
-        {
-        if (printing_state == PRINT_STATE_RECOVER)
-          break;
-        uint8_t x = 0, y = 0, w = 1, h = 1;
-        if (code_seen(strCmd, 'X')) x = code_value_long();
-        if (code_seen(strCmd, 'Y')) y = code_value_long();
-        if (code_seen(strCmd, 'W')) w = code_value_long();
-        if (code_seen(strCmd, 'H')) h = code_value_long();
-        lcd_lib_set(x, y, x + w, y + h);
-        }
-        break;
-    case 10004://M10004 - Draw filled rectangle on LCD, M10004 X1 Y1 W10 H10
-        {
-         uint8_t x = 0, y = 0, w = 1, h = 1;
-         if (code_seen(strCmd, 'X')) x = code_value_long();
-         if (code_seen(strCmd, 'Y')) y = code_value_long();
-         if (code_seen(strCmd, 'W')) w = code_value_long();
-         if (code_seen(strCmd, 'H')) h = code_value_long();
-         lcd_lib_set(x, y, x + w, y + h);
-        }
-        break;
-    case 10005://M10005 - Draw shaded square on LCD, M10004 X1 Y1 W10 H10
-        {
-        if (printing_state == PRINT_STATE_RECOVER)
-          break;
-        uint8_t x = 0, y = 0, w = 1, h = 1;
-        if (code_seen(strCmd, 'X')) x = code_value_long();
-        if (code_seen(strCmd, 'Y')) y = code_value_long();
-        if (code_seen(strCmd, 'W')) w = code_value_long();
-        if (code_seen(strCmd, 'H')) h = code_value_long();
-        lcd_lib_draw_shade(x, y, x + w, y + h);
-        }
-        break;
-    case 10010://M10010 - Request LCD screen button info (R:[rotation difference compared to previous request] B:[button down])
-        {
-            SERIAL_PROTOCOLPGM("ok R:");
-            SERIAL_PROTOCOL(lcd_lib_encoder_pos);
-            lcd_lib_encoder_pos = 0;
-            if (lcd_lib_button_down)
-                SERIAL_PROTOCOLLNPGM(" B:1");
-            else
-                SERIAL_PROTOCOLLNPGM(" B:0");
-            return;
-        }
-        break;
+  }
+  return GCODE_DONE;
+}
+
+// M10003 - Draw square on LCD, M10003 X1 Y1 W10 H10
+static uint8_t gcode_M10003(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  uint8_t x = 0, y = 0, w = 1, h = 1;
+  if (code_seen(strCmd, 'X')) x = code_value_long();
+  if (code_seen(strCmd, 'Y')) y = code_value_long();
+  if (code_seen(strCmd, 'W')) w = code_value_long();
+  if (code_seen(strCmd, 'H')) h = code_value_long();
+  lcd_lib_set(x, y, x + w, y + h);
+  return GCODE_DONE;
+}
+
+// M10004 - Draw filled rectangle on LCD, M10004 X1 Y1 W10 H10
+static uint8_t gcode_M10004(const char *strCmd)
+{
+  uint8_t x = 0, y = 0, w = 1, h = 1;
+  if (code_seen(strCmd, 'X')) x = code_value_long();
+  if (code_seen(strCmd, 'Y')) y = code_value_long();
+  if (code_seen(strCmd, 'W')) w = code_value_long();
+  if (code_seen(strCmd, 'H')) h = code_value_long();
+  lcd_lib_set(x, y, x + w, y + h);
+  return GCODE_DONE;
+}
+
+// M10005 - Draw shaded square on LCD, M10004 X1 Y1 W10 H10
+static uint8_t gcode_M10005(const char *strCmd)
+{
+  if (printing_state == PRINT_STATE_RECOVER)
+    return GCODE_DONE;
+  uint8_t x = 0, y = 0, w = 1, h = 1;
+  if (code_seen(strCmd, 'X')) x = code_value_long();
+  if (code_seen(strCmd, 'Y')) y = code_value_long();
+  if (code_seen(strCmd, 'W')) w = code_value_long();
+  if (code_seen(strCmd, 'H')) h = code_value_long();
+  lcd_lib_draw_shade(x, y, x + w, y + h);
+  return GCODE_DONE;
+}
+
+// M10010 - Request LCD screen button info (R:[rotation difference compared to previous request] B:[button down])
+static uint8_t gcode_M10010(const char *strCmd)
+{
+  SERIAL_PROTOCOLPGM("ok R:");
+  SERIAL_PROTOCOL(lcd_lib_encoder_pos);
+  lcd_lib_encoder_pos = 0;
+  if (lcd_lib_button_down)
+      SERIAL_PROTOCOLLNPGM(" B:1");
+  else
+      SERIAL_PROTOCOLLNPGM(" B:0");
+  return GCODE_REPLIED;
+}
+
 #endif//ENABLE_ULTILCD2
+
+// Sorted on code, gcode_handler() does a binary search
+static const gcode_entry_t gcode_G_table[] PROGMEM = {
+  {     0, gcode_G1 },
+  {     1, gcode_G1 },
+  {     2, gcode_G2 },
+  {     3, gcode_G3 },
+  {     4, gcode_G4 },
+#ifdef FWRETRACT
+  {    10, gcode_G10 },
+  {    11, gcode_G11 },
+#endif
+  {    28, gcode_G28 },
+  {    90, gcode_G90 },
+  {    91, gcode_G91 },
+  {    92, gcode_G92 },
+};
+
+static const gcode_entry_t gcode_M_table[] PROGMEM = {
+#if defined(ULTIPANEL) || defined(ENABLE_ULTILCD2)
+  {     0, gcode_M0 },
+  {     1, gcode_M0 },
+#endif
+  {    17, gcode_M17 },
+  {    18, gcode_M84 },
+#ifdef SDSUPPORT
+  {    20, gcode_M20 },
+  {    21, gcode_M21 },
+  {    22, gcode_M22 },
+  {    23, gcode_M23 },
+  {    24, gcode_M24 },
+  {    25, gcode_M25 },
+  {    26, gcode_M26 },
+  {    27, gcode_M27 },
+  {    28, gcode_M28 },
+  {    29, gcode_M29 },
+  {    30, gcode_M30 },
+#endif
+  {    31, gcode_M31 },
+  {    42, gcode_M42 },
+#if defined(PS_ON_PIN) && PS_ON_PIN > -1
+  {    80, gcode_M80 },
+#endif
+  {    81, gcode_M81 },
+  {    82, gcode_M82 },
+  {    83, gcode_M83 },
+  {    84, gcode_M84 },
+  {    85, gcode_M85 },
+  {    92, gcode_M92 },
+  {   104, gcode_M104 },
+  {   105, gcode_M105 },
+#if defined(FAN_PIN) && FAN_PIN > -1
+  {   106, gcode_M106 },
+  {   107, gcode_M107 },
+#endif
+  {   109, gcode_M109 },
+  {   114, gcode_M114 },
+  {   115, gcode_M115 },
+  {   117, gcode_M117 },
+  {   119, gcode_M119 },
+  {   120, gcode_M120 },
+  {   121, gcode_M121 },
+#ifdef STEPPER_ISR_PROFILE
+  {   122, gcode_M122 },
+#endif
+#ifdef BARICUDA
+#if defined(HEATER_1_PIN) && HEATER_1_PIN > -1
+  {   126, gcode_M126 },
+  {   127, gcode_M127 },
+#endif
+#if defined(HEATER_2_PIN) && HEATER_2_PIN > -1
+  {   128, gcode_M128 },
+  {   129, gcode_M129 },
+#endif
+#endif
+  {   140, gcode_M140 },
+  {   190, gcode_M190 },
+  {   200, gcode_M200 },
+  {   201, gcode_M201 },
+#if 0 // Not used for Sprinter/grbl gen6
+  {   202, gcode_M202 },
+#endif
+  {   203, gcode_M203 },
+  {   204, gcode_M204 },
+  {   205, gcode_M205 },
+  {   206, gcode_M206 },
+#ifdef FWRETRACT
+  {   207, gcode_M207 },
+  {   208, gcode_M208 },
+  {   209, gcode_M209 },
+#endif
+#if EXTRUDERS > 1
+  {   218, gcode_M218 },
+#endif
+  {   220, gcode_M220 },
+  {   221, gcode_M221 },
+  {   240, gcode_M240 },
+#if NUM_SERVOS > 0
+  {   280, gcode_M280 },
+#endif
+#if LARGE_FLASH == true && ( BEEPER > 0 || defined(ULTRALCD) || defined(ENABLE_ULTILCD2) )
+  {   300, gcode_M300 },
+#endif
+#ifdef PIDTEMP
+  {   301, gcode_M301 },
+#endif
+#ifdef PREVENT_DANGEROUS_EXTRUDE
+  {   302, gcode_M302 },
+#endif
+  {   303, gcode_M303 },
+#if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0)
+  {   304, gcode_M304 },
+#endif
+  {   350, gcode_M350 },
+  {   351, gcode_M351 },
+  {   400, gcode_M400 },
+  {   401, gcode_M401 },
+  {   500, gcode_M500 },
+  {   501, gcode_M501 },
+  {   502, gcode_M502 },
+  {   503, gcode_M503 },
+#ifdef ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED
+  {   540, gcode_M540 },
+#endif
+#ifdef FILAMENTCHANGEENABLE
+  {   600, gcode_M600 },
+#endif
+#ifdef ENABLE_ULTILCD2
+  {   601, gcode_M601 },
+  {   605, gcode_M605 },
+  {   606, gcode_M606 },
+#endif
+#ifdef LIN_ADVANCE
+  {   900, gcode_M900 },
+#endif
+  {   907, gcode_M907 },
+  {   908, gcode_M908 },
+#ifdef SDSUPPORT
+  {   923, gcode_M923 },
+  {   928, gcode_M928 },
+#endif
+  {   999, gcode_M999 },
+#ifdef ENABLE_ULTILCD2
+  { 10000, gcode_M10000 },
+  { 10001, gcode_M10001 },
+  { 10002, gcode_M10002 },
+  { 10003, gcode_M10003 },
+  { 10004, gcode_M10004 },
+  { 10005, gcode_M10005 },
+  { 10010, gcode_M10010 },
+#endif
+};
+
+// Binary search of a sorted handler table, NULL when the code is not in it
+static gcode_handler_t gcode_handler(const gcode_entry_t *table, uint8_t count, long code)
+{
+  uint8_t low = 0, high = count;
+  while (low < high)
+  {
+    uint8_t mid = (low + high) / 2;
+    long entry = pgm_read_word(&table[mid].code);
+    if (entry == code)
+    {
+      gcode_handler_t handler;
+      memcpy_P(&handler, &table[mid].handler, sizeof(handler));
+      return handler;
     }
+    if (entry < code)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return NULL;
+}
+
+void process_command(const char *strCmd, bool sendAck)
+{
+  if ((printing_state != PRINT_STATE_RECOVER) && (printing_state != PRINT_STATE_START) && (printing_state != PRINT_STATE_ABORT))
+    printing_state = PRINT_STATE_NORMAL;
+
+#ifdef BINARY_GCODE
+  if (strCmd[0] & BGCODE_MARKER)
+  {
+    if(!Stopped)
+      process_binary_move(strCmd);
+    if (sendAck) ClearToSend();
+    return;
   }
+#endif
 
+  parse_command(strCmd);
+  uint8_t result = GCODE_DONE;
+  if(code_seen(strCmd, 'G'))
+  {
+    gcode_handler_t handler = gcode_handler(gcode_G_table, COUNT(gcode_G_table), code_value_long());
+    if (handler)
+      result = handler(strCmd);
+  }
+  else if(code_seen(strCmd, 'M'))
+  {
+    gcode_handler_t handler = gcode_handler(gcode_M_table, COUNT(gcode_M_table), code_value_long());
+    if (handler)
+      result = handler(strCmd);
+  }
   else if(code_seen(strCmd, 'T'))
   {
     tmp_extruder = code_value();
@@ -2897,7 +3695,11 @@ void process_command(const char *strCmd, bool sendAck)
     SERIAL_ECHOLNPGM("\"");
   }
 
-  if ((printing_state != PRINT_STATE_RECOVER) && (printing_state != PRINT_STATE_START) && (printing_state != PRINT_STATE_ABORT))
+  code_cmd = NULL;
+  if (result == GCODE_REPLIED)
+    return;
+
+  if ((result == GCODE_DONE) && (printing_state != PRINT_STATE_RECOVER) && (printing_state != PRINT_STATE_START) && (printing_state != PRINT_STATE_ABORT))
     printing_state = PRINT_STATE_NORMAL;
 
   // send acknowledge for serial commands
@@ -3188,6 +3990,7 @@ void idle()
 
     lcd_update();
     lifetime_stats_tick();
+    eeprom_journal_tick();
 
     // detect serial communication
     if (commands_queued() && serialCmd)
@@ -3283,12 +4086,16 @@ void kill()
 #if EXTRUDERS > 1
   last_extruder = 0xFF;
 #endif
+  eeprom_journal_flush();
 
 #if defined(PS_ON_PIN) && PS_ON_PIN > -1
   pinMode(PS_ON_PIN,INPUT);
 #endif
   SERIAL_ERROR_START;
   SERIAL_ERRORLNPGM(MSG_ERR_KILLED);
+#ifndef AT90USB
+  MYSERIAL.flushTx(); // Interrupts are off, so the message has to be sent from here
+#endif
   LCD_ALERTMESSAGEPGM(MSG_KILLED);
   suicide();
   while(1) { /* Intentionally left empty */ } // Wait for reset
@@ -1098,6 +1098,56 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
   return -1;
 }
 //------------------------------------------------------------------------------
+/** Read the rest of the current block without copying it.
+ *
+ * The block is read into the volume cache and \a data points at the
+ * current position in it. The data stays valid till the cache is used
+ * for another block. The position is moved past the returned bytes,
+ * use seekCur() with a negative offset to give back the unused part.
+ *
+ * \param[out] data Set to the data at the current position.
+ *
+ * \return The number of bytes available, up to the end of the block
+ * or of the file. Zero at end of file, -1 if an error occurred.
+ */
+int16_t SdBaseFile::readCached(uint8_t** data) {
+  uint16_t offset;
+  uint16_t n;
+  uint32_t block;  // raw device block number
+
+  // error if not open or write only
+  if (!isOpen() || !(flags_ & O_READ)) goto fail;
+  if (curPosition_ >= fileSize_) return 0;
+
+  offset = curPosition_ & 0X1FF;  // offset in block
+  if (type_ == FAT_FILE_TYPE_ROOT_FIXED) {
+    block = vol_->rootDirStart() + (curPosition_ >> 9);
+  } else {
+    uint8_t blockOfCluster = vol_->blockOfCluster(curPosition_);
+    if (offset == 0 && blockOfCluster == 0) {
+      // start of new cluster
+      if (curPosition_ == 0) {
+        // use first cluster in file
+        curCluster_ = firstCluster_;
+      } else {
+        // get next cluster from FAT
+        if (!vol_->fatGet(curCluster_, &curCluster_)) goto fail;
+      }
+    }
+    block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
+  }
+  if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ)) goto fail;
+  *data = vol_->cache()->data + offset;
+
+  n = 512 - offset;
+  if (n > fileSize_ - curPosition_) n = fileSize_ - curPosition_;
+  curPosition_ += n;
+  return n;
+
+ fail:
+  return -1;
+}
+//------------------------------------------------------------------------------
 /** Read the next directory entry from a directory file.
  *
  * \param[out] dir The dir_t struct that will receive the data.
@@ -1,6 +1,7 @@
 #include "Configuration.h"
 
 #ifdef ENABLE_ULTILCD2
+#include <util/crc16.h>
 #include "pins.h"
 #include "preferences.h"
 #include "UltiLCD2_low_lib.h"
@@ -40,12 +41,35 @@
 #define LCD_COMMAND_LOCK_COMMANDS           0xFD
 
 #define LCD_COMMAND_SET_ADDRESSING_MODE     0x20
+#define LCD_COMMAND_SET_COLUMN_ADDRESS      0x21
+#define LCD_COMMAND_SET_PAGE_ADDRESS        0x22
+
+#define LCD_ADDRESSING_MODE_HORIZONTAL      0x00
 
 unsigned long last_user_interaction=0;
 
 /** Backbuffer for LCD */
 #define LCD_BUFFER_SIZE  (LCD_GFX_WIDTH * LCD_GFX_HEIGHT / 8)
 uint8_t lcd_buffer[LCD_BUFFER_SIZE];
+
+/**
+ * Only the changed parts of the screen are sent. The screen is split in cells of 16 columns of one 8 pixel page,
+ * and a CRC of every cell as it was last sent is kept. Of each page, the columns from the first to the last changed
+ * cell are sent in the column and page address window of the display.
+ * A copy of the sent frame would be exact, but costs 1KB of RAM where the CRCs take 128 bytes. A change that keeps
+ * the CRC of a cell would stay on the screen, so every LCD_FULL_UPDATE_INTERVAL updates the whole screen is sent.
+ **/
+#define LCD_PAGES                (LCD_GFX_HEIGHT / 8)
+#define LCD_CELL_WIDTH           16
+#define LCD_CELLS_PER_PAGE       (LCD_GFX_WIDTH / LCD_CELL_WIDTH)
+#define LCD_FULL_UPDATE_INTERVAL 64
+//Sending the whole screen at 400kHz takes 25ms, which used to limit the screen updates. Keep that rate when less is sent.
+#define LCD_MIN_UPDATE_INTERVAL  25
+static uint16_t lcd_cell_crc[LCD_PAGES][LCD_CELLS_PER_PAGE];
+static uint8_t lcd_page_first[LCD_PAGES];//First column to send of each page, LCD_GFX_WIDTH when the page did not change
+static uint8_t lcd_page_last[LCD_PAGES];
+static uint8_t lcd_full_update_countdown;
+static unsigned long lcd_update_millis;
 uint8_t led_r, led_g, led_b;
 uint8_t led_glow = 0;
 uint8_t led_glow_dir;
@@ -182,6 +206,7 @@ void lcd_lib_init()
     i2c_send_raw(0x34);
 
     i2c_send_raw(LCD_COMMAND_SET_ADDRESSING_MODE);
+    i2c_send_raw(LCD_ADDRESSING_MODE_HORIZONTAL);
 
     i2c_send_raw(LCD_COMMAND_FULL_DISPLAY_ON_DISABLE);
 
@@ -191,23 +216,102 @@ void lcd_lib_init()
     lcd_lib_buttons_update_interrupt();
     lcd_lib_buttons_update();
     lcd_lib_encoder_pos = 0;
+    lcd_full_update_countdown = 0;
     lcd_lib_update_screen();
 }
 
-#if USE_TWI_INTERRUPT
-uint16_t lcd_update_pos = 0;
-ISR(TWI_vect)
+//Compare the CRC of each cell with the one last sent, and set the columns to send of each page. Returns false when nothing changed.
+static bool lcd_lib_find_changes(bool full)
 {
-    if (lcd_update_pos == LCD_GFX_WIDTH*LCD_GFX_HEIGHT/8u)
+    bool changed = false;
+    const uint8_t* src = lcd_buffer;
+    for(uint8_t page=0; page<LCD_PAGES; page++)
     {
-        i2c_end();
+        uint8_t first = LCD_GFX_WIDTH;
+        uint8_t last = 0;
+        for(uint8_t cell=0; cell<LCD_CELLS_PER_PAGE; cell++)
+        {
+            uint16_t crc = 0xFFFF;
+            for(uint8_t n=0; n<LCD_CELL_WIDTH; n++)
+                crc = _crc16_update(crc, *src++);
+            if (full || crc != lcd_cell_crc[page][cell])
+            {
+                lcd_cell_crc[page][cell] = crc;
+                if (first == LCD_GFX_WIDTH)
+                    first = cell * LCD_CELL_WIDTH;
+                last = cell * LCD_CELL_WIDTH + LCD_CELL_WIDTH - 1;
+                changed = true;
+            }
+        }
+        lcd_page_first[page] = first;
+        lcd_page_last[page] = last;
     }
-    else
+    return changed;
+}
+
+#if USE_TWI_INTERRUPT
+/**
+ * The interrupt sends each changed page as two i2c messages, one with the address window and one with the data.
+ * Each interrupt sends the next byte, lcd_update_step counts the bytes around the data.
+ **/
+static uint8_t lcd_update_page;
+static uint8_t lcd_update_step;
+static uint16_t lcd_update_pos;
+static uint16_t lcd_update_end;
+
+//Start the messages of the next changed page. Returns false when all pages are sent.
+static bool lcd_update_start_page()
+{
+    while (lcd_update_page < LCD_PAGES && lcd_page_first[lcd_update_page] >= LCD_GFX_WIDTH)
+        lcd_update_page++;
+    if (lcd_update_page >= LCD_PAGES)
+        return false;
+    i2c_start();
+    lcd_update_step = 1;
+    return true;
+}
+
+ISR(TWI_vect)
+{
+    if (lcd_update_pos < lcd_update_end)
     {
         i2c_send_raw(lcd_buffer[lcd_update_pos]);
         TWCR |= _BV(TWIE);
         lcd_update_pos++;
+        return;
     }
+    switch(lcd_update_step++)
+    {
+    case 0:
+        if (!lcd_update_start_page())
+        {
+            i2c_end();
+            return;
+        }
+        break;
+    case 1:
+    case 10:
+        i2c_send_raw(I2C_LCD_ADDRESS << 1 | I2C_WRITE);
+        break;
+    case 2: i2c_send_raw(I2C_LCD_SEND_COMMAND); break;
+    case 3: i2c_send_raw(LCD_COMMAND_SET_COLUMN_ADDRESS); break;
+    case 4: i2c_send_raw(lcd_page_first[lcd_update_page]); break;
+    case 5: i2c_send_raw(lcd_page_last[lcd_update_page]); break;
+    case 6: i2c_send_raw(LCD_COMMAND_SET_PAGE_ADDRESS); break;
+    case 7:
+    case 8:
+        i2c_send_raw(lcd_update_page);
+        break;
+    case 9: i2c_start(); break;
+    default:
+        i2c_send_raw(I2C_LCD_SEND_DATA);
+        lcd_update_pos = lcd_update_page * LCD_GFX_WIDTH + lcd_page_first[lcd_update_page];
+        lcd_update_end = lcd_update_page * LCD_GFX_WIDTH + lcd_page_last[lcd_update_page] + 1;
+        lcd_update_page++;
+        lcd_update_step = 0;
+        break;
+    }
+    TWCR |= _BV(TWIE);
 }
 #endif
 
@@ -286,27 +390,46 @@ void lcd_lib_update_screen()
         i2c_led_write(4, led_b);//PWM2
     }
 
+    lcd_update_millis = millis();
     if (!(sleep_state & SLEEP_LCD_DIMMED) || lcd_sleep_contrast)
     {
-        // update screen content
-        i2c_start();
-        i2c_send_raw(I2C_LCD_ADDRESS << 1 | I2C_WRITE);
-        //Set the drawing position to 0,0
-        i2c_send_raw(I2C_LCD_SEND_COMMAND);
-        i2c_send_raw(0x00 | (0 & 0x0F));
-        i2c_send_raw(0x10 | (0 >> 4));
-        i2c_send_raw(0xB0 | 0);
-
-        i2c_restart();
-        i2c_send_raw(I2C_LCD_ADDRESS << 1 | I2C_WRITE);
-        i2c_send_raw(I2C_LCD_SEND_DATA);
+        // update the changed parts of the screen content
+        bool full = (lcd_full_update_countdown == 0);
+        lcd_full_update_countdown = full ? LCD_FULL_UPDATE_INTERVAL : lcd_full_update_countdown - 1;
+        if (!lcd_lib_find_changes(full))
+            return;
     #if USE_TWI_INTERRUPT
-        lcd_update_pos = 0;
+        lcd_update_page = 0;
+        lcd_update_pos = lcd_update_end = 0;
+        lcd_update_start_page();
         TWCR |= _BV(TWIE);
     #else
-        for(uint16_t n=0;n<LCD_GFX_WIDTH*LCD_GFX_HEIGHT/8;n++)
+        bool started = false;
+        for(uint8_t page=0; page<LCD_PAGES; page++)
         {
-            i2c_send_raw(lcd_buffer[n]);
+            if (lcd_page_first[page] >= LCD_GFX_WIDTH)
+                continue;
+            if (started)
+                i2c_restart();
+            else
+                i2c_start();
+            started = true;
+            i2c_send_raw(I2C_LCD_ADDRESS << 1 | I2C_WRITE);
+            i2c_send_raw(I2C_LCD_SEND_COMMAND);
+            i2c_send_raw(LCD_COMMAND_SET_COLUMN_ADDRESS);
+            i2c_send_raw(lcd_page_first[page]);
+            i2c_send_raw(lcd_page_last[page]);
+            i2c_send_raw(LCD_COMMAND_SET_PAGE_ADDRESS);
+            i2c_send_raw(page);
+            i2c_send_raw(page);
+
+            i2c_restart();
+            i2c_send_raw(I2C_LCD_ADDRESS << 1 | I2C_WRITE);
+            i2c_send_raw(I2C_LCD_SEND_DATA);
+            for(uint16_t n=page*LCD_GFX_WIDTH+lcd_page_first[page]; n<=page*LCD_GFX_WIDTH+lcd_page_last[page]; n++)
+            {
+                i2c_send_raw(lcd_buffer[n]);
+            }
         }
         i2c_end();
     #endif
@@ -315,6 +438,8 @@ void lcd_lib_update_screen()
 
 bool lcd_lib_update_ready()
 {
+    if (millis() - lcd_update_millis < LCD_MIN_UPDATE_INTERVAL)
+        return false;
 #if USE_TWI_INTERRUPT
     return !(TWCR & _BV(TWIE));
 #else
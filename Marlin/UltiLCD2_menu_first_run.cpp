@@ -332,7 +332,7 @@ static void lcd_menu_first_run_material_load()
 
 static void lcd_menu_first_run_material_select_1()
 {
-    if (eeprom_read_byte(EEPROM_MATERIAL_COUNT_OFFSET()) == 1)
+    if (eeprom_journal_read_byte(EEPROM_MATERIAL_COUNT_OFFSET()) == 1)
     {
         digipot_current(2, motor_current_setting[2]);//Set E motor power to default.
 
@@ -357,7 +357,7 @@ static void lcd_menu_first_run_material_select_1()
 static void lcd_material_select_callback(uint8_t nr, uint8_t offsetY, uint8_t flags)
 {
     char buffer[10];
-    eeprom_read_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(nr), MATERIAL_NAME_SIZE);
+    eeprom_journal_read_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(nr), MATERIAL_NAME_SIZE);
 
     buffer[MATERIAL_NAME_SIZE] = '\0';
     lcd_draw_scroll_entry(offsetY, buffer, flags);
@@ -371,7 +371,7 @@ static void lcd_material_select_details_callback(uint8_t nr)
 static void lcd_menu_first_run_material_select_material()
 {
     LED_GLOW
-    uint8_t count = eeprom_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
+    uint8_t count = eeprom_journal_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
 
     lcd_scroll_menu(PSTR("MATERIAL"), count, lcd_material_select_callback, lcd_material_select_details_callback);
     CLEAR_PROGRESS_NR(13);
@@ -1,9 +1,11 @@
 #ifndef ULTI_LCD2_MENU_FIRST_RUN_H
 #define ULTI_LCD2_MENU_FIRST_RUN_H
 
+#include "eeprom_journal.h"
+
 #define EEPROM_FIRST_RUN_DONE_OFFSET 0x400
-#define IS_FIRST_RUN_DONE() ((eeprom_read_byte((const uint8_t*)EEPROM_FIRST_RUN_DONE_OFFSET) == 'U'))
-#define SET_FIRST_RUN_DONE() do { eeprom_write_byte((uint8_t*)EEPROM_FIRST_RUN_DONE_OFFSET, 'U'); } while(0)
+#define IS_FIRST_RUN_DONE() ((eeprom_journal_read_byte((const uint8_t*)EEPROM_FIRST_RUN_DONE_OFFSET) == 'U'))
+#define SET_FIRST_RUN_DONE() do { eeprom_journal_write_byte((uint8_t*)EEPROM_FIRST_RUN_DONE_OFFSET, 'U'); } while(0)
 
 void lcd_menu_first_run_init();
 void lcd_menu_first_run_start_bed_leveling();
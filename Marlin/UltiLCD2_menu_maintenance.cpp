@@ -537,6 +537,7 @@ static void lcd_menu_advanced_stats()
 
 static void doMachineRestart()
 {
+    eeprom_journal_flush();
     cli();
     //NOTE: Jumping to address 0 is not a fully proper way to reset.
     // Letting the watchdog timeout is a better reset, but the bootloader does not continue on a watchdog timeout.
@@ -557,12 +558,12 @@ static void doFactoryReset()
 {
     lcd_change_to_previous_menu();
     //Clear the EEPROM settings so they get read from default.
-    eeprom_write_byte((uint8_t*)100, 0);
-    eeprom_write_byte((uint8_t*)101, 0);
-    eeprom_write_byte((uint8_t*)102, 0);
-    eeprom_write_byte((uint8_t*)EEPROM_FIRST_RUN_DONE_OFFSET, 0);
-    eeprom_write_word((uint16_t*)EEPROM_EXPERT_VERSION_OFFSET, 0xFFFF);
-    eeprom_write_byte(EEPROM_MATERIAL_COUNT_OFFSET(), 0);
+    eeprom_journal_write_byte((uint8_t*)100, 0);
+    eeprom_journal_write_byte((uint8_t*)101, 0);
+    eeprom_journal_write_byte((uint8_t*)102, 0);
+    eeprom_journal_write_byte((uint8_t*)EEPROM_FIRST_RUN_DONE_OFFSET, 0);
+    eeprom_journal_write_word((uint16_t*)EEPROM_EXPERT_VERSION_OFFSET, 0xFFFF);
+    eeprom_journal_write_byte(EEPROM_MATERIAL_COUNT_OFFSET(), 0);
     doMachineRestart();
 }
 
@@ -17,6 +17,12 @@
 struct materialSettings material[EXTRUDERS];
 static unsigned long preheat_end_time;
 
+#ifdef LIN_ADVANCE
+#define ADVANCE_MENU_OFFSET 1
+#else
+#define ADVANCE_MENU_OFFSET 0
+#endif
+
 void doCooldown();//TODO
 static void lcd_menu_change_material_remove();
 static void lcd_menu_change_material_remove_wait_user();
@@ -455,7 +461,7 @@ static void lcd_menu_change_material_insert()
 static void lcd_menu_change_material_select_material_callback(uint8_t nr, uint8_t offsetY, uint8_t flags)
 {
     char buffer[10];
-    eeprom_read_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(nr), MATERIAL_NAME_SIZE);
+    eeprom_journal_read_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(nr), MATERIAL_NAME_SIZE);
     buffer[MATERIAL_NAME_SIZE] = '\0';
     lcd_draw_scroll_entry(offsetY, buffer, flags);
 }
@@ -467,28 +473,28 @@ static void lcd_menu_change_material_select_material_details_callback(uint8_t nr
 
     if (led_glow_dir)
     {
-        c = float_to_string2(eeprom_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(nr)), c, PSTR("mm"));
+        c = float_to_string2(eeprom_journal_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(nr)), c, PSTR("mm"));
         while(c < buffer + 10) *c++ = ' ';
         strcpy_P(c, PSTR("Flow:"));
         c += 5;
-        c = int_to_string(eeprom_read_word(EEPROM_MATERIAL_FLOW_OFFSET(nr)), c, PSTR("%"));
+        c = int_to_string(eeprom_journal_read_word(EEPROM_MATERIAL_FLOW_OFFSET(nr)), c, PSTR("%"));
     }else{
-        c = int_to_string(eeprom_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(nr)), c, PSTR("C"));
+        c = int_to_string(eeprom_journal_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(nr)), c, PSTR("C"));
 #if TEMP_SENSOR_BED != 0
         *c++ = ' ';
-        c = int_to_string(eeprom_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(nr)), c, PSTR("C"));
+        c = int_to_string(eeprom_journal_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(nr)), c, PSTR("C"));
 #endif
         while(c < buffer + 10) *c++ = ' ';
         strcpy_P(c, PSTR("Fan: "));
         c += 5;
-        c = int_to_string(eeprom_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(nr)), c, PSTR("%"));
+        c = int_to_string(eeprom_journal_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(nr)), c, PSTR("%"));
     }
     lcd_lib_draw_string_left(BOTTOM_MENU_YPOS, buffer);
 }
 
 static void lcd_menu_change_material_select_material()
 {
-    uint8_t count = eeprom_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
+    uint8_t count = eeprom_journal_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
 
     lcd_scroll_menu(PSTR("MATERIAL"), count, lcd_menu_change_material_select_material_callback, lcd_menu_change_material_select_material_details_callback);
     if (lcd_lib_button_pressed)
@@ -534,7 +540,7 @@ static void lcd_menu_material_export()
 
     card.setroot();
     card.openFile("MATERIAL.TXT", false);
-    uint8_t count = eeprom_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
+    uint8_t count = eeprom_journal_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
     for(uint8_t n=0; n<count; ++n)
     {
         char buffer[32] = {0};
@@ -543,57 +549,67 @@ static void lcd_menu_material_export()
 
         strcpy_P(buffer, PSTR("name="));
         char* ptr = buffer + strlen(buffer);
-        eeprom_read_block(ptr, EEPROM_MATERIAL_NAME_OFFSET(n), MATERIAL_NAME_SIZE);
+        eeprom_journal_read_block(ptr, EEPROM_MATERIAL_NAME_OFFSET(n), MATERIAL_NAME_SIZE);
         ptr[MATERIAL_NAME_SIZE] = '\0';
         strcat_P(buffer, PSTR("\n"));
         card.write_string(buffer);
 
         strcpy_P(buffer, PSTR("temperature="));
         ptr = buffer + strlen(buffer);
-        int_to_string(eeprom_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(n)), ptr, PSTR("\n"));
+        int_to_string(eeprom_journal_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(n)), ptr, PSTR("\n"));
         card.write_string(buffer);
 
         for(uint8_t nozzle=0; nozzle<MATERIAL_TEMPERATURE_COUNT; ++nozzle)
         {
             strcpy_P(buffer, PSTR("temperature_"));
             ptr = float_to_string2(nozzleIndexToNozzleSize(nozzle), buffer + strlen(buffer), PSTR("="));
-            int_to_string(eeprom_read_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(n, nozzle)), ptr, PSTR("\n"));
+            int_to_string(eeprom_journal_read_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(n, nozzle)), ptr, PSTR("\n"));
             card.write_string(buffer);
         }
 
 #if TEMP_SENSOR_BED != 0
         strcpy_P(buffer, PSTR("bed_temperature="));
         ptr = buffer + strlen(buffer);
-        int_to_string(eeprom_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(n)), ptr, PSTR("\n"));
+        int_to_string(eeprom_journal_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(n)), ptr, PSTR("\n"));
         card.write_string(buffer);
 #endif
 
         strcpy_P(buffer, PSTR("fan_speed="));
         ptr = buffer + strlen(buffer);
-        int_to_string(eeprom_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(n)), ptr, PSTR("\n"));
+        int_to_string(eeprom_journal_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(n)), ptr, PSTR("\n"));
         card.write_string(buffer);
 
         strcpy_P(buffer, PSTR("flow="));
         ptr = buffer + strlen(buffer);
-        int_to_string(eeprom_read_word(EEPROM_MATERIAL_FLOW_OFFSET(n)), ptr, PSTR("\n"));
+        int_to_string(eeprom_journal_read_word(EEPROM_MATERIAL_FLOW_OFFSET(n)), ptr, PSTR("\n"));
         card.write_string(buffer);
 
         strcpy_P(buffer, PSTR("diameter="));
         ptr = buffer + strlen(buffer);
-        float_to_string2(eeprom_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(n)), ptr, PSTR("\n"));
+        float_to_string2(eeprom_journal_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(n)), ptr, PSTR("\n"));
         card.write_string(buffer);
 
 #ifdef USE_CHANGE_TEMPERATURE
         strcpy_P(buffer, PSTR("change_temp="));
         ptr = buffer + strlen(buffer);
-        float_to_string2(eeprom_read_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(n)), ptr, PSTR("\n"));
+        float_to_string2(eeprom_journal_read_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(n)), ptr, PSTR("\n"));
         card.write_string(buffer);
 
         strcpy_P(buffer, PSTR("change_wait="));
         ptr = buffer + strlen(buffer);
-        float_to_string2(eeprom_read_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(n)), ptr, PSTR("\n\n"));
+        float_to_string2(eeprom_journal_read_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(n)), ptr, PSTR("\n"));
+        card.write_string(buffer);
+#endif
+
+#ifdef LIN_ADVANCE
+        strcpy_P(buffer, PSTR("advance_k="));
+        ptr = buffer + strlen(buffer);
+        float_to_string2(eeprom_journal_read_float(EEPROM_MATERIAL_ADVANCE_K(n)), ptr, PSTR("\n"));
         card.write_string(buffer);
 #endif
+
+        strcpy_P(buffer, PSTR("\n"));
+        card.write_string(buffer);
     }
     card.closefile();
     menu.replace_menu(menu_t(lcd_menu_material_export_done));
@@ -652,6 +668,11 @@ static void lcd_menu_material_import()
         if(strcmp_P(buffer, PSTR("[material]")) == 0)
         {
             count++;
+#ifdef LIN_ADVANCE
+            //Files from before the advance setting leave it off
+            if (count < EEPROM_MATERIAL_SETTINGS_MAX_COUNT)
+                eeprom_journal_write_float(EEPROM_MATERIAL_ADVANCE_K(count), 0.0);
+#endif
         }else if (count < EEPROM_MATERIAL_SETTINGS_MAX_COUNT)
         {
             c = strchr(buffer, '=');
@@ -660,29 +681,34 @@ static void lcd_menu_material_import()
                 *c++ = '\0';
                 if (strcmp_P(buffer, PSTR("name")) == 0)
                 {
-                    eeprom_write_block(c, EEPROM_MATERIAL_NAME_OFFSET(count), MATERIAL_NAME_SIZE);
+                    eeprom_journal_write_block(c, EEPROM_MATERIAL_NAME_OFFSET(count), MATERIAL_NAME_SIZE);
                 }else if (strcmp_P(buffer, PSTR("temperature")) == 0)
                 {
-                    eeprom_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(count), strtol(c, NULL, 10));
+                    eeprom_journal_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(count), strtol(c, NULL, 10));
                 }else if (strcmp_P(buffer, PSTR("bed_temperature")) == 0)
                 {
-                    eeprom_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(count), strtol(c, NULL, 10));
+                    eeprom_journal_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(count), strtol(c, NULL, 10));
                 }else if (strcmp_P(buffer, PSTR("fan_speed")) == 0)
                 {
-                    eeprom_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(count), strtol(c, NULL, 10));
+                    eeprom_journal_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(count), strtol(c, NULL, 10));
                 }else if (strcmp_P(buffer, PSTR("flow")) == 0)
                 {
-                    eeprom_write_word(EEPROM_MATERIAL_FLOW_OFFSET(count), strtol(c, NULL, 10));
+                    eeprom_journal_write_word(EEPROM_MATERIAL_FLOW_OFFSET(count), strtol(c, NULL, 10));
                 }else if (strcmp_P(buffer, PSTR("diameter")) == 0)
                 {
-                    eeprom_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(count), strtod(c, NULL));
+                    eeprom_journal_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(count), strtod(c, NULL));
 #ifdef USE_CHANGE_TEMPERATURE
                 }else if (strcmp_P(buffer, PSTR("change_temp")) == 0)
                 {
-                    eeprom_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(count), strtol(c, NULL, 10));
+                    eeprom_journal_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(count), strtol(c, NULL, 10));
                 }else if (strcmp_P(buffer, PSTR("change_wait")) == 0)
                 {
-                    eeprom_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(count), strtol(c, NULL, 10));
+                    eeprom_journal_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(count), strtol(c, NULL, 10));
+#endif
+#ifdef LIN_ADVANCE
+                }else if (strcmp_P(buffer, PSTR("advance_k")) == 0)
+                {
+                    eeprom_journal_write_float(EEPROM_MATERIAL_ADVANCE_K(count), constrain(strtod(c, NULL), 0.0, LIN_ADVANCE_K_MAX));
 #endif
                 }
                 for(uint8_t nozzle=0; nozzle<MATERIAL_TEMPERATURE_COUNT; ++nozzle)
@@ -693,7 +719,7 @@ static void lcd_menu_material_import()
                     float_to_string2(nozzleIndexToNozzleSize(nozzle), ptr);
                     if (strcmp(buffer, buffer2) == 0)
                     {
-                        eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(count, nozzle), strtol(c, NULL, 10));
+                        eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(count, nozzle), strtol(c, NULL, 10));
                     }
                 }
             }
@@ -702,7 +728,7 @@ static void lcd_menu_material_import()
     count++;
     if (count > 0)
     {
-        eeprom_write_byte(EEPROM_MATERIAL_COUNT_OFFSET(), count);
+        eeprom_journal_write_byte(EEPROM_MATERIAL_COUNT_OFFSET(), count);
     }
     card.closefile();
 
@@ -711,7 +737,7 @@ static void lcd_menu_material_import()
 
 static void lcd_material_select_callback(uint8_t nr, uint8_t offsetY, uint8_t flags)
 {
-    uint8_t count = eeprom_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
+    uint8_t count = eeprom_journal_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
     char buffer[32] = {0};
     if (nr == 0)
         strcpy_P(buffer, PSTR("< RETURN"));
@@ -722,7 +748,7 @@ static void lcd_material_select_callback(uint8_t nr, uint8_t offsetY, uint8_t fl
     else if (nr == count + 3)
         strcpy_P(buffer, PSTR("Import from SD"));
     else{
-        eeprom_read_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(nr - 1), MATERIAL_NAME_SIZE);
+        eeprom_journal_read_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(nr - 1), MATERIAL_NAME_SIZE);
         buffer[MATERIAL_NAME_SIZE] = '\0';
     }
     lcd_draw_scroll_entry(offsetY, buffer, flags);
@@ -730,7 +756,7 @@ static void lcd_material_select_callback(uint8_t nr, uint8_t offsetY, uint8_t fl
 
 static void lcd_material_select_details_callback(uint8_t nr)
 {
-    uint8_t count = eeprom_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
+    uint8_t count = eeprom_journal_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
     if (nr == 0)
     {
 
@@ -743,21 +769,21 @@ static void lcd_material_select_details_callback(uint8_t nr)
 
         if (led_glow_dir)
         {
-            c = float_to_string2(eeprom_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(nr)), c, PSTR("mm"));
+            c = float_to_string2(eeprom_journal_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(nr)), c, PSTR("mm"));
             while(c < buffer + 10) *c++ = ' ';
             strcpy_P(c, PSTR("Flow:"));
             c += 5;
-            c = int_to_string(eeprom_read_word(EEPROM_MATERIAL_FLOW_OFFSET(nr)), c, PSTR("%"));
+            c = int_to_string(eeprom_journal_read_word(EEPROM_MATERIAL_FLOW_OFFSET(nr)), c, PSTR("%"));
         }else{
-            c = int_to_string(eeprom_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(nr)), c, PSTR("C"));
+            c = int_to_string(eeprom_journal_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(nr)), c, PSTR("C"));
 #if TEMP_SENSOR_BED != 0
             *c++ = ' ';
-            c = int_to_string(eeprom_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(nr)), c, PSTR("C"));
+            c = int_to_string(eeprom_journal_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(nr)), c, PSTR("C"));
 #endif
             while(c < buffer + 10) *c++ = ' ';
             strcpy_P(c, PSTR("Fan: "));
             c += 5;
-            c = int_to_string(eeprom_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(nr)), c, PSTR("%"));
+            c = int_to_string(eeprom_journal_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(nr)), c, PSTR("%"));
         }
         lcd_lib_draw_string_left(BOTTOM_MENU_YPOS, buffer);
     }else if (nr == count + 1)
@@ -774,7 +800,7 @@ static void lcd_material_select_details_callback(uint8_t nr)
 
 void lcd_menu_material_select()
 {
-    uint8_t count = eeprom_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
+    uint8_t count = eeprom_journal_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
 
     lcd_scroll_menu(PSTR("MATERIAL"), count + 4, lcd_material_select_callback, lcd_material_select_details_callback);
     if (lcd_lib_button_pressed)
@@ -826,15 +852,19 @@ static void lcd_material_settings_callback(uint8_t nr, uint8_t offsetY, uint8_t
         strcpy_P(buffer, PSTR("Fan"));
     else if (nr == 4 + BED_MENU_OFFSET)
         strcpy_P(buffer, PSTR("Flow %"));
-#ifdef USE_CHANGE_TEMPERATURE
+#ifdef LIN_ADVANCE
     else if (nr == 5 + BED_MENU_OFFSET)
+        strcpy_P(buffer, PSTR("Pressure advance"));
+#endif
+#ifdef USE_CHANGE_TEMPERATURE
+    else if (nr == 5 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET)
         strcpy_P(buffer, PSTR("Change temperature"));
-    else if (nr == 6 + BED_MENU_OFFSET)
+    else if (nr == 6 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET)
         strcpy_P(buffer, PSTR("Change wait time"));
-    else if (nr == 7 + BED_MENU_OFFSET)
+    else if (nr == 7 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET)
         strcpy_P(buffer, PSTR("Store as preset"));
 #else
-    else if (nr == 5 + BED_MENU_OFFSET)
+    else if (nr == 5 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET)
         strcpy_P(buffer, PSTR("Store as preset"));
 #endif
     else
@@ -875,11 +905,16 @@ static void lcd_material_settings_details_callback(uint8_t nr)
     }else if (nr == 4 + BED_MENU_OFFSET)
     {
         int_to_string(material[active_extruder].flow, buffer, PSTR("%"));
-#ifdef USE_CHANGE_TEMPERATURE
+#ifdef LIN_ADVANCE
     }else if (nr == 5 + BED_MENU_OFFSET)
+    {
+        float_to_string2(material[active_extruder].advance_k, buffer, PSTR("s"));
+#endif
+#ifdef USE_CHANGE_TEMPERATURE
+    }else if (nr == 5 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET)
     {
         int_to_string(material[active_extruder].change_temperature, buffer, PSTR("C"));
-    }else if (nr == 6 + BED_MENU_OFFSET)
+    }else if (nr == 6 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET)
     {
         int_to_string(material[active_extruder].change_preheat_wait_time, buffer, PSTR("Sec"));
 #endif
@@ -890,9 +925,9 @@ static void lcd_material_settings_details_callback(uint8_t nr)
 static void lcd_menu_material_settings()
 {
 #ifdef USE_CHANGE_TEMPERATURE
-    lcd_scroll_menu(PSTR("MATERIAL"), 8 + BED_MENU_OFFSET, lcd_material_settings_callback, lcd_material_settings_details_callback);
+    lcd_scroll_menu(PSTR("MATERIAL"), 8 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET, lcd_material_settings_callback, lcd_material_settings_details_callback);
 #else
-    lcd_scroll_menu(PSTR("MATERIAL"), 6 + BED_MENU_OFFSET, lcd_material_settings_callback, lcd_material_settings_details_callback);
+    lcd_scroll_menu(PSTR("MATERIAL"), 6 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET, lcd_material_settings_callback, lcd_material_settings_details_callback);
 #endif
     if (lcd_lib_button_pressed)
     {
@@ -915,15 +950,19 @@ static void lcd_menu_material_settings()
             LCD_EDIT_SETTING(material[active_extruder].fan_speed, "Fan speed", "%", 0, 100);
         else if (IS_SELECTED_SCROLL(4 + BED_MENU_OFFSET))
             LCD_EDIT_SETTING(material[active_extruder].flow, "Material flow", "%", 1, 1000);
-#ifdef USE_CHANGE_TEMPERATURE
+#ifdef LIN_ADVANCE
         else if (IS_SELECTED_SCROLL(5 + BED_MENU_OFFSET))
+            LCD_EDIT_SETTING_FLOAT001(material[active_extruder].advance_k, "Pressure advance", "s", 0, LIN_ADVANCE_K_MAX);
+#endif
+#ifdef USE_CHANGE_TEMPERATURE
+        else if (IS_SELECTED_SCROLL(5 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET))
             LCD_EDIT_SETTING(material[active_extruder].change_temperature, "Change temperature", "C", 0, get_maxtemp(active_extruder));
-        else if (IS_SELECTED_SCROLL(6 + BED_MENU_OFFSET))
+        else if (IS_SELECTED_SCROLL(6 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET))
             LCD_EDIT_SETTING(material[active_extruder].change_preheat_wait_time, "Change wait time", "sec", 0, 180);
-        else if (IS_SELECTED_SCROLL(7 + BED_MENU_OFFSET))
+        else if (IS_SELECTED_SCROLL(7 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET))
             menu.add_menu(menu_t(lcd_menu_material_settings_store));
 #else
-        else if (IS_SELECTED_SCROLL(5 + BED_MENU_OFFSET))
+        else if (IS_SELECTED_SCROLL(5 + BED_MENU_OFFSET + ADVANCE_MENU_OFFSET))
             menu.add_menu(menu_t(lcd_menu_material_settings_store));
 #endif
     }
@@ -977,14 +1016,14 @@ static void lcd_menu_material_temperature_settings()
 
 static void lcd_menu_material_settings_store_callback(uint8_t nr, uint8_t offsetY, uint8_t flags)
 {
-    uint8_t count = eeprom_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
+    uint8_t count = eeprom_journal_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
     char buffer[32] = {0};
     if (nr == 0)
         strcpy_P(buffer, PSTR("< RETURN"));
     else if (nr > count)
         strcpy_P(buffer, PSTR("New preset"));
     else{
-        eeprom_read_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(nr - 1), MATERIAL_NAME_SIZE);
+        eeprom_journal_read_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(nr - 1), MATERIAL_NAME_SIZE);
         buffer[MATERIAL_NAME_SIZE] = '\0';
     }
     lcd_draw_scroll_entry(offsetY, buffer, flags);
@@ -996,7 +1035,7 @@ static void lcd_menu_material_settings_store_details_callback(uint8_t nr)
 
 static void lcd_menu_material_settings_store()
 {
-    uint8_t count = eeprom_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
+    uint8_t count = eeprom_journal_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
     if (count == EEPROM_MATERIAL_SETTINGS_MAX_COUNT)
         count--;
     lcd_scroll_menu(PSTR("PRESETS"), 2 + count, lcd_menu_material_settings_store_callback, lcd_menu_material_settings_store_details_callback);
@@ -1010,8 +1049,8 @@ static void lcd_menu_material_settings_store()
             {
                 char buffer[9] = "CUSTOM";
                 int_to_string(idx - 1, buffer + 6);
-                eeprom_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(idx), MATERIAL_NAME_SIZE);
-                eeprom_write_byte(EEPROM_MATERIAL_COUNT_OFFSET(), idx + 1);
+                eeprom_journal_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(idx), MATERIAL_NAME_SIZE);
+                eeprom_journal_write_byte(EEPROM_MATERIAL_COUNT_OFFSET(), idx + 1);
             }
             lcd_material_store_material(idx);
         }
@@ -1026,87 +1065,96 @@ void lcd_material_reset_defaults()
     char buffer[MATERIAL_NAME_SIZE+1] = {0};
 
     strcpy_P(buffer, PSTR("PLA"));
-    eeprom_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(0), 4);
-    eeprom_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(0), 210);
-    eeprom_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(0), 60);
-    eeprom_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(0), 100);
-    eeprom_write_word(EEPROM_MATERIAL_FLOW_OFFSET(0), 100);
-    eeprom_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(0), 2.85);
-
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, 0), 210);//0.4
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, 1), 195);//0.25
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, 2), 230);//0.6
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, 3), 240);//0.8
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, 4), 240);//1.0
-
-    eeprom_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(0), 70);
-    eeprom_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(0), 30);
+    eeprom_journal_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(0), 4);
+    eeprom_journal_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(0), 210);
+    eeprom_journal_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(0), 60);
+    eeprom_journal_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(0), 100);
+    eeprom_journal_write_word(EEPROM_MATERIAL_FLOW_OFFSET(0), 100);
+    eeprom_journal_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(0), 2.85);
+
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, 0), 210);//0.4
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, 1), 195);//0.25
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, 2), 230);//0.6
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, 3), 240);//0.8
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, 4), 240);//1.0
+
+    eeprom_journal_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(0), 70);
+#ifdef LIN_ADVANCE
+    eeprom_journal_write_float(EEPROM_MATERIAL_ADVANCE_K(0), 0.0);
+#endif
+    eeprom_journal_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(0), 30);
 
     strcpy_P(buffer, PSTR("ABS"));
-    eeprom_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(1), 4);
-    eeprom_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(1), 260);
-    eeprom_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(1), 90);
-    eeprom_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(1), 100);
-    eeprom_write_word(EEPROM_MATERIAL_FLOW_OFFSET(1), 107);
-    eeprom_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(1), 2.85);
-
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, 0), 255);//0.4
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, 1), 245);//0.25
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, 2), 260);//0.6
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, 3), 260);//0.8
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, 4), 260);//1.0
-
-    eeprom_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(1), 90);
-    eeprom_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(1), 30);
+    eeprom_journal_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(1), 4);
+    eeprom_journal_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(1), 260);
+    eeprom_journal_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(1), 90);
+    eeprom_journal_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(1), 100);
+    eeprom_journal_write_word(EEPROM_MATERIAL_FLOW_OFFSET(1), 107);
+    eeprom_journal_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(1), 2.85);
+
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, 0), 255);//0.4
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, 1), 245);//0.25
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, 2), 260);//0.6
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, 3), 260);//0.8
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, 4), 260);//1.0
+
+    eeprom_journal_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(1), 90);
+#ifdef LIN_ADVANCE
+    eeprom_journal_write_float(EEPROM_MATERIAL_ADVANCE_K(1), 0.0);
+#endif
+    eeprom_journal_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(1), 30);
 
     strcpy_P(buffer, PSTR("CPE"));
-    eeprom_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(2), 4);
-    eeprom_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(2), 255);
-    eeprom_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(2), 60);
-    eeprom_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(2), 50);
-    eeprom_write_word(EEPROM_MATERIAL_FLOW_OFFSET(2), 100);
-    eeprom_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(2), 2.85);
-
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, 0), 255);//0.4
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, 1), 245);//0.25
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, 2), 260);//0.6
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, 3), 260);//0.8
-    eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, 4), 260);//1.0
-
-    eeprom_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(2), 85);
-    eeprom_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(2), 15);
+    eeprom_journal_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(2), 4);
+    eeprom_journal_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(2), 255);
+    eeprom_journal_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(2), 60);
+    eeprom_journal_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(2), 50);
+    eeprom_journal_write_word(EEPROM_MATERIAL_FLOW_OFFSET(2), 100);
+    eeprom_journal_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(2), 2.85);
+
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, 0), 255);//0.4
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, 1), 245);//0.25
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, 2), 260);//0.6
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, 3), 260);//0.8
+    eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, 4), 260);//1.0
+
+    eeprom_journal_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(2), 85);
+#ifdef LIN_ADVANCE
+    eeprom_journal_write_float(EEPROM_MATERIAL_ADVANCE_K(2), 0.0);
+#endif
+    eeprom_journal_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(2), 15);
 
-    eeprom_write_byte(EEPROM_MATERIAL_COUNT_OFFSET(), 3);
+    eeprom_journal_write_byte(EEPROM_MATERIAL_COUNT_OFFSET(), 3);
 
     for(uint8_t n=MATERIAL_TEMPERATURE_COUNT; n<MAX_MATERIAL_TEMPERATURES; ++n)
     {
-        eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, n), 0);
-        eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, n), 0);
-        eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, n), 0);
+        eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(0, n), 0);
+        eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(1, n), 0);
+        eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(2, n), 0);
     }
 }
 
 void lcd_material_set_material(uint8_t nr, uint8_t e)
 {
-    material[e].temperature[0] = eeprom_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(nr));
+    material[e].temperature[0] = eeprom_journal_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(nr));
     set_maxtemp(e, constrain(material[e].temperature[0] + 15, HEATER_0_MAXTEMP, min(HEATER_0_MAXTEMP + 15, material[e].temperature[0] + 15)));
 
 #if TEMP_SENSOR_BED != 0
-    material[e].bed_temperature = eeprom_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(nr));
+    material[e].bed_temperature = eeprom_journal_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(nr));
     if (material[e].bed_temperature > BED_MAXTEMP - 15)
         material[e].bed_temperature = BED_MAXTEMP - 15;
 #endif
-    material[e].flow = eeprom_read_word(EEPROM_MATERIAL_FLOW_OFFSET(nr));
+    material[e].flow = eeprom_journal_read_word(EEPROM_MATERIAL_FLOW_OFFSET(nr));
 
-    material[e].fan_speed = eeprom_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(nr));
-    material[e].diameter = eeprom_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(nr));
+    material[e].fan_speed = eeprom_journal_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(nr));
+    material[e].diameter = eeprom_journal_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(nr));
 
-    eeprom_read_block(material[e].name, EEPROM_MATERIAL_NAME_OFFSET(nr), MATERIAL_NAME_SIZE);
+    eeprom_journal_read_block(material[e].name, EEPROM_MATERIAL_NAME_OFFSET(nr), MATERIAL_NAME_SIZE);
     material[e].name[MATERIAL_NAME_SIZE] = '\0';
     strcpy(LCD_CACHE_FILENAME(0), material[e].name);
     for(uint8_t n=0; n<MAX_MATERIAL_TEMPERATURES; ++n)
     {
-        material[e].temperature[n] = eeprom_read_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(nr, n));
+        material[e].temperature[n] = eeprom_journal_read_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(nr, n));
 //        set_maxtemp(e, constrain(material[e].temperature[n] + 15, HEATER_0_MAXTEMP, min(max(get_maxtemp(e), HEATER_0_MAXTEMP + 15), material[e].temperature[n] + 15)));
         if (material[e].temperature[n] > get_maxtemp(e) - 15)
             material[e].temperature[n] = get_maxtemp(e) - 15;
@@ -1116,57 +1164,68 @@ void lcd_material_set_material(uint8_t nr, uint8_t e)
     if (material[e].bed_temperature > BED_MAXTEMP - 15)
         material[e].bed_temperature = BED_MAXTEMP - 15;
 #endif
-    material[e].change_temperature = eeprom_read_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(nr));
-    material[e].change_preheat_wait_time = eeprom_read_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(nr));
+    material[e].change_temperature = eeprom_journal_read_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(nr));
+    material[e].change_preheat_wait_time = eeprom_journal_read_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(nr));
     if ((material[e].change_temperature < 10) || (material[e].change_temperature > (get_maxtemp(e) - 15)))
         material[e].change_temperature = material[e].temperature[0];
+#ifdef LIN_ADVANCE
+    material[e].advance_k = eeprom_journal_read_float(EEPROM_MATERIAL_ADVANCE_K(nr));
+#endif
 
     lcd_material_store_current_material();
 }
 
 void lcd_material_store_material(uint8_t nr)
 {
-    eeprom_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(nr), material[active_extruder].temperature[0]);
+    eeprom_journal_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(nr), material[active_extruder].temperature[0]);
 #if TEMP_SENSOR_BED != 0
-    eeprom_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(nr), material[active_extruder].bed_temperature);
+    eeprom_journal_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(nr), material[active_extruder].bed_temperature);
 #endif
-    eeprom_write_word(EEPROM_MATERIAL_FLOW_OFFSET(nr), material[active_extruder].flow);
+    eeprom_journal_write_word(EEPROM_MATERIAL_FLOW_OFFSET(nr), material[active_extruder].flow);
 
-    eeprom_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(nr), material[active_extruder].fan_speed);
-    eeprom_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(nr), material[active_extruder].diameter);
+    eeprom_journal_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(nr), material[active_extruder].fan_speed);
+    eeprom_journal_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(nr), material[active_extruder].diameter);
     for(uint8_t n=0; n<MAX_MATERIAL_TEMPERATURES; ++n)
-        eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(nr, n), material[active_extruder].temperature[n]);
+        eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(nr, n), material[active_extruder].temperature[n]);
 
-    eeprom_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(nr), material[active_extruder].change_temperature);
-    eeprom_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(nr), material[active_extruder].change_preheat_wait_time);
+    eeprom_journal_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(nr), material[active_extruder].change_temperature);
+    eeprom_journal_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(nr), material[active_extruder].change_preheat_wait_time);
+#ifdef LIN_ADVANCE
+    eeprom_journal_write_float(EEPROM_MATERIAL_ADVANCE_K(nr), material[active_extruder].advance_k);
+#endif
 }
 
 void lcd_material_read_current_material()
 {
     for(uint8_t e=0; e<EXTRUDERS; ++e)
     {
-        material[e].temperature[0] = eeprom_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
+        material[e].temperature[0] = eeprom_journal_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
         set_maxtemp(e, constrain(material[e].temperature[0] + 15, HEATER_0_MAXTEMP, min(HEATER_0_MAXTEMP + 15, material[e].temperature[0] + 15)));
 #if TEMP_SENSOR_BED != 0
-        material[e].bed_temperature = eeprom_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
+        material[e].bed_temperature = eeprom_journal_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
 #endif
-        material[e].flow = eeprom_read_word(EEPROM_MATERIAL_FLOW_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
+        material[e].flow = eeprom_journal_read_word(EEPROM_MATERIAL_FLOW_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
 
-        material[e].fan_speed = eeprom_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
-        material[e].diameter = eeprom_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
+        material[e].fan_speed = eeprom_journal_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
+        material[e].diameter = eeprom_journal_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
         for(uint8_t n=0; n<MAX_MATERIAL_TEMPERATURES; ++n)
         {
-            material[e].temperature[n] = eeprom_read_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e, n));
+            material[e].temperature[n] = eeprom_journal_read_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e, n));
             // set_maxtemp(e, constrain(material[e].temperature[n] + 15, HEATER_0_MAXTEMP, min(HEATER_0_MAXTEMP + 15, material[e].temperature[n] + 15)));
         }
 
-        eeprom_read_block(material[e].name, EEPROM_MATERIAL_NAME_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), MATERIAL_NAME_SIZE);
+        eeprom_journal_read_block(material[e].name, EEPROM_MATERIAL_NAME_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), MATERIAL_NAME_SIZE);
         material[e].name[MATERIAL_NAME_SIZE] = '\0';
 
-        material[e].change_temperature = eeprom_read_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
-        material[e].change_preheat_wait_time = eeprom_read_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
+        material[e].change_temperature = eeprom_journal_read_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
+        material[e].change_preheat_wait_time = eeprom_journal_read_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
         if ((material[e].change_temperature < 10) || (material[e].change_temperature > (get_maxtemp(e) - 15)))
             material[e].change_temperature = material[e].temperature[0];
+#ifdef LIN_ADVANCE
+        material[e].advance_k = eeprom_journal_read_float(EEPROM_MATERIAL_ADVANCE_K(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e));
+        if (!(material[e].advance_k >= 0.0 && material[e].advance_k <= LIN_ADVANCE_K_MAX))
+            material[e].advance_k = 0.0;
+#endif
     }
 }
 
@@ -1174,26 +1233,29 @@ void lcd_material_store_current_material()
 {
     for(uint8_t e=0; e<EXTRUDERS; ++e)
     {
-        eeprom_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].temperature[0]);
+        eeprom_journal_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].temperature[0]);
         set_maxtemp(e, constrain(material[e].temperature[0] + 15, HEATER_0_MAXTEMP, min(HEATER_0_MAXTEMP + 15, material[e].temperature[0] + 15)));
 #if TEMP_SENSOR_BED != 0
-        eeprom_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].bed_temperature);
+        eeprom_journal_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].bed_temperature);
 #endif
-        eeprom_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].fan_speed);
-        eeprom_write_word(EEPROM_MATERIAL_FLOW_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].flow);
-        eeprom_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].diameter);
+        eeprom_journal_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].fan_speed);
+        eeprom_journal_write_word(EEPROM_MATERIAL_FLOW_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].flow);
+        eeprom_journal_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].diameter);
 
         for(uint8_t n=0; n<MAX_MATERIAL_TEMPERATURES; ++n)
         {
-            eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e, n), material[e].temperature[n]);
+            eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e, n), material[e].temperature[n]);
             // set_maxtemp(e, constrain(material[e].temperature[n] + 15, HEATER_0_MAXTEMP, min(max(get_maxtemp(e), HEATER_0_MAXTEMP + 15), material[e].temperature[n] + 15)));
         }
 
-        eeprom_write_block(material[e].name, EEPROM_MATERIAL_NAME_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), MATERIAL_NAME_SIZE);
+        eeprom_journal_write_block(material[e].name, EEPROM_MATERIAL_NAME_OFFSET(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), MATERIAL_NAME_SIZE);
 
 
-        eeprom_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].change_temperature);
-        eeprom_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].change_preheat_wait_time);
+        eeprom_journal_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].change_temperature);
+        eeprom_journal_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].change_preheat_wait_time);
+#ifdef LIN_ADVANCE
+        eeprom_journal_write_float(EEPROM_MATERIAL_ADVANCE_K(EEPROM_MATERIAL_SETTINGS_MAX_COUNT+e), material[e].advance_k);
+#endif
     }
 }
 
@@ -1202,92 +1264,103 @@ bool lcd_material_verify_material_settings()
     bool hasCPE = false;
     char buffer[MATERIAL_NAME_SIZE+1] = {0};
 
-    uint8_t cnt = eeprom_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
+    uint8_t cnt = eeprom_journal_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
     if (cnt < 2 || cnt > EEPROM_MATERIAL_SETTINGS_MAX_COUNT)
         return false;
     while(cnt > 0)
     {
         cnt --;
-        if (eeprom_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(cnt)) > HEATER_0_MAXTEMP)
+        if (eeprom_journal_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(cnt)) > HEATER_0_MAXTEMP)
             return false;
 #if TEMP_SENSOR_BED != 0
-        if (eeprom_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(cnt)) > BED_MAXTEMP)
+        if (eeprom_journal_read_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(cnt)) > BED_MAXTEMP)
             return false;
 #endif
-        if (eeprom_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(cnt)) > 100)
+        if (eeprom_journal_read_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(cnt)) > 100)
             return false;
-        if (eeprom_read_word(EEPROM_MATERIAL_FLOW_OFFSET(cnt)) > 1000)
+        if (eeprom_journal_read_word(EEPROM_MATERIAL_FLOW_OFFSET(cnt)) > 1000)
             return false;
-        if (eeprom_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(cnt)) > 10.0)
+        if (eeprom_journal_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(cnt)) > 10.0)
             return false;
-        if (eeprom_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(cnt)) < 0.1)
+        if (eeprom_journal_read_float(EEPROM_MATERIAL_DIAMETER_OFFSET(cnt)) < 0.1)
             return false;
 
         for(uint8_t n=0; n<MATERIAL_TEMPERATURE_COUNT; ++n)
         {
-            if (eeprom_read_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, n)) > HEATER_0_MAXTEMP)
+            if (eeprom_journal_read_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, n)) > HEATER_0_MAXTEMP)
                 return false;
-            if (eeprom_read_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, n)) == 0)
+            if (eeprom_journal_read_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, n)) == 0)
                 return false;
         }
 
-        eeprom_read_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(cnt), MATERIAL_NAME_SIZE);
+        eeprom_journal_read_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(cnt), MATERIAL_NAME_SIZE);
         buffer[MATERIAL_NAME_SIZE] = '\0';
         if (strcmp_P(buffer, PSTR("UPET")) == 0)
         {
             strcpy_P(buffer, PSTR("CPE"));
-            eeprom_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(cnt), 4);
+            eeprom_journal_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(cnt), 4);
         }
         if (strcmp_P(buffer, PSTR("CPE")) == 0)
         {
             hasCPE = true;
         }
 
-        if (eeprom_read_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt)) > HEATER_0_MAXTEMP || eeprom_read_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt)) < 10)
+        if (eeprom_journal_read_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt)) > HEATER_0_MAXTEMP || eeprom_journal_read_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt)) < 10)
         {
             //Invalid temperature for change temperature.
             if (strcmp_P(buffer, PSTR("PLA")) == 0)
             {
-                eeprom_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt), 70);
-                eeprom_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(cnt), 30);
+                eeprom_journal_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt), 70);
+                eeprom_journal_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(cnt), 30);
             }
             else if (strcmp_P(buffer, PSTR("ABS")) == 0)
             {
-                eeprom_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt), 90);
-                eeprom_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(cnt), 30);
+                eeprom_journal_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt), 90);
+                eeprom_journal_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(cnt), 30);
             }
             else if (strcmp_P(buffer, PSTR("CPE")) == 0)
             {
-                eeprom_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt), 85);
-                eeprom_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(cnt), 15);
+                eeprom_journal_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt), 85);
+                eeprom_journal_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(cnt), 15);
             }
             else
             {
-                eeprom_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt), eeprom_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(cnt)));
-                eeprom_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(cnt), 5);
+                eeprom_journal_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt), eeprom_journal_read_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(cnt)));
+                eeprom_journal_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(cnt), 5);
             }
         }
+#ifdef LIN_ADVANCE
+        float k = eeprom_journal_read_float(EEPROM_MATERIAL_ADVANCE_K(cnt));
+        if (!(k >= 0.0 && k <= LIN_ADVANCE_K_MAX))
+        {
+            //Not set before, or invalid. Start without advance.
+            eeprom_journal_write_float(EEPROM_MATERIAL_ADVANCE_K(cnt), 0.0);
+        }
+#endif
     }
-    cnt = eeprom_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
+    cnt = eeprom_journal_read_byte(EEPROM_MATERIAL_COUNT_OFFSET());
     if (!hasCPE && cnt < EEPROM_MATERIAL_SETTINGS_MAX_COUNT)
     {
         strcpy_P(buffer, PSTR("CPE"));
-        eeprom_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(cnt), 4);
-        eeprom_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(cnt), 250);
-        eeprom_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(cnt), 60);
-        eeprom_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(cnt), 50);
-        eeprom_write_word(EEPROM_MATERIAL_FLOW_OFFSET(cnt), 100);
-        eeprom_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(cnt), 2.85);
-        eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, 0), 255);//0.4
-        eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, 1), 245);//0.25
-        eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, 2), 260);//0.6
-        eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, 3), 260);//0.8
-        eeprom_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, 4), 260);//1.0
-
-        eeprom_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt), 85);
-        eeprom_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(cnt), 15);
-
-        eeprom_write_byte(EEPROM_MATERIAL_COUNT_OFFSET(), cnt + 1);
+        eeprom_journal_write_block(buffer, EEPROM_MATERIAL_NAME_OFFSET(cnt), 4);
+        eeprom_journal_write_word(EEPROM_MATERIAL_TEMPERATURE_OFFSET(cnt), 250);
+        eeprom_journal_write_word(EEPROM_MATERIAL_BED_TEMPERATURE_OFFSET(cnt), 60);
+        eeprom_journal_write_byte(EEPROM_MATERIAL_FAN_SPEED_OFFSET(cnt), 50);
+        eeprom_journal_write_word(EEPROM_MATERIAL_FLOW_OFFSET(cnt), 100);
+        eeprom_journal_write_float(EEPROM_MATERIAL_DIAMETER_OFFSET(cnt), 2.85);
+        eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, 0), 255);//0.4
+        eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, 1), 245);//0.25
+        eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, 2), 260);//0.6
+        eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, 3), 260);//0.8
+        eeprom_journal_write_word(EEPROM_MATERIAL_EXTRA_TEMPERATURE_OFFSET(cnt, 4), 260);//1.0
+
+        eeprom_journal_write_word(EEPROM_MATERIAL_CHANGE_TEMPERATURE(cnt), 85);
+        eeprom_journal_write_byte(EEPROM_MATERIAL_CHANGE_WAIT_TIME(cnt), 15);
+#ifdef LIN_ADVANCE
+        eeprom_journal_write_float(EEPROM_MATERIAL_ADVANCE_K(cnt), 0.0);
+#endif
+
+        eeprom_journal_write_byte(EEPROM_MATERIAL_COUNT_OFFSET(), cnt + 1);
     }
     return true;
 }
@@ -11,6 +11,7 @@ Tinker settings    0x0401-
 RuntimeStats:      0x0700-0x071C 0x1C
 Materials:         0x0800-0x09B1 (8+16)*18+1=0x1B1
 ExtraTemperatures: 0x0a00-0x0C40 (16*18*2)=0x240
+AdvanceK:          0x0D50-0x0D98 (18*4)=0x48
 */
 
 //Introducing extra set of material temperatures, one for each possible nozzle.
@@ -33,6 +34,9 @@ struct materialSettings
     char name[MATERIAL_NAME_SIZE+1];
     int16_t change_temperature;      //Temperature for the hotend during the change material procedure.
     int8_t change_preheat_wait_time; //when reaching the change material temperature, wait for this amount of seconds for the temperature to stabalize and the material to heatup.
+#ifdef LIN_ADVANCE
+    float advance_k;                 //Linear pressure advance K in seconds, 0 is off.
+#endif
 };
 
 extern struct materialSettings material[EXTRUDERS];
@@ -50,6 +54,7 @@ extern struct materialSettings material[EXTRUDERS];
 #define EEPROM_MATERIAL_EXTRA_TEMPERATURES_OFFSET 0xa00
 #define EEPROM_MATERIAL_CHANGE_TEMPERATURE_OFFSET 0xD00
 #define EEPROM_MATERIAL_CHANGE_WAIT_TIME_OFFSET 0xD30
+#define EEPROM_MATERIAL_ADVANCE_K_OFFSET 0xD50
 #define EEPROM_MATERIAL_SETTINGS_MAX_COUNT 16
 #define EEPROM_MATERIAL_SETTINGS_SIZE   (8 + 16)
 #define EEPROM_MATERIAL_COUNT_OFFSET()            ((uint8_t*)(EEPROM_MATERIAL_SETTINGS_OFFSET + 0))
@@ -63,6 +68,7 @@ extern struct materialSettings material[EXTRUDERS];
 
 #define EEPROM_MATERIAL_CHANGE_TEMPERATURE(n)     ((uint16_t*)(EEPROM_MATERIAL_CHANGE_TEMPERATURE_OFFSET + uint16_t(n) * 2))
 #define EEPROM_MATERIAL_CHANGE_WAIT_TIME(n)       ((uint8_t*)(EEPROM_MATERIAL_CHANGE_WAIT_TIME_OFFSET + uint16_t(n)))
+#define EEPROM_MATERIAL_ADVANCE_K(n)              ((float*)(EEPROM_MATERIAL_ADVANCE_K_OFFSET + uint16_t(n) * 4))
 
 void lcd_menu_material_main();
 bool lcd_material_verify_material_settings();
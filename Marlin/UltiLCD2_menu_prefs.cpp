@@ -297,8 +297,8 @@ void lcd_menu_sleeptimer()
 
 static void lcd_store_axislimit()
 {
-    eeprom_write_block(min_pos, (uint8_t *)EEPROM_AXIS_LIMITS, sizeof(min_pos));
-    eeprom_write_block(max_pos, (uint8_t *)(EEPROM_AXIS_LIMITS+sizeof(min_pos)), sizeof(max_pos));
+    eeprom_journal_write_block(min_pos, (uint8_t *)EEPROM_AXIS_LIMITS, sizeof(min_pos));
+    eeprom_journal_write_block(max_pos, (uint8_t *)(EEPROM_AXIS_LIMITS+sizeof(min_pos)), sizeof(max_pos));
     menu.return_to_previous();
 }
 
@@ -2148,7 +2148,7 @@ void lcd_menu_swap_extruder()
 
 static void lcd_store_pid2()
 {
-    eeprom_write_block(pid2, (uint8_t *)(EEPROM_PID_2), sizeof(pid2));
+    eeprom_journal_write_block(pid2, (uint8_t *)(EEPROM_PID_2), sizeof(pid2));
     menu.return_to_previous();
 }
 
@@ -2625,6 +2625,7 @@ static bool autotune_callback(uint8_t state, uint8_t cycle, float kp, float ki,
                 bedKd = scalePID_d(kd);
             }
 #endif
+            updatePID();
             menu.set_selection(0);
         }
         return (state == 0);
@@ -2701,6 +2702,7 @@ static void lcd_preset_e1_kd()
     if (lcd_tune_value(FLOAT_SETTING(2), 0.0f, 999.99f, 0.01f))
     {
         Kd = scalePID_d(FLOAT_SETTING(2));
+        updatePID();
     }
 }
 
@@ -2709,12 +2711,16 @@ static void lcd_preset_e1_ki()
     if (lcd_tune_value(FLOAT_SETTING(1), 0.0f, 999.99f, 0.01f))
     {
         Ki = scalePID_i(FLOAT_SETTING(1));
+        updatePID();
     }
 }
 
 static void lcd_preset_e1_kp()
 {
-    lcd_tune_value(Kp, 0.0f, 999.99f, 0.01f);
+    if (lcd_tune_value(Kp, 0.0f, 999.99f, 0.01f))
+    {
+        updatePID();
+    }
 }
 
 static const menu_t & get_temp_e1_menuoption(uint8_t nr, menu_t &opt)
@@ -2915,6 +2921,7 @@ static void lcd_preset_e2_kd()
     if (lcd_tune_value(FLOAT_SETTING(2), 0.0f, 999.99f, 0.01f))
     {
         pid2[2] = scalePID_d(FLOAT_SETTING(2));
+        updatePID();
     }
 }
 
@@ -2923,12 +2930,16 @@ static void lcd_preset_e2_ki()
     if (lcd_tune_value(FLOAT_SETTING(1), 0.0f, 999.99f, 0.01f))
     {
         pid2[1] = scalePID_i(FLOAT_SETTING(1));
+        updatePID();
     }
 }
 
 static void lcd_preset_e2_kp()
 {
-    lcd_tune_value(pid2[0], 0.0f, 999.99f, 0.01f);
+    if (lcd_tune_value(pid2[0], 0.0f, 999.99f, 0.01f))
+    {
+        updatePID();
+    }
 }
 
 static const menu_t & get_temp_e2_menuoption(uint8_t nr, menu_t &opt)
@@ -3124,7 +3135,7 @@ static void lcd_store_pidbed()
     pidBed[0] = bedKp;
     pidBed[1] = bedKi;
     pidBed[2] = bedKd;
-    eeprom_write_block(pidBed, (uint8_t*)EEPROM_PID_BED, sizeof(pidBed));
+    eeprom_journal_write_block(pidBed, (uint8_t*)EEPROM_PID_BED, sizeof(pidBed));
 
     SET_CONTROL_FLAGS(control_flags);
     menu.return_to_previous();
@@ -3149,6 +3160,7 @@ static void lcd_preset_bed_kd()
     if (lcd_tune_value(FLOAT_SETTING(2), 0.0f, 999.99f, 0.01f))
     {
         bedKd = scalePID_d(FLOAT_SETTING(2));
+        updatePID();
     }
 }
 
@@ -3157,12 +3169,16 @@ static void lcd_preset_bed_ki()
     if (lcd_tune_value(FLOAT_SETTING(1), 0.0f, 999.99f, 0.01f))
     {
         bedKi = scalePID_i(FLOAT_SETTING(1));
+        updatePID();
     }
 }
 
 static void lcd_preset_bed_kp()
 {
-    lcd_tune_value(bedKp, 0.0f, 999.99f, 0.01f);
+    if (lcd_tune_value(bedKp, 0.0f, 999.99f, 0.01f))
+    {
+        updatePID();
+    }
 }
 
 static const menu_t & get_temp_bed_menuoption(uint8_t nr, menu_t &opt)
@@ -38,10 +38,44 @@ void lcd_clear_cache()
         LCD_CACHE_ID(n) = 0xFF;
     for(uint8_t n=0; n<LCD_CACHE_REMAIN_COUNT; ++n)
         LCD_CACHE_REMAIN_ID(n) = 0xFF;
-    LCD_DETAIL_CACHE_ID() = 0;
+    for(uint8_t n=0; n<LCD_DETAIL_CACHE_COUNT; ++n)
+        LCD_DETAIL_CACHE_ENTRY(n)[0] = 0;
     LCD_CACHE_NR_OF_FILES() = 0xFF;
 }
 
+// Make the cached details of file nr the first detail cache entry. Returns false if they are not cached.
+static bool lcd_detail_cache_select(uint8_t nr)
+{
+    for(uint8_t n=1; n<LCD_DETAIL_CACHE_COUNT; ++n)
+    {
+        if (LCD_DETAIL_CACHE_ENTRY(n)[0] == nr)
+        {
+            uint8_t entry[LCD_DETAIL_CACHE_SIZE];
+            memcpy(entry, LCD_DETAIL_CACHE_ENTRY(n), LCD_DETAIL_CACHE_SIZE);
+            memmove(LCD_DETAIL_CACHE_ENTRY(1), LCD_DETAIL_CACHE_ENTRY(0), n * LCD_DETAIL_CACHE_SIZE);
+            memcpy(LCD_DETAIL_CACHE_ENTRY(0), entry, LCD_DETAIL_CACHE_SIZE);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Make room for the details of file nr as the first detail cache entry, dropping the least recently selected one.
+static void lcd_detail_cache_add(uint8_t nr)
+{
+    // an entry with a read error is not worth keeping
+    if (LCD_DETAIL_CACHE_ID() != 0xFF)
+        memmove(LCD_DETAIL_CACHE_ENTRY(1), LCD_DETAIL_CACHE_ENTRY(0), (LCD_DETAIL_CACHE_COUNT - 1) * LCD_DETAIL_CACHE_SIZE);
+    LCD_DETAIL_CACHE_ID() = nr;
+    LCD_DETAIL_CACHE_TIME() = 0;
+    for(uint8_t e=0; e<EXTRUDERS; e++)
+    {
+        LCD_DETAIL_CACHE_MATERIAL(e) = 0;
+        LCD_DETAIL_CACHE_NOZZLE_DIAMETER(e) = 0.4;
+        LCD_DETAIL_CACHE_MATERIAL_TYPE(e)[0] = '\0';
+    }
+}
+
 void abortPrint(bool bQuickstop)
 {
     clear_command_queue();
@@ -338,7 +372,7 @@ void lcd_sd_menu_details_callback(uint8_t nr)
                 lcd_lib_draw_string_centerP(BOTTOM_MENU_YPOS, PSTR("Folder"));
             }else{
                 char buffer[64];
-                if (LCD_DETAIL_CACHE_ID() != nr)
+                if (LCD_DETAIL_CACHE_ID() != nr && !lcd_detail_cache_select(nr))
                 {
                     card.getfilename(nr - 1);
                     if (card.errorCode())
@@ -346,55 +380,59 @@ void lcd_sd_menu_details_callback(uint8_t nr)
                         card.clearError();
                         return;
                     }
-                    LCD_DETAIL_CACHE_ID() = nr;
-                    LCD_DETAIL_CACHE_TIME() = 0;
-                    for(uint8_t e=0; e<EXTRUDERS; e++)
-                    {
-                        LCD_DETAIL_CACHE_MATERIAL(e) = 0;
-                        LCD_DETAIL_CACHE_NOZZLE_DIAMETER(e) = 0.4;
-                        LCD_DETAIL_CACHE_MATERIAL_TYPE(e)[0] = '\0';
-                    }
-                    card.openFile(card.currentFileName(), true);
-                    if (card.isFileOpen())
+                    lcd_detail_cache_add(nr);
+#ifdef SD_DETAIL_INDEX
+                    if (!card.readDetailIndex(&LCD_DETAIL_CACHE_ENTRY(0)[1], LCD_DETAIL_CACHE_SIZE - 1))
+#endif
                     {
-                        for(uint8_t n=0;n<16;n++)
+                        card.openFile(card.currentFileName(), true);
+                        if (card.isFileOpen())
                         {
-                            card.fgets(buffer, sizeof(buffer));
-                            buffer[sizeof(buffer)-1] = '\0';
-                            while (strlen(buffer) > 0 && buffer[strlen(buffer)-1] < ' ') buffer[strlen(buffer)-1] = '\0';
-                            if (strncmp_P(buffer, PSTR(";TIME:"), 6) == 0)
-                                LCD_DETAIL_CACHE_TIME() = strtol(buffer + 6, 0, 0);
-                            else if (strncmp_P(buffer, PSTR(";MATERIAL:"), 10) == 0)
+                            for(uint8_t n=0;n<16;n++)
                             {
-                                LCD_DETAIL_CACHE_MATERIAL(0) = strtol(buffer + 10, 0, 10);
-                            }
-                            else if (strncmp_P(buffer, PSTR(";NOZZLE_DIAMETER:"), 17) == 0)
-                                LCD_DETAIL_CACHE_NOZZLE_DIAMETER(0) = strtod(buffer + 17, NULL);
-                            else if (strncmp_P(buffer, PSTR(";MTYPE:"), 7) == 0)
-                            {
-                                strncpy(LCD_DETAIL_CACHE_MATERIAL_TYPE(0), buffer + 7, 8);
-                                LCD_DETAIL_CACHE_MATERIAL_TYPE(0)[7] = '\0';
-                            }
+                                card.fgets(buffer, sizeof(buffer));
+                                buffer[sizeof(buffer)-1] = '\0';
+                                while (strlen(buffer) > 0 && buffer[strlen(buffer)-1] < ' ') buffer[strlen(buffer)-1] = '\0';
+                                if (strncmp_P(buffer, PSTR(";TIME:"), 6) == 0)
+                                    LCD_DETAIL_CACHE_TIME() = strtol(buffer + 6, 0, 0);
+                                else if (strncmp_P(buffer, PSTR(";MATERIAL:"), 10) == 0)
+                                {
+                                    LCD_DETAIL_CACHE_MATERIAL(0) = strtol(buffer + 10, 0, 10);
+                                }
+                                else if (strncmp_P(buffer, PSTR(";NOZZLE_DIAMETER:"), 17) == 0)
+                                    LCD_DETAIL_CACHE_NOZZLE_DIAMETER(0) = strtod(buffer + 17, NULL);
+                                else if (strncmp_P(buffer, PSTR(";MTYPE:"), 7) == 0)
+                                {
+                                    strncpy(LCD_DETAIL_CACHE_MATERIAL_TYPE(0), buffer + 7, 8);
+                                    LCD_DETAIL_CACHE_MATERIAL_TYPE(0)[7] = '\0';
+                                }
 #if EXTRUDERS > 1
-                            else if (strncmp_P(buffer, PSTR(";MATERIAL2:"), 11) == 0)
-                            {
-                                LCD_DETAIL_CACHE_MATERIAL(1) = strtol(buffer + 11, 0, 10);
-                            }
-                            else if (strncmp_P(buffer, PSTR(";NOZZLE_DIAMETER2:"), 18) == 0)
-                                LCD_DETAIL_CACHE_NOZZLE_DIAMETER(1) = strtod(buffer + 18, NULL);
-                            else if (strncmp_P(buffer, PSTR(";MTYPE2:"), 8) == 0)
-                            {
-                                strncpy(LCD_DETAIL_CACHE_MATERIAL_TYPE(1), buffer + 8, 8);
-                                LCD_DETAIL_CACHE_MATERIAL_TYPE(1)[7] = '\0';
-                            }
+                                else if (strncmp_P(buffer, PSTR(";MATERIAL2:"), 11) == 0)
+                                {
+                                    LCD_DETAIL_CACHE_MATERIAL(1) = strtol(buffer + 11, 0, 10);
+                                }
+                                else if (strncmp_P(buffer, PSTR(";NOZZLE_DIAMETER2:"), 18) == 0)
+                                    LCD_DETAIL_CACHE_NOZZLE_DIAMETER(1) = strtod(buffer + 18, NULL);
+                                else if (strncmp_P(buffer, PSTR(";MTYPE2:"), 8) == 0)
+                                {
+                                    strncpy(LCD_DETAIL_CACHE_MATERIAL_TYPE(1), buffer + 8, 8);
+                                    LCD_DETAIL_CACHE_MATERIAL_TYPE(1)[7] = '\0';
+                                }
 #endif
+                            }
                         }
-                    }
-                    if (card.errorCode())
-                    {
-                        //On a read error reset the file position and try to keep going. (not pretty, but these read errors are annoying as hell)
-                        card.clearError();
-                        LCD_DETAIL_CACHE_ID() = 0xFF;
+                        if (card.errorCode())
+                        {
+                            //On a read error reset the file position and try to keep going. (not pretty, but these read errors are annoying as hell)
+                            card.clearError();
+                            LCD_DETAIL_CACHE_ID() = 0xFF;
+                        }
+#ifdef SD_DETAIL_INDEX
+                        else
+                        {
+                            card.writeDetailIndex(&LCD_DETAIL_CACHE_ENTRY(0)[1], LCD_DETAIL_CACHE_SIZE - 1);
+                        }
+#endif
                     }
                 }
 
@@ -594,6 +632,9 @@ void lcd_menu_print_select()
                             fanSpeedPercent = max(fanSpeedPercent, material[e].fan_speed);
                             volume_to_filament_length[e] = 1.0 / (M_PI * (material[e].diameter / 2.0) * (material[e].diameter / 2.0));
                             extrudemultiply[e] = material[e].flow;
+#ifdef LIN_ADVANCE
+                            extruder_advance_k[e] = material[e].advance_k;
+#endif
                         }
 
                         if (printing_state == PRINT_STATE_RECOVER)
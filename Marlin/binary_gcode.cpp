@@ -0,0 +1,96 @@
+#include <string.h>
+#include "binary_gcode.h"
+
+//Position of the previous record in 1/BGCODE_SCALE mm, the base of the changes in the next one.
+static int32_t bgcode_position[4];
+
+static uint8_t value_count(uint8_t header)
+{
+    uint8_t count = (header & BGCODE_NUMBERED) ? 1 : 0;
+    for(uint8_t flag=BGCODE_F; flag; flag >>= 1)
+        if (header & flag)
+            count++;
+    return count;
+}
+
+static const uint8_t* read_varint(const uint8_t* data, uint32_t& value)
+{
+    value = 0;
+    for(uint8_t shift=0; ; shift += 7)
+    {
+        if (shift < 32)
+            value |= uint32_t(*data & 0x7F) << shift;
+        if (!(*data++ & 0x80))
+            return data;
+    }
+}
+
+uint8_t bgcode_length(const uint8_t* record, uint8_t size)
+{
+    uint8_t count = value_count(record[0]);
+    uint8_t n = 1;
+    while(count)
+    {
+        if (n >= size)
+            return 0;
+        if (!(record[n++] & 0x80))
+            count--;
+    }
+    //And the checksum
+    if (n >= size)
+        return 0;
+    return n + 1;
+}
+
+bool bgcode_checksum_ok(const uint8_t* record, uint8_t length)
+{
+    uint8_t checksum = 0;
+    for(uint8_t n=0; n<length - 1; n++)
+        checksum ^= record[n];
+    return checksum == record[length - 1];
+}
+
+uint32_t bgcode_line_number(const uint8_t* record)
+{
+    uint32_t value = 0;
+    if (record[0] & BGCODE_NUMBERED)
+        read_varint(record + 1, value);
+    return value;
+}
+
+uint8_t bgcode_decode(const uint8_t* record, float* position, float& feedrate)
+{
+    uint8_t header = *record++;
+    uint32_t value;
+    if (header & BGCODE_NUMBERED)
+        record = read_varint(record, value);
+    for(uint8_t i=0; i<4; i++)
+    {
+        if (!(header & (1 << i)))
+            continue;
+        record = read_varint(record, value);
+        int32_t v = int32_t(value >> 1) ^ -int32_t(value & 1);
+        if (header & BGCODE_ABSOLUTE)
+            bgcode_position[i] = v;
+        else
+            bgcode_position[i] += v;
+        //Divide, so the result is the same float as reading the decimal number of a g-code line.
+        position[i] = float(bgcode_position[i]) / BGCODE_SCALE;
+    }
+    if (header & BGCODE_F)
+    {
+        read_varint(record, value);
+        feedrate = float(value) / BGCODE_SCALE;
+    }
+    return header & (BGCODE_AXES | BGCODE_F);
+}
+
+void bgcode_get_position(int32_t* position)
+{
+    memcpy(position, bgcode_position, sizeof(bgcode_position));
+}
+
+void bgcode_set_position(const int32_t* position)
+{
+    memcpy(bgcode_position, position, sizeof(bgcode_position));
+}
@@ -0,0 +1,36 @@
+#ifndef BINARY_GCODE_H
+#define BINARY_GCODE_H
+
+#include <stdint.h>
+
+//Compact encoding of G1 moves, accepted over serial and from SD files in between normal g-code lines.
+// binary_gcode.py converts a g-code file. A record is:
+//  header       BGCODE_MARKER and the flags below. No g-code line starts with a byte that has bit 7 set.
+//  line number  unsigned varint, only with BGCODE_NUMBERED. Checked like the N of a g-code line over serial.
+//  X, Y, Z, E   signed varint in 1/BGCODE_SCALE mm, the change from the previous record, or the position with
+//               BGCODE_ABSOLUTE. Only the axes flagged in the header are present. The positions are absolute g-code
+//               coordinates, the relative modes do not apply.
+//  F            unsigned varint in 1/BGCODE_SCALE mm/min, when flagged.
+//  checksum     XOR of all bytes before it.
+//A varint holds 7 bits per byte, lowest first, with bit 7 set in every byte but the last. Signed values are zigzag
+// encoded (0, -1, 1, -2, ... as 0, 1, 2, 3, ...).
+#define BGCODE_MARKER     0x80
+#define BGCODE_NUMBERED   0x40
+#define BGCODE_ABSOLUTE   0x20
+#define BGCODE_F          0x10
+#define BGCODE_AXES       0x0F//Bit n for axis n (X, Y, Z, E)
+#define BGCODE_SCALE      1000
+#define BGCODE_MAX_LENGTH 32//Header, 6 varints of up to 5 bytes and checksum
+
+//Length of the record at the start of the buffer if the first size bytes hold all of it, 0 if it needs more bytes.
+uint8_t bgcode_length(const uint8_t* record, uint8_t size);
+bool bgcode_checksum_ok(const uint8_t* record, uint8_t length);
+uint32_t bgcode_line_number(const uint8_t* record);
+//Store the values of the record in position (X, Y, Z, E) and feedrate, the others are not touched.
+// Returns the BGCODE_AXES and BGCODE_F flags of the values that were in the record.
+uint8_t bgcode_decode(const uint8_t* record, float* position, float& feedrate);
+//The X, Y, Z, E the next record changes, for jumping to a record in the middle of a file.
+void bgcode_get_position(int32_t* position);
+void bgcode_set_position(const int32_t* position);
+
+#endif//BINARY_GCODE_H
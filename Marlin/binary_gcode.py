@@ -0,0 +1,198 @@
+#!/usr/bin/env python
+
+""" Convert g-code to the binary move records of binary_gcode.h.
+
+G0/G1 moves in absolute positioning become binary records, every other line is copied
+without its comment, so the result prints on firmware with BINARY_GCODE like the original:
+
+    binary_gcode.py print.gcode print.gco
+
+The comment lines before the first command stay, the print menu reads the ;FLAVOR, ;TIME and
+;MATERIAL header from them. Positions and feedrates are rounded to 0.001, so E values with more
+decimals move at most 0.0005mm, less than an extruder step.
+
+With --port the g-code is streamed to the printer over USB instead, with a line number and
+checksum in every line and record, and sent again when the printer asks for it:
+
+    binary_gcode.py print.gcode --port /dev/ttyACM0
+"""
+
+from __future__ import print_function
+
+import argparse
+import re
+import sys
+from decimal import Decimal, ROUND_HALF_EVEN
+
+MARKER = 0x80
+NUMBERED = 0x40
+ABSOLUTE = 0x20
+FEEDRATE = 0x10
+SCALE = 1000
+
+AXES = 'XYZE'
+INT32_MIN = -(1 << 31)
+INT32_MAX = (1 << 31) - 1
+
+MOVE = re.compile(r'^G0*[01]((?:\s*[XYZEF][-+]?(?:[0-9]+\.?[0-9]*|\.[0-9]+))*)\s*$')
+WORD = re.compile(r'([XYZEF])([-+]?(?:[0-9]+\.?[0-9]*|\.[0-9]+))')
+
+def fixed(text):
+    return int((Decimal(text) * SCALE).to_integral_value(rounding=ROUND_HALF_EVEN))
+
+def varint(value):
+    data = bytearray()
+    while value > 0x7F:
+        data.append(0x80 | (value & 0x7F))
+        value >>= 7
+    data.append(value)
+    return data
+
+def zigzag(value):
+    return value * 2 if value >= 0 else -value * 2 - 1
+
+class Encoder:
+    """ Keeps track of the position the firmware decodes the next record against. """
+    def __init__(self):
+        # None until a record told the firmware the axis, a record does not start from a known position.
+        self.position = [None] * len(AXES)
+
+    def record(self, values, feedrate, line_number=None):
+        absolute = any(self.position[i] is None or not INT32_MIN <= v - self.position[i] <= INT32_MAX for i, v in values.items())
+        header = MARKER
+        if absolute:
+            header |= ABSOLUTE
+        if feedrate is not None:
+            header |= FEEDRATE
+        if line_number is not None:
+            header |= NUMBERED
+        for i in values:
+            header |= 1 << i
+        data = bytearray([header])
+        if line_number is not None:
+            data += varint(line_number)
+        for i in sorted(values):
+            data += varint(zigzag(values[i] if absolute else values[i] - self.position[i]))
+            self.position[i] = values[i]
+        if feedrate is not None:
+            data += varint(feedrate)
+        checksum = 0
+        for b in data:
+            checksum ^= b
+        data.append(checksum)
+        return data
+
+def parse(filename):
+    """ Yields the g-code as (text, None) for lines that are copied, and (values, feedrate) for moves. """
+    relative = False
+    relative_e = False
+    header = True
+    for line in open(filename, 'r'):
+        code = line.split(';')[0].strip()
+        if not code:
+            if header and line.strip():
+                yield line.rstrip('\r\n'), None
+            continue
+        header = False
+        m = MOVE.match(code)
+        if m and not relative:
+            words = WORD.findall(m.group(1))
+            letters = [w[0] for w in words]
+            if words and len(set(letters)) == len(letters) and not ('E' in letters and relative_e):
+                values = dict((AXES.index(w[0]), fixed(w[1])) for w in words if w[0] != 'F')
+                feedrate = [fixed(w[1]) for w in words if w[0] == 'F']
+                if all(INT32_MIN <= v <= INT32_MAX for v in values.values()) and all(0 <= f < (1 << 32) for f in feedrate):
+                    yield values, feedrate[0] if feedrate else None
+                    continue
+        # The firmware reads the words wherever they are, G91 and M83 switch the modes just as well in a longer line.
+        if re.match(r'^G0*90\b', code):
+            relative = False
+            relative_e = False
+        elif re.match(r'^G0*91\b', code):
+            relative = True
+        elif re.match(r'^M0*82\b', code):
+            relative_e = False
+        elif re.match(r'^M0*83\b', code):
+            relative_e = True
+        yield code, None
+
+def convert(source, target):
+    encoder = Encoder()
+    out = open(target, 'wb')
+    moves = 0
+    lines = 0
+    for item, feedrate in parse(source):
+        if isinstance(item, dict):
+            out.write(encoder.record(item, feedrate))
+            moves += 1
+        else:
+            out.write((item + '\n').encode())
+            lines += 1
+    size = out.tell()
+    out.close()
+    original = len(open(source, 'rb').read())
+    print('%s: %d moves as records, %d lines copied, %d bytes (%.1f%% of %d)' % (target, moves, lines, size, size * 100.0 / max(original, 1), original))
+
+def checksum_line(line_number, text):
+    line = ('N%d %s' % (line_number, text)).encode()
+    checksum = 0
+    for b in bytearray(line):
+        checksum ^= b
+    return line + ('*%d\n' % checksum).encode()
+
+class Printer:
+    """ Sends one line or record at a time and waits for the ok, like the firmware expects from a host. """
+    def __init__(self, port, baudrate):
+        import serial
+        self.serial = serial.Serial(port, baudrate, timeout=2)
+        # Opening the port resets the printer, wait until it talks.
+        while True:
+            response = self.serial.readline()
+            if not response or response.startswith(b'start'):
+                break
+
+    def send(self, data):
+        while True:
+            self.serial.write(data)
+            resend = False
+            while True:
+                response = self.serial.readline()
+                if response.startswith(b'ok'):
+                    break
+                if response.startswith(b'Resend:') or response.startswith(b'rs'):
+                    resend = True
+                elif response:
+                    sys.stdout.write(response.decode('ascii', 'replace'))
+            if not resend:
+                return
+
+def stream(source, port, baudrate):
+    printer = Printer(port, baudrate)
+    encoder = Encoder()
+    printer.send(checksum_line(0, 'M110'))
+    line_number = 0
+    for item, feedrate in parse(source):
+        if isinstance(item, dict):
+            line_number += 1
+            printer.send(encoder.record(item, feedrate, line_number))
+        elif not item.startswith(';'):
+            line_number += 1
+            printer.send(checksum_line(line_number, item))
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('gcode', help='g-code file to convert')
+    parser.add_argument('output', nargs='?', help='file to write the converted g-code to')
+    parser.add_argument('-p', '--port', help='stream to the printer on this serial port instead')
+    parser.add_argument('-b', '--baudrate', type=int, default=250000, help='baud rate of the serial port (default=250000)')
+    args = parser.parse_args()
+
+    if args.port:
+        stream(args.gcode, args.port, args.baudrate)
+    elif args.output:
+        convert(args.gcode, args.output)
+    else:
+        parser.error('Give an output file or a serial port')
+
+if __name__ == '__main__':
+    main()
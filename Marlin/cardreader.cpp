@@ -5,6 +5,7 @@
 #include "stepper.h"
 #include "temperature.h"
 #include "language.h"
+#include "binary_gcode.h"
 
 #ifdef SDSUPPORT
 
@@ -15,6 +16,7 @@ CardReader::CardReader() :
  , filesize(0)
  , autostart_atmillis(0)
  , sdpos(0)
+ , dirIndexCount(0)
 {
   //power to SD reader
   #if SDPOWER > -1
@@ -47,7 +49,8 @@ void  CardReader::lsDive(SdFile &parent, SdFile** parents, uint8_t dirDepth)
   dir_t p;
   uint8_t cnt=0;
 
-  while (parent.readDir(&p, longFilename) > 0)
+  //entryPos is where the read of the current entry started, including its long filename entries.
+  for(uint32_t entryPos = parent.curPosition(); parent.readDir(&p, longFilename) > 0; entryPos = parent.curPosition())
   {
     if( DIR_IS_SUBDIR(&p) && (lsAction!=LS_Count) && (lsAction!=LS_GetFilename)) // hence LS_SerialPrint
     {
@@ -113,12 +116,22 @@ void  CardReader::lsDive(SdFile &parent, SdFile** parents, uint8_t dirDepth)
       }
       else if(lsAction==LS_Count)
       {
+        if ((nrFiles % DIR_INDEX_STEP) == 0 && dirIndexCount < DIR_INDEX_SIZE)
+          dirIndex[dirIndexCount++] = entryPos / sizeof(dir_t);
         nrFiles++;
       }
       else if(lsAction==LS_GetFilename)
       {
         if(cnt==nrFiles)
+        {
+#ifdef SD_DETAIL_INDEX
+          fileKey.size = p.fileSize;
+          fileKey.entry = entryPos / sizeof(dir_t);
+          fileKey.date = p.lastWriteDate;
+          fileKey.time = p.lastWriteTime;
+#endif
           return;
+        }
         cnt++;
       }
     }
@@ -169,6 +182,7 @@ void CardReader::initsd()
   }
   workDir=root;
   curDir=&root;
+  invalidateDirIndex();
   /*
   if(!workDir.openRoot(&volume))
   {
@@ -187,6 +201,7 @@ void CardReader::setroot()
   workDir=root;
   curDir=&workDir;
   workDirDepth = 0;
+  invalidateDirIndex();
 }
 
 void CardReader::release()
@@ -195,6 +210,7 @@ void CardReader::release()
 //  pause = false;
 //  cardOK = false;
   state &= ~(SD_PRINTING | SD_PAUSE | SD_OK);
+  invalidateDirIndex();
 }
 
 void CardReader::startFileprint()
@@ -234,7 +250,7 @@ void CardReader::openFile(const char* name,bool read)
     while(dirname_start>(char*)1)
     {
       dirname_end=strchr(dirname_start,'/');
-      if(dirname_end>0 && dirname_end>dirname_start)
+      if(dirname_end!=NULL && dirname_end>dirname_start)
       {
         char subdirname[13];
         strncpy(subdirname, dirname_start, dirname_end-dirname_start);
@@ -295,6 +311,7 @@ void CardReader::openFile(const char* name,bool read)
     }
     else
     {
+      invalidateDirIndex();
       state |= SD_SAVING;
       SERIAL_PROTOCOLPGM(MSG_SD_WRITE_TO_FILE);
       SERIAL_PROTOCOLLN(name);
@@ -322,10 +339,10 @@ void CardReader::removeFile(const char* name)
   if(name[0]=='/')
   {
     dirname_start=strchr(name,'/')+1;
-    while(dirname_start>0)
+    while(dirname_start!=NULL)
     {
       dirname_end=strchr(dirname_start,'/');
-      if(dirname_end>0 && dirname_end>dirname_start)
+      if(dirname_end!=NULL && dirname_end>dirname_start)
       {
         char subdirname[13];
         strncpy(subdirname, dirname_start, dirname_end-dirname_start);
@@ -358,6 +375,7 @@ void CardReader::removeFile(const char* name)
       SERIAL_PROTOCOLPGM("File deleted:");
       SERIAL_PROTOCOL(fname);
       sdpos = 0;
+      invalidateDirIndex();
     }
     else
     {
@@ -408,6 +426,19 @@ void CardReader::write_command(char *buf)
   }
 }
 
+#ifdef BINARY_GCODE
+void CardReader::write_record(const uint8_t* record, uint8_t length)
+{
+  file.clearWriteError();
+  file.write(record, length);
+  if (file.getWriteError())
+  {
+    SERIAL_ERROR_START;
+    SERIAL_ERRORLNPGM(MSG_SD_ERR_WRITE_TO_FILE);
+  }
+}
+#endif
+
 bool CardReader::write_string(char* buffer)
 {
     file.write(buffer);
@@ -477,6 +508,61 @@ void CardReader::checkautostart(bool force)
   clearError();
 }
 
+//Read the next line of the file into line, without its comment and line end, and return its length.
+// The bytes are scanned straight in the volume cache, a whole block at a time. Characters beyond size-1 are dropped.
+// Returns -1 at the end of the file or on a read error (check errorCode()).
+int16_t CardReader::getLine(char* line, uint8_t size)
+{
+  uint8_t count = 0;
+  uint8_t maxCount = size - 1;
+  bool comment = false;
+  uint8_t* data;
+  int16_t n;
+  while ((n = file.readCached(&data)) > 0)
+  {
+    uint8_t* end = data + n;
+    for(uint8_t* p = data; p < end; p++)
+    {
+      char c = *p;
+#ifdef BINARY_GCODE
+      //A binary record ends at its length, any byte can be in it
+      if (count ? (line[0] & BGCODE_MARKER) : (!comment && (c & BGCODE_MARKER)))
+      {
+        line[count++] = c;
+        if (bgcode_length((uint8_t*)line, count) || count >= BGCODE_MAX_LENGTH)
+        {
+          if (p + 1 < end)
+            file.seekCur(p + 1 - end);
+          sdpos = file.curPosition();
+          return count;
+        }
+        continue;
+      }
+#endif
+      if (c == '\n' || c == '\r' || c == '\0' || (!comment && (c == '#' || c == ':')))
+      {
+        if (c == '\0')
+          file.seekEnd();//Like get(), a zero byte ends the file
+        else if (p + 1 < end)
+          file.seekCur(p + 1 - end);//Give back the rest of the block
+        sdpos = file.curPosition();
+        line[count] = '\0';
+        return count;
+      }
+      if (c == ';')
+        comment = true;
+      else if (!comment && count < maxCount)
+        line[count++] = c;
+    }
+  }
+  //End of the file, the last line does not need a line end.
+  sdpos = file.curPosition();
+  line[count] = '\0';
+  if (n == 0 && count > 0)
+    return count;
+  return -1;
+}
+
 void CardReader::closefile()
 {
   file.sync();
@@ -490,8 +576,18 @@ void CardReader::getfilename(const uint8_t nr)
 {
   curDir=&workDir;
   lsAction=LS_GetFilename;
-  nrFiles=nr;
-  curDir->rewind();
+  if (dirIndexCount)
+  {
+    //Start at the nearest indexed file before nr
+    uint8_t idx = min(nr / DIR_INDEX_STEP, dirIndexCount - 1);
+    nrFiles=nr - idx * DIR_INDEX_STEP;
+    curDir->seekSet(uint32_t(dirIndex[idx]) * sizeof(dir_t));
+  }
+  else
+  {
+    nrFiles=nr;
+    curDir->rewind();
+  }
   lsDive(*curDir, NULL, 0);
 }
 
@@ -500,12 +596,84 @@ uint16_t CardReader::getnrfilenames()
   curDir=&workDir;
   lsAction=LS_Count;
   nrFiles=0;
+  invalidateDirIndex();
   curDir->rewind();
   lsDive(*curDir, NULL, 0);
   //SERIAL_ECHOLN(nrFiles);
   return nrFiles;
 }
 
+#ifdef SD_DETAIL_INDEX
+//The detail index holds a record per file of the working directory: record size, detailIndexKey and the details.
+// The leading '_' keeps it out of the file list, and it does not move the other directory entries, so the
+// directory index stays valid when it is created.
+#define DETAIL_INDEX_FILENAME "_DETAILS.IDX"
+
+static bool sameDetailIndexKey(const detailIndexKey& a, const detailIndexKey& b)
+{
+  return a.entry == b.entry && a.size == b.size && a.date == b.date && a.time == b.time;
+}
+
+//Read the details of the file found by the last getfilename() from the detail index. Returns false if they are not in it.
+bool CardReader::readDetailIndex(void* details, uint8_t size)
+{
+  SdFile index;
+  if (!index.open(&workDir, DETAIL_INDEX_FILENAME, O_READ))
+    return false;
+  uint8_t recordSize;
+  detailIndexKey key;
+  while(index.read(&recordSize, 1) == 1 && recordSize == 1 + sizeof(key) + size && index.read(&key, sizeof(key)) == int16_t(sizeof(key)))
+  {
+    if (sameDetailIndexKey(key, fileKey))
+      return index.read(details, size) == size;
+    if (!index.seekCur(size))
+      break;
+  }
+  return false;
+}
+
+//Store the details of the file found by the last getfilename() in the detail index. The record of an older file
+// with the same directory entry is replaced, an index that is full or written by a build with other details starts over.
+void CardReader::writeDetailIndex(const void* details, uint8_t size)
+{
+  SdFile index;
+  if (!index.open(&workDir, DETAIL_INDEX_FILENAME, O_RDWR | O_CREAT))
+  {
+    clearError();//A write protected card is no reason to stop browsing it
+    return;
+  }
+  uint8_t recordSize = 1 + sizeof(fileKey) + size;
+  uint32_t pos = 0;
+  uint8_t n;
+  for(n=0; n<SD_DETAIL_INDEX_MAX; n++)
+  {
+    uint8_t readSize;
+    detailIndexKey key;
+    if (index.read(&readSize, 1) != 1)
+      break;
+    if (readSize != recordSize || index.read(&key, sizeof(key)) != int16_t(sizeof(key)))
+    {
+      n = SD_DETAIL_INDEX_MAX;
+      break;
+    }
+    if (key.entry == fileKey.entry)
+      break;
+    index.seekCur(size);
+    pos += recordSize;
+  }
+  if (n == SD_DETAIL_INDEX_MAX)
+  {
+    index.truncate(0);
+    pos = 0;
+  }
+  index.seekSet(pos);
+  index.write(&recordSize, 1);
+  index.write(&fileKey, sizeof(fileKey));
+  index.write(details, size);
+  index.close();
+}
+#endif//SD_DETAIL_INDEX
+
 void CardReader::chdir(const char * relpath)
 {
   SdFile newfile;
@@ -528,6 +696,7 @@ void CardReader::chdir(const char * relpath)
       workDirParents[0]=*parent;
     }
     workDir=newfile;
+    invalidateDirIndex();
   }
 }
 
@@ -539,6 +708,7 @@ void CardReader::updir()
     workDir = workDirParents[0];
     for (uint8_t d = 0; d < workDirDepth; d++)
       workDirParents[d] = workDirParents[d+1];
+    invalidateDirIndex();
   }
 }
 
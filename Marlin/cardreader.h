@@ -5,6 +5,23 @@
 
 #define MAX_DIR_DEPTH 10
 
+//Index of the working directory, so getfilename() does not need to read the directory from the start.
+// Counting the files stores the directory entry of every DIR_INDEX_STEP-th file, a lookup reads at most DIR_INDEX_STEP files from there.
+#define DIR_INDEX_STEP 8
+#define DIR_INDEX_SIZE 32//Index entries, enough for the 255 files the menus can show
+
+#ifdef SD_DETAIL_INDEX
+//Identifies a file in the detail index of its directory, taken from the directory entry by getfilename().
+// A file that is changed or replaced gets a different size or date, so its old record is not used.
+struct detailIndexKey
+{
+  uint32_t size;
+  uint16_t entry;//Directory entry number
+  uint16_t date;
+  uint16_t time;
+};
+#endif
+
 #if (SDCARDDETECT > -1)
 # ifdef SDCARDDETECTINVERTED
 #  define IS_SD_INSERTED (READ(SDCARDDETECT)!=0)
@@ -36,6 +53,9 @@ public:
 
   void initsd();
   void write_command(char *buf);
+#ifdef BINARY_GCODE
+  void write_record(const uint8_t* record, uint8_t length);
+#endif
   bool write_string(char* buffer);
   //files auto[0-9].g on the sd card are performed in a row
   //this is to delay autostart and hence the initialization of the sd card to some seconds after the normal init, so the device is available quick after a reset
@@ -49,10 +69,16 @@ public:
   void startFileprint();
   void getStatus();
   void printingHasFinished();
+  //Read the next g-code line without comments, or the next record of binary_gcode.h. Returns the length, -1 at the end of the file.
+  int16_t getLine(char* line, uint8_t size);
 
   void getfilename(const uint8_t nr);
   void getFilenameFromNr(char* buffer, uint8_t nr);
   uint16_t getnrfilenames();
+#ifdef SD_DETAIL_INDEX
+  bool readDetailIndex(void* details, uint8_t size);
+  void writeDetailIndex(const void* details, uint8_t size);
+#endif
 
 
   void ls();
@@ -71,6 +97,7 @@ public:
   FORCE_INLINE bool atRoot() { return workDirDepth==0; }
   FORCE_INLINE uint32_t getFilePos() { return sdpos; }
   FORCE_INLINE uint32_t getFileSize() { return filesize; }
+  FORCE_INLINE uint32_t getFileCluster() { return file.firstCluster(); }
   FORCE_INLINE bool isOk() { return cardOK() && card.errorCode() == 0; }
   FORCE_INLINE int errorCode() { return card.errorCode(); }
   FORCE_INLINE void clearError() { card.clearError(); }
@@ -124,11 +151,17 @@ private:
   uint32_t filesize;
   unsigned long autostart_atmillis;
   uint32_t sdpos ;
+  uint16_t dirIndex[DIR_INDEX_SIZE];//Directory entry number of every DIR_INDEX_STEP-th file of workDir
+  uint8_t dirIndexCount;//0 when workDir has no index
+#ifdef SD_DETAIL_INDEX
+  detailIndexKey fileKey;//Of the file found by the last getfilename()
+#endif
 
   LsAction lsAction; //stored for recursion.
   int16_t nrFiles; //counter for the files in the current directory and recycled as position counter for getting the nrFiles'th name in the directory.
   char* diveDirName;
   void lsDive(SdFile &parent, SdFile** parents, uint8_t dirDepth);
+  FORCE_INLINE void invalidateDirIndex() { dirIndexCount = 0; }
 };
 extern CardReader card;
 #define IS_SD_PRINTING (card.sdprinting())
@@ -20,9 +20,22 @@ Options:
   --t1=ttt:rrr      middle temperature temperature:resistance point (around 150C)
   --t2=ttt:rrr      high temperature temperature:resistance point (around 250C)
   --num-temps=...   the number of temperature points to calculate (default: 20)
+  --uniform=...     instead, resample the tables of this thermistortables.h for analog2temp()
+  --max-error=...   largest difference from the original tables for --uniform in degrees C (default: 0.5)
+  --range=lll:hhh   temperatures in degrees C where --max-error applies (default: 20:350)
+
+With --uniform every temptable_N of thermistortables.h becomes a temptable_uniform_N with an entry for every
+(1 << TEMPTABLE_UNIFORM_N_SHIFT) raw ADC values, so the firmware can index it directly instead of searching.
+The spacing is the widest one that stays within --max-error of the linear interpolation of the original table
+in the printing range, but never below one ADC count, the resolution of the original tables.
+The Makefile regenerates thermistortables_uniform.h this way when thermistortables.h changes:
+
+  python createTemperatureLookupMarlin.py --uniform=thermistortables.h > thermistortables_uniform.h
 """
 
+from __future__ import print_function
 from math import *
+import re
 import sys
 import getopt
 
@@ -65,7 +78,7 @@ class Thermistor:
     def adc(self,temp):
         "Convert temperature into a ADC reading"
         y = (self.c1 - (1/(temp+273.15))) / (2*self.c3)
-	x = sqrt(pow(self.c2 / (3*self.c3),3) + pow(y,2))
+        x = sqrt(pow(self.c2 / (3*self.c3),3) + pow(y,2))
         r = exp(pow(x-y,1.0/3) - pow(x+y,1.0/3)) # resistance of thermistor
         return (r / (self.rp + r)) * (1024*16)
 
@@ -81,11 +94,14 @@ def main(argv):
     num_temps = int(36);
 
     try:
-        opts, args = getopt.getopt(argv, "h", ["help", "rp=", "t1=", "t2=", "t3=", "num-temps="])
+        opts, args = getopt.getopt(argv, "h", ["help", "rp=", "t1=", "t2=", "t3=", "num-temps=", "uniform=", "max-error=", "range="])
     except getopt.GetoptError:
         usage()
         sys.exit(2)
 
+    uniform = None
+    max_error = 0.5
+    temp_range = (20, 350)
     for opt, arg in opts:
         if opt in ("-h", "--help"):
             usage()
@@ -106,6 +122,17 @@ def main(argv):
             r3 = float( arg[1])
         elif opt == "--num-temps":
             num_temps =  int(arg)
+        elif opt == "--uniform":
+            uniform = arg
+        elif opt == "--max-error":
+            max_error = float(arg)
+        elif opt == "--range":
+            arg =  arg.split(':')
+            temp_range = (float(arg[0]), float(arg[1]))
+
+    if uniform:
+        print_uniform_tables(uniform, max_error, temp_range)
+        return
 
     max_adc = (1024 * 16) - 1
     min_temp = 0
@@ -113,26 +140,93 @@ def main(argv):
     increment = int(max_adc/(num_temps-1));
 
     t = Thermistor(rp, t1, r1, t2, r2, t3, r3)
-    tmp = (min_temp - max_temp) / (num_temps-1)
-    print tmp
+    tmp = (min_temp - max_temp) // (num_temps-1)
+    print(tmp)
     temps = range(max_temp, min_temp + tmp, tmp);
 
-    print "// Thermistor lookup table for Marlin"
-    print "// ./createTemperatureLookup.py --rp=%s --t1=%s:%s --t2=%s:%s --t3=%s:%s --num-temps=%s" % (rp, t1, r1, t2, r2, t3, r3, num_temps)
-    print "#define NUMTEMPS %s" % (len(temps))
-    print "short temptable[NUMTEMPS][2] = {"
+    print("// Thermistor lookup table for Marlin")
+    print("// ./createTemperatureLookup.py --rp=%s --t1=%s:%s --t2=%s:%s --t3=%s:%s --num-temps=%s" % (rp, t1, r1, t2, r2, t3, r3, num_temps))
+    print("#define NUMTEMPS %s" % (len(temps)))
+    print("short temptable[NUMTEMPS][2] = {")
 
     counter = 0
     for temp in temps:
         counter = counter +1
         if counter == len(temps):
-            print "   {%s, %s}" % (int(t.adc(temp)), temp)
+            print("   {%s, %s}" % (int(t.adc(temp)), temp))
         else:
-            print "   {%s, %s}," % (int(t.adc(temp)), temp)
-    print "};"
+            print("   {%s, %s}," % (int(t.adc(temp)), temp))
+    print("};")
+
+# Must match uniform_table_lookup() in temperature.cpp
+UNIFORM_SCALE = 16      # entries in 1/16 degrees C
+UNIFORM_MAX_SHIFT = 8
+
+def read_tables(filename):
+    "The OVERSAMPLENR and the {raw, celsius} pairs of every temptable_N in a thermistortables.h"
+    text = open(filename).read()
+    oversample = int(re.search(r'#define\s+OVERSAMPLENR\s+(\d+)', text).group(1))
+    tables = []
+    for m in re.finditer(r'const short temptable_(\w+)\[\]\[2\] PROGMEM = \{(.*?)\};', text, re.S):
+        body = re.sub(r'//.*', '', m.group(2))
+        points = [(int(raw) * oversample, int(celsius)) for raw, celsius in re.findall(r'\{\s*(\d+)\s*\*\s*OVERSAMPLENR\s*,\s*(-?\d+)\s*\}', body)]
+        tables.append((m.group(1), points))
+    return oversample, tables
+
+def original_temp(points, raw):
+    "analog2temp() as it was, linear interpolation between the table points and the last value past the end"
+    for i in range(1, len(points)):
+        if points[i][0] > raw:
+            return points[i-1][1] + (raw - points[i-1][0]) * float(points[i][1] - points[i-1][1]) / (points[i][0] - points[i-1][0])
+    return points[-1][1]
+
+def uniform_temp(entries, shift, raw):
+    "The fixed point interpolation of the firmware, in degrees C"
+    i = raw >> shift
+    if i >= len(entries) - 1:
+        return entries[-1] / float(UNIFORM_SCALE)
+    frac = raw & ((1 << shift) - 1)
+    return (entries[i] + (((entries[i+1] - entries[i]) * frac + ((1 << shift) >> 1)) >> shift)) / float(UNIFORM_SCALE)
+
+def make_uniform(points, raw_max, min_shift, max_error, temp_range):
+    "The widest spacing (as shift) and its entries that stay within max_error of the original table in temp_range"
+    checked = [raw for raw in range(raw_max + 1) if temp_range[0] <= original_temp(points, raw) <= temp_range[1]]
+    for shift in range(UNIFORM_MAX_SHIFT, min_shift - 1, -1):
+        entries = [int(round(original_temp(points, i << shift) * UNIFORM_SCALE)) for i in range((raw_max >> shift) + 1)]
+        error = max([abs(uniform_temp(entries, shift, raw) - original_temp(points, raw)) for raw in checked] + [0])
+        if error <= max_error or shift == min_shift:
+            return shift, entries, error
+
+def print_uniform_tables(filename, max_error, temp_range):
+    oversample, tables = read_tables(filename)
+    raw_max = 1024 * oversample
+    min_shift = int(log(oversample, 2))
+    print("// Generated from %s by createTemperatureLookupMarlin.py --uniform, do not edit." % (filename.replace('\\', '/').split('/')[-1]))
+    print("// temptable_uniform_N[i] is temptable_N at raw value (i << TEMPTABLE_UNIFORM_N_SHIFT), in 1/TEMPTABLE_UNIFORM_SCALE degrees C.")
+    print("#ifndef THERMISTORTABLES_UNIFORM_H_")
+    print("#define THERMISTORTABLES_UNIFORM_H_")
+    print("")
+    print("#define TEMPTABLE_UNIFORM_SCALE %d" % (UNIFORM_SCALE))
+    print("#define TEMPTABLE_UNIFORM_RAW_MAX %d" % (raw_max))
+    print("#if OVERSAMPLENR != %d" % (oversample))
+    print("# error OVERSAMPLENR changed, generate thermistortables_uniform.h again")
+    print("#endif")
+    for name, points in tables:
+        shift, entries, error = make_uniform(points, raw_max, min_shift, max_error, temp_range)
+        print("")
+        print("#if (THERMISTORHEATER_0 == %s) || (THERMISTORHEATER_1 == %s) || (THERMISTORHEATER_2 == %s) || (THERMISTORBED == %s)" % (name, name, name, name))
+        print("// %d entries, at most %.2f degrees C from temptable_%s between %g and %g degrees C" % (len(entries), error, name, temp_range[0], temp_range[1]))
+        print("#define TEMPTABLE_UNIFORM_%s_SHIFT %d" % (name, shift))
+        print("const short temptable_uniform_%s[] PROGMEM = {" % (name))
+        for n in range(0, len(entries), 8):
+            print("  " + ", ".join("%d" % e for e in entries[n:n+8]) + ("," if n + 8 < len(entries) else ""))
+        print("};")
+        print("#endif")
+    print("")
+    print("#endif //THERMISTORTABLES_UNIFORM_H_")
 
 def usage():
-    print __doc__
+    print(__doc__)
 
 if __name__ == "__main__":
     main(sys.argv[1:])
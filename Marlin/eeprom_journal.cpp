@@ -0,0 +1,92 @@
+#include "Marlin.h"
+#include "eeprom_journal.h"
+
+#ifdef EEPROM_JOURNAL_SIZE
+
+struct eepromJournalEntry
+{
+    uint16_t addr;
+    uint8_t value;
+};
+
+//Oldest entry first. An address can be in the journal more than once (a setting that is invalidated first and
+// written again when the save is complete), reads use the newest entry.
+static eepromJournalEntry journal[EEPROM_JOURNAL_SIZE];
+static uint8_t journal_count;
+
+static void commit_oldest()
+{
+    if (eeprom_read_byte((const uint8_t*)journal[0].addr) != journal[0].value)
+        eeprom_write_byte((uint8_t*)journal[0].addr, journal[0].value);
+    --journal_count;
+    memmove(&journal[0], &journal[1], journal_count * sizeof(eepromJournalEntry));
+}
+
+static void stage_byte(uint16_t addr, uint8_t value)
+{
+    uint8_t n = journal_count;
+    while(n > 0 && journal[n-1].addr != addr)
+        --n;
+    if (n == 0)
+    {
+        //Nothing staged for this address, skip the byte if the EEPROM already holds it.
+        if (eeprom_read_byte((const uint8_t*)addr) == value)
+            return;
+    }
+    else if (n == journal_count)
+    {
+        //Only the newest entry can be changed in place, an older one would be written out of order.
+        journal[n-1].value = value;
+        return;
+    }
+    if (journal_count >= EEPROM_JOURNAL_SIZE)
+    {
+        eeprom_busy_wait();
+        commit_oldest();
+    }
+    journal[journal_count].addr = addr;
+    journal[journal_count].value = value;
+    ++journal_count;
+}
+
+void eeprom_journal_write_block(const void* src, void* dst, uint16_t size)
+{
+    const uint8_t* value = (const uint8_t*)src;
+    for(uint16_t addr = (uint16_t)dst; size; --size, ++addr, ++value)
+        stage_byte(addr, *value);
+}
+
+void eeprom_journal_read_block(void* dst, const void* src, uint16_t size)
+{
+    eeprom_read_block(dst, src, size);
+    for(uint8_t n=0; n<journal_count; ++n)
+    {
+        uint16_t offset = journal[n].addr - (uint16_t)src;
+        if (offset < size)
+            ((uint8_t*)dst)[offset] = journal[n].value;
+    }
+}
+
+uint8_t eeprom_journal_read_byte(const uint8_t* addr)
+{
+    uint8_t value;
+    eeprom_journal_read_block(&value, addr, sizeof(value));
+    return value;
+}
+
+void eeprom_journal_tick()
+{
+    if (journal_count && eeprom_is_ready())
+        commit_oldest();
+}
+
+void eeprom_journal_flush()
+{
+    while(journal_count)
+    {
+        eeprom_busy_wait();
+        commit_oldest();
+    }
+}
+
+#endif//EEPROM_JOURNAL_SIZE
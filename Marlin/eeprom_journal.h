@@ -0,0 +1,47 @@
+#ifndef EEPROM_JOURNAL_H
+#define EEPROM_JOURNAL_H
+
+#include <avr/eeprom.h>
+#include "Marlin.h"
+
+//Write-back layer for the settings in the EEPROM. Writes are staged in a small RAM journal and committed by
+// eeprom_journal_tick() from idle(), one byte whenever the EEPROM is ready, so saving settings during a print does not
+// hold up the main loop. Only bytes that differ from the EEPROM are written, and bytes are committed in the order they
+// were staged. Reads through the journal see the staged values, so use the eeprom_journal_* functions for both reading
+// and writing the same data.
+#ifdef EEPROM_JOURNAL_SIZE
+
+void eeprom_journal_write_block(const void* src, void* dst, uint16_t size);
+void eeprom_journal_read_block(void* dst, const void* src, uint16_t size);
+uint8_t eeprom_journal_read_byte(const uint8_t* addr);
+//Commit the oldest staged byte if the EEPROM is not busy.
+void eeprom_journal_tick();
+//Commit everything that is staged, waits for the EEPROM. Call before a reset or when the main loop stops.
+void eeprom_journal_flush();
+
+FORCE_INLINE void eeprom_journal_write_byte(uint8_t* addr, uint8_t value) { eeprom_journal_write_block(&value, addr, sizeof(value)); }
+FORCE_INLINE void eeprom_journal_write_word(uint16_t* addr, uint16_t value) { eeprom_journal_write_block(&value, addr, sizeof(value)); }
+FORCE_INLINE void eeprom_journal_write_dword(uint32_t* addr, uint32_t value) { eeprom_journal_write_block(&value, addr, sizeof(value)); }
+FORCE_INLINE void eeprom_journal_write_float(float* addr, float value) { eeprom_journal_write_block(&value, addr, sizeof(value)); }
+FORCE_INLINE uint16_t eeprom_journal_read_word(const uint16_t* addr) { uint16_t value; eeprom_journal_read_block(&value, addr, sizeof(value)); return value; }
+FORCE_INLINE uint32_t eeprom_journal_read_dword(const uint32_t* addr) { uint32_t value; eeprom_journal_read_block(&value, addr, sizeof(value)); return value; }
+FORCE_INLINE float eeprom_journal_read_float(const float* addr) { float value; eeprom_journal_read_block(&value, addr, sizeof(value)); return value; }
+
+#else
+
+#define eeprom_journal_write_block eeprom_write_block
+#define eeprom_journal_write_byte eeprom_write_byte
+#define eeprom_journal_write_word eeprom_write_word
+#define eeprom_journal_write_dword eeprom_write_dword
+#define eeprom_journal_write_float eeprom_write_float
+#define eeprom_journal_read_block eeprom_read_block
+#define eeprom_journal_read_byte eeprom_read_byte
+#define eeprom_journal_read_word eeprom_read_word
+#define eeprom_journal_read_dword eeprom_read_dword
+#define eeprom_journal_read_float eeprom_read_float
+#define eeprom_journal_tick()
+#define eeprom_journal_flush()
+
+#endif//EEPROM_JOURNAL_SIZE
+
+#endif//EEPROM_JOURNAL_H
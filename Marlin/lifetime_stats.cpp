@@ -1,12 +1,16 @@
+#include <stddef.h>
 #include <avr/eeprom.h>
 #include "Marlin.h"
 #include "planner.h"
 #include "lifetime_stats.h"
+#include "eeprom_journal.h"
 
 //Random number to verify if the lifetime has actually been written to the EEPROM already
 #define LIFETIME_MAGIC 0x2624BA15
+#define LIFETIME_SLOT_MAGIC 0x2624BA16
 
 //EEPROM has a 100.000 erase cycles guarantee. By writing once a hour we get about 11 years of continues service. Which should be enough to last a lifetime.
+//The saves rotate over 8 slots, so a single slot is only written every 16 hours of running.
 #define MILLIS_MINUTE (1000L * 60L)
 #define LIFETIME_SAVEINTERVAL (MILLIS_MINUTE * 120L)
 
@@ -17,6 +21,18 @@
 //Material profiles are stored at 0x800 and is currently 385 bytes long.
 //Storing the lifetime stats at 0x700 gives 256 bytes of storage that should be safe to use.
 #define LIFETIME_EEPROM_OFFSET 0x700
+#define LIFETIME_SLOT_COUNT 8
+#define LIFETIME_SLOT_OFFSET(n) (LIFETIME_EEPROM_OFFSET + sizeof(lifetimeStatsSlot) * (n))
+
+//A save goes to the slot after the newest one. A slot is valid when the magic and checksum match, so a save that was
+// cut short by a power off falls back to the previous slot. Older firmware only wrote slot 0, with LIFETIME_MAGIC.
+struct lifetimeStatsSlot
+{
+    uint32_t magic;
+    uint32_t values[6];
+    uint16_t sequence;
+    uint16_t checksum;
+};
 
 static unsigned long startup_millis;
 static unsigned long minute_counter_millis;
@@ -31,6 +47,8 @@ unsigned long triptime_minutes;
 unsigned long triptime_print_minutes;
 unsigned long triptime_print_centimeters;
 static bool is_printing;
+static uint8_t lifetime_slot;
+static uint16_t lifetime_sequence;
 
 static void load_lifetime_stats();
 static void save_lifetime_stats();
@@ -101,18 +119,51 @@ void lifetime_stats_print_end()
     }
 }
 
+static uint16_t slot_checksum(const lifetimeStatsSlot& slot)
+{
+    const uint8_t* data = (const uint8_t*)&slot;
+    uint16_t checksum = 0;
+    for(uint8_t n=0; n<offsetof(lifetimeStatsSlot, checksum); ++n)
+        checksum = ((checksum << 1) | (checksum >> 15)) + data[n];
+    return checksum;
+}
+
 static void load_lifetime_stats()
 {
-    unsigned long magic = eeprom_read_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 0));
-    if (magic == LIFETIME_MAGIC)
+    lifetimeStatsSlot slot;
+    lifetimeStatsSlot newest;
+    bool found = false;
+    for(uint8_t n=0; n<LIFETIME_SLOT_COUNT; ++n)
+    {
+        eeprom_journal_read_block(&slot, (const void*)LIFETIME_SLOT_OFFSET(n), sizeof(slot));
+        if (slot.magic != LIFETIME_SLOT_MAGIC || slot.checksum != slot_checksum(slot))
+            continue;
+        if (!found || int16_t(slot.sequence - newest.sequence) > 0)
+        {
+            newest = slot;
+            lifetime_slot = n;
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        eeprom_journal_read_block(&newest, (const void*)LIFETIME_SLOT_OFFSET(0), sizeof(newest));
+        newest.sequence = 0;
+        lifetime_slot = 0;
+        found = (newest.magic == LIFETIME_MAGIC);
+    }
+    if (found)
     {
-        lifetime_minutes = eeprom_read_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 4));
-        lifetime_print_minutes = eeprom_read_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 8));
-        lifetime_print_centimeters = eeprom_read_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 12));
-        triptime_minutes = eeprom_read_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 16));
-        triptime_print_minutes = eeprom_read_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 20));
-        triptime_print_centimeters = eeprom_read_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 24));
+        lifetime_sequence = newest.sequence;
+        lifetime_minutes = newest.values[0];
+        lifetime_print_minutes = newest.values[1];
+        lifetime_print_centimeters = newest.values[2];
+        triptime_minutes = newest.values[3];
+        triptime_print_minutes = newest.values[4];
+        triptime_print_centimeters = newest.values[5];
     }else{
+        lifetime_sequence = 0;
+        lifetime_slot = LIFETIME_SLOT_COUNT - 1;
         lifetime_minutes = 0;
         lifetime_print_minutes = 0;
         lifetime_print_centimeters = 0;
@@ -124,11 +175,17 @@ static void load_lifetime_stats()
 
 static void save_lifetime_stats()
 {
-    eeprom_write_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 0), LIFETIME_MAGIC);
-    eeprom_write_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 4), lifetime_minutes);
-    eeprom_write_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 8), lifetime_print_minutes);
-    eeprom_write_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 12), lifetime_print_centimeters);
-    eeprom_write_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 16), triptime_minutes);
-    eeprom_write_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 20), triptime_print_minutes);
-    eeprom_write_dword((uint32_t*)(LIFETIME_EEPROM_OFFSET + 24), triptime_print_centimeters);
+    lifetimeStatsSlot slot;
+    slot.magic = LIFETIME_SLOT_MAGIC;
+    slot.values[0] = lifetime_minutes;
+    slot.values[1] = lifetime_print_minutes;
+    slot.values[2] = lifetime_print_centimeters;
+    slot.values[3] = triptime_minutes;
+    slot.values[4] = triptime_print_minutes;
+    slot.values[5] = triptime_print_centimeters;
+    slot.sequence = ++lifetime_sequence;
+    slot.checksum = slot_checksum(slot);
+    lifetime_slot = (lifetime_slot + 1) % LIFETIME_SLOT_COUNT;
+    //The journal writes the slot in order, the checksum last.
+    eeprom_journal_write_block(&slot, (void*)LIFETIME_SLOT_OFFSET(lifetime_slot), sizeof(slot));
 }
@@ -78,11 +78,21 @@ float max_z_jerk;
 float max_e_jerk;
 float mintravelfeedrate;
 unsigned long axis_steps_per_sqr_second[NUM_AXIS+EXTRUDERS-1];
+#ifdef LIN_ADVANCE
+float extruder_advance_k[EXTRUDERS];
+#endif
 
 // The current position of the tool in absolute steps
 static long position[NUM_AXIS];   //rescaled from extern when axis_steps_per_unit are changed by gcode
 static float previous_speed[NUM_AXIS]; // Speed of previous path line segment
 static float previous_nominal_speed; // Nominal speed of previous path line segment
+static bool stepper_held;            // The stepper is kept off the pieces of a split move until they are all planned
+#ifdef LIN_ADVANCE
+// The E steps of short lines jump between the neighbouring step counts by the rounding, the advance would jump with
+// them. It uses the E length without rounding: the position of the last line and the steps of the block being planned.
+static float position_e_exact;
+static float block_e_exact;
+#endif
 
 #ifdef AUTOTEMP
 float autotemp_max=250;
@@ -97,6 +107,7 @@ bool autotemp_enabled=false;
 block_t block_buffer[BLOCK_BUFFER_SIZE];            // A ring buffer for motion instructions
 volatile unsigned char block_buffer_head;           // Index of the next block to be pushed
 volatile unsigned char block_buffer_tail;           // Index of the block to process now
+volatile unsigned char block_buffer_planned;        // Index of the last optimally planned block
 
 //===========================================================================
 //=============================private variables ============================
@@ -165,9 +176,68 @@ FORCE_INLINE float intersection_distance(float initial_rate, float final_rate, f
   }
 }
 
+// The step indexes of a block where the acceleration ends and the deceleration starts, for the rates in steps/s and
+// the acceleration in steps/s^2. With integer_math (FAST_TRAPEZOID) the distances are the same as those of
+// estimate_acceleration_distance() and intersection_distance(), with the squares of the rates exact in integer math
+// and a multiplication with 1/(2*acceleration) instead of the divisions.
+FORCE_INLINE void trapezoid_steps(uint16_t step_event_count, uint16_t nominal_rate, unsigned long initial_rate, unsigned long final_rate,
+    float acceleration, bool integer_math, int32_t &accelerate_steps, int32_t &decelerate_after)
+{
+  int32_t decelerate_steps;
+#ifdef FAST_TRAPEZOID
+  long nominal_sq = (long)nominal_rate * nominal_rate;  // 16 bit int on the AVR, widen before the product
+  long initial_sq = initial_rate * initial_rate;
+  long final_sq = final_rate * final_rate;
+  float half_inverse_acceleration = 0.0;
+  if (integer_math) {
+    half_inverse_acceleration = 0.5 / acceleration;
+    accelerate_steps = ceil((nominal_sq - initial_sq) * half_inverse_acceleration);
+    decelerate_steps = floor((nominal_sq - final_sq) * half_inverse_acceleration);
+  }
+  else
+#endif
+  {
+    accelerate_steps = ceil(estimate_acceleration_distance(initial_rate, nominal_rate, acceleration));
+    decelerate_steps = floor(estimate_acceleration_distance(nominal_rate, final_rate, -acceleration));
+  }
+
+  // Calculate the size of Plateau of Nominal Rate.
+  int32_t plateau_steps = step_event_count-accelerate_steps-decelerate_steps;
+
+  // Is the Plateau of Nominal Rate smaller than nothing? That means no cruising, and we will
+  // have to use intersection_distance() to calculate when to abort acceleration and start braking
+  // in order to reach the final_rate exactly at the end of this block.
+  if (plateau_steps < 0) {
+    PLANNER_BENCH_COUNT(PLANNER_BENCH_INTERSECTION);
+#ifdef FAST_TRAPEZOID
+    if (integer_math)
+      accelerate_steps = ceil((step_event_count + (final_sq - initial_sq) * half_inverse_acceleration) * 0.5);
+    else
+#endif
+    accelerate_steps = ceil(intersection_distance(initial_rate, final_rate, acceleration, step_event_count));
+    accelerate_steps = max(accelerate_steps,0); // Check limits due to numerical round-off
+    accelerate_steps = min(accelerate_steps,(int32_t)step_event_count);
+    plateau_steps = 0;
+  }
+
+  // A block slower than the minimal step rate gets step indexes outside of the block,
+  // keep them within it so they fit the 16 bit fields.
+  decelerate_after = constrain(accelerate_steps+plateau_steps, 0, (int32_t)step_event_count);
+  accelerate_steps = constrain(accelerate_steps, 0, (int32_t)step_event_count);
+}
+
+#ifdef PLANNER_BENCHMARK
+void planner_bench_trapezoid(uint16_t step_event_count, uint16_t nominal_rate, unsigned long initial_rate, unsigned long final_rate,
+    float acceleration, bool integer_math, int32_t &accelerate_until, int32_t &decelerate_after)
+{
+  trapezoid_steps(step_event_count, nominal_rate, initial_rate, final_rate, acceleration, integer_math, accelerate_until, decelerate_after);
+}
+#endif
+
 // Calculates trapezoid parameters so that the entry- and exit-speed is compensated by the provided factors.
 
 static void calculate_trapezoid_for_block(block_t *block, float entry_factor, float exit_factor) {
+  PLANNER_BENCH_COUNT(PLANNER_BENCH_TRAPEZOID);
   unsigned long initial_rate = ceil(block->nominal_rate*entry_factor); // (step/min)
   unsigned long final_rate = ceil(block->nominal_rate*exit_factor); // (step/min)
 
@@ -179,24 +249,17 @@ static void calculate_trapezoid_for_block(block_t *block, float entry_factor, fl
     final_rate=120;
   }
 
-  long acceleration = block->acceleration_st;
-  int32_t accelerate_steps =
-    ceil(estimate_acceleration_distance(initial_rate, block->nominal_rate, acceleration));
-  int32_t decelerate_steps =
-    floor(estimate_acceleration_distance(block->nominal_rate, final_rate, -acceleration));
-
-  // Calculate the size of Plateau of Nominal Rate.
-  int32_t plateau_steps = block->step_event_count-accelerate_steps-decelerate_steps;
-
-  // Is the Plateau of Nominal Rate smaller than nothing? That means no cruising, and we will
-  // have to use intersection_distance() to calculate when to abort acceleration and start braking
-  // in order to reach the final_rate exactly at the end of this block.
-  if (plateau_steps < 0) {
-    accelerate_steps = ceil(intersection_distance(initial_rate, final_rate, acceleration, block->step_event_count));
-    accelerate_steps = max(accelerate_steps,0); // Check limits due to numerical round-off
-    accelerate_steps = min((uint32_t)accelerate_steps,block->step_event_count);//(We can cast here to unsigned, because the above line ensures that we are above zero)
-    plateau_steps = 0;
-  }
+  float acceleration = block->acceleration_rate * ((F_CPU / 8.0) / 16777216.0); // The steps/sec^2 the stepper runs at
+  int32_t accelerate_steps;
+  int32_t decelerate_after;
+#ifdef FAST_TRAPEZOID
+  // The squares of the rates fit a long up to 46340 steps/s, faster blocks use the float math.
+  bool integer_math = acceleration > 0 && block->nominal_rate <= 46340 && initial_rate <= 46340 && final_rate <= 46340;
+#else
+  bool integer_math = false;
+#endif
+  trapezoid_steps(block->step_event_count, block->nominal_rate, initial_rate, final_rate, acceleration, integer_math,
+      accelerate_steps, decelerate_after);
 
 #ifdef ADVANCE
   volatile long initial_advance = block->advance*entry_factor*entry_factor;
@@ -208,7 +271,7 @@ static void calculate_trapezoid_for_block(block_t *block, float entry_factor, fl
   CRITICAL_SECTION_START;  // Fill variables used by the stepper in a critical section
   if(block->busy == false) { // Don't update variables if block is busy.
     block->accelerate_until = accelerate_steps;
-    block->decelerate_after = accelerate_steps+plateau_steps;
+    block->decelerate_after = decelerate_after;
     block->initial_rate = initial_rate;
     block->final_rate = final_rate;
 #ifdef ADVANCE
@@ -220,9 +283,10 @@ static void calculate_trapezoid_for_block(block_t *block, float entry_factor, fl
 }
 
 // Calculates the maximum allowable speed at this point when you must be able to reach target_velocity using the
-// acceleration within the allotted distance.
-FORCE_INLINE float max_allowable_speed(float acceleration, float target_velocity, float distance) {
-  return  sqrt(target_velocity*target_velocity-2*acceleration*distance);
+// acceleration within the allotted distance, given as speed_sq_change = 2*acceleration*distance.
+FORCE_INLINE float max_allowable_speed(float speed_sq_change, float target_velocity) {
+  PLANNER_BENCH_COUNT(PLANNER_BENCH_JUNCTION);
+  return  sqrt(target_velocity*target_velocity+speed_sq_change);
 }
 
 // "Junction jerk" in this context is the immediate change in speed at the junction of two blocks.
@@ -235,108 +299,97 @@ FORCE_INLINE float max_allowable_speed(float acceleration, float target_velocity
 
 
 // The kernel called by planner_recalculate() when scanning the plan from last to first entry.
-static void planner_reverse_pass_kernel(block_t *previous, block_t *current, block_t *next) {
-  if(!current) {
-    return;
-  }
-
-  if (next) {
-    // If entry speed is already at the maximum entry speed, no need to recheck. Block is cruising.
-    // If not, block in state of acceleration or deceleration. Reset entry speed to maximum and
-    // check for maximum allowable speed reductions to ensure maximum possible planned speed.
-    if (current->entry_speed != current->max_entry_speed) {
-
-      // If nominal length true, max junction speed is guaranteed to be reached. Only compute
-      // for max allowable speed if block is decelerating and nominal length is false.
-      if ((!current->nominal_length_flag) && (current->max_entry_speed > next->entry_speed)) {
-        current->entry_speed = min( current->max_entry_speed,
-        max_allowable_speed(-current->acceleration,next->entry_speed,current->millimeters));
-      }
-      else {
-        current->entry_speed = current->max_entry_speed;
-      }
+static void planner_reverse_pass_kernel(block_t *current, block_t *next) {
+  // If entry speed is already at the maximum entry speed, no need to recheck. Block is cruising.
+  // If not, block in state of acceleration or deceleration. Reset entry speed to maximum and
+  // check for maximum allowable speed reductions to ensure maximum possible planned speed.
+  if (current->entry_speed != current->max_entry_speed) {
+    float entry_speed;
+
+    // If nominal length true, max junction speed is guaranteed to be reached. Only compute
+    // for max allowable speed if block is decelerating and nominal length is false.
+    if ((!current->nominal_length_flag) && (current->max_entry_speed > next->entry_speed)) {
+      // Not directly in min(), that would evaluate the sqrt twice.
+      entry_speed = max_allowable_speed(current->speed_sq_change,next->entry_speed);
+      entry_speed = min(current->max_entry_speed, entry_speed);
+    }
+    else {
+      entry_speed = current->max_entry_speed;
+    }
+    if (current->entry_speed != entry_speed) {
+      current->entry_speed = entry_speed;
       current->recalculate_flag = true;
-
     }
-  } // Skip last block. Already initialized and set for recalculation.
+  }
 }
 
 // planner_recalculate() needs to go over the current plan twice. Once in reverse and once forward. This
-// implements the reverse pass.
-static void planner_reverse_pass() {
-  uint8_t block_index = block_buffer_head;
-
-  //Make a local copy of block_buffer_tail, because the interrupt can alter it
-  CRITICAL_SECTION_START
-  unsigned char tail = block_buffer_tail;
-  CRITICAL_SECTION_END
-
-  if(((block_buffer_head-tail + BLOCK_BUFFER_SIZE) & (BLOCK_BUFFER_SIZE - 1)) > 3) {
-    block_index = (block_buffer_head - 3) & (BLOCK_BUFFER_SIZE - 1);
-    block_t *block[3] = {
-      NULL, NULL, NULL         };
-    while(block_index != tail) {
-      block_index = prev_block_index(block_index);
-      block[2]= block[1];
-      block[1]= block[0];
-      block[0] = &block_buffer[block_index];
-      planner_reverse_pass_kernel(block[0], block[1], block[2]);
-    }
+// implements the reverse pass, from the newest block back to the last optimally planned block.
+// The newest block is already planned to decelerate to MINIMUM_PLANNER_SPEED by plan_buffer_line().
+static void planner_reverse_pass(uint8_t planned) {
+  uint8_t block_index = prev_block_index(block_buffer_head);
+  if (block_index == planned) {
+    return;
+  }
+  block_t *next = &block_buffer[block_index];
+  for(block_index = prev_block_index(block_index); block_index != planned; block_index = prev_block_index(block_index)) {
+    block_t *current = &block_buffer[block_index];
+    PLANNER_BENCH_COUNT(PLANNER_BENCH_BLOCK);
+    planner_reverse_pass_kernel(current, next);
+    next = current;
   }
 }
 
 // The kernel called by planner_recalculate() when scanning the plan from first to last entry.
-static void planner_forward_pass_kernel(block_t *previous, block_t *current, block_t *next) {
-  if(!previous) {
-    return;
-  }
-
+// Returns true when the entry speed of the current block can not be raised by any block added later:
+// it is at its maximum, or it is limited by the acceleration over the (optimally planned) previous block.
+static bool planner_forward_pass_kernel(block_t *previous, block_t *current) {
   // If the previous block is an acceleration block, but it is not long enough to complete the
   // full speed change within the block, we need to adjust the entry speed accordingly. Entry
   // speeds have already been reset, maximized, and reverse planned by reverse planner.
   // If nominal length is true, max junction speed is guaranteed to be reached. No need to recheck.
   if (!previous->nominal_length_flag) {
     if (previous->entry_speed < current->entry_speed) {
-      double entry_speed = min( current->entry_speed,
-      max_allowable_speed(-previous->acceleration,previous->entry_speed,previous->millimeters) );
+      float entry_speed = max_allowable_speed(previous->speed_sq_change,previous->entry_speed);
 
       // Check for junction speed change
-      if (current->entry_speed != entry_speed) {
+      if (entry_speed < current->entry_speed) {
         current->entry_speed = entry_speed;
         current->recalculate_flag = true;
+        return true;
       }
     }
   }
+  return current->entry_speed == current->max_entry_speed;
 }
 
 // planner_recalculate() needs to go over the current plan twice. Once in reverse and once forward. This
-// implements the forward pass.
-void planner_forward_pass() {
-  uint8_t block_index = block_buffer_tail;
-  block_t *block[3] = {
-    NULL, NULL, NULL   };
-
-  while(block_index != block_buffer_head) {
-    block[0] = block[1];
-    block[1] = block[2];
-    block[2] = &block_buffer[block_index];
-    planner_forward_pass_kernel(block[0],block[1],block[2]);
-    block_index = next_block_index(block_index);
+// implements the forward pass, from the last optimally planned block on. Returns the new last optimally planned block.
+static uint8_t planner_forward_pass(uint8_t planned) {
+  uint8_t block_index = planned;
+  block_t *previous = &block_buffer[block_index];
+  for(block_index = next_block_index(block_index); block_index != block_buffer_head; block_index = next_block_index(block_index)) {
+    block_t *current = &block_buffer[block_index];
+    PLANNER_BENCH_COUNT(PLANNER_BENCH_BLOCK);
+    if (planner_forward_pass_kernel(previous, current)) {
+      planned = block_index;
+    }
+    previous = current;
   }
-  planner_forward_pass_kernel(block[1], block[2], NULL);
+  return planned;
 }
 
-// Recalculates the trapezoid speed profiles for all blocks in the plan according to the
-// entry_factor for each junction. Must be called by planner_recalculate() after
-// updating the blocks.
-void planner_recalculate_trapezoids() {
-  int8_t block_index = block_buffer_tail;
+// Recalculates the trapezoid speed profiles for flagged blocks in the plan according to the
+// entry_factor for each junction. Starts at the last optimally planned block, the blocks before
+// it did not change. Must be called by planner_recalculate() after updating the blocks.
+static void planner_recalculate_trapezoids(uint8_t block_index) {
   block_t *current;
   block_t *next = NULL;
 
   while(block_index != block_buffer_head) {
     current = next;
     next = &block_buffer[block_index];
+    PLANNER_BENCH_COUNT(PLANNER_BENCH_BLOCK);
     if (current) {
       // Recalculate if current block entry or exit junction speed has changed.
       if (current->recalculate_flag || next->recalculate_flag) {
@@ -356,6 +409,18 @@ void planner_recalculate_trapezoids() {
   }
 }
 
+// The stepper moves block_buffer_planned along when it discards that block,
+// so only move it forward when the new optimal block is still in the buffer.
+static void planner_set_planned(uint8_t optimal) {
+  CRITICAL_SECTION_START
+  uint8_t moves_queued = (block_buffer_head - block_buffer_tail) & (BLOCK_BUFFER_SIZE - 1);
+  uint8_t optimal_index = (optimal - block_buffer_tail) & (BLOCK_BUFFER_SIZE - 1);
+  if (optimal_index < moves_queued && optimal_index > ((block_buffer_planned - block_buffer_tail) & (BLOCK_BUFFER_SIZE - 1))) {
+    block_buffer_planned = optimal;
+  }
+  CRITICAL_SECTION_END
+}
+
 // Recalculates the motion plan according to the following algorithm:
 //
 //   1. Go over every block in reverse order and calculate a junction speed reduction (i.e. block_t.entry_factor)
@@ -371,12 +436,26 @@ void planner_recalculate_trapezoids() {
 // be performed using only the one, true constant acceleration, and where no junction jerk is jerkier than
 // the set limit. Finally it will:
 //
-//   3. Recalculate trapezoids for all blocks.
+//   3. Recalculate trapezoids for all blocks that changed.
+//
+// The passes stop at block_buffer_planned, the last block with an entry speed that no later block can raise.
+// It is at its maximum entry speed, or it accelerates at the full rate from an optimally planned block before it.
+// So a new block only reprocesses the blocks after it, instead of the whole buffer.
 
 void planner_recalculate() {
-  planner_reverse_pass();
-  planner_forward_pass();
-  planner_recalculate_trapezoids();
+  CRITICAL_SECTION_START
+  uint8_t planned = block_buffer_planned;
+  CRITICAL_SECTION_END
+
+  PLANNER_BENCH_SECTION(PLANNER_BENCH_REVERSE_PASS);
+  planner_reverse_pass(planned);
+  PLANNER_BENCH_SECTION(PLANNER_BENCH_FORWARD_PASS);
+  uint8_t optimal = planner_forward_pass(planned);
+  PLANNER_BENCH_SECTION(PLANNER_BENCH_TRAPEZOIDS);
+  planner_recalculate_trapezoids(planned);
+  PLANNER_BENCH_SECTION(PLANNER_BENCH_NONE);
+
+  planner_set_planned(optimal);
 }
 
 void plan_init()
@@ -384,6 +463,7 @@ void plan_init()
   CRITICAL_SECTION_START
   block_buffer_head = 0;
   block_buffer_tail = 0;
+  block_buffer_planned = 0;
   CRITICAL_SECTION_END
   memset(position, 0, sizeof(position)); // clear position
   previous_speed[0] = 0.0;
@@ -536,19 +616,21 @@ void check_axes_activity()
 // float junction_deviation = 0.1;
 #define JUNCTION_DEVIATION  0.1f
 
+static void plan_buffer_block(const long *target, float feed_rate, const uint8_t extruder);
+
 // Add a new linear movement to the buffer. x, y and z is the signed, absolute target position in
 // millimeters. Feed rate specifies the speed of the motion.
 void plan_buffer_line(const float &x, const float &y, const float &z, const float &e, float feed_rate, const uint8_t extruder)
 {
-  // Calculate the buffer head after we push this byte
-  uint8_t next_buffer_head = next_block_index(block_buffer_head);
-
   // If the buffer is full: good! That means we are well ahead of the robot.
   // Rest here until there is room in the buffer.
-  while(block_buffer_tail == next_buffer_head)
+  while(block_buffer_tail == next_block_index(block_buffer_head))
   {
     idle();
   }
+#ifdef PLANNER_BENCHMARK
+  planner_bench_line(x, y, z, e, feed_rate, extruder);
+#endif
 
   // The target position of the tool in absolute steps
   // Calculate target position in absolute steps
@@ -559,6 +641,15 @@ void plan_buffer_line(const float &x, const float &y, const float &z, const floa
   target[Z_AXIS] = lround(z*axis_steps_per_unit[Z_AXIS]);
   target[E_AXIS] = lround(e*e_steps_per_unit(extruder)*volume_to_filament_length[extruder]);
 
+#ifdef LIN_ADVANCE
+  // Start over from the rounded position after G92 or a change of the steps per mm
+  if (fabs(position_e_exact - position[E_AXIS]) > 1.0)
+    position_e_exact = position[E_AXIS];
+  float target_e_exact = e*e_steps_per_unit(extruder)*volume_to_filament_length[extruder];
+  block_e_exact = fabs(target_e_exact - position_e_exact) * extrudemultiply[extruder] / 100;
+  position_e_exact = target_e_exact;
+#endif
+
   #ifdef PREVENT_DANGEROUS_EXTRUDE
   if(target[E_AXIS]!=position[E_AXIS])
   {
@@ -580,6 +671,62 @@ void plan_buffer_line(const float &x, const float &y, const float &z, const floa
   }
   #endif
 
+  // The step counts of a block are 16 bit. Longer moves (like loading filament) are split in equal pieces
+  // of at most half that, so the rounding of the pieces and the extrude multiplier can not overflow them.
+#ifndef COREXY
+  long steps = max(labs(target[X_AXIS]-position[X_AXIS]), labs(target[Y_AXIS]-position[Y_AXIS]));
+#else
+  long steps = max(labs((target[X_AXIS]-position[X_AXIS]) + (target[Y_AXIS]-position[Y_AXIS])),
+                   labs((target[X_AXIS]-position[X_AXIS]) - (target[Y_AXIS]-position[Y_AXIS])));
+#endif
+  steps = max(steps, labs(target[Z_AXIS]-position[Z_AXIS]));
+  steps = max(steps, labs(target[E_AXIS]-position[E_AXIS]) * extrudemultiply[extruder] / 100);
+  if (steps > MAX_STEPS_PER_BLOCK)
+  {
+    uint16_t pieces = steps / (MAX_STEPS_PER_BLOCK / 2) + 1;
+    // With an empty buffer the stepper would start on the first piece before the next one is planned,
+    // and stop at its end. Hold it off until all pieces are in, when they fit.
+    if (!blocks_queued() && pieces < BLOCK_BUFFER_SIZE)
+    {
+      st_sleep();
+      stepper_held = true;
+    }
+#ifdef LIN_ADVANCE
+    block_e_exact /= pieces;
+#endif
+    long start[NUM_AXIS];
+    memcpy(start, position, sizeof(start));
+    for(uint16_t n = 1; n < pieces; n++)
+    {
+      long piece[NUM_AXIS];
+      for(uint8_t i = 0; i < NUM_AXIS; i++)
+      {
+        long delta = target[i] - start[i];
+        piece[i] = start[i] + delta / pieces * n + delta % pieces * n / pieces;
+      }
+      plan_buffer_block(piece, feed_rate, extruder);
+    }
+  }
+  plan_buffer_block(target, feed_rate, extruder);
+  if (stepper_held)
+  {
+    stepper_held = false;
+    st_wake_up();
+  }
+}
+
+// Add a block moving from position to target, in absolute steps.
+static void plan_buffer_block(const long *target, float feed_rate, const uint8_t extruder)
+{
+  // Calculate the buffer head after we push this byte
+  uint8_t next_buffer_head = next_block_index(block_buffer_head);
+
+  // Wait for room again, a split move needs a block per piece.
+  while(block_buffer_tail == next_buffer_head)
+  {
+    idle();
+  }
+
   // Prepare to set up new block
   block_t *block = &block_buffer[block_buffer_head];
 
@@ -598,9 +745,7 @@ block->steps_x = labs((target[X_AXIS]-position[X_AXIS]) + (target[Y_AXIS]-positi
 block->steps_y = labs((target[X_AXIS]-position[X_AXIS]) - (target[Y_AXIS]-position[Y_AXIS]));
 #endif
   block->steps_z = labs(target[Z_AXIS]-position[Z_AXIS]);
-  block->steps_e = labs(target[E_AXIS]-position[E_AXIS]);
-  block->steps_e *= extrudemultiply[extruder];
-  block->steps_e /= 100;
+  block->steps_e = labs(target[E_AXIS]-position[E_AXIS]) * extrudemultiply[extruder] / 100;
   block->step_event_count = max(block->steps_x, max(block->steps_y, max(block->steps_z, block->steps_e)));
 
   // Bail if this is a zero-length block
@@ -691,15 +836,16 @@ block->steps_y = labs((target[X_AXIS]-position[X_AXIS]) - (target[Y_AXIS]-positi
   #endif
   delta_mm[Z_AXIS] = (target[Z_AXIS]-position[Z_AXIS])/axis_steps_per_unit[Z_AXIS];
   delta_mm[E_AXIS] = ((target[E_AXIS]-position[E_AXIS])/e_steps_per_unit(extruder))*float(extrudemultiply[extruder])/100.0;
+  float millimeters;
   if ( block->steps_x <=dropsegments && block->steps_y <=dropsegments && block->steps_z <=dropsegments )
   {
-    block->millimeters = fabs(delta_mm[E_AXIS]);
+    millimeters = fabs(delta_mm[E_AXIS]);
   }
   else
   {
-    block->millimeters = sqrt(square(delta_mm[X_AXIS]) + square(delta_mm[Y_AXIS]) + square(delta_mm[Z_AXIS]));
+    millimeters = sqrt(square(delta_mm[X_AXIS]) + square(delta_mm[Y_AXIS]) + square(delta_mm[Z_AXIS]));
   }
-  float inverse_millimeters = 1.0/block->millimeters;  // Inverse millimeters to remove multiple divides
+  float inverse_millimeters = 1.0/millimeters;  // Inverse millimeters to remove multiple divides
 
     // Calculate speed in mm/second for each axis. No divide by zero due to previous checks.
   float inverse_second = feed_rate * inverse_millimeters;
@@ -729,8 +875,8 @@ block->steps_y = labs((target[X_AXIS]-position[X_AXIS]) - (target[Y_AXIS]-positi
   //  END OF SLOW DOWN SECTION
 
 
-  block->nominal_speed = block->millimeters * inverse_second; // (mm/sec) Always > 0
-  block->nominal_rate = ceil(block->step_event_count * inverse_second); // (step/sec) Always > 0
+  block->nominal_speed = millimeters * inverse_second; // (mm/sec) Always > 0
+  unsigned long nominal_rate = ceil(block->step_event_count * inverse_second); // (step/sec) Always > 0
 
   // Calculate and limit speed in mm/sec for each axis
   float current_speed[NUM_AXIS];
@@ -785,31 +931,35 @@ block->steps_y = labs((target[X_AXIS]-position[X_AXIS]) - (target[Y_AXIS]-positi
       current_speed[i] *= speed_factor;
     }
     block->nominal_speed *= speed_factor;
-    block->nominal_rate *= speed_factor;
+    nominal_rate *= speed_factor;
   }
+  // The stepper does not go faster than MAX_STEP_FREQUENCY anyway
+  block->nominal_rate = min(nominal_rate, 0xFFFF);
 
   // Compute and limit the acceleration rate for the trapezoid generator.
-  float steps_per_mm = block->step_event_count/block->millimeters;
+  float steps_per_mm = block->step_event_count/millimeters;
+  unsigned long acceleration_st;
   if(block->steps_x == 0 && block->steps_y == 0 && block->steps_z == 0)
   {
-    block->acceleration_st = ceil(retract_acceleration * steps_per_mm); // convert to: acceleration steps/sec^2
+    acceleration_st = ceil(retract_acceleration * steps_per_mm); // convert to: acceleration steps/sec^2
   }
   else {
-    block->acceleration_st = ceil(acceleration * steps_per_mm); // convert to: acceleration steps/sec^2
+    acceleration_st = ceil(acceleration * steps_per_mm); // convert to: acceleration steps/sec^2
   }
 
   // Limit acceleration per axis
-  if(((float)block->acceleration_st * (float)block->steps_x / (float)block->step_event_count) > axis_steps_per_sqr_second[X_AXIS])
-    block->acceleration_st = axis_steps_per_sqr_second[X_AXIS];
-  if(((float)block->acceleration_st * (float)block->steps_y / (float)block->step_event_count) > axis_steps_per_sqr_second[Y_AXIS])
-    block->acceleration_st = min(block->acceleration_st, axis_steps_per_sqr_second[Y_AXIS]);
-  if(((float)block->acceleration_st * (float)block->steps_z / (float)block->step_event_count ) > axis_steps_per_sqr_second[Z_AXIS])
-    block->acceleration_st = min(block->acceleration_st, axis_steps_per_sqr_second[Z_AXIS]);
-  if(((float)block->acceleration_st * (float)block->steps_e / (float)block->step_event_count) > axis_steps_per_sqr_second[E_AXIS+extruder])
-    block->acceleration_st = min(block->acceleration_st, axis_steps_per_sqr_second[E_AXIS+extruder]);
-
-  block->acceleration = block->acceleration_st / steps_per_mm;
-  block->acceleration_rate = (long)((float)block->acceleration_st * (16777216.0 / (F_CPU / 8.0)));
+  if(((float)acceleration_st * (float)block->steps_x / (float)block->step_event_count) > axis_steps_per_sqr_second[X_AXIS])
+    acceleration_st = axis_steps_per_sqr_second[X_AXIS];
+  if(((float)acceleration_st * (float)block->steps_y / (float)block->step_event_count) > axis_steps_per_sqr_second[Y_AXIS])
+    acceleration_st = min(acceleration_st, axis_steps_per_sqr_second[Y_AXIS]);
+  if(((float)acceleration_st * (float)block->steps_z / (float)block->step_event_count ) > axis_steps_per_sqr_second[Z_AXIS])
+    acceleration_st = min(acceleration_st, axis_steps_per_sqr_second[Z_AXIS]);
+  if(((float)acceleration_st * (float)block->steps_e / (float)block->step_event_count) > axis_steps_per_sqr_second[E_AXIS+extruder])
+    acceleration_st = min(acceleration_st, axis_steps_per_sqr_second[E_AXIS+extruder]);
+
+  float block_acceleration = acceleration_st / steps_per_mm;
+  block->speed_sq_change = 2*block_acceleration*millimeters;
+  block->acceleration_rate = (long)((float)acceleration_st * (16777216.0 / (F_CPU / 8.0)));
 
 #if 0  // Use old jerk for now
   // Compute path unit vector
@@ -846,7 +996,7 @@ block->steps_y = labs((target[X_AXIS]-position[X_AXIS]) - (target[Y_AXIS]-positi
         // Compute maximum junction velocity based on maximum acceleration and junction deviation
         double sin_theta_d2 = sqrt(0.5*(1.0-cos_theta)); // Trig half angle identity. Always positive.
         vmax_junction = min(vmax_junction,
-        sqrt(block->acceleration * JUNCTION_DEVIATION * sin_theta_d2/(1.0-sin_theta_d2)) );
+        sqrt(block_acceleration * JUNCTION_DEVIATION * sin_theta_d2/(1.0-sin_theta_d2)) );
       }
     }
   }
@@ -861,7 +1011,8 @@ block->steps_y = labs((target[X_AXIS]-position[X_AXIS]) - (target[Y_AXIS]-positi
   vmax_junction = min(vmax_junction, block->nominal_speed);
   float safe_speed = vmax_junction;
 
-  if ((moves_queued > 1) && (previous_nominal_speed > 0.0001)) {
+  // A single queued block may already be running, unless the stepper is held.
+  if ((moves_queued > 1 || (moves_queued > 0 && stepper_held)) && (previous_nominal_speed > 0.0001)) {
     float xy_jerk = sqrt(square(current_speed[X_AXIS]-previous_speed[X_AXIS])+square(current_speed[Y_AXIS]-previous_speed[Y_AXIS]));
     //    if((fabs(previous_speed[X_AXIS]) > 0.0001) || (fabs(previous_speed[Y_AXIS]) > 0.0001)) {
     vmax_junction = block->nominal_speed;
@@ -880,7 +1031,7 @@ block->steps_y = labs((target[X_AXIS]-position[X_AXIS]) - (target[Y_AXIS]-positi
   block->max_entry_speed = vmax_junction;
 
   // Initialize block entry speed. Compute based on deceleration to user-defined MINIMUM_PLANNER_SPEED.
-  double v_allowable = max_allowable_speed(-block->acceleration,MINIMUM_PLANNER_SPEED,block->millimeters);
+  double v_allowable = max_allowable_speed(block->speed_sq_change,MINIMUM_PLANNER_SPEED);
   block->entry_speed = min(vmax_junction, v_allowable);
 
   // Initialize planner efficiency flags
@@ -911,7 +1062,7 @@ block->steps_y = labs((target[X_AXIS]-position[X_AXIS]) - (target[Y_AXIS]-positi
     block->advance = 0;
   }
   else {
-    long acc_dist = estimate_acceleration_distance(0, block->nominal_rate, block->acceleration_st);
+    long acc_dist = estimate_acceleration_distance(0, block->nominal_rate, acceleration_st);
     float advance = (STEPS_PER_CUBIC_MM_E * EXTRUDER_ADVANCE_K) *
       (current_speed[E_AXIS] * current_speed[E_AXIS] * EXTRUTION_AREA * EXTRUTION_AREA)*256;
     block->advance = advance;
@@ -931,6 +1082,18 @@ block->steps_y = labs((target[X_AXIS]-position[X_AXIS]) - (target[Y_AXIS]-positi
    */
 #endif // ADVANCE
 
+#ifdef LIN_ADVANCE
+  // The advance is K times the E step rate, which is the step event rate times the E steps per step event.
+  // Only printing moves get it, retracts and travels let the pressure go.
+  if (block->steps_e == 0 || (block->steps_x == 0 && block->steps_y == 0) || (block->direction_bits & (1<<E_AXIS)) || extruder_advance_k[extruder] <= 0) {
+    block->advance_lead = 0;
+  }
+  else {
+    float lead = extruder_advance_k[extruder] * block_e_exact / block->step_event_count * (1 << LIN_ADVANCE_SHIFT);
+    block->advance_lead = min(lead + 0.5, 0xFFFF);
+  }
+#endif // LIN_ADVANCE
+
   calculate_trapezoid_for_block(block, block->entry_speed/block->nominal_speed, safe_speed/block->nominal_speed);
 
   // Move buffer head
@@ -943,7 +1106,9 @@ block->steps_y = labs((target[X_AXIS]-position[X_AXIS]) - (target[Y_AXIS]-positi
 
   planner_recalculate();
 
-  st_wake_up();
+  // A split move wakes the stepper once its last piece is in, see plan_buffer_line()
+  if (!stepper_held)
+    st_wake_up();
 }
 
 void plan_set_position(const float &x, const float &y, const float &z, const float &e, const uint8_t extruder, bool bSynchronize)
@@ -957,6 +1122,9 @@ void plan_set_position(const float &x, const float &y, const float &z, const flo
   previous_speed[1] = 0.0;
   previous_speed[2] = 0.0;
   previous_speed[3] = 0.0;
+#ifdef PLANNER_BENCHMARK
+  planner_bench_set_position(x, y, z, e, extruder);
+#endif
   if (bSynchronize)
   {
     st_set_position(position[X_AXIS], position[Y_AXIS], position[Z_AXIS], position[E_AXIS]);
@@ -966,6 +1134,9 @@ void plan_set_position(const float &x, const float &y, const float &z, const flo
 void plan_set_e_position(const float &e, const uint8_t extruder, bool bSynchronize)
 {
   position[E_AXIS] = lround(e*e_steps_per_unit(extruder)*volume_to_filament_length[extruder]);
+#ifdef PLANNER_BENCHMARK
+  planner_bench_set_e_position(e, extruder);
+#endif
   if (bSynchronize)
   {
       st_set_e_position(position[E_AXIS]);
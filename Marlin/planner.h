@@ -28,45 +28,51 @@
 
 // This struct is used when buffering the setup for each linear movement "nominal" values are as specified in
 // the source g-code and may never actually be reached if acceleration management is active.
+// The layout is kept compact so more blocks fit in the same RAM: step counts and rates are stored in 16 bits,
+// values that can be derived from others are not stored. Longer moves are split by plan_buffer_line().
 typedef struct {
   // Fields used by the bresenham algorithm for tracing the line
-  long steps_x, steps_y, steps_z, steps_e;  // Step count along each axis
-  unsigned long step_event_count;           // The number of step events required to complete this block
-  long accelerate_until;                    // The index of the step event on which to stop acceleration
-  long decelerate_after;                    // The index of the step event on which to start decelerating
-  long acceleration_rate;                   // The acceleration rate used for acceleration calculation
-  unsigned char direction_bits;             // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
-  unsigned char active_extruder;            // Selects the active extruder
+  uint16_t steps_x, steps_y, steps_z, steps_e;  // Step count along each axis
+  uint16_t step_event_count;                    // The number of step events required to complete this block
+  uint16_t accelerate_until;                    // The index of the step event on which to stop acceleration
+  uint16_t decelerate_after;                    // The index of the step event on which to start decelerating
+  long acceleration_rate;                       // The acceleration rate used for acceleration calculation
+  unsigned char direction_bits;                 // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
+  unsigned char active_extruder;                // Selects the active extruder
   #ifdef ADVANCE
     long advance_rate;
     volatile long initial_advance;
     volatile long final_advance;
     float advance;
   #endif
+  #ifdef LIN_ADVANCE
+    uint16_t advance_lead;                      // E advance steps per step event/sec, LIN_ADVANCE_SHIFT fraction bits
+  #endif
 
   // Fields used by the motion planner to manage acceleration
 //  float speed_x, speed_y, speed_z, speed_e;        // Nominal mm/sec for each axis
   float nominal_speed;                               // The nominal speed for this block in mm/sec
   float entry_speed;                                 // Entry speed at previous-current junction in mm/sec
   float max_entry_speed;                             // Maximum allowable junction entry speed in mm/sec
-  float millimeters;                                 // The total travel of this block in mm
-  float acceleration;                                // acceleration mm/sec^2
-  unsigned char recalculate_flag;                    // Planner flag to recalculate trapezoids on entry junction
-  unsigned char nominal_length_flag;                 // Planner flag for nominal speed always reached
-
-  // Settings for the trapezoid generator
-  unsigned long nominal_rate;                        // The nominal step rate for this block in step_events/sec
-  unsigned long initial_rate;                        // The jerk-adjusted step rate at start of block
-  unsigned long final_rate;                          // The minimal rate at exit
-  unsigned long acceleration_st;                     // acceleration steps/sec^2
-  unsigned long fan_speed;
+  float speed_sq_change;                             // 2 * acceleration * millimeters, the change of speed^2 over the block
+  unsigned char recalculate_flag : 1;                // Planner flag to recalculate trapezoids on entry junction
+  unsigned char nominal_length_flag : 1;             // Planner flag for nominal speed always reached
+
+  // Settings for the trapezoid generator, the acceleration in steps/sec^2 follows from acceleration_rate
+  uint16_t nominal_rate;                             // The nominal step rate for this block in step_events/sec
+  uint16_t initial_rate;                             // The jerk-adjusted step rate at start of block
+  uint16_t final_rate;                               // The minimal rate at exit
+  unsigned char fan_speed;
   #ifdef BARICUDA
-  unsigned long valve_pressure;
-  unsigned long e_to_p_pressure;
+  unsigned char valve_pressure;
+  unsigned char e_to_p_pressure;
   #endif
   volatile char busy;
 } block_t;
 
+// The largest step count of a block
+#define MAX_STEPS_PER_BLOCK 0xFFFF
+
 // Initialize the motion plan subsystem
 void plan_init();
 
@@ -102,6 +108,10 @@ FORCE_INLINE float e_steps_per_unit(uint8_t e) {return (e ? e2_steps_per_unit :
 FORCE_INLINE float e_steps_per_unit(uint8_t e) {return axis_steps_per_unit[E_AXIS];}
 #endif
 
+#ifdef LIN_ADVANCE
+extern float extruder_advance_k[EXTRUDERS]; // Linear advance K in s, set from the material at the print start or M900
+#endif
+
 #ifdef AUTOTEMP
     extern bool autotemp_enabled;
     extern float autotemp_max;
@@ -112,11 +122,15 @@ FORCE_INLINE float e_steps_per_unit(uint8_t e) {return axis_steps_per_unit[E_AXI
 extern block_t block_buffer[BLOCK_BUFFER_SIZE];            // A ring buffer for motion instructions
 extern volatile unsigned char block_buffer_head;           // Index of the next block to be pushed
 extern volatile unsigned char block_buffer_tail;
+extern volatile unsigned char block_buffer_planned;        // Index of the last optimally planned block
 // Called when the current block is no longer needed. Discards the block and makes the memory
 // available for new blocks.
 FORCE_INLINE void plan_discard_current_block()
 {
   if (block_buffer_head != block_buffer_tail) {
+    if (block_buffer_planned == block_buffer_tail) {
+      block_buffer_planned = (block_buffer_tail + 1) & (BLOCK_BUFFER_SIZE - 1);
+    }
     block_buffer_tail = (block_buffer_tail + 1) & (BLOCK_BUFFER_SIZE - 1);
   }
 }
@@ -148,4 +162,38 @@ float get_extrude_min_temp();
 #endif
 
 void reset_acceleration_rates();
+
+#ifdef PLANNER_BENCHMARK
+// Hooks for the planner benchmark of the headless simulator (MarlinSimulator/plannerbench.cpp).
+// The time and cpu cycles spent in the planner are accounted to the current section,
+// the counted operations are used to estimate the cost of the floating point math on the AVR.
+#define PLANNER_BENCH_NONE          0
+#define PLANNER_BENCH_LINE          1//plan_buffer_line() without the planner passes
+#define PLANNER_BENCH_REVERSE_PASS  2
+#define PLANNER_BENCH_FORWARD_PASS  3
+#define PLANNER_BENCH_TRAPEZOIDS    4
+#define PLANNER_BENCH_SECTIONS      5
+
+#define PLANNER_BENCH_BLOCK         0//Block visited by one of the passes
+#define PLANNER_BENCH_JUNCTION      1//max_allowable_speed()
+#define PLANNER_BENCH_TRAPEZOID     2//calculate_trapezoid_for_block()
+#define PLANNER_BENCH_INTERSECTION  3//Trapezoid without plateau
+#define PLANNER_BENCH_OPERATIONS    4
+
+void planner_bench_line(const float &x, const float &y, const float &z, const float &e, float feed_rate, uint8_t extruder);
+void planner_bench_set_position(const float &x, const float &y, const float &z, const float &e, uint8_t extruder);
+void planner_bench_set_e_position(const float &e, uint8_t extruder);
+void planner_bench_section(uint8_t section);
+// The accelerate_until and decelerate_after of calculate_trapezoid_for_block(), with the integer math of FAST_TRAPEZOID or the float math.
+void planner_bench_trapezoid(uint16_t step_event_count, uint16_t nominal_rate, unsigned long initial_rate, unsigned long final_rate,
+    float acceleration, bool integer_math, int32_t &accelerate_until, int32_t &decelerate_after);
+extern unsigned long planner_bench_count[PLANNER_BENCH_SECTIONS][PLANNER_BENCH_OPERATIONS];
+extern uint8_t planner_bench_current;
+#define PLANNER_BENCH_SECTION(section) planner_bench_section(section)
+#define PLANNER_BENCH_COUNT(operation) planner_bench_count[planner_bench_current][operation]++
+#else
+#define PLANNER_BENCH_SECTION(section)
+#define PLANNER_BENCH_COUNT(operation)
+#endif
+
 #endif
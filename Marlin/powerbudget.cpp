@@ -1,6 +1,7 @@
 #include "Configuration.h"
 #include "Marlin.h"
 #include "powerbudget.h"
+#include "eeprom_journal.h"
 
 #ifdef ENABLE_ULTILCD2
 #include "UltiLCD2_hi_lib.h"
@@ -11,6 +12,54 @@ uint16_t power_budget=DEFAULT_POWER_BUDGET;
 uint16_t power_buildplate=DEFAULT_POWER_BUILDPLATE;
 uint16_t power_extruder[EXTRUDERS]=ARRAY_BY_EXTRUDERS(DEFAULT_POWER_EXTRUDER, DEFAULT_POWER_EXTRUDER, DEFAULT_POWER_EXTRUDER);
 
+void PowerBudget_Allocate(uint16_t budget, const uint16_t *wattage, const uint16_t *priority, uint8_t *pwm, uint8_t count)
+{
+    uint16_t power[EXTRUDERS + 1];
+    uint32_t total = 0;
+    // heaters that still wait for their part of the budget
+    uint8_t open = 0;
+    for (uint8_t i=0; i<count; ++i)
+    {
+        power[i] = (uint32_t(pwm[i]) * wattage[i]) / 0x7f;
+        total += power[i];
+        if (!wattage[i] || !budget)
+            pwm[i] = 0;
+        else if (pwm[i])
+            open |= _BV(i);
+    }
+    if (total <= budget)
+        return;
+
+    while (open)
+    {
+        uint32_t weight = 0;
+        for (uint8_t i=0; i<count; ++i)
+            if (open & _BV(i))
+                weight += priority[i];
+
+        // every heater that asks for less than its share gets all of it, the rest is shared again
+        uint8_t served = 0;
+        uint16_t used = 0;
+        for (uint8_t i=0; i<count; ++i)
+        {
+            if ((open & _BV(i)) && power[i] * weight <= uint32_t(budget) * priority[i])
+            {
+                served |= _BV(i);
+                used += power[i];
+            }
+        }
+        if (!served)
+        {
+            for (uint8_t i=0; i<count; ++i)
+                if (open & _BV(i))
+                    pwm[i] = (uint32_t(budget) * priority[i] / weight) * 0x7f / wattage[i];
+            break;
+        }
+        open &= ~served;
+        budget -= used;
+    }
+}
+
 
 /////
 
@@ -37,11 +86,11 @@ uint16_t power_extruder[EXTRUDERS]=ARRAY_BY_EXTRUDERS(DEFAULT_POWER_EXTRUDER, DE
 
 static bool PowerBudget_RetrieveVersion(uint16_t &version)
 {
-    uint32_t magic = eeprom_read_dword((uint32_t*)(EEPROM_POWER_START));
-    char postfix = eeprom_read_byte((const uint8_t*)EEPROM_POWER_POSTFIX);
+    uint32_t magic = eeprom_journal_read_dword((uint32_t*)(EEPROM_POWER_START));
+    char postfix = eeprom_journal_read_byte((const uint8_t*)EEPROM_POWER_POSTFIX);
     if ((magic == EEPROM_POWER_MAGIC) && (postfix == POWER_POSTFIX))
     {
-        version = eeprom_read_word((const uint16_t*)EEPROM_POWER_VERSION);
+        version = eeprom_journal_read_word((const uint16_t*)EEPROM_POWER_VERSION);
         return true;
     }
     return false;
@@ -50,7 +99,7 @@ static bool PowerBudget_RetrieveVersion(uint16_t &version)
 //void PowerBudget_ClearStorage()
 //{
 //    // invalidate data
-//    eeprom_write_dword((uint32_t*)(EEPROM_WATTAGE_START), 0);
+//    eeprom_journal_write_dword((uint32_t*)(EEPROM_WATTAGE_START), 0);
 //}
 
 void PowerBudget_RetrieveSettings()
@@ -60,12 +109,12 @@ void PowerBudget_RetrieveSettings()
     bool bValid = PowerBudget_RetrieveVersion(version);
     if (bValid)
     {
-        power_budget     = eeprom_read_word((const uint16_t*)EEPROM_POWER_BUDGET);
-        power_buildplate = eeprom_read_word((const uint16_t*)EEPROM_POWER_BUILDPATE);
+        power_budget     = eeprom_journal_read_word((const uint16_t*)EEPROM_POWER_BUDGET);
+        power_buildplate = eeprom_journal_read_word((const uint16_t*)EEPROM_POWER_BUILDPATE);
 
         // read extruder wattage
         uint16_t tmp_array[2];
-        eeprom_read_block(tmp_array, (uint8_t*)EEPROM_POWER_EXTRUDER, sizeof(tmp_array));
+        eeprom_journal_read_block(tmp_array, (uint8_t*)EEPROM_POWER_EXTRUDER, sizeof(tmp_array));
         power_extruder[0] = tmp_array[0];
       #if EXTRUDERS > 1
         for (uint8_t e=1; e<EXTRUDERS; ++e)
@@ -90,8 +139,8 @@ static void PowerBudget_SaveSettings()
     bool bValid = PowerBudget_RetrieveVersion(version);
 
     // write values to EEPROM
-    eeprom_write_word((uint16_t*)EEPROM_POWER_BUDGET, power_budget);
-    eeprom_write_word((uint16_t*)EEPROM_POWER_BUILDPATE, power_buildplate);
+    eeprom_journal_write_word((uint16_t*)EEPROM_POWER_BUDGET, power_budget);
+    eeprom_journal_write_word((uint16_t*)EEPROM_POWER_BUILDPATE, power_buildplate);
 
     uint16_t tmp_array[2];
     tmp_array[0] = power_extruder[0];
@@ -100,15 +149,15 @@ static void PowerBudget_SaveSettings()
   #else
     tmp_array[1] = power_extruder[0];
   #endif
-    eeprom_write_block(tmp_array, (uint8_t*)EEPROM_POWER_EXTRUDER, sizeof(tmp_array));
+    eeprom_journal_write_block(tmp_array, (uint8_t*)EEPROM_POWER_EXTRUDER, sizeof(tmp_array));
 
     if (!bValid)
     {
         // validate stored data
         // version = STORE_WATTAGE_VERSION;
-        eeprom_write_word((uint16_t*)EEPROM_POWER_VERSION, STORE_POWER_VERSION);
-        eeprom_write_dword((uint32_t*)(EEPROM_POWER_START), EEPROM_POWER_MAGIC);
-        eeprom_write_byte((uint8_t*)EEPROM_POWER_POSTFIX, POWER_POSTFIX);
+        eeprom_journal_write_word((uint16_t*)EEPROM_POWER_VERSION, STORE_POWER_VERSION);
+        eeprom_journal_write_dword((uint32_t*)(EEPROM_POWER_START), EEPROM_POWER_MAGIC);
+        eeprom_journal_write_byte((uint8_t*)EEPROM_POWER_POSTFIX, POWER_POSTFIX);
     }
 
 }
@@ -12,6 +12,10 @@
   #define DEFAULT_POWER_BUILDPLATE 150
 #endif
 
+// priority of a nozzle in the power budget per mm/s of filament feed queued for it
+#ifndef POWER_EXTRUSION_PRIORITY
+  #define POWER_EXTRUSION_PRIORITY  10
+#endif
 
 // min/max allowed input value
 #define POWER_MINVALUE             0
@@ -23,6 +27,11 @@ extern uint16_t power_extruder[EXTRUDERS];
 
 void PowerBudget_RetrieveSettings();
 
+// Share the budget (W) among count (up to EXTRUDERS + 1) heaters with the given wattage. pwm holds the duty cycle (0..127) each heater asks
+// for and returns the duty cycle it gets. When the requests add up to more than the budget, every heater gets at least
+// its share of the budget by priority, and what a heater does not need of its share goes to the others, again by priority.
+void PowerBudget_Allocate(uint16_t budget, const uint16_t *wattage, const uint16_t *priority, uint8_t *pwm, uint8_t count);
+
 #ifdef ENABLE_ULTILCD2
 // menu function
 void lcd_menu_powerbudget();
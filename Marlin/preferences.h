@@ -3,6 +3,7 @@
 
 #include "Marlin.h"
 #include "fastio.h"
+#include "eeprom_journal.h"
 
 #define EEPROM_UI_MODE_OFFSET 0x401
 #define EEPROM_LED_TIMEOUT_OFFSET 0x402
@@ -25,38 +26,38 @@
 #define EEPROM_AXIS_DIRECTION 0x44A  // 1 Byte
 #define EEPROM_RESERVED 0x44B  // next position
 
-#define GET_UI_MODE() (eeprom_read_byte((const uint8_t*)EEPROM_UI_MODE_OFFSET))
-#define SET_UI_MODE(n) do { eeprom_write_byte((uint8_t*)EEPROM_UI_MODE_OFFSET, n); } while(0)
-#define GET_LED_TIMEOUT() (eeprom_read_word((const uint16_t*)EEPROM_LED_TIMEOUT_OFFSET))
-#define SET_LED_TIMEOUT(n) do { eeprom_write_word((uint16_t*)EEPROM_LED_TIMEOUT_OFFSET, n); } while(0)
-#define GET_LCD_TIMEOUT() (eeprom_read_word((const uint16_t*)EEPROM_LCD_TIMEOUT_OFFSET))
-#define SET_LCD_TIMEOUT(n) do { eeprom_write_word((uint16_t*)EEPROM_LCD_TIMEOUT_OFFSET, n); } while(0)
-#define GET_LCD_CONTRAST() (eeprom_read_byte((const uint8_t*)EEPROM_LCD_CONTRAST_OFFSET))
-#define SET_LCD_CONTRAST(n) do { eeprom_write_byte((uint8_t*)EEPROM_LCD_CONTRAST_OFFSET, n); } while(0)
-#define GET_EXPERT_VERSION() (eeprom_read_word((const uint16_t*)EEPROM_EXPERT_VERSION_OFFSET))
-#define SET_EXPERT_VERSION(n) do { eeprom_write_word((uint16_t*)EEPROM_EXPERT_VERSION_OFFSET, n); } while(0)
-#define GET_SLEEP_BRIGHTNESS() (eeprom_read_byte((const uint8_t*)EEPROM_SLEEP_BRIGHTNESS_OFFSET))
-#define SET_SLEEP_BRIGHTNESS(n) do { eeprom_write_byte((uint8_t*)EEPROM_SLEEP_BRIGHTNESS_OFFSET, n); } while(0)
-#define GET_SLEEP_CONTRAST() (eeprom_read_byte((const uint8_t*)EEPROM_SLEEP_CONTRAST_OFFSET))
-#define SET_SLEEP_CONTRAST(n) do { eeprom_write_byte((uint8_t*)EEPROM_SLEEP_CONTRAST_OFFSET, n); } while(0)
-#define GET_SLEEP_GLOW() (eeprom_read_byte((const uint8_t*)EEPROM_SLEEP_GLOW_OFFSET))
-#define SET_SLEEP_GLOW(n) do { eeprom_write_byte((uint8_t*)EEPROM_SLEEP_GLOW_OFFSET, n); } while(0)
-#define GET_CONTROL_FLAGS() (eeprom_read_byte((const uint8_t*)EEPROM_PID_FLAGS))
-#define SET_CONTROL_FLAGS(n) do { eeprom_write_byte((uint8_t*)EEPROM_PID_FLAGS, n); } while(0)
-#define GET_HEATER_TIMEOUT() (eeprom_read_byte((const uint8_t*)EEPROM_HEATER_TIMEOUT))
-#define SET_HEATER_TIMEOUT(n) do { eeprom_write_byte((uint8_t*)EEPROM_HEATER_TIMEOUT, n); } while(0)
-#define GET_END_RETRACT() (eeprom_read_float((const float*)EEPROM_END_RETRACT))
-#define SET_END_RETRACT(n) do { eeprom_write_float((float*)EEPROM_END_RETRACT, n); } while(0)
-#define GET_HEATER_CHECK_TEMP() (eeprom_read_byte((const uint8_t*)EEPROM_HEATER_CHECK_TEMP))
-#define SET_HEATER_CHECK_TEMP(n) do { eeprom_write_byte((uint8_t*)EEPROM_HEATER_CHECK_TEMP, n); } while(0)
-#define GET_HEATER_CHECK_TIME() (eeprom_read_byte((const uint8_t*)EEPROM_HEATER_CHECK_TIME))
-#define SET_HEATER_CHECK_TIME(n) do { eeprom_write_byte((uint8_t*)EEPROM_HEATER_CHECK_TIME, n); } while(0)
-#define GET_MOTOR_CURRENT_E2() (eeprom_read_word((const uint16_t*)EEPROM_MOTOR_CURRENT_E2))
-#define SET_MOTOR_CURRENT_E2(n) do { eeprom_write_word((uint16_t*)EEPROM_MOTOR_CURRENT_E2, n); } while(0)
-#define GET_STEPS_E2() (eeprom_read_float((const float*)EEPROM_STEPS_E2))
-#define SET_STEPS_E2(n) do { eeprom_write_float((float*)EEPROM_STEPS_E2, n); } while(0)
-#define GET_AXIS_DIRECTION() (eeprom_read_byte((const uint8_t*)EEPROM_AXIS_DIRECTION))
-#define SET_AXIS_DIRECTION(n) do { eeprom_write_byte((uint8_t*)EEPROM_AXIS_DIRECTION, n); } while(0)
+#define GET_UI_MODE() (eeprom_journal_read_byte((const uint8_t*)EEPROM_UI_MODE_OFFSET))
+#define SET_UI_MODE(n) do { eeprom_journal_write_byte((uint8_t*)EEPROM_UI_MODE_OFFSET, n); } while(0)
+#define GET_LED_TIMEOUT() (eeprom_journal_read_word((const uint16_t*)EEPROM_LED_TIMEOUT_OFFSET))
+#define SET_LED_TIMEOUT(n) do { eeprom_journal_write_word((uint16_t*)EEPROM_LED_TIMEOUT_OFFSET, n); } while(0)
+#define GET_LCD_TIMEOUT() (eeprom_journal_read_word((const uint16_t*)EEPROM_LCD_TIMEOUT_OFFSET))
+#define SET_LCD_TIMEOUT(n) do { eeprom_journal_write_word((uint16_t*)EEPROM_LCD_TIMEOUT_OFFSET, n); } while(0)
+#define GET_LCD_CONTRAST() (eeprom_journal_read_byte((const uint8_t*)EEPROM_LCD_CONTRAST_OFFSET))
+#define SET_LCD_CONTRAST(n) do { eeprom_journal_write_byte((uint8_t*)EEPROM_LCD_CONTRAST_OFFSET, n); } while(0)
+#define GET_EXPERT_VERSION() (eeprom_journal_read_word((const uint16_t*)EEPROM_EXPERT_VERSION_OFFSET))
+#define SET_EXPERT_VERSION(n) do { eeprom_journal_write_word((uint16_t*)EEPROM_EXPERT_VERSION_OFFSET, n); } while(0)
+#define GET_SLEEP_BRIGHTNESS() (eeprom_journal_read_byte((const uint8_t*)EEPROM_SLEEP_BRIGHTNESS_OFFSET))
+#define SET_SLEEP_BRIGHTNESS(n) do { eeprom_journal_write_byte((uint8_t*)EEPROM_SLEEP_BRIGHTNESS_OFFSET, n); } while(0)
+#define GET_SLEEP_CONTRAST() (eeprom_journal_read_byte((const uint8_t*)EEPROM_SLEEP_CONTRAST_OFFSET))
+#define SET_SLEEP_CONTRAST(n) do { eeprom_journal_write_byte((uint8_t*)EEPROM_SLEEP_CONTRAST_OFFSET, n); } while(0)
+#define GET_SLEEP_GLOW() (eeprom_journal_read_byte((const uint8_t*)EEPROM_SLEEP_GLOW_OFFSET))
+#define SET_SLEEP_GLOW(n) do { eeprom_journal_write_byte((uint8_t*)EEPROM_SLEEP_GLOW_OFFSET, n); } while(0)
+#define GET_CONTROL_FLAGS() (eeprom_journal_read_byte((const uint8_t*)EEPROM_PID_FLAGS))
+#define SET_CONTROL_FLAGS(n) do { eeprom_journal_write_byte((uint8_t*)EEPROM_PID_FLAGS, n); } while(0)
+#define GET_HEATER_TIMEOUT() (eeprom_journal_read_byte((const uint8_t*)EEPROM_HEATER_TIMEOUT))
+#define SET_HEATER_TIMEOUT(n) do { eeprom_journal_write_byte((uint8_t*)EEPROM_HEATER_TIMEOUT, n); } while(0)
+#define GET_END_RETRACT() (eeprom_journal_read_float((const float*)EEPROM_END_RETRACT))
+#define SET_END_RETRACT(n) do { eeprom_journal_write_float((float*)EEPROM_END_RETRACT, n); } while(0)
+#define GET_HEATER_CHECK_TEMP() (eeprom_journal_read_byte((const uint8_t*)EEPROM_HEATER_CHECK_TEMP))
+#define SET_HEATER_CHECK_TEMP(n) do { eeprom_journal_write_byte((uint8_t*)EEPROM_HEATER_CHECK_TEMP, n); } while(0)
+#define GET_HEATER_CHECK_TIME() (eeprom_journal_read_byte((const uint8_t*)EEPROM_HEATER_CHECK_TIME))
+#define SET_HEATER_CHECK_TIME(n) do { eeprom_journal_write_byte((uint8_t*)EEPROM_HEATER_CHECK_TIME, n); } while(0)
+#define GET_MOTOR_CURRENT_E2() (eeprom_journal_read_word((const uint16_t*)EEPROM_MOTOR_CURRENT_E2))
+#define SET_MOTOR_CURRENT_E2(n) do { eeprom_journal_write_word((uint16_t*)EEPROM_MOTOR_CURRENT_E2, n); } while(0)
+#define GET_STEPS_E2() (eeprom_journal_read_float((const float*)EEPROM_STEPS_E2))
+#define SET_STEPS_E2(n) do { eeprom_journal_write_float((float*)EEPROM_STEPS_E2, n); } while(0)
+#define GET_AXIS_DIRECTION() (eeprom_journal_read_byte((const uint8_t*)EEPROM_AXIS_DIRECTION))
+#define SET_AXIS_DIRECTION(n) do { eeprom_journal_write_byte((uint8_t*)EEPROM_AXIS_DIRECTION, n); } while(0)
 
 // UI Mode
 // UI Mode
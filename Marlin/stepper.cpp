@@ -58,6 +58,16 @@ volatile static uint32_t step_events_completed; // The number of step events exe
   static long old_advance = 0;
   static long e_steps[3];
 #endif
+#ifdef LIN_ADVANCE
+  static int16_t e_steps;          // E steps still to take: the bresenham E steps and the changes of the advance
+  static uint16_t current_advance; // E steps the extruder is ahead of the bresenham position
+  static int8_t e_step_direction;  // Direction the E DIR pin is set to, 0 when it has to be set again
+  static uint16_t main_ticks_left; // Timer ticks from an advance E step to the next step event, 0 when no E step is in between
+#endif
+#ifdef BABYSTEPPING
+  volatile int babystepsTodo[3]={0,0,0};
+  static uint16_t babystep_ticks;  // Timer ticks until the next babystep can be taken
+#endif
 static long acceleration_time, deceleration_time;
 //static unsigned long accelerate_until, decelerate_after, acceleration_rate, initial_rate, final_rate, nominal_rate;
 static uint16_t acc_step_rate; // needed for deceleration start point
@@ -275,6 +285,10 @@ void st_wake_up() {
   ENABLE_STEPPER_DRIVER_INTERRUPT();
 }
 
+void st_sleep() {
+  DISABLE_STEPPER_DRIVER_INTERRUPT();
+}
+
 void step_wait(){
     for(int8_t i=0; i < 6; i++){
     }
@@ -316,6 +330,202 @@ FORCE_INLINE uint16_t calc_timer(uint16_t step_rate) {
   return timer;
 }
 
+#ifdef LIN_ADVANCE
+// Set the advance for the step rate, the steps for the change go out with the E steps of the block.
+FORCE_INLINE void update_advance(uint16_t step_rate) {
+  uint16_t advance = (uint32_t(step_rate) * current_block->advance_lead) >> LIN_ADVANCE_SHIFT;
+  e_steps += int16_t(advance - current_advance);
+  current_advance = advance;
+}
+
+// Take one of the outstanding E steps. Every step event takes one, the rest go out in between the step events.
+// The A4988 needs the DIR pin set 200ns before the STEP edge and STEP high for 1us. e_steps is not volatile, so its
+// update can not be relied on for that time, the delays give it.
+FORCE_INLINE void take_e_step() {
+  if (e_steps == 0)
+    return;
+  int8_t direction = (e_steps < 0) ? -1 : 1;
+  if (e_step_direction != direction) {
+    if (direction < 0)
+      REV_E_DIR();
+    else
+      NORM_E_DIR();
+    e_step_direction = direction;
+    _delay_us(1);
+  }
+  WRITE_E_STEP(!INVERT_E_STEP_PIN);
+  e_steps -= direction;
+  _delay_us(1);
+  WRITE_E_STEP(INVERT_E_STEP_PIN);
+}
+
+// An interrupt in between the step events, the changes of the advance can be more E steps than there are step events.
+// They go out at most one per LIN_ADVANCE_MIN_TICKS until the next step event is due.
+FORCE_INLINE void advance_isr() {
+  if (current_block != NULL)
+    take_e_step();
+  uint16_t ticks = max(uint16_t(LIN_ADVANCE_MIN_TICKS), TCNT1 + 16);
+  if (e_steps != 0 && current_block != NULL && main_ticks_left >= ticks + LIN_ADVANCE_MIN_TICKS) {
+    OCR1A = ticks;
+    main_ticks_left -= ticks;
+  }
+  else {
+    OCR1A = max(main_ticks_left, TCNT1 + 16);
+    main_ticks_left = 0;
+  }
+}
+#endif // LIN_ADVANCE
+
+#ifdef BABYSTEPPING
+// Perform a short step with a single stepper motor, outside of the block. The DIR pin is put back for the block.
+// The STEP pin stays high for 2us, the A4988 needs at least 1us.
+FORCE_INLINE void babystep(const uint8_t axis, const bool direction)
+{
+  switch(axis)
+  {
+  case X_AXIS:
+  {
+    enable_x();
+    uint8_t old_x_dir_pin= READ(X_DIR_PIN);  //if dualzstepper, both point to same direction.
+
+    //setup new step
+    WRITE(X_DIR_PIN,((axis_direction & 1) ? 0x1 : 0x0)^direction);
+    #ifdef DUAL_X_CARRIAGE
+      WRITE(X2_DIR_PIN,((axis_direction & 1) ? 0x1 : 0x0)^direction);
+    #endif
+
+    //perform step
+    WRITE(X_STEP_PIN, !INVERT_X_STEP_PIN);
+    #ifdef DUAL_X_CARRIAGE
+      WRITE(X2_STEP_PIN, !INVERT_X_STEP_PIN);
+    #endif
+    babystepsTodo[X_AXIS] += direction ? -1 : 1;
+    delayMicroseconds(2);
+    WRITE(X_STEP_PIN, INVERT_X_STEP_PIN);
+    #ifdef DUAL_X_CARRIAGE
+      WRITE(X2_STEP_PIN, INVERT_X_STEP_PIN);
+    #endif
+
+    //get old pin state back.
+    WRITE(X_DIR_PIN,old_x_dir_pin);
+    #ifdef DUAL_X_CARRIAGE
+      WRITE(X2_DIR_PIN,old_x_dir_pin);
+    #endif
+  }
+  break;
+  case Y_AXIS:
+  {
+    enable_y();
+    uint8_t old_y_dir_pin= READ(Y_DIR_PIN);  //if dualzstepper, both point to same direction.
+
+    //setup new step
+    WRITE(Y_DIR_PIN,((axis_direction & 2) ? 0x1 : 0x0)^direction);
+    #ifdef DUAL_Y_CARRIAGE
+      WRITE(Y2_DIR_PIN,((axis_direction & 2) ? 0x1 : 0x0)^direction);
+    #endif
+
+    //perform step
+    WRITE(Y_STEP_PIN, !INVERT_Y_STEP_PIN);
+    #ifdef DUAL_Y_CARRIAGE
+      WRITE(Y2_STEP_PIN, !INVERT_Y_STEP_PIN);
+    #endif
+    babystepsTodo[Y_AXIS] += direction ? -1 : 1;
+    delayMicroseconds(2);
+    WRITE(Y_STEP_PIN, INVERT_Y_STEP_PIN);
+    #ifdef DUAL_Y_CARRIAGE
+      WRITE(Y2_STEP_PIN, INVERT_Y_STEP_PIN);
+    #endif
+
+    //get old pin state back.
+    WRITE(Y_DIR_PIN,old_y_dir_pin);
+    #ifdef DUAL_Y_CARRIAGE
+      WRITE(Y2_DIR_PIN,old_y_dir_pin);
+    #endif
+  }
+  break;
+
+#ifndef DELTA
+  case Z_AXIS:
+  {
+    enable_z();
+    uint8_t old_z_dir_pin= READ(Z_DIR_PIN);  //if dualzstepper, both point to same direction.
+    //setup new step
+    WRITE(Z_DIR_PIN,((axis_direction & 4) ? 0x1 : 0x0)^direction^BABYSTEP_INVERT_Z);
+    #ifdef Z_DUAL_STEPPER_DRIVERS
+      WRITE(Z2_DIR_PIN,((axis_direction & 4) ? 0x1 : 0x0)^direction^BABYSTEP_INVERT_Z);
+    #endif
+    //perform step
+    WRITE(Z_STEP_PIN, !INVERT_Z_STEP_PIN);
+    #ifdef Z_DUAL_STEPPER_DRIVERS
+      WRITE(Z2_STEP_PIN, !INVERT_Z_STEP_PIN);
+    #endif
+    babystepsTodo[Z_AXIS] += direction ? -1 : 1;
+    delayMicroseconds(2);
+    WRITE(Z_STEP_PIN, INVERT_Z_STEP_PIN);
+    #ifdef Z_DUAL_STEPPER_DRIVERS
+      WRITE(Z2_STEP_PIN, INVERT_Z_STEP_PIN);
+    #endif
+
+    //get old pin state back.
+    WRITE(Z_DIR_PIN,old_z_dir_pin);
+    #ifdef Z_DUAL_STEPPER_DRIVERS
+      WRITE(Z2_DIR_PIN,old_z_dir_pin);
+    #endif
+  }
+  break;
+#else //DELTA
+  case Z_AXIS:
+  {
+    enable_x();
+    enable_y();
+    enable_z();
+    uint8_t old_x_dir_pin= READ(X_DIR_PIN);
+    uint8_t old_y_dir_pin= READ(Y_DIR_PIN);
+    uint8_t old_z_dir_pin= READ(Z_DIR_PIN);
+    //setup new step
+    WRITE(X_DIR_PIN,((axis_direction & 1) ? 0x1 : 0x0)^direction^BABYSTEP_INVERT_Z);
+    WRITE(Y_DIR_PIN,((axis_direction & 2) ? 0x1 : 0x0)^direction^BABYSTEP_INVERT_Z);
+    WRITE(Z_DIR_PIN,((axis_direction & 4) ? 0x1 : 0x0)^direction^BABYSTEP_INVERT_Z);
+
+    //perform step
+    WRITE(X_STEP_PIN, !INVERT_X_STEP_PIN);
+    WRITE(Y_STEP_PIN, !INVERT_Y_STEP_PIN);
+    WRITE(Z_STEP_PIN, !INVERT_Z_STEP_PIN);
+    babystepsTodo[Z_AXIS] += direction ? -1 : 1;
+    delayMicroseconds(2);
+    WRITE(X_STEP_PIN, INVERT_X_STEP_PIN);
+    WRITE(Y_STEP_PIN, INVERT_Y_STEP_PIN);
+    WRITE(Z_STEP_PIN, INVERT_Z_STEP_PIN);
+
+    //get old pin state back.
+    WRITE(X_DIR_PIN,old_x_dir_pin);
+    WRITE(Y_DIR_PIN,old_y_dir_pin);
+    WRITE(Z_DIR_PIN,old_z_dir_pin);
+  }
+  break;
+#endif
+
+  default:    break;
+  }
+}
+
+// Take one of the outstanding babysteps of each axis, at the end of the stepper interrupt so they do not collide
+// with the step events. They are at least BABYSTEP_MIN_TICKS apart, interval is the time to the next interrupt.
+FORCE_INLINE void babystep_isr(uint16_t interval)
+{
+  if (babystep_ticks == 0) {
+    for(uint8_t axis=0; axis<3; ++axis) {
+      int curTodo=babystepsTodo[axis]; //get rid of volatile for performance
+      if (curTodo != 0) {
+        babystep(axis, curTodo > 0);
+        babystep_ticks = BABYSTEP_MIN_TICKS;
+      }
+    }
+  }
+  babystep_ticks = (babystep_ticks > interval) ? babystep_ticks - interval : 0;
+}
+#endif // BABYSTEPPING
+
 // Initializes the trapezoid generator from the current block. Called whenever a new
 // block begins.
 FORCE_INLINE void trapezoid_generator_reset() {
@@ -326,6 +536,11 @@ FORCE_INLINE void trapezoid_generator_reset() {
     e_steps[current_block->active_extruder] += ((advance >>8) - old_advance);
     old_advance = advance >>8;
   #endif
+  #ifdef LIN_ADVANCE
+    // The block can be for the other extruder
+    e_step_direction = 0;
+    update_advance(current_block->initial_rate);
+  #endif
   deceleration_time = 0;
   // step_rate to timer interval
   OCR1A_nominal = calc_timer(current_block->nominal_rate);
@@ -351,10 +566,90 @@ FORCE_INLINE void trapezoid_generator_reset() {
   unsigned char last_extruder = 0xFF;
 #endif // EXTRUDERS
 
+#ifdef STEPPER_ISR_PROFILE
+static st_profile_t st_profile;
+
+// Timer 1 counts from 0 since the interrupt was due, so its count is the time the interrupt took.
+FORCE_INLINE void st_profile_record(uint16_t ticks) {
+  st_profile.count++;
+  st_profile.total_ticks += ticks;
+  if (ticks < st_profile.min_ticks) st_profile.min_ticks = ticks;
+  if (ticks > st_profile.max_ticks) st_profile.max_ticks = ticks;
+  int32_t slack = int32_t(OCR1A) - ticks;
+  if (slack < st_profile.min_slack) st_profile.min_slack = slack;
+  if (slack < 16) st_profile.missed++; // The next interrupt is moved to a later time below
+  uint16_t bucket = ticks >> ST_PROFILE_BUCKET_SHIFT;
+  st_profile.histogram[min(bucket, ST_PROFILE_BUCKETS - 1)]++;
+  st_profile.step_loops[step_loops >> 1]++;
+}
+
+void st_profile_read(st_profile_t &profile)
+{
+  CRITICAL_SECTION_START;
+  profile = st_profile;
+  CRITICAL_SECTION_END;
+}
+
+void st_profile_reset()
+{
+  CRITICAL_SECTION_START;
+  memset(&st_profile, 0, sizeof(st_profile));
+  st_profile.min_ticks = 0xFFFF;
+  st_profile.min_slack = 0x7FFFFFFF;
+  st_profile.start_millis = millis();
+  CRITICAL_SECTION_END;
+}
+
+void st_profile_report()
+{
+  st_profile_t profile;
+  st_profile_read(profile);
+  // Timer 1 runs at F_CPU/8
+  unsigned long time = millis() - profile.start_millis;
+  SERIAL_PROTOCOLPGM("Stepper ISR count:");
+  SERIAL_PROTOCOL(profile.count);
+  if (profile.count)
+  {
+    SERIAL_PROTOCOLPGM(" cycles min:");
+    SERIAL_PROTOCOL(uint32_t(profile.min_ticks) * 8);
+    SERIAL_PROTOCOLPGM(" avg:");
+    SERIAL_PROTOCOL(profile.total_ticks / profile.count * 8);
+    SERIAL_PROTOCOLPGM(" max:");
+    SERIAL_PROTOCOL(uint32_t(profile.max_ticks) * 8);
+    SERIAL_PROTOCOLPGM(" slack min:");
+    SERIAL_PROTOCOL(profile.min_slack * 8);
+  }
+  SERIAL_PROTOCOLPGM(" missed:");
+  SERIAL_PROTOCOL(profile.missed);
+  SERIAL_PROTOCOLPGM(" load:");
+  SERIAL_PROTOCOL(time ? profile.total_ticks * 100.0 / (time * (F_CPU / 8000.0)) : 0.0);
+  SERIAL_PROTOCOLLNPGM("%");
+  SERIAL_PROTOCOLPGM("Cycles histogram, 128 per bucket:");
+  for(uint8_t i=0; i<ST_PROFILE_BUCKETS; i++)
+  {
+    SERIAL_PROTOCOLPGM(" ");
+    SERIAL_PROTOCOL(profile.histogram[i]);
+  }
+  SERIAL_PROTOCOLLN("");
+  SERIAL_PROTOCOLPGM("Step loops 1:");
+  SERIAL_PROTOCOL(profile.step_loops[0]);
+  SERIAL_PROTOCOLPGM(" 2:");
+  SERIAL_PROTOCOL(profile.step_loops[1]);
+  SERIAL_PROTOCOLPGM(" 4:");
+  SERIAL_PROTOCOLLN(profile.step_loops[2]);
+}
+#endif // STEPPER_ISR_PROFILE
+
 // "The Stepper Driver Interrupt" - This timer interrupt is the workhorse.
 // It pops blocks from the block_buffer and executes them by pulsing the stepper pins appropriately.
 ISR(TIMER1_COMPA_vect)
 {
+  #ifdef LIN_ADVANCE
+    if (main_ticks_left) {
+      advance_isr();
+      return;
+    }
+  #endif
   // If there is no current block, attempt to pop one from the buffer
   if (current_block == NULL) {
     // Anything in the buffer?
@@ -409,11 +704,15 @@ ISR(TIMER1_COMPA_vect)
       }
     #ifndef ADVANCE
       if ((out_bits & (1<<E_AXIS)) != 0) {  // -direction
+        #ifndef LIN_ADVANCE
         REV_E_DIR();
+        #endif
         count_direction[E_AXIS]=-1;
       }
       else { // +direction
+        #ifndef LIN_ADVANCE
         NORM_E_DIR();
+        #endif
         count_direction[E_AXIS]=1;
       }
     #endif //!ADVANCE
@@ -445,6 +744,11 @@ ISR(TIMER1_COMPA_vect)
         // adjust motor current
         digipot_current(2, last_extruder ? motor_current_e2 : motor_current_setting[2]);
     #endif
+    #ifdef LIN_ADVANCE
+        // The advance of the other nozzle does not carry over
+        e_steps = 0;
+        current_advance = 0;
+    #endif
 
         current_block = NULL;
 
@@ -519,6 +823,14 @@ ISR(TIMER1_COMPA_vect)
 //      #endif
     }
     else {
+      #ifdef BABYSTEPPING
+        // Without a block the interrupt keeps the pace of the babysteps
+        if (babystepsTodo[X_AXIS] || babystepsTodo[Y_AXIS] || babystepsTodo[Z_AXIS]) {
+          OCR1A = BABYSTEP_MIN_TICKS;
+          babystep_isr(BABYSTEP_MIN_TICKS);
+        }
+        else
+      #endif
         OCR1A=2000; // 1kHz.
     }
   }
@@ -671,7 +983,15 @@ ISR(TIMER1_COMPA_vect)
         #endif
       }
 
-      #ifndef ADVANCE
+      #ifdef LIN_ADVANCE
+        counter_e += current_block->steps_e;
+        if (counter_e > 0) {
+          counter_e -= current_block->step_event_count;
+          count_position[E_AXIS]+=count_direction[E_AXIS];
+          e_steps += count_direction[E_AXIS];
+        }
+        take_e_step();
+      #elif !defined(ADVANCE)
         counter_e += current_block->steps_e;
         if (counter_e > 0) {
           WRITE_E_STEP(!INVERT_E_STEP_PIN);
@@ -697,6 +1017,9 @@ ISR(TIMER1_COMPA_vect)
       uint16_t timer = calc_timer(acc_step_rate);
       OCR1A = timer;
       acceleration_time += timer;
+      #ifdef LIN_ADVANCE
+        update_advance(acc_step_rate);
+      #endif
       #ifdef ADVANCE
         for(int8_t i=0; i < step_loops; i++) {
           advance += advance_rate;
@@ -723,6 +1046,9 @@ ISR(TIMER1_COMPA_vect)
       uint16_t timer = calc_timer(step_rate);
       OCR1A = timer;
       deceleration_time += timer;
+      #ifdef LIN_ADVANCE
+        update_advance(step_rate);
+      #endif
       #ifdef ADVANCE
         for(int8_t i=0; i < step_loops; i++) {
           advance -= advance_rate;
@@ -739,12 +1065,33 @@ ISR(TIMER1_COMPA_vect)
       step_loops = step_loops_nominal;
     }
 
-#ifdef __AVR
+    #ifdef STEPPER_ISR_PROFILE
+      st_profile_record(TCNT1);
+    #endif
+
     // Hack to address stuttering caused by ISR not finishing in time.
     // When the ISR does not finish in time, the timer will wrap in the computation of the next interrupt time.
     // This hack replaces the correct (past) time with a time not far in the future.
-    OCR1A = max(OCR1A, TCNT1 + 16);
-#endif
+    OCR1A = max(uint16_t(OCR1A), TCNT1 + 16);
+
+    #ifdef LIN_ADVANCE
+      // E steps left over go out in between, the interrupt can have taken longer than LIN_ADVANCE_MIN_TICKS itself
+      if (e_steps != 0) {
+        uint16_t ticks = max(uint16_t(LIN_ADVANCE_MIN_TICKS), TCNT1 + 16);
+        if (OCR1A >= ticks + LIN_ADVANCE_MIN_TICKS) {
+          main_ticks_left = OCR1A - ticks;
+          OCR1A = ticks;
+        }
+      }
+    #endif
+
+    #ifdef BABYSTEPPING
+      #ifdef LIN_ADVANCE
+        babystep_isr(OCR1A + main_ticks_left);
+      #else
+        babystep_isr(OCR1A);
+      #endif
+    #endif
 
     // If current block is finished, reset pointer
     if (step_events_completed >= current_block->step_event_count) {
@@ -989,6 +1336,9 @@ void st_init()
   // Init Stepper ISR to 122 Hz for quick starting
   OCR1A = 0x4000;
   TCNT1 = 0;
+  #ifdef STEPPER_ISR_PROFILE
+    st_profile_reset();
+  #endif
   ENABLE_STEPPER_DRIVER_INTERRUPT();
 
   #ifdef ADVANCE
@@ -1073,6 +1423,12 @@ void quickStop()
   while(blocks_queued())
     plan_discard_current_block();
   current_block = NULL;
+  #ifdef LIN_ADVANCE
+    // The steps still to take are for the moves that are gone, and the pressure is gone with them
+    e_steps = 0;
+    current_advance = 0;
+    main_ticks_left = 0;
+  #endif
   ENABLE_STEPPER_DRIVER_INTERRUPT();
   for (uint8_t i=0; i<NUM_AXIS-1; ++i)
   {
@@ -1082,144 +1438,6 @@ void quickStop()
   plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], active_extruder, true);
 }
 
-#if defined(BABYSTEPPING)
-
-// MUST ONLY BE CALLED BY AN ISR,
-// No other ISR should ever interrupt this!
-void babystep(const uint8_t axis, const bool direction)
-{
-  switch(axis)
-  {
-  case X_AXIS:
-  {
-    enable_x();
-    uint8_t old_x_dir_pin= READ(X_DIR_PIN);  //if dualzstepper, both point to same direction.
-
-
-    //setup new step
-    WRITE(X_DIR_PIN,((axis_direction & 1) ? 0x1 : 0x0)^direction);
-    #ifdef DUAL_X_CARRIAGE
-      WRITE(X2_DIR_PIN,((axis_direction & 1) ? 0x1 : 0x0)^direction);
-    #endif
-
-    //perform step
-    WRITE(X_STEP_PIN, !INVERT_X_STEP_PIN);
-    #ifdef DUAL_X_CARRIAGE
-      WRITE(X2_STEP_PIN, !INVERT_X_STEP_PIN);
-    #endif
-    delayMicroseconds(2);
-    WRITE(X_STEP_PIN, INVERT_X_STEP_PIN);
-    #ifdef DUAL_X_CARRIAGE
-      WRITE(X2_STEP_PIN, INVERT_X_STEP_PIN);
-    #endif
-
-    //get old pin state back.
-    WRITE(X_DIR_PIN,old_x_dir_pin);
-    #ifdef DUAL_X_CARRIAGE
-      WRITE(X2_DIR_PIN,old_x_dir_pin);
-    #endif
-
-  }
-  break;
-  case Y_AXIS:
-  {
-    enable_y();
-    uint8_t old_y_dir_pin= READ(Y_DIR_PIN);  //if dualzstepper, both point to same direction.
-
-    //setup new step
-    WRITE(Y_DIR_PIN,((axis_direction & 2) ? 0x1 : 0x0)^direction);
-    #ifdef DUAL_Y_CARRIAGE
-      WRITE(Y2_DIR_PIN,((axis_direction & 2) ? 0x1 : 0x0)^direction);
-    #endif
-
-    //perform step
-    WRITE(Y_STEP_PIN, !INVERT_Y_STEP_PIN);
-    #ifdef DUAL_Y_CARRIAGE
-      WRITE(Y2_STEP_PIN, !INVERT_Y_STEP_PIN);
-    #endif
-    delayMicroseconds(2);
-    WRITE(Y_STEP_PIN, INVERT_Y_STEP_PIN);
-    #ifdef DUAL_Y_CARRIAGE
-      WRITE(Y2_STEP_PIN, INVERT_Y_STEP_PIN);
-    #endif
-
-    //get old pin state back.
-    WRITE(Y_DIR_PIN,old_y_dir_pin);
-    #ifdef DUAL_Y_CARRIAGE
-      WRITE(Y2_DIR_PIN,old_y_dir_pin);
-    #endif
-
-  }
-  break;
-
-#ifndef DELTA
-  case Z_AXIS:
-  {
-    enable_z();
-    uint8_t old_z_dir_pin= READ(Z_DIR_PIN);  //if dualzstepper, both point to same direction.
-    //setup new step
-    WRITE(Z_DIR_PIN,((axis_direction & 4) ? 0x1 : 0x0)^direction^BABYSTEP_INVERT_Z);
-    #ifdef Z_DUAL_STEPPER_DRIVERS
-      WRITE(Z2_DIR_PIN,((axis_direction & 4) ? 0x1 : 0x0)^direction^BABYSTEP_INVERT_Z);
-    #endif
-    //perform step
-    WRITE(Z_STEP_PIN, !INVERT_Z_STEP_PIN);
-    #ifdef Z_DUAL_STEPPER_DRIVERS
-      WRITE(Z2_STEP_PIN, !INVERT_Z_STEP_PIN);
-    #endif
-    //wait a tiny bit
-    delayMicroseconds(2);
-    WRITE(Z_STEP_PIN, INVERT_Z_STEP_PIN);
-    #ifdef Z_DUAL_STEPPER_DRIVERS
-      WRITE(Z2_STEP_PIN, INVERT_Z_STEP_PIN);
-    #endif
-
-    //get old pin state back.
-    WRITE(Z_DIR_PIN,old_z_dir_pin);
-    #ifdef Z_DUAL_STEPPER_DRIVERS
-      WRITE(Z2_DIR_PIN,old_z_dir_pin);
-    #endif
-  }
-  break;
-#else //DELTA
-  case Z_AXIS:
-  {
-    enable_x();
-    enable_y();
-    enable_z();
-    uint8_t old_x_dir_pin= READ(X_DIR_PIN);
-    uint8_t old_y_dir_pin= READ(Y_DIR_PIN);
-    uint8_t old_z_dir_pin= READ(Z_DIR_PIN);
-    //setup new step
-    WRITE(X_DIR_PIN,((axis_direction & 1) ? 0x1 : 0x0)^direction^BABYSTEP_INVERT_Z);
-    WRITE(Y_DIR_PIN,((axis_direction & 2) ? 0x1 : 0x0)^direction^BABYSTEP_INVERT_Z);
-    WRITE(Z_DIR_PIN,((axis_direction & 4) ? 0x1 : 0x0)^direction^BABYSTEP_INVERT_Z);
-
-    //perform step
-    WRITE(X_STEP_PIN, !INVERT_X_STEP_PIN);
-    WRITE(Y_STEP_PIN, !INVERT_Y_STEP_PIN);
-    WRITE(Z_STEP_PIN, !INVERT_Z_STEP_PIN);
-
-    //wait a tiny bit
-    delayMicroseconds(2);
-    WRITE(X_STEP_PIN, INVERT_X_STEP_PIN);
-    WRITE(Y_STEP_PIN, INVERT_Y_STEP_PIN);
-    WRITE(Z_STEP_PIN, INVERT_Z_STEP_PIN);
-
-    //get old pin state back.
-    WRITE(X_DIR_PIN,old_x_dir_pin);
-    WRITE(Y_DIR_PIN,old_y_dir_pin);
-    WRITE(Z_DIR_PIN,old_z_dir_pin);
-
-  }
-  break;
-#endif
-
-  default:    break;
-  }
-}
-#endif //BABYSTEPPING
-
 void digitalPotWrite(int address, int value) // From Arduino DigitalPotControl example
 {
   #if defined(DIGIPOTSS_PIN) && DIGIPOTSS_PIN > -1
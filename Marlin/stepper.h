@@ -62,6 +62,10 @@ long st_get_position(uint8_t axis);
 // to notify the subsystem that it is time to go to work.
 void st_wake_up();
 
+// Keep the stepper subsystem from starting on new blocks until st_wake_up(). Only call this
+// with an empty block buffer, there is nothing to stop then.
+void st_sleep();
+
 
 void checkHitEndstops(); //call from somwhere to create an serial error message with the locations the endstops where hit, in case they were triggered
 void endstops_hit_on_purpose(); //avoid creation of the message, i.e. after homeing and before a routine call of checkHitEndstops();
@@ -87,7 +91,28 @@ void microstep_readings();
 #endif
 
 #if defined(BABYSTEPPING)
-  void babystep(const uint8_t axis,const bool direction); // perform a short step with a single stepper motor, outside of any convention
+  extern volatile int babystepsTodo[3]; // Babysteps the stepper interrupt still has to take, in steps of each axis
+#endif
+
+#ifdef STEPPER_ISR_PROFILE
+// Timing of the stepper interrupts that executed steps. Times are in timer 1 ticks of 8 cpu cycles, measured from
+// the moment the interrupt was due, so they include the latency caused by other interrupts.
+#define ST_PROFILE_BUCKETS 16
+#define ST_PROFILE_BUCKET_SHIFT 4 // 16 ticks (128 cpu cycles) per histogram bucket, the last bucket holds everything longer
+typedef struct {
+  uint32_t count;                          // Number of interrupts measured
+  uint32_t total_ticks;                    // Sum of their durations
+  uint16_t min_ticks, max_ticks;
+  int32_t min_slack;                       // Smallest number of ticks left before the next interrupt was due
+  uint32_t missed;                         // Interrupts that ran past the next interrupt time
+  uint32_t histogram[ST_PROFILE_BUCKETS];
+  uint32_t step_loops[3];                  // Interrupts doing 1, 2 and 4 steps per axis
+  unsigned long start_millis;              // When the counters were cleared
+} st_profile_t;
+
+void st_profile_read(st_profile_t &profile); // Copy of the counters
+void st_profile_reset();
+void st_profile_report();                    // Print the counters to serial (M122)
 #endif
 
 #endif
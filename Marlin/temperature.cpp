@@ -58,9 +58,9 @@ float current_temperature_bed = 0.0;
   float Kp=DEFAULT_Kp;
   float Ki=(DEFAULT_Ki*PID_dT);
   float Kd=(DEFAULT_Kd/PID_dT);
-//  #ifdef PID_ADD_EXTRUSION_RATE
-//    float Kc=DEFAULT_Kc;
-//  #endif
+  #ifdef PID_ADD_EXTRUSION_RATE
+    float Kc=DEFAULT_Kc;
+  #endif
 #endif //PIDTEMP
 
 #if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0)
@@ -73,16 +73,31 @@ float current_temperature_bed = 0.0;
   unsigned char fanSpeedSoftPwm;
 #endif
 
-#if defined(BABYSTEPPING)
-  volatile int babystepsTodo[3]={0,0,0};
-#endif
-
 //===========================================================================
 //=============================private variables============================
 //===========================================================================
 static volatile bool temp_meas_ready = false;
 
+#ifdef PID_FIXED_POINT
+  // Q16.16 fixed point values of the PID loops
+  typedef int32_t fixed_t;
+  #define FIXED_ONE 65536L
+  #define FIXED_TO_FLOAT(x) ((x) * (1.0 / FIXED_ONE))
+  #define K1_FIXED ((fixed_t)(K1 * FIXED_ONE))
+#endif
+
 #ifdef PIDTEMP
+#ifdef PID_FIXED_POINT
+  // The gains as used by manage_heater(), set by updatePID(). iTerm adds up Ki * error instead of keeping the sum of the errors,
+  // so it does not need the range of temp_iState, and Kd includes the (1 - K1) of the derivative filter.
+  static fixed_t pid_Kp[EXTRUDERS];
+  static fixed_t pid_Ki[EXTRUDERS];
+  static fixed_t pid_Kd[EXTRUDERS];
+  static fixed_t temp_dState[EXTRUDERS] = { 0 };
+  static fixed_t pTerm[EXTRUDERS];
+  static fixed_t iTerm[EXTRUDERS];
+  static fixed_t dTerm[EXTRUDERS];
+#else
   //static cannot be external:
   static float temp_iState[EXTRUDERS] = { 0 };
   static float temp_dState[EXTRUDERS] = { 0 };
@@ -95,9 +110,19 @@ static volatile bool temp_meas_ready = false;
   static float temp_iState_max[EXTRUDERS];
   // static float pid_input[EXTRUDERS];
   // static float pid_output[EXTRUDERS];
+#endif //PID_FIXED_POINT
   static bool pid_reset[EXTRUDERS];
 #endif //PIDTEMP
 #if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0)
+#ifdef PID_FIXED_POINT
+  static fixed_t pid_bedKp;
+  static fixed_t pid_bedKi;
+  static fixed_t pid_bedKd;
+  static fixed_t pTerm_bed;
+  static fixed_t iTerm_bed;
+  static fixed_t temp_dState_bed = { 0 };
+  static fixed_t dTerm_bed;
+#else
   //static cannot be external:
   static float pTerm_bed;
   static float iTerm_bed;
@@ -108,6 +133,7 @@ static volatile bool temp_meas_ready = false;
   static float pid_error_bed;
   static float temp_iState_min_bed;
   static float temp_iState_max_bed;
+#endif //PID_FIXED_POINT
 //#else //PIDTEMPBED
 #endif //PIDTEMPBED
 #if TEMP_SENSOR_BED != 0
@@ -143,10 +169,10 @@ static float max_heating_start_temperature[EXTRUDERS];
 
 #ifdef TEMP_SENSOR_1_AS_REDUNDANT
   static void *heater_ttbl_map[2] = {(void *)HEATER_0_TEMPTABLE, (void *)HEATER_1_TEMPTABLE };
-  static uint8_t heater_ttbllen_map[2] = { HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN };
+  static uint8_t heater_ttblshift_map[2] = { HEATER_0_TEMPTABLE_SHIFT, HEATER_1_TEMPTABLE_SHIFT };
 #else
   static void *heater_ttbl_map[EXTRUDERS] = ARRAY_BY_EXTRUDERS( (void *)HEATER_0_TEMPTABLE, (void *)HEATER_1_TEMPTABLE, (void *)HEATER_2_TEMPTABLE );
-  static uint8_t heater_ttbllen_map[EXTRUDERS] = ARRAY_BY_EXTRUDERS( HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN, HEATER_2_TEMPTABLE_LEN );
+  static uint8_t heater_ttblshift_map[EXTRUDERS] = ARRAY_BY_EXTRUDERS( HEATER_0_TEMPTABLE_SHIFT, HEATER_1_TEMPTABLE_SHIFT, HEATER_2_TEMPTABLE_SHIFT );
 #endif
 
 static float analog2temp(int raw, uint8_t e);
@@ -164,6 +190,13 @@ unsigned long watchmillis[EXTRUDERS] = ARRAY_BY_EXTRUDERS(0,0,0);
 #define SOFT_PWM_SCALE 0
 #endif
 
+// The heaters that share the power budget: the nozzles, and the bed last.
+#if TEMP_SENSOR_BED != 0
+#define HEATERS (EXTRUDERS + 1)
+#else
+#define HEATERS EXTRUDERS
+#endif
+
 #ifdef HEATER_0_USES_MAX6675
 static int read_max6675();
 #endif
@@ -351,19 +384,74 @@ void PID_autotune(float temp, int extruder, int ncycles, autotuneFunc_t pCallbac
   }
 }
 
+#ifdef PID_FIXED_POINT
+// Rounded, and saturated at the range of Q16.16
+static fixed_t to_fixed(float f)
+{
+  f *= FIXED_ONE;
+  if (f >= 2147483647.0)
+    return 2147483647L;
+  if (f <= -2147483647.0)
+    return -2147483647L;
+  return (fixed_t)(f < 0 ? f - 0.5 : f + 0.5);
+}
+
+// (a * b) >> 16 for Q16.16 values, from four 16x16 bit products instead of a 64 bit multiply.
+// Saturates at +/-FIXED_LIMIT, far outside the 0-255 output, so adding up the terms cannot overflow.
+#define FIXED_LIMIT (1L << 29)
+static fixed_t fixed_mul(fixed_t a, fixed_t b)
+{
+  bool negative = false;
+  if (a < 0) { a = -a; negative = !negative; }
+  if (b < 0) { b = -b; negative = !negative; }
+  uint16_t ah = (uint32_t)a >> 16, al = a;
+  uint16_t bh = (uint32_t)b >> 16, bl = b;
+  uint32_t r = FIXED_LIMIT;
+  uint32_t high = (uint32_t)ah * bh;
+  uint32_t mid1 = (uint32_t)ah * bl;
+  uint32_t mid2 = (uint32_t)al * bh;
+  //Each part below FIXED_LIMIT, so the sum cannot overflow 32 bits
+  if (high < (FIXED_LIMIT >> 16) && mid1 < FIXED_LIMIT && mid2 < FIXED_LIMIT)
+  {
+    r = (high << 16) + mid1 + mid2 + (((uint32_t)al * bl) >> 16);
+    if (r > FIXED_LIMIT)
+      r = FIXED_LIMIT;
+  }
+  return negative ? -(fixed_t)r : (fixed_t)r;
+}
+#endif
+
 void updatePID()
 {
 #ifdef PIDTEMP
   for(int e = 0; e < EXTRUDERS; ++e) {
+#ifdef PID_FIXED_POINT
+  #if EXTRUDERS > 1
+     pid_Kp[e] = to_fixed(e ? pid2[0] : Kp);
+     pid_Ki[e] = to_fixed(e ? pid2[1] : Ki);
+     pid_Kd[e] = to_fixed((e ? pid2[2] : Kd) * (1.0 - K1));
+  #else
+     pid_Kp[e] = to_fixed(Kp);
+     pid_Ki[e] = to_fixed(Ki);
+     pid_Kd[e] = to_fixed(Kd * (1.0 - K1));
+  #endif
+#else
      temp_iState_max[e] = PID_INTEGRAL_DRIVE_MAX / Ki;
+#endif
   }
 #endif
 #if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0)
+#ifdef PID_FIXED_POINT
+  pid_bedKp = to_fixed(bedKp);
+  pid_bedKi = to_fixed(bedKi);
+  pid_bedKd = to_fixed(bedKd * (1.0 - K1));
+#else
   if (pidTempBed())
   {
     temp_iState_max_bed = PID_INTEGRAL_DRIVE_MAX / bedKi;
   }
 #endif
+#endif
 }
 
 int getHeaterPower(int heater)
@@ -445,29 +533,59 @@ void checkExtruderAutoFans()
 
 #endif // any extruder auto fan pins set
 
-static unsigned char limit_power(uint16_t wattage, unsigned char pwm, uint16_t &budget)
+#if TEMP_SENSOR_BED != 0
+// Duty cycle (0..127) the bed heater asks for, before the power budget. Kept between the bang-bang checks.
+static unsigned char bed_pwm_request;
+
+static void manage_bed_heater();
+#endif
+
+// Filament feed (mm/s) of each nozzle over the blocks queued in the planner: the E steps of its blocks divided by the time
+// all queued blocks take at their nominal rate, so travel moves in between lower it. Set by update_extrusion_rate().
+static float extrusion_rate[EXTRUDERS];
+
+static void update_extrusion_rate()
 {
-    if (pwm)
+    uint32_t steps_e[EXTRUDERS] = { 0 };
+    uint32_t duration = 0;  // in 1/10000 s
+    for(uint8_t n = block_buffer_tail; n != block_buffer_head; n = (n + 1) & (BLOCK_BUFFER_SIZE - 1))
     {
-        if (budget && wattage)
-        {
-            uint16_t power = (float(pwm) / 0x7f) * wattage;
-            if (power > budget)
-            {
-                pwm = (float(budget) / wattage) * 0x7f;
-                budget = 0;
-            }
-            else
-            {
-                budget -= power;
-            }
-        }
-        else
-        {
-            pwm = 0;
-        }
+        block_t *block = &block_buffer[n];
+        if (block->nominal_rate)
+            duration += (uint32_t)block->step_event_count * 10000 / block->nominal_rate;
+        steps_e[block->active_extruder] += block->steps_e;
     }
-    return pwm;
+    for(uint8_t e = 0; e < EXTRUDERS; ++e)
+        extrusion_rate[e] = (duration && steps_e[e]) ? float(steps_e[e]) * 10000 / (e_steps_per_unit(e) * duration) : 0.0;
+}
+
+// Hand out the power budget to the duty cycles the heaters ask for, see PowerBudget_Allocate().
+static void allocate_heater_power(uint16_t budget, unsigned char *heater_pwm)
+{
+    uint16_t wattage[HEATERS];
+    uint16_t priority[HEATERS];
+    for(uint8_t e = 0; e < EXTRUDERS; ++e)
+    {
+        int target_temp = (printing_state == PRINT_STATE_RECOVER) ? recover_temperature[e] : target_temperature[e];
+        wattage[e] = power_extruder[e];
+        priority[e] = 1 + min(extrusion_rate[e] * POWER_EXTRUSION_PRIORITY, 0x7FFF);
+        if (current_temperature[e] < target_temp)
+            priority[e] += target_temp - current_temperature[e];
+    }
+  #if TEMP_SENSOR_BED != 0
+    wattage[EXTRUDERS] = power_buildplate;
+    priority[EXTRUDERS] = 1;
+    if (current_temperature_bed < target_temperature_bed)
+        priority[EXTRUDERS] += target_temperature_bed - current_temperature_bed;
+  #endif
+
+    PowerBudget_Allocate(budget, wattage, priority, heater_pwm, HEATERS);
+
+    for(uint8_t e = 0; e < EXTRUDERS; ++e)
+        soft_pwm[e] = heater_pwm[e];
+  #if TEMP_SENSOR_BED != 0
+    soft_pwm_bed = heater_pwm[EXTRUDERS];
+  #endif
 }
 
 void manage_heater()
@@ -476,6 +594,7 @@ void manage_heater()
     return;
 
   updateTemperaturesFromRawValues();
+  update_extrusion_rate();
 
   #ifdef HEATER_0_USES_MAX6675
   if (current_temperature[0] > 1023 || current_temperature[0] > maxttemp[0])
@@ -504,14 +623,79 @@ void manage_heater()
       }
   }
 
+#ifdef PID_FIXED_POINT
+  fixed_t pid_input;
+  fixed_t pid_error;
+  int pid_output;
+#else
   float pid_input;
   float pid_output;
+#endif
+#ifdef PID_ADD_EXTRUSION_RATE
+  float cTerm;
+#endif
   int target_temp;
+  unsigned char heater_pwm[HEATERS];
 
   for(uint8_t e = 0; e < EXTRUDERS; ++e)
   {
     target_temp = (printing_state == PRINT_STATE_RECOVER) ? recover_temperature[e] : target_temperature[e];
-  #ifdef PIDTEMP
+  #ifdef PID_ADD_EXTRUSION_RATE
+    // Feed forward the power to melt the filament that is queued, so the output rises before the temperature drops
+    cTerm = Kc * extrusion_rate[e];
+  #endif
+  #if defined(PIDTEMP) && defined(PID_FIXED_POINT)
+    pid_input = to_fixed(current_temperature[e]);
+
+    #ifndef PID_OPENLOOP
+        pid_error = ((fixed_t)target_temp << 16) - pid_input;
+        if(pid_error > (fixed_t)PID_FUNCTIONAL_RANGE << 16) {
+          pid_output = BANG_MAX;
+          pid_reset[e] = true;
+        }
+        else if(pid_error < -((fixed_t)PID_FUNCTIONAL_RANGE << 16) || target_temp == 0) {
+          pid_output = 0;
+          pid_reset[e] = true;
+        }
+        else {
+          if(pid_reset[e] == true) {
+            iTerm[e] = 0;
+            pid_reset[e] = false;
+          }
+          pTerm[e] = fixed_mul(pid_Kp[e], pid_error);
+          iTerm[e] = constrain(iTerm[e] + fixed_mul(pid_Ki[e], pid_error), 0, (fixed_t)PID_INTEGRAL_DRIVE_MAX << 16);
+          dTerm[e] = constrain(fixed_mul(pid_Kd[e], pid_input - temp_dState[e]) + fixed_mul(K1_FIXED, dTerm[e]), -FIXED_LIMIT, FIXED_LIMIT);
+          #ifdef PID_ADD_EXTRUSION_RATE
+          pid_output = constrain(pTerm[e] + iTerm[e] - dTerm[e] + to_fixed(cTerm), 0, (fixed_t)PID_MAX << 16) >> 16;
+          #else
+          pid_output = constrain(pTerm[e] + iTerm[e] - dTerm[e], 0, (fixed_t)PID_MAX << 16) >> 16;
+          #endif
+        }
+        temp_dState[e] = pid_input;
+    #else
+        pid_output = constrain(target_temp, 0, PID_MAX);
+    #endif //PID_OPENLOOP
+    #ifdef PID_DEBUG
+    SERIAL_ECHO_START;
+    SERIAL_ECHOPGM(" PIDDEBUG ");
+    SERIAL_ECHO(e);
+    SERIAL_ECHOPGM(": Input ");
+    SERIAL_ECHO(current_temperature[e]);
+    SERIAL_ECHOPGM(" Output ");
+    SERIAL_ECHO(pid_output);
+    SERIAL_ECHOPGM(" pTerm ");
+    SERIAL_ECHO(FIXED_TO_FLOAT(pTerm[e]));
+    SERIAL_ECHOPGM(" iTerm ");
+    SERIAL_ECHO(FIXED_TO_FLOAT(iTerm[e]));
+    SERIAL_ECHOPGM(" dTerm ");
+    SERIAL_ECHO(FIXED_TO_FLOAT(dTerm[e]));
+    #ifdef PID_ADD_EXTRUSION_RATE
+    SERIAL_ECHOPGM(" cTerm ");
+    SERIAL_ECHO(cTerm);
+    #endif
+    SERIAL_EOL;
+    #endif //PID_DEBUG
+  #elif defined(PIDTEMP)
     pid_input = current_temperature[e];
 
     #ifndef PID_OPENLOOP
@@ -549,7 +733,11 @@ void manage_heater()
           #else
             dTerm[e] = (Kd * (pid_input - temp_dState[e]))*K2 + (K1 * dTerm[e]);
           #endif
+          #ifdef PID_ADD_EXTRUSION_RATE
+          pid_output = constrain(pTerm[e] + iTerm[e] - dTerm[e] + cTerm, 0, PID_MAX);
+          #else
           pid_output = constrain(pTerm[e] + iTerm[e] - dTerm[e], 0, PID_MAX);
+          #endif
         }
         temp_dState[e] = pid_input;
     #else
@@ -568,7 +756,12 @@ void manage_heater()
     SERIAL_ECHOPGM(" iTerm ");
     SERIAL_ECHO(iTerm[e]);
     SERIAL_ECHOPGM(" dTerm ");
-    SERIAL_ECHOLN(dTerm[e]);
+    SERIAL_ECHO(dTerm[e]);
+    #ifdef PID_ADD_EXTRUSION_RATE
+    SERIAL_ECHOPGM(" cTerm ");
+    SERIAL_ECHO(cTerm);
+    #endif
+    SERIAL_EOL;
     #endif //PID_DEBUG
   #else /* PID off */
     pid_output = 0;
@@ -580,10 +773,10 @@ void manage_heater()
     // Check if temperature is within the correct range
     if((current_temperature[e] > minttemp[e]) && (current_temperature[e] < maxttemp[e]))
     {
-      soft_pwm[e] = limit_power(power_extruder[e], (int)pid_output >> 1, budget);
+      heater_pwm[e] = (int)pid_output >> 1;
     }
     else {
-      soft_pwm[e] = 0;
+      heater_pwm[e] = 0;
     }
 
     #ifdef WATCH_TEMP_PERIOD
@@ -665,6 +858,29 @@ void manage_heater()
   }
 
   #if TEMP_SENSOR_BED != 0
+  manage_bed_heater();
+  // The bang-bang request is only updated every BED_CHECK_INTERVAL, it must not switch the bed back on after it was turned off
+  if (target_temperature_bed == 0 || IsStopped())
+    bed_pwm_request = 0;
+  heater_pwm[EXTRUDERS] = bed_pwm_request;
+  #endif
+
+  allocate_heater_power(budget, heater_pwm);
+}
+
+#if TEMP_SENSOR_BED != 0
+static void manage_bed_heater()
+{
+#ifdef PIDTEMPBED
+#ifdef PID_FIXED_POINT
+  fixed_t pid_input;
+  fixed_t pid_error;
+  int pid_output;
+#else
+  float pid_input;
+  float pid_output;
+#endif
+#endif
 
   if (!pidTempBed())
   {
@@ -676,6 +892,21 @@ void manage_heater()
   #ifdef PIDTEMPBED
   if (pidTempBed())
   {
+  #ifdef PID_FIXED_POINT
+    pid_input = to_fixed(current_temperature_bed);
+
+    #ifndef PID_OPENLOOP
+		  pid_error = ((fixed_t)target_temperature_bed << 16) - pid_input;
+		  pTerm_bed = fixed_mul(pid_bedKp, pid_error);
+		  iTerm_bed = constrain(iTerm_bed + fixed_mul(pid_bedKi, pid_error), 0, (fixed_t)PID_INTEGRAL_DRIVE_MAX << 16);
+		  dTerm_bed = constrain(fixed_mul(pid_bedKd, pid_input - temp_dState_bed) + fixed_mul(K1_FIXED, dTerm_bed), -FIXED_LIMIT, FIXED_LIMIT);
+		  temp_dState_bed = pid_input;
+
+		  pid_output = constrain(pTerm_bed + iTerm_bed - dTerm_bed, 0, (fixed_t)MAX_BED_POWER << 16) >> 16;
+    #else
+      pid_output = constrain(target_temperature_bed, 0, MAX_BED_POWER);
+    #endif //PID_OPENLOOP
+  #else
     pid_input = current_temperature_bed;
 
     #ifndef PID_OPENLOOP
@@ -695,13 +926,14 @@ void manage_heater()
     #else
       pid_output = constrain(target_temperature_bed, 0, MAX_BED_POWER);
     #endif //PID_OPENLOOP
+  #endif //PID_FIXED_POINT
 
 	  if((current_temperature_bed > BED_MINTEMP) && (current_temperature_bed < BED_MAXTEMP))
 	  {
-	    soft_pwm_bed = limit_power(power_buildplate, (int)pid_output >> 1, budget);
+	    bed_pwm_request = (int)pid_output >> 1;
 	  }
 	  else {
-	    soft_pwm_bed = 0;
+	    bed_pwm_request = 0;
 	  }
   }
   else // printbed bang-bang mode
@@ -713,16 +945,16 @@ void manage_heater()
       {
         if(current_temperature_bed >= target_temperature_bed)
         {
-          soft_pwm_bed = 0;
+          bed_pwm_request = 0;
         }
         else
         {
-          soft_pwm_bed = limit_power(power_buildplate, MAX_BED_POWER>>1, budget);
+          bed_pwm_request = MAX_BED_POWER>>1;
         }
       }
       else
       {
-        soft_pwm_bed = 0;
+        bed_pwm_request = 0;
         WRITE(HEATER_BED_PIN,LOW);
       }
     #else //#ifdef BED_LIMIT_SWITCHING
@@ -731,24 +963,39 @@ void manage_heater()
       {
         if(current_temperature_bed > target_temperature_bed + BED_HYSTERESIS)
         {
-          soft_pwm_bed = 0;
+          bed_pwm_request = 0;
         }
         else if(current_temperature_bed <= target_temperature_bed - BED_HYSTERESIS)
         {
-          soft_pwm_bed = limit_power(power_buildplate, MAX_BED_POWER>>1, budget);
+          bed_pwm_request = MAX_BED_POWER>>1;
         }
       }
       else
       {
-        soft_pwm_bed = 0;
+        bed_pwm_request = 0;
         WRITE(HEATER_BED_PIN,LOW);
       }
     #endif
   }
-  #endif
 }
+#endif
 
 #define PGM_RD_W(x)   (short)pgm_read_word(&x)
+// Temperature from a table of thermistortables_uniform.h, which has an entry every (1 << shift) raw values.
+// Interpolates between the two entries around raw in fixed point, rounded to the 1/TEMPTABLE_UNIFORM_SCALE degree.
+static float uniform_table_lookup(const short* table, uint8_t shift, int raw)
+{
+  if (raw < 0)
+    raw = 0;
+  uint16_t i = raw >> shift;
+  if (i >= (TEMPTABLE_UNIFORM_RAW_MAX >> shift))
+    return PGM_RD_W(table[TEMPTABLE_UNIFORM_RAW_MAX >> shift]) * (1.0 / TEMPTABLE_UNIFORM_SCALE);
+  short t0 = PGM_RD_W(table[i]);
+  short t1 = PGM_RD_W(table[i + 1]);
+  uint16_t frac = raw & ((1 << shift) - 1);
+  return (t0 + (int16_t)(((int32_t)(t1 - t0) * frac + ((1 << shift) >> 1)) >> shift)) * (1.0 / TEMPTABLE_UNIFORM_SCALE);
+}
+
 // Derived from RepRap FiveD extruder::getTemperature()
 // For hot end temperature measurement.
 static float analog2temp(int raw, uint8_t e) {
@@ -772,26 +1019,7 @@ static float analog2temp(int raw, uint8_t e) {
 
   if(heater_ttbl_map[e] != NULL)
   {
-    float celsius = 0;
-    uint8_t i;
-    short (*tt)[][2] = (short (*)[][2])(heater_ttbl_map[e]);
-
-    for (i=1; i<heater_ttbllen_map[e]; i++)
-    {
-      if (PGM_RD_W((*tt)[i][0]) > raw)
-      {
-        celsius = PGM_RD_W((*tt)[i-1][1]) +
-          (raw - PGM_RD_W((*tt)[i-1][0])) *
-          (float)(PGM_RD_W((*tt)[i][1]) - PGM_RD_W((*tt)[i-1][1])) /
-          (float)(PGM_RD_W((*tt)[i][0]) - PGM_RD_W((*tt)[i-1][0]));
-        break;
-      }
-    }
-
-    // Overflow: Set to last value in the table
-    if (i == heater_ttbllen_map[e]) celsius = PGM_RD_W((*tt)[i-1][1]);
-
-    return celsius;
+    return uniform_table_lookup((const short*)heater_ttbl_map[e], heater_ttblshift_map[e], raw);
   }
   return ((raw * ((5.0 * 100.0) / 1024.0) / OVERSAMPLENR) * TEMP_SENSOR_AD595_GAIN) + TEMP_SENSOR_AD595_OFFSET;
 }
@@ -801,25 +1029,7 @@ static float analog2temp(int raw, uint8_t e) {
 // For bed temperature measurement.
 static float analog2tempBed(int raw) {
   #ifdef BED_USES_THERMISTOR
-    float celsius = 0;
-    byte i;
-
-    for (i=1; i<BEDTEMPTABLE_LEN; i++)
-    {
-      if (PGM_RD_W(BEDTEMPTABLE[i][0]) > raw)
-      {
-        celsius  = PGM_RD_W(BEDTEMPTABLE[i-1][1]) +
-          (raw - PGM_RD_W(BEDTEMPTABLE[i-1][0])) *
-          (float)(PGM_RD_W(BEDTEMPTABLE[i][1]) - PGM_RD_W(BEDTEMPTABLE[i-1][1])) /
-          (float)(PGM_RD_W(BEDTEMPTABLE[i][0]) - PGM_RD_W(BEDTEMPTABLE[i-1][0]));
-        break;
-      }
-    }
-
-    // Overflow: Set to last value in the table
-    if (i == BEDTEMPTABLE_LEN) celsius = PGM_RD_W(BEDTEMPTABLE[i-1][1]);
-
-    return celsius;
+    return uniform_table_lookup(BEDTEMPTABLE, BEDTEMPTABLE_SHIFT, raw);
   #elif defined BED_USES_AD595
     return ((raw * ((5.0 * 100.0) / 1024.0) / OVERSAMPLENR) * TEMP_SENSOR_AD595_GAIN) + TEMP_SENSOR_AD595_OFFSET;
   #else
@@ -866,15 +1076,18 @@ void tp_init()
   for(int e = 0; e < EXTRUDERS; e++) {
     // populate with the first value
     maxttemp[e] = maxttemp[0];
-#ifdef PIDTEMP
+#if defined(PIDTEMP) && !defined(PID_FIXED_POINT)
     temp_iState_min[e] = 0.0;
     temp_iState_max[e] = PID_INTEGRAL_DRIVE_MAX / Ki;
 #endif //PIDTEMP
   }
-#if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0)
+#if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0) && !defined(PID_FIXED_POINT)
   temp_iState_min_bed = 0.0;
   temp_iState_max_bed = PID_INTEGRAL_DRIVE_MAX / bedKi;
 #endif //PIDTEMPBED
+#ifdef PID_FIXED_POINT
+  updatePID();
+#endif
 
   #if defined(HEATER_0_PIN) && (HEATER_0_PIN > -1)
     SET_OUTPUT(HEATER_0_PIN);
@@ -1090,6 +1303,7 @@ void disable_heater()
 
   #if defined(TEMP_BED_PIN) && (TEMP_BED_PIN > -1) && (TEMP_SENSOR_BED != 0)
     target_temperature_bed=0;
+    bed_pwm_request=0;
     soft_pwm_bed=0;
     #ifdef PIDTEMPBED
     pTerm_bed = 0;
@@ -1128,6 +1342,10 @@ void min_temp_error(uint8_t e) {
 }
 
 void bed_max_temp_error(void) {
+#if TEMP_SENSOR_BED != 0
+  bed_pwm_request = 0;
+  soft_pwm_bed = 0;
+#endif
 #if HEATER_BED_PIN > -1
   WRITE(HEATER_BED_PIN, 0);
 #endif
@@ -1218,9 +1436,11 @@ ISR(TIMER0_COMPB_vect)
   static unsigned char soft_pwm_0;
   #if EXTRUDERS > 1
   static unsigned char soft_pwm_1;
+  static unsigned char soft_phase_1;
   #endif
   #if EXTRUDERS > 2
   static unsigned char soft_pwm_2;
+  static unsigned char soft_phase_2;
   #endif
   #if HEATER_BED_PIN > -1
   static unsigned char soft_pwm_b;
@@ -1228,6 +1448,8 @@ ISR(TIMER0_COMPB_vect)
 
   if (pwm_count == 0)
   {
+    // The nozzle heaters are on one after the other: the second one turns on where the first one turns off, and so on.
+    // They only overlap when their duty cycles add up to more than a full cycle, which keeps the peak current down.
     soft_pwm_0 = soft_pwm[0];
     if (soft_pwm_0 > 0)
     {
@@ -1235,17 +1457,11 @@ ISR(TIMER0_COMPB_vect)
     }
     #if EXTRUDERS > 1
     soft_pwm_1 = soft_pwm[1];
-    if (soft_pwm_1 > 0)
-    {
-      WRITE(HEATER_1_PIN, 1);
-    }
+    soft_phase_1 = soft_pwm_0;
     #endif
     #if EXTRUDERS > 2
     soft_pwm_2 = soft_pwm[2];
-    if (soft_pwm_2 > 0)
-    {
-      WRITE(HEATER_2_PIN, 1);
-    }
+    soft_phase_2 = soft_pwm_0 + soft_pwm_1;
     #endif
     #if defined(HEATER_BED_PIN) && HEATER_BED_PIN > -1
     soft_pwm_b = soft_pwm_bed;
@@ -1257,10 +1473,10 @@ ISR(TIMER0_COMPB_vect)
   }
   if(soft_pwm_0 <= pwm_count) WRITE(HEATER_0_PIN,0);
   #if EXTRUDERS > 1
-  if(soft_pwm_1 <= pwm_count) WRITE(HEATER_1_PIN,0);
+  WRITE(HEATER_1_PIN, ((pwm_count - soft_phase_1) & 0x7f) < soft_pwm_1);
   #endif
   #if EXTRUDERS > 2
-  if(soft_pwm_2 <= pwm_count) WRITE(HEATER_2_PIN,0);
+  WRITE(HEATER_2_PIN, ((pwm_count - soft_phase_2) & 0x7f) < soft_pwm_2);
   #endif
   #if defined(HEATER_BED_PIN) && HEATER_BED_PIN > -1
   // bed is reverse of other heaters - nozzle heaters typically turn on at pwm_count=0 and typically
@@ -1461,24 +1677,6 @@ ISR(TIMER0_COMPB_vect)
     }
 #endif
   }
-#if defined(BABYSTEPPING)
-  for(uint8_t axis=0; axis<3; ++axis)
-  {
-    int curTodo=babystepsTodo[axis]; //get rid of volatile for performance
-
-    if(curTodo>0)
-    {
-      babystep(axis,/*fwd*/true);
-      --babystepsTodo[axis]; //less to do next time
-    }
-    else if(curTodo<0)
-    {
-      babystep(axis,/*fwd*/false);
-      ++babystepsTodo[axis]; //less to do next time
-    }
-  }
-#endif //BABYSTEPPING
-
 }
 
 #ifdef PIDTEMP
@@ -1575,6 +1773,8 @@ void setTargetBed(const uint16_t &celsius)
   target_temperature_bed = celsius;
   if (target_temperature_bed > BED_MAXTEMP - 15)
     target_temperature_bed = BED_MAXTEMP - 15;
+  if (target_temperature_bed == 0)
+    bed_pwm_request = 0;
 }
 #endif
 
@@ -45,9 +45,9 @@ extern float current_temperature_bed;
 
 #ifdef PIDTEMP
   extern float Kp,Ki,Kd;
-//  #ifdef PID_ADD_EXTRUSION_RATE
-//  extern float Kc;
-//  #endif // PID_ADD_EXTRUSION_RATE
+  #ifdef PID_ADD_EXTRUSION_RATE
+  extern float Kc;
+  #endif // PID_ADD_EXTRUSION_RATE
   float scalePID_i(float i);
   float scalePID_d(float d);
   float unscalePID_i(float i);
@@ -58,10 +58,6 @@ extern float current_temperature_bed;
   extern float bedKp,bedKi,bedKd;
 #endif
 
-#if defined(BABYSTEPPING)
-  extern volatile int babystepsTodo[3];
-#endif
-
 //high level conversion routines, for use outside of temperature.cpp
 //inline so that there is no performance decrease.
 //deg=degreeCelsius
@@ -686,18 +686,23 @@ const short temptable_60[][2] PROGMEM = {
 #endif
 
 
-#define _TT_NAME(_N) temptable_ ## _N
+#include "thermistortables_uniform.h"
+
+//analog2temp() uses the tables above resampled to uniformly spaced raw values by createTemperatureLookupMarlin.py --uniform
+#define _TT_NAME(_N) temptable_uniform_ ## _N
 #define TT_NAME(_N) _TT_NAME(_N)
+#define _TT_SHIFT(_N) TEMPTABLE_UNIFORM_ ## _N ## _SHIFT
+#define TT_SHIFT(_N) _TT_SHIFT(_N)
 
 #ifdef THERMISTORHEATER_0
 # define HEATER_0_TEMPTABLE TT_NAME(THERMISTORHEATER_0)
-# define HEATER_0_TEMPTABLE_LEN (sizeof(HEATER_0_TEMPTABLE)/sizeof(*HEATER_0_TEMPTABLE))
+# define HEATER_0_TEMPTABLE_SHIFT TT_SHIFT(THERMISTORHEATER_0)
 #else
 # ifdef HEATER_0_USES_THERMISTOR
 #  error No heater 0 thermistor table specified
 # else  // HEATER_0_USES_THERMISTOR
 #  define HEATER_0_TEMPTABLE NULL
-#  define HEATER_0_TEMPTABLE_LEN 0
+#  define HEATER_0_TEMPTABLE_SHIFT 0
 # endif // HEATER_0_USES_THERMISTOR
 #endif
 
@@ -714,13 +719,13 @@ const short temptable_60[][2] PROGMEM = {
 
 #ifdef THERMISTORHEATER_1
 # define HEATER_1_TEMPTABLE TT_NAME(THERMISTORHEATER_1)
-# define HEATER_1_TEMPTABLE_LEN (sizeof(HEATER_1_TEMPTABLE)/sizeof(*HEATER_1_TEMPTABLE))
+# define HEATER_1_TEMPTABLE_SHIFT TT_SHIFT(THERMISTORHEATER_1)
 #else
 # ifdef HEATER_1_USES_THERMISTOR
 #  error No heater 1 thermistor table specified
 # else  // HEATER_1_USES_THERMISTOR
 #  define HEATER_1_TEMPTABLE NULL
-#  define HEATER_1_TEMPTABLE_LEN 0
+#  define HEATER_1_TEMPTABLE_SHIFT 0
 # endif // HEATER_1_USES_THERMISTOR
 #endif
 
@@ -737,13 +742,13 @@ const short temptable_60[][2] PROGMEM = {
 
 #ifdef THERMISTORHEATER_2
 # define HEATER_2_TEMPTABLE TT_NAME(THERMISTORHEATER_2)
-# define HEATER_2_TEMPTABLE_LEN (sizeof(HEATER_2_TEMPTABLE)/sizeof(*HEATER_2_TEMPTABLE))
+# define HEATER_2_TEMPTABLE_SHIFT TT_SHIFT(THERMISTORHEATER_2)
 #else
 # ifdef HEATER_2_USES_THERMISTOR
 #  error No heater 2 thermistor table specified
 # else  // HEATER_2_USES_THERMISTOR
 #  define HEATER_2_TEMPTABLE NULL
-#  define HEATER_2_TEMPTABLE_LEN 0
+#  define HEATER_2_TEMPTABLE_SHIFT 0
 # endif // HEATER_2_USES_THERMISTOR
 #endif
 
@@ -760,7 +765,7 @@ const short temptable_60[][2] PROGMEM = {
 
 #ifdef THERMISTORBED
 # define BEDTEMPTABLE TT_NAME(THERMISTORBED)
-# define BEDTEMPTABLE_LEN (sizeof(BEDTEMPTABLE)/sizeof(*BEDTEMPTABLE))
+# define BEDTEMPTABLE_SHIFT TT_SHIFT(THERMISTORBED)
 #else
 # ifdef BED_USES_THERMISTOR
 #  error No bed thermistor table specified
@@ -0,0 +1,1452 @@
+// Generated from thermistortables.h by createTemperatureLookupMarlin.py --uniform, do not edit.
+// temptable_uniform_N[i] is temptable_N at raw value (i << TEMPTABLE_UNIFORM_N_SHIFT), in 1/TEMPTABLE_UNIFORM_SCALE degrees C.
+#ifndef THERMISTORTABLES_UNIFORM_H_
+#define THERMISTORTABLES_UNIFORM_H_
+
+#define TEMPTABLE_UNIFORM_SCALE 16
+#define TEMPTABLE_UNIFORM_RAW_MAX 8192
+#if OVERSAMPLENR != 8
+# error OVERSAMPLENR changed, generate thermistortables_uniform.h again
+#endif
+
+#if (THERMISTORHEATER_0 == 1) || (THERMISTORHEATER_1 == 1) || (THERMISTORHEATER_2 == 1) || (THERMISTORBED == 1)
+// 1025 entries, at most 0.06 degrees C from temptable_1 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_1_SHIFT 3
+const short temptable_uniform_1[] PROGMEM = {
+  5720, 5680, 5640, 5600, 5560, 5520, 5480, 5440,
+  5400, 5360, 5320, 5280, 5240, 5200, 5160, 5120,
+  5080, 5040, 5000, 4960, 4920, 4880, 4840, 4800,
+  4760, 4720, 4680, 4640, 4560, 4533, 4507, 4480,
+  4440, 4400, 4360, 4320, 4293, 4267, 4240, 4213,
+  4187, 4160, 4133, 4107, 4080, 4060, 4040, 4020,
+  4000, 3980, 3960, 3940, 3920, 3900, 3880, 3860,
+  3840, 3824, 3808, 3792, 3776, 3760, 3744, 3728,
+  3712, 3696, 3680, 3664, 3648, 3632, 3616, 3600,
+  3589, 3577, 3566, 3554, 3543, 3531, 3520, 3507,
+  3493, 3480, 3467, 3453, 3440, 3430, 3420, 3410,
+  3400, 3390, 3380, 3370, 3360, 3350, 3340, 3330,
+  3320, 3310, 3300, 3290, 3280, 3271, 3262, 3253,
+  3244, 3236, 3227, 3218, 3209, 3200, 3193, 3185,
+  3178, 3171, 3164, 3156, 3149, 3142, 3135, 3127,
+  3120, 3113, 3105, 3098, 3091, 3084, 3076, 3069,
+  3062, 3055, 3047, 3040, 3033, 3027, 3020, 3013,
+  3007, 3000, 2993, 2987, 2980, 2973, 2967, 2960,
+  2954, 2948, 2942, 2935, 2929, 2923, 2917, 2911,
+  2905, 2898, 2892, 2886, 2880, 2875, 2869, 2864,
+  2859, 2853, 2848, 2843, 2837, 2832, 2827, 2821,
+  2816, 2811, 2805, 2800, 2795, 2790, 2785, 2780,
+  2775, 2770, 2765, 2760, 2755, 2750, 2745, 2740,
+  2735, 2730, 2725, 2720, 2716, 2711, 2707, 2702,
+  2698, 2693, 2689, 2684, 2680, 2676, 2671, 2667,
+  2662, 2658, 2653, 2649, 2644, 2640, 2636, 2632,
+  2627, 2623, 2619, 2615, 2611, 2606, 2602, 2598,
+  2594, 2589, 2585, 2581, 2577, 2573, 2568, 2564,
+  2560, 2556, 2552, 2549, 2545, 2541, 2537, 2533,
+  2530, 2526, 2522, 2518, 2514, 2510, 2507, 2503,
+  2499, 2495, 2491, 2488, 2484, 2480, 2477, 2473,
+  2470, 2466, 2463, 2459, 2456, 2452, 2449, 2445,
+  2442, 2438, 2435, 2431, 2428, 2424, 2421, 2417,
+  2414, 2410, 2407, 2403, 2400, 2397, 2394, 2390,
+  2387, 2384, 2381, 2378, 2374, 2371, 2368, 2365,
+  2362, 2358, 2355, 2352, 2349, 2346, 2342, 2339,
+  2336, 2333, 2330, 2326, 2323, 2320, 2317, 2314,
+  2311, 2308, 2305, 2302, 2299, 2296, 2293, 2290,
+  2287, 2284, 2281, 2279, 2276, 2273, 2270, 2267,
+  2264, 2261, 2258, 2255, 2252, 2249, 2246, 2243,
+  2240, 2237, 2234, 2231, 2229, 2226, 2223, 2220,
+  2217, 2214, 2211, 2209, 2206, 2203, 2200, 2197,
+  2194, 2191, 2189, 2186, 2183, 2180, 2177, 2174,
+  2171, 2169, 2166, 2163, 2160, 2157, 2155, 2152,
+  2150, 2147, 2145, 2142, 2139, 2137, 2134, 2132,
+  2129, 2126, 2124, 2121, 2119, 2116, 2114, 2111,
+  2108, 2106, 2103, 2101, 2098, 2095, 2093, 2090,
+  2088, 2085, 2083, 2080, 2078, 2075, 2072, 2070,
+  2068, 2065, 2062, 2060, 2058, 2055, 2052, 2050,
+  2048, 2045, 2042, 2040, 2038, 2035, 2032, 2030,
+  2028, 2025, 2022, 2020, 2018, 2015, 2012, 2010,
+  2008, 2005, 2002, 2000, 1998, 1995, 1993, 1991,
+  1988, 1986, 1984, 1981, 1979, 1976, 1974, 1972,
+  1969, 1967, 1965, 1962, 1960, 1958, 1955, 1953,
+  1951, 1948, 1946, 1944, 1941, 1939, 1936, 1934,
+  1932, 1929, 1927, 1925, 1922, 1920, 1918, 1915,
+  1913, 1911, 1909, 1906, 1904, 1902, 1899, 1897,
+  1895, 1893, 1890, 1888, 1886, 1883, 1881, 1879,
+  1877, 1874, 1872, 1870, 1867, 1865, 1863, 1861,
+  1858, 1856, 1854, 1851, 1849, 1847, 1845, 1842,
+  1840, 1838, 1836, 1833, 1831, 1829, 1827, 1824,
+  1822, 1820, 1818, 1816, 1813, 1811, 1809, 1807,
+  1804, 1802, 1800, 1798, 1796, 1793, 1791, 1789,
+  1787, 1784, 1782, 1780, 1778, 1776, 1773, 1771,
+  1769, 1767, 1764, 1762, 1760, 1758, 1756, 1754,
+  1751, 1749, 1747, 1745, 1743, 1741, 1738, 1736,
+  1734, 1732, 1730, 1728, 1725, 1723, 1721, 1719,
+  1717, 1715, 1712, 1710, 1708, 1706, 1704, 1702,
+  1699, 1697, 1695, 1693, 1691, 1689, 1686, 1684,
+  1682, 1680, 1678, 1676, 1674, 1672, 1669, 1667,
+  1665, 1663, 1661, 1659, 1657, 1655, 1653, 1651,
+  1648, 1646, 1644, 1642, 1640, 1638, 1636, 1634,
+  1632, 1629, 1627, 1625, 1623, 1621, 1619, 1617,
+  1615, 1613, 1611, 1608, 1606, 1604, 1602, 1600,
+  1598, 1596, 1594, 1591, 1589, 1587, 1585, 1583,
+  1581, 1578, 1576, 1574, 1572, 1570, 1568, 1565,
+  1563, 1561, 1559, 1557, 1555, 1552, 1550, 1548,
+  1546, 1544, 1542, 1539, 1537, 1535, 1533, 1531,
+  1529, 1526, 1524, 1522, 1520, 1518, 1516, 1514,
+  1511, 1509, 1507, 1505, 1503, 1501, 1498, 1496,
+  1494, 1492, 1490, 1488, 1485, 1483, 1481, 1479,
+  1477, 1475, 1472, 1470, 1468, 1466, 1464, 1462,
+  1459, 1457, 1455, 1453, 1451, 1449, 1446, 1444,
+  1442, 1440, 1438, 1436, 1434, 1431, 1429, 1427,
+  1425, 1423, 1421, 1418, 1416, 1414, 1412, 1410,
+  1408, 1405, 1403, 1401, 1399, 1397, 1395, 1392,
+  1390, 1388, 1386, 1384, 1382, 1379, 1377, 1375,
+  1373, 1371, 1369, 1366, 1364, 1362, 1360, 1358,
+  1355, 1353, 1351, 1349, 1346, 1344, 1342, 1339,
+  1337, 1335, 1333, 1330, 1328, 1326, 1323, 1321,
+  1319, 1317, 1314, 1312, 1310, 1307, 1305, 1303,
+  1301, 1298, 1296, 1294, 1291, 1289, 1287, 1285,
+  1282, 1280, 1278, 1275, 1273, 1270, 1268, 1265,
+  1263, 1261, 1258, 1256, 1253, 1251, 1248, 1246,
+  1244, 1241, 1239, 1236, 1234, 1232, 1229, 1227,
+  1224, 1222, 1219, 1217, 1215, 1212, 1210, 1207,
+  1205, 1202, 1200, 1197, 1195, 1192, 1190, 1187,
+  1185, 1182, 1179, 1177, 1174, 1172, 1169, 1166,
+  1164, 1161, 1159, 1156, 1154, 1151, 1148, 1146,
+  1143, 1141, 1138, 1135, 1133, 1130, 1128, 1125,
+  1123, 1120, 1117, 1114, 1112, 1109, 1106, 1103,
+  1101, 1098, 1095, 1092, 1090, 1087, 1084, 1081,
+  1079, 1076, 1073, 1070, 1068, 1065, 1062, 1059,
+  1057, 1054, 1051, 1048, 1046, 1043, 1040, 1037,
+  1034, 1031, 1028, 1025, 1022, 1019, 1016, 1013,
+  1010, 1007, 1004, 1001, 999, 996, 993, 990,
+  987, 984, 981, 978, 975, 972, 969, 966,
+  963, 960, 957, 953, 950, 947, 943, 940,
+  937, 933, 930, 927, 923, 920, 917, 913,
+  910, 907, 903, 900, 897, 893, 890, 887,
+  883, 880, 876, 873, 869, 865, 862, 858,
+  855, 851, 847, 844, 840, 836, 833, 829,
+  825, 822, 818, 815, 811, 807, 804, 800,
+  796, 792, 787, 783, 779, 775, 771, 766,
+  762, 758, 754, 749, 745, 741, 737, 733,
+  728, 724, 720, 715, 711, 706, 701, 696,
+  692, 687, 682, 678, 673, 668, 664, 659,
+  654, 649, 645, 640, 635, 629, 624, 619,
+  613, 608, 603, 597, 592, 587, 581, 576,
+  571, 565, 560, 553, 547, 540, 533, 527,
+  520, 513, 507, 500, 493, 487, 480, 473,
+  465, 458, 451, 444, 436, 429, 422, 415,
+  407, 400, 390, 380, 370, 360, 350, 340,
+  330, 320, 310, 300, 290, 280, 270, 260,
+  250, 240, 227, 213, 200, 187, 173, 160,
+  144, 128, 112, 96, 80, 60, 40, 20,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 2) || (THERMISTORHEATER_1 == 2) || (THERMISTORHEATER_2 == 2) || (THERMISTORBED == 2)
+// 513 entries, at most 0.31 degrees C from temptable_2 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_2_SHIFT 4
+const short temptable_uniform_2[] PROGMEM = {
+  13870, 13266, 12661, 12056, 11452, 10847, 10242, 9638,
+  9033, 8428, 7823, 7219, 6614, 6009, 5405, 4800,
+  4720, 4640, 4576, 4512, 4457, 4411, 4366, 4320,
+  4274, 4229, 4183, 4144, 4112, 4080, 4048, 4016,
+  3985, 3956, 3927, 3898, 3869, 3840, 3815, 3791,
+  3766, 3742, 3717, 3692, 3671, 3652, 3633, 3614,
+  3595, 3576, 3558, 3539, 3520, 3504, 3488, 3472,
+  3456, 3440, 3424, 3408, 3392, 3376, 3360, 3347,
+  3333, 3320, 3307, 3293, 3280, 3267, 3253, 3240,
+  3227, 3213, 3200, 3189, 3177, 3166, 3154, 3143,
+  3131, 3120, 3109, 3097, 3086, 3074, 3063, 3051,
+  3040, 3031, 3022, 3013, 3003, 2994, 2985, 2976,
+  2967, 2958, 2949, 2939, 2930, 2921, 2912, 2903,
+  2894, 2885, 2876, 2868, 2860, 2853, 2845, 2837,
+  2829, 2821, 2814, 2806, 2798, 2790, 2782, 2775,
+  2767, 2759, 2751, 2743, 2736, 2728, 2720, 2713,
+  2707, 2700, 2694, 2687, 2681, 2674, 2668, 2661,
+  2655, 2648, 2642, 2635, 2629, 2622, 2616, 2609,
+  2602, 2596, 2589, 2583, 2576, 2570, 2563, 2557,
+  2551, 2546, 2540, 2534, 2529, 2523, 2517, 2511,
+  2506, 2500, 2494, 2489, 2483, 2477, 2471, 2466,
+  2460, 2454, 2449, 2443, 2437, 2431, 2426, 2420,
+  2414, 2409, 2403, 2397, 2392, 2387, 2382, 2377,
+  2372, 2367, 2362, 2357, 2352, 2347, 2342, 2337,
+  2331, 2326, 2321, 2316, 2311, 2306, 2301, 2296,
+  2291, 2286, 2281, 2276, 2270, 2265, 2260, 2255,
+  2250, 2245, 2240, 2235, 2231, 2226, 2221, 2217,
+  2212, 2208, 2203, 2198, 2194, 2189, 2184, 2180,
+  2175, 2170, 2166, 2161, 2157, 2152, 2147, 2143,
+  2138, 2133, 2129, 2124, 2119, 2115, 2110, 2106,
+  2101, 2096, 2092, 2087, 2082, 2078, 2073, 2069,
+  2065, 2060, 2056, 2052, 2047, 2043, 2038, 2034,
+  2030, 2025, 2021, 2016, 2012, 2008, 2003, 1999,
+  1995, 1990, 1986, 1981, 1977, 1973, 1968, 1964,
+  1959, 1955, 1951, 1946, 1942, 1938, 1933, 1929,
+  1924, 1920, 1916, 1911, 1907, 1903, 1898, 1894,
+  1890, 1885, 1881, 1877, 1872, 1868, 1864, 1859,
+  1855, 1851, 1846, 1842, 1838, 1834, 1829, 1825,
+  1821, 1816, 1812, 1808, 1803, 1799, 1795, 1790,
+  1786, 1782, 1777, 1773, 1769, 1764, 1760, 1756,
+  1751, 1747, 1742, 1738, 1733, 1729, 1724, 1720,
+  1716, 1711, 1707, 1702, 1698, 1693, 1689, 1684,
+  1680, 1676, 1671, 1667, 1662, 1658, 1653, 1649,
+  1644, 1640, 1636, 1631, 1627, 1622, 1618, 1613,
+  1609, 1604, 1600, 1595, 1590, 1586, 1581, 1576,
+  1571, 1567, 1562, 1557, 1552, 1547, 1543, 1538,
+  1533, 1528, 1524, 1519, 1514, 1509, 1504, 1500,
+  1495, 1490, 1485, 1481, 1476, 1471, 1466, 1461,
+  1457, 1452, 1447, 1442, 1437, 1432, 1427, 1421,
+  1416, 1411, 1405, 1400, 1395, 1389, 1384, 1379,
+  1373, 1368, 1363, 1357, 1352, 1347, 1341, 1336,
+  1331, 1325, 1320, 1315, 1309, 1304, 1299, 1293,
+  1288, 1283, 1277, 1270, 1264, 1257, 1251, 1244,
+  1238, 1231, 1224, 1218, 1211, 1205, 1198, 1192,
+  1185, 1179, 1172, 1166, 1159, 1153, 1146, 1140,
+  1133, 1127, 1120, 1112, 1104, 1096, 1088, 1080,
+  1072, 1064, 1056, 1048, 1040, 1032, 1024, 1016,
+  1008, 1000, 992, 984, 976, 968, 960, 950,
+  939, 929, 919, 908, 898, 888, 877, 867,
+  857, 846, 836, 826, 815, 805, 793, 778,
+  764, 749, 735, 720, 705, 691, 676, 662,
+  647, 630, 610, 590, 570, 550, 530, 510,
+  490, 465, 436, 407, 378, 349, 320, 280,
+  240, 200, 160, 80, 0, 0, 0, 0,
+  0
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 3) || (THERMISTORHEATER_1 == 3) || (THERMISTORHEATER_2 == 3) || (THERMISTORBED == 3)
+// 1025 entries, at most 0.06 degrees C from temptable_3 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_3_SHIFT 3
+const short temptable_uniform_3[] PROGMEM = {
+  14275, 13824, 13373, 12922, 12470, 12019, 11568, 11117,
+  10666, 10214, 9763, 9312, 8861, 8410, 7958, 7507,
+  7056, 6605, 6154, 5702, 5251, 4800, 4760, 4720,
+  4680, 4640, 4600, 4560, 4520, 4480, 4440, 4400,
+  4360, 4320, 4293, 4267, 4240, 4213, 4187, 4160,
+  4137, 4114, 4091, 4069, 4046, 4023, 4000, 3980,
+  3960, 3940, 3920, 3900, 3880, 3860, 3840, 3824,
+  3808, 3792, 3776, 3760, 3744, 3728, 3712, 3696,
+  3680, 3665, 3651, 3636, 3622, 3607, 3593, 3578,
+  3564, 3549, 3535, 3520, 3509, 3499, 3488, 3477,
+  3467, 3456, 3445, 3435, 3424, 3413, 3403, 3392,
+  3381, 3371, 3360, 3351, 3341, 3332, 3322, 3313,
+  3304, 3294, 3285, 3275, 3266, 3256, 3247, 3238,
+  3228, 3219, 3209, 3200, 3192, 3185, 3177, 3170,
+  3162, 3154, 3147, 3139, 3131, 3124, 3116, 3109,
+  3101, 3093, 3086, 3078, 3070, 3063, 3055, 3048,
+  3040, 3034, 3028, 3022, 3015, 3009, 3003, 2997,
+  2991, 2985, 2978, 2972, 2966, 2960, 2954, 2948,
+  2942, 2935, 2929, 2923, 2917, 2911, 2905, 2898,
+  2892, 2886, 2880, 2875, 2869, 2864, 2859, 2853,
+  2848, 2843, 2837, 2832, 2827, 2821, 2816, 2811,
+  2805, 2800, 2795, 2789, 2784, 2779, 2773, 2768,
+  2763, 2757, 2752, 2747, 2741, 2736, 2731, 2725,
+  2720, 2716, 2711, 2707, 2703, 2698, 2694, 2690,
+  2685, 2681, 2677, 2672, 2668, 2664, 2659, 2655,
+  2651, 2646, 2642, 2638, 2634, 2629, 2625, 2621,
+  2616, 2612, 2608, 2603, 2599, 2595, 2590, 2586,
+  2582, 2577, 2573, 2569, 2564, 2560, 2556, 2553,
+  2549, 2545, 2542, 2538, 2535, 2531, 2527, 2524,
+  2520, 2516, 2513, 2509, 2505, 2502, 2498, 2495,
+  2491, 2487, 2484, 2480, 2476, 2473, 2469, 2465,
+  2462, 2458, 2455, 2451, 2447, 2444, 2440, 2436,
+  2433, 2429, 2425, 2422, 2418, 2415, 2411, 2407,
+  2404, 2400, 2397, 2394, 2391, 2387, 2384, 2381,
+  2378, 2375, 2372, 2369, 2365, 2362, 2359, 2356,
+  2353, 2350, 2347, 2344, 2340, 2337, 2334, 2331,
+  2328, 2325, 2322, 2318, 2315, 2312, 2309, 2306,
+  2303, 2300, 2296, 2293, 2290, 2287, 2284, 2281,
+  2278, 2275, 2271, 2268, 2265, 2262, 2259, 2256,
+  2253, 2249, 2246, 2243, 2240, 2237, 2235, 2232,
+  2229, 2226, 2224, 2221, 2218, 2216, 2213, 2210,
+  2207, 2205, 2202, 2199, 2197, 2194, 2191, 2188,
+  2186, 2183, 2180, 2178, 2175, 2172, 2169, 2167,
+  2164, 2161, 2159, 2156, 2153, 2151, 2148, 2145,
+  2142, 2140, 2137, 2134, 2132, 2129, 2126, 2123,
+  2121, 2118, 2115, 2113, 2110, 2107, 2104, 2102,
+  2099, 2096, 2094, 2091, 2088, 2085, 2083, 2080,
+  2078, 2075, 2073, 2070, 2068, 2065, 2063, 2061,
+  2058, 2056, 2053, 2051, 2048, 2046, 2044, 2041,
+  2039, 2036, 2034, 2032, 2029, 2027, 2024, 2022,
+  2019, 2017, 2015, 2012, 2010, 2007, 2005, 2002,
+  2000, 1998, 1995, 1993, 1990, 1988, 1985, 1983,
+  1981, 1978, 1976, 1973, 1971, 1968, 1966, 1964,
+  1961, 1959, 1956, 1954, 1952, 1949, 1947, 1944,
+  1942, 1939, 1937, 1935, 1932, 1930, 1927, 1925,
+  1922, 1920, 1918, 1916, 1913, 1911, 1909, 1907,
+  1904, 1902, 1900, 1898, 1896, 1893, 1891, 1889,
+  1887, 1884, 1882, 1880, 1878, 1876, 1873, 1871,
+  1869, 1867, 1864, 1862, 1860, 1858, 1856, 1853,
+  1851, 1849, 1847, 1844, 1842, 1840, 1838, 1836,
+  1833, 1831, 1829, 1827, 1824, 1822, 1820, 1818,
+  1816, 1813, 1811, 1809, 1807, 1804, 1802, 1800,
+  1798, 1796, 1793, 1791, 1789, 1787, 1784, 1782,
+  1780, 1778, 1776, 1773, 1771, 1769, 1767, 1764,
+  1762, 1760, 1758, 1756, 1754, 1751, 1749, 1747,
+  1745, 1743, 1741, 1739, 1737, 1734, 1732, 1730,
+  1728, 1726, 1724, 1722, 1719, 1717, 1715, 1713,
+  1711, 1709, 1707, 1705, 1702, 1700, 1698, 1696,
+  1694, 1692, 1690, 1687, 1685, 1683, 1681, 1679,
+  1677, 1675, 1673, 1670, 1668, 1666, 1664, 1662,
+  1660, 1658, 1655, 1653, 1651, 1649, 1647, 1645,
+  1643, 1641, 1638, 1636, 1634, 1632, 1630, 1628,
+  1626, 1623, 1621, 1619, 1617, 1615, 1613, 1611,
+  1609, 1606, 1604, 1602, 1600, 1598, 1596, 1593,
+  1591, 1589, 1587, 1585, 1582, 1580, 1578, 1576,
+  1574, 1572, 1569, 1567, 1565, 1563, 1561, 1558,
+  1556, 1554, 1552, 1550, 1547, 1545, 1543, 1541,
+  1539, 1536, 1534, 1532, 1530, 1528, 1525, 1523,
+  1521, 1519, 1517, 1515, 1512, 1510, 1508, 1506,
+  1504, 1501, 1499, 1497, 1495, 1493, 1490, 1488,
+  1486, 1484, 1482, 1479, 1477, 1475, 1473, 1471,
+  1468, 1466, 1464, 1462, 1460, 1458, 1455, 1453,
+  1451, 1449, 1447, 1444, 1442, 1440, 1438, 1436,
+  1433, 1431, 1429, 1427, 1425, 1422, 1420, 1418,
+  1416, 1414, 1412, 1409, 1407, 1405, 1403, 1401,
+  1398, 1396, 1394, 1392, 1390, 1387, 1385, 1383,
+  1381, 1379, 1376, 1374, 1372, 1370, 1368, 1365,
+  1363, 1361, 1359, 1357, 1355, 1352, 1350, 1348,
+  1346, 1344, 1341, 1339, 1337, 1335, 1333, 1330,
+  1328, 1326, 1324, 1322, 1319, 1317, 1315, 1313,
+  1311, 1308, 1306, 1304, 1302, 1300, 1298, 1295,
+  1293, 1291, 1289, 1287, 1284, 1282, 1280, 1277,
+  1275, 1272, 1270, 1267, 1264, 1262, 1259, 1256,
+  1254, 1251, 1249, 1246, 1243, 1241, 1238, 1235,
+  1233, 1230, 1228, 1225, 1222, 1220, 1217, 1214,
+  1212, 1209, 1207, 1204, 1201, 1199, 1196, 1193,
+  1191, 1188, 1186, 1183, 1180, 1178, 1175, 1172,
+  1170, 1167, 1165, 1162, 1159, 1157, 1154, 1151,
+  1149, 1146, 1144, 1141, 1138, 1136, 1133, 1130,
+  1128, 1125, 1123, 1120, 1117, 1115, 1112, 1110,
+  1107, 1104, 1102, 1099, 1096, 1094, 1091, 1089,
+  1086, 1083, 1081, 1078, 1075, 1073, 1070, 1068,
+  1065, 1062, 1060, 1057, 1054, 1052, 1049, 1047,
+  1044, 1041, 1039, 1036, 1033, 1031, 1028, 1026,
+  1023, 1020, 1018, 1015, 1012, 1010, 1007, 1005,
+  1002, 999, 997, 994, 991, 989, 986, 984,
+  981, 978, 976, 973, 970, 968, 965, 963,
+  960, 956, 952, 948, 944, 940, 937, 933,
+  929, 925, 921, 917, 913, 909, 905, 901,
+  898, 894, 890, 886, 882, 878, 874, 870,
+  866, 862, 859, 855, 851, 847, 843, 839,
+  835, 831, 827, 823, 820, 816, 812, 808,
+  804, 800, 796, 792, 788, 784, 780, 777,
+  773, 769, 765, 761, 757, 753, 749, 745,
+  741, 738, 734, 730, 726, 722, 718, 714,
+  710, 706, 702, 699, 695, 691, 687, 683,
+  679, 675, 671, 667, 663, 660, 656, 652,
+  648, 644, 640, 633, 627, 620, 613, 607,
+  600, 593, 587, 580, 573, 567, 560, 553,
+  547, 540, 533, 527, 520, 513, 507, 500,
+  493, 487, 480, 473, 467, 460, 453, 447,
+  440, 433, 427, 420, 413, 407, 400, 393,
+  387, 380, 373, 367, 360, 353, 347, 340,
+  333, 327, 320, 305, 291, 276, 262, 247,
+  233, 218, 204, 189, 175, 160, 145, 131,
+  116, 102, 87, 73, 58, 44, 29, 15,
+  0, -32, -64, -96, -128, -160, -192, -224,
+  -256, -288, -320, -320, -320, -320, -320, -320,
+  -320
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 4) || (THERMISTORHEATER_1 == 4) || (THERMISTORHEATER_2 == 4) || (THERMISTORBED == 4)
+// 513 entries, at most 0.12 degrees C from temptable_4 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_4_SHIFT 4
+const short temptable_uniform_4[] PROGMEM = {
+  6968, 6792, 6615, 6438, 6261, 6084, 5907, 5730,
+  5553, 5376, 5199, 5022, 4846, 4669, 4492, 4315,
+  4138, 3961, 3784, 3607, 3430, 3253, 3077, 2900,
+  2723, 2546, 2369, 2192, 2174, 2156, 2138, 2120,
+  2101, 2083, 2065, 2047, 2029, 2011, 1993, 1975,
+  1957, 1938, 1920, 1902, 1884, 1866, 1848, 1830,
+  1812, 1794, 1775, 1757, 1739, 1721, 1707, 1698,
+  1688, 1678, 1669, 1659, 1649, 1640, 1630, 1620,
+  1611, 1601, 1591, 1582, 1572, 1562, 1553, 1543,
+  1533, 1524, 1514, 1504, 1495, 1485, 1475, 1466,
+  1456, 1449, 1443, 1436, 1429, 1423, 1416, 1410,
+  1403, 1396, 1390, 1383, 1376, 1370, 1363, 1356,
+  1350, 1343, 1336, 1330, 1323, 1317, 1310, 1303,
+  1297, 1290, 1283, 1277, 1272, 1266, 1261, 1256,
+  1250, 1245, 1239, 1234, 1228, 1223, 1218, 1212,
+  1207, 1201, 1196, 1190, 1185, 1179, 1174, 1169,
+  1163, 1158, 1152, 1147, 1141, 1136, 1132, 1128,
+  1123, 1119, 1115, 1111, 1106, 1102, 1098, 1094,
+  1090, 1085, 1081, 1077, 1073, 1068, 1064, 1060,
+  1056, 1051, 1047, 1043, 1039, 1035, 1030, 1026,
+  1022, 1018, 1013, 1009, 1005, 1001, 997, 992,
+  988, 984, 980, 975, 971, 967, 963, 958,
+  954, 950, 946, 942, 937, 933, 929, 925,
+  920, 916, 912, 908, 905, 901, 898, 894,
+  890, 887, 883, 879, 876, 872, 869, 865,
+  861, 858, 854, 850, 847, 843, 840, 836,
+  832, 829, 825, 821, 818, 814, 811, 808,
+  805, 802, 799, 796, 793, 790, 787, 784,
+  781, 778, 775, 772, 769, 766, 763, 760,
+  757, 754, 751, 748, 745, 742, 739, 736,
+  733, 730, 727, 724, 721, 718, 715, 712,
+  709, 706, 703, 700, 697, 694, 691, 688,
+  685, 682, 679, 676, 673, 670, 667, 664,
+  661, 658, 654, 651, 647, 643, 640, 636,
+  632, 629, 625, 622, 618, 614, 611, 607,
+  603, 600, 596, 593, 589, 585, 582, 578,
+  574, 571, 567, 564, 560, 557, 554, 551,
+  548, 545, 542, 539, 536, 533, 530, 527,
+  524, 521, 518, 515, 512, 509, 506, 503,
+  500, 497, 494, 491, 488, 485, 482, 478,
+  475, 472, 469, 466, 463, 460, 457, 454,
+  451, 448, 445, 442, 439, 436, 433, 430,
+  427, 424, 421, 418, 415, 412, 409, 406,
+  403, 400, 397, 394, 391, 388, 385, 382,
+  379, 376, 373, 370, 367, 364, 361, 358,
+  355, 352, 349, 346, 343, 340, 337, 334,
+  331, 328, 325, 322, 318, 315, 311, 307,
+  304, 300, 296, 293, 289, 286, 282, 278,
+  275, 271, 267, 264, 260, 257, 253, 249,
+  246, 242, 238, 235, 231, 228, 224, 220,
+  216, 211, 207, 203, 199, 194, 190, 186,
+  182, 178, 173, 169, 165, 161, 156, 152,
+  148, 144, 139, 135, 131, 127, 123, 118,
+  114, 110, 106, 101, 97, 93, 89, 85,
+  80, 76, 72, 68, 63, 59, 55, 51,
+  46, 42, 38, 34, 30, 25, 21, 17,
+  13, 8, 4, 0, -7, -13, -20, -27,
+  -33, -40, -46, -53, -60, -66, -73, -80,
+  -86, -93, -100, -106, -113, -120, -126, -133,
+  -139, -146, -153, -159, -166, -173, -183, -198,
+  -212, -227, -241, -256, -270, -285, -299, -314,
+  -328, -343, -357, -372, -386, -401, -415, -430,
+  -444, -459, -473, -488, -502, -517, -531, -546,
+  -560, -560, -560, -560, -560, -560, -560, -560,
+  -560
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 5) || (THERMISTORHEATER_1 == 5) || (THERMISTORHEATER_2 == 5) || (THERMISTORBED == 5)
+// 1025 entries, at most 0.06 degrees C from temptable_5 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_5_SHIFT 3
+const short temptable_uniform_5[] PROGMEM = {
+  11821, 11408, 10995, 10582, 10169, 9756, 9343, 8930,
+  8517, 8104, 7691, 7278, 6865, 6452, 6039, 5626,
+  5213, 4800, 4747, 4693, 4640, 4587, 4533, 4480,
+  4440, 4400, 4360, 4320, 4280, 4240, 4200, 4160,
+  4133, 4107, 4080, 4053, 4027, 4000, 3973, 3947,
+  3920, 3893, 3867, 3840, 3820, 3800, 3780, 3760,
+  3740, 3720, 3700, 3680, 3664, 3648, 3632, 3616,
+  3600, 3584, 3568, 3552, 3536, 3520, 3507, 3493,
+  3480, 3467, 3453, 3440, 3427, 3413, 3400, 3387,
+  3373, 3360, 3349, 3337, 3326, 3314, 3303, 3291,
+  3280, 3269, 3257, 3246, 3234, 3223, 3211, 3200,
+  3192, 3183, 3175, 3166, 3158, 3149, 3141, 3133,
+  3124, 3116, 3107, 3099, 3091, 3082, 3074, 3065,
+  3057, 3048, 3040, 3033, 3025, 3018, 3011, 3004,
+  2996, 2989, 2982, 2975, 2967, 2960, 2953, 2945,
+  2938, 2931, 2924, 2916, 2909, 2902, 2895, 2887,
+  2880, 2874, 2868, 2862, 2856, 2850, 2844, 2839,
+  2833, 2827, 2821, 2815, 2809, 2803, 2797, 2791,
+  2785, 2779, 2773, 2767, 2761, 2756, 2750, 2744,
+  2738, 2732, 2726, 2720, 2715, 2711, 2706, 2701,
+  2696, 2692, 2687, 2682, 2678, 2673, 2668, 2664,
+  2659, 2654, 2649, 2645, 2640, 2635, 2631, 2626,
+  2621, 2616, 2612, 2607, 2602, 2598, 2593, 2588,
+  2584, 2579, 2574, 2569, 2565, 2560, 2556, 2552,
+  2548, 2544, 2540, 2537, 2533, 2529, 2525, 2521,
+  2517, 2513, 2509, 2505, 2501, 2498, 2494, 2490,
+  2486, 2482, 2478, 2474, 2470, 2466, 2462, 2459,
+  2455, 2451, 2447, 2443, 2439, 2435, 2431, 2427,
+  2423, 2420, 2416, 2412, 2408, 2404, 2400, 2397,
+  2393, 2390, 2387, 2383, 2380, 2377, 2373, 2370,
+  2367, 2363, 2360, 2357, 2353, 2350, 2347, 2343,
+  2340, 2337, 2333, 2330, 2327, 2323, 2320, 2317,
+  2313, 2310, 2307, 2303, 2300, 2297, 2293, 2290,
+  2287, 2283, 2280, 2277, 2273, 2270, 2267, 2263,
+  2260, 2257, 2253, 2250, 2247, 2243, 2240, 2237,
+  2234, 2232, 2229, 2226, 2223, 2221, 2218, 2215,
+  2212, 2210, 2207, 2204, 2201, 2199, 2196, 2193,
+  2190, 2188, 2185, 2182, 2179, 2177, 2174, 2171,
+  2168, 2166, 2163, 2160, 2157, 2154, 2152, 2149,
+  2146, 2143, 2141, 2138, 2135, 2132, 2130, 2127,
+  2124, 2121, 2119, 2116, 2113, 2110, 2108, 2105,
+  2102, 2099, 2097, 2094, 2091, 2088, 2086, 2083,
+  2080, 2078, 2075, 2073, 2070, 2068, 2065, 2063,
+  2061, 2058, 2056, 2053, 2051, 2048, 2046, 2044,
+  2041, 2039, 2036, 2034, 2032, 2029, 2027, 2024,
+  2022, 2019, 2017, 2015, 2012, 2010, 2007, 2005,
+  2002, 2000, 1998, 1995, 1993, 1990, 1988, 1985,
+  1983, 1981, 1978, 1976, 1973, 1971, 1968, 1966,
+  1964, 1961, 1959, 1956, 1954, 1952, 1949, 1947,
+  1944, 1942, 1939, 1937, 1935, 1932, 1930, 1927,
+  1925, 1922, 1920, 1918, 1916, 1914, 1911, 1909,
+  1907, 1905, 1903, 1901, 1898, 1896, 1894, 1892,
+  1890, 1888, 1885, 1883, 1881, 1879, 1877, 1875,
+  1872, 1870, 1868, 1866, 1864, 1862, 1859, 1857,
+  1855, 1853, 1851, 1849, 1846, 1844, 1842, 1840,
+  1838, 1836, 1834, 1831, 1829, 1827, 1825, 1823,
+  1821, 1818, 1816, 1814, 1812, 1810, 1808, 1805,
+  1803, 1801, 1799, 1797, 1795, 1792, 1790, 1788,
+  1786, 1784, 1782, 1779, 1777, 1775, 1773, 1771,
+  1769, 1766, 1764, 1762, 1760, 1758, 1756, 1754,
+  1752, 1750, 1748, 1746, 1744, 1742, 1739, 1737,
+  1735, 1733, 1731, 1729, 1727, 1725, 1723, 1721,
+  1719, 1717, 1715, 1713, 1711, 1709, 1707, 1705,
+  1703, 1701, 1698, 1696, 1694, 1692, 1690, 1688,
+  1686, 1684, 1682, 1680, 1678, 1676, 1674, 1672,
+  1670, 1668, 1666, 1664, 1662, 1659, 1657, 1655,
+  1653, 1651, 1649, 1647, 1645, 1643, 1641, 1639,
+  1637, 1635, 1633, 1631, 1629, 1627, 1625, 1623,
+  1621, 1618, 1616, 1614, 1612, 1610, 1608, 1606,
+  1604, 1602, 1600, 1598, 1596, 1594, 1592, 1590,
+  1588, 1586, 1584, 1582, 1580, 1578, 1576, 1574,
+  1572, 1570, 1568, 1566, 1564, 1562, 1560, 1559,
+  1557, 1555, 1553, 1551, 1549, 1547, 1545, 1543,
+  1541, 1539, 1537, 1535, 1533, 1531, 1529, 1527,
+  1525, 1523, 1521, 1519, 1517, 1515, 1513, 1511,
+  1509, 1507, 1505, 1503, 1501, 1499, 1497, 1495,
+  1493, 1491, 1489, 1487, 1485, 1483, 1481, 1480,
+  1478, 1476, 1474, 1472, 1470, 1468, 1466, 1464,
+  1462, 1460, 1458, 1456, 1454, 1452, 1450, 1448,
+  1446, 1444, 1442, 1440, 1438, 1436, 1434, 1432,
+  1430, 1428, 1426, 1424, 1422, 1419, 1417, 1415,
+  1413, 1411, 1409, 1407, 1405, 1403, 1401, 1399,
+  1397, 1395, 1393, 1391, 1389, 1387, 1385, 1383,
+  1381, 1378, 1376, 1374, 1372, 1370, 1368, 1366,
+  1364, 1362, 1360, 1358, 1356, 1354, 1352, 1350,
+  1348, 1346, 1344, 1342, 1339, 1337, 1335, 1333,
+  1331, 1329, 1327, 1325, 1323, 1321, 1319, 1317,
+  1315, 1313, 1311, 1309, 1307, 1305, 1303, 1301,
+  1298, 1296, 1294, 1292, 1290, 1288, 1286, 1284,
+  1282, 1280, 1278, 1275, 1273, 1271, 1269, 1266,
+  1264, 1262, 1260, 1257, 1255, 1253, 1251, 1248,
+  1246, 1244, 1242, 1239, 1237, 1235, 1233, 1230,
+  1228, 1226, 1224, 1221, 1219, 1217, 1215, 1212,
+  1210, 1208, 1206, 1203, 1201, 1199, 1197, 1194,
+  1192, 1190, 1188, 1185, 1183, 1181, 1179, 1176,
+  1174, 1172, 1170, 1167, 1165, 1163, 1161, 1158,
+  1156, 1154, 1152, 1149, 1147, 1145, 1143, 1140,
+  1138, 1136, 1134, 1131, 1129, 1127, 1125, 1122,
+  1120, 1117, 1115, 1112, 1110, 1107, 1105, 1102,
+  1099, 1097, 1094, 1092, 1089, 1086, 1084, 1081,
+  1079, 1076, 1074, 1071, 1068, 1066, 1063, 1061,
+  1058, 1055, 1053, 1050, 1048, 1045, 1043, 1040,
+  1037, 1035, 1032, 1030, 1027, 1025, 1022, 1019,
+  1017, 1014, 1012, 1009, 1006, 1004, 1001, 999,
+  996, 994, 991, 988, 986, 983, 981, 978,
+  975, 973, 970, 968, 965, 963, 960, 957,
+  954, 951, 947, 944, 941, 938, 935, 932,
+  929, 925, 922, 919, 916, 913, 910, 907,
+  904, 900, 897, 894, 891, 888, 885, 882,
+  878, 875, 872, 869, 866, 863, 860, 856,
+  853, 850, 847, 844, 841, 838, 835, 831,
+  828, 825, 822, 819, 816, 813, 809, 806,
+  803, 800, 796, 792, 788, 784, 780, 776,
+  772, 768, 764, 760, 756, 752, 748, 744,
+  740, 736, 732, 728, 724, 720, 716, 712,
+  708, 704, 700, 696, 692, 688, 684, 680,
+  676, 672, 668, 664, 660, 656, 652, 648,
+  644, 640, 634, 629, 623, 618, 612, 607,
+  601, 596, 590, 585, 579, 574, 568, 563,
+  557, 552, 546, 541, 535, 530, 524, 519,
+  513, 508, 502, 497, 491, 486, 480, 472,
+  464, 456, 448, 440, 432, 424, 416, 408,
+  400, 392, 384, 376, 368, 360, 352, 344,
+  336, 328, 320, 309, 297, 286, 274, 263,
+  251, 240, 229, 217, 206, 194, 183, 171,
+  160, 144, 128, 112, 96, 80, 64, 48,
+  32, 16, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 6) || (THERMISTORHEATER_1 == 6) || (THERMISTORHEATER_2 == 6) || (THERMISTORBED == 6)
+// 1025 entries, at most 4.38 degrees C from temptable_6 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_6_SHIFT 3
+const short temptable_uniform_6[] PROGMEM = {
+  5659, 5600, 5541, 5481, 5422, 5363, 5304, 5244,
+  5185, 5126, 5067, 5007, 4948, 4889, 4830, 4770,
+  4711, 4652, 4593, 4533, 4474, 4415, 4356, 4296,
+  4237, 4178, 4119, 4059, 4000, 3973, 3947, 3920,
+  3900, 3880, 3860, 3840, 3820, 3800, 3780, 3760,
+  3733, 3707, 3680, 3640, 3600, 3584, 3568, 3552,
+  3536, 3520, 3500, 3480, 3460, 3440, 3431, 3422,
+  3413, 3404, 3396, 3387, 3378, 3369, 3360, 3351,
+  3342, 3333, 3324, 3316, 3307, 3298, 3289, 3280,
+  3269, 3257, 3246, 3234, 3223, 3211, 3200, 3190,
+  3180, 3170, 3160, 3150, 3140, 3130, 3120, 3110,
+  3100, 3090, 3080, 3070, 3060, 3050, 3040, 3030,
+  3020, 3010, 3000, 2990, 2980, 2970, 2960, 2943,
+  2926, 2909, 2891, 2874, 2857, 2840, 2823, 2806,
+  2789, 2771, 2754, 2737, 2720, 2714, 2708, 2702,
+  2696, 2690, 2684, 2679, 2673, 2667, 2661, 2655,
+  2649, 2643, 2637, 2631, 2625, 2619, 2613, 2607,
+  2601, 2596, 2590, 2584, 2578, 2572, 2566, 2560,
+  2556, 2552, 2548, 2544, 2540, 2536, 2532, 2528,
+  2524, 2520, 2516, 2512, 2508, 2504, 2500, 2496,
+  2492, 2488, 2484, 2480, 2476, 2472, 2468, 2464,
+  2460, 2456, 2452, 2448, 2444, 2440, 2436, 2432,
+  2428, 2424, 2420, 2416, 2412, 2408, 2404, 2400,
+  2396, 2392, 2388, 2384, 2380, 2376, 2372, 2368,
+  2364, 2360, 2356, 2352, 2348, 2344, 2340, 2336,
+  2332, 2328, 2324, 2320, 2316, 2312, 2308, 2304,
+  2300, 2296, 2292, 2288, 2284, 2280, 2276, 2272,
+  2268, 2264, 2260, 2256, 2252, 2248, 2244, 2240,
+  2237, 2233, 2230, 2226, 2223, 2220, 2216, 2213,
+  2209, 2206, 2203, 2199, 2196, 2192, 2189, 2186,
+  2182, 2179, 2175, 2172, 2169, 2165, 2162, 2158,
+  2155, 2151, 2148, 2145, 2141, 2138, 2134, 2131,
+  2128, 2124, 2121, 2117, 2114, 2111, 2107, 2104,
+  2100, 2097, 2094, 2090, 2087, 2083, 2080, 2077,
+  2073, 2070, 2067, 2063, 2060, 2057, 2053, 2050,
+  2047, 2043, 2040, 2037, 2033, 2030, 2027, 2023,
+  2020, 2017, 2013, 2010, 2007, 2003, 2000, 1997,
+  1993, 1990, 1987, 1983, 1980, 1977, 1973, 1970,
+  1967, 1963, 1960, 1957, 1953, 1950, 1947, 1943,
+  1940, 1937, 1933, 1930, 1927, 1923, 1920, 1918,
+  1915, 1913, 1910, 1908, 1905, 1903, 1900, 1898,
+  1895, 1893, 1890, 1888, 1886, 1883, 1881, 1878,
+  1876, 1873, 1871, 1868, 1866, 1863, 1861, 1858,
+  1856, 1854, 1851, 1849, 1846, 1844, 1841, 1839,
+  1836, 1834, 1831, 1829, 1826, 1824, 1822, 1819,
+  1817, 1814, 1812, 1809, 1807, 1804, 1802, 1799,
+  1797, 1794, 1792, 1790, 1787, 1785, 1782, 1780,
+  1777, 1775, 1772, 1770, 1767, 1765, 1762, 1760,
+  1757, 1755, 1752, 1749, 1747, 1744, 1741, 1739,
+  1736, 1733, 1731, 1728, 1725, 1723, 1720, 1717,
+  1715, 1712, 1709, 1707, 1704, 1701, 1699, 1696,
+  1693, 1691, 1688, 1685, 1683, 1680, 1677, 1674,
+  1671, 1668, 1665, 1662, 1658, 1655, 1652, 1649,
+  1646, 1643, 1640, 1637, 1634, 1631, 1628, 1625,
+  1622, 1618, 1615, 1612, 1609, 1606, 1603, 1600,
+  1598, 1596, 1595, 1593, 1591, 1589, 1588, 1586,
+  1584, 1582, 1580, 1579, 1577, 1575, 1573, 1572,
+  1570, 1568, 1566, 1564, 1563, 1561, 1559, 1557,
+  1556, 1554, 1552, 1550, 1548, 1547, 1545, 1543,
+  1541, 1540, 1538, 1536, 1534, 1532, 1531, 1529,
+  1527, 1525, 1524, 1522, 1520, 1517, 1514, 1512,
+  1509, 1506, 1503, 1501, 1498, 1495, 1492, 1490,
+  1487, 1484, 1481, 1479, 1476, 1473, 1470, 1468,
+  1465, 1462, 1459, 1457, 1454, 1451, 1448, 1446,
+  1443, 1440, 1438, 1437, 1435, 1433, 1431, 1430,
+  1428, 1426, 1425, 1423, 1421, 1420, 1418, 1416,
+  1414, 1413, 1411, 1409, 1408, 1406, 1404, 1403,
+  1401, 1399, 1397, 1396, 1394, 1392, 1391, 1389,
+  1387, 1386, 1384, 1382, 1380, 1379, 1377, 1375,
+  1374, 1372, 1370, 1369, 1367, 1365, 1363, 1362,
+  1360, 1358, 1357, 1355, 1353, 1351, 1350, 1348,
+  1346, 1345, 1343, 1341, 1340, 1338, 1336, 1334,
+  1333, 1331, 1329, 1328, 1326, 1324, 1323, 1321,
+  1319, 1317, 1316, 1314, 1312, 1311, 1309, 1307,
+  1306, 1304, 1302, 1300, 1299, 1297, 1295, 1294,
+  1292, 1290, 1289, 1287, 1285, 1283, 1282, 1280,
+  1277, 1274, 1272, 1269, 1266, 1263, 1260, 1258,
+  1255, 1252, 1249, 1246, 1244, 1241, 1238, 1235,
+  1232, 1229, 1227, 1224, 1221, 1218, 1215, 1213,
+  1210, 1207, 1204, 1201, 1199, 1196, 1193, 1190,
+  1187, 1185, 1182, 1179, 1176, 1173, 1171, 1168,
+  1165, 1162, 1159, 1156, 1154, 1151, 1148, 1145,
+  1142, 1140, 1137, 1134, 1131, 1128, 1126, 1123,
+  1120, 1119, 1117, 1116, 1115, 1113, 1112, 1110,
+  1109, 1108, 1106, 1105, 1104, 1102, 1101, 1099,
+  1098, 1097, 1095, 1094, 1093, 1091, 1090, 1089,
+  1087, 1086, 1084, 1083, 1082, 1080, 1079, 1078,
+  1076, 1075, 1074, 1072, 1071, 1069, 1068, 1067,
+  1065, 1064, 1063, 1061, 1060, 1058, 1057, 1056,
+  1054, 1053, 1052, 1050, 1049, 1048, 1046, 1045,
+  1043, 1042, 1041, 1039, 1038, 1037, 1035, 1034,
+  1032, 1031, 1030, 1028, 1027, 1026, 1024, 1023,
+  1022, 1020, 1019, 1017, 1016, 1015, 1013, 1012,
+  1011, 1009, 1008, 1006, 1005, 1004, 1002, 1001,
+  1000, 998, 997, 996, 994, 993, 991, 990,
+  989, 987, 986, 985, 983, 982, 981, 979,
+  978, 976, 975, 974, 972, 971, 970, 968,
+  967, 965, 964, 963, 961, 960, 957, 954,
+  952, 949, 946, 943, 941, 938, 935, 932,
+  930, 927, 924, 921, 919, 916, 913, 910,
+  908, 905, 902, 899, 897, 894, 891, 888,
+  886, 883, 880, 878, 876, 874, 872, 870,
+  868, 866, 864, 862, 859, 857, 855, 853,
+  851, 849, 847, 845, 843, 841, 839, 837,
+  835, 833, 831, 829, 827, 825, 823, 821,
+  818, 816, 814, 812, 810, 808, 806, 804,
+  802, 800, 799, 798, 796, 795, 794, 793,
+  791, 790, 789, 788, 786, 785, 784, 783,
+  782, 780, 779, 778, 777, 775, 774, 773,
+  772, 770, 769, 768, 767, 766, 764, 763,
+  762, 761, 759, 758, 757, 756, 754, 753,
+  752, 751, 750, 748, 747, 746, 745, 743,
+  742, 741, 740, 738, 737, 736, 735, 734,
+  732, 731, 730, 729, 727, 726, 725, 724,
+  722, 721, 640, 636, 632, 629, 625, 621,
+  617, 613, 610, 606, 602, 598, 594, 590,
+  587, 583, 579, 575, 571, 568, 564, 560,
+  556, 552, 547, 543, 539, 535, 531, 526,
+  522, 518, 514, 509, 505, 501, 497, 493,
+  488, 484, 480, 475, 470, 465, 460, 455,
+  450, 445, 440, 435, 430, 425, 420, 415,
+  410, 405, 400, 394, 388, 382, 376, 370,
+  364, 358, 352, 342, 332, 322, 311, 301,
+  291, 281, 271, 261, 251, 241, 230, 220,
+  210, 200, 190, 180, 170, 159, 149, 139,
+  129, 119, 109, 99, 89, 78, 68, 58,
+  48, 45, 42, 38, 35, 32, 29, 26,
+  22, 19, 16, 13, 10, 6, 3, 0,
+  0
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 7) || (THERMISTORHEATER_1 == 7) || (THERMISTORHEATER_2 == 7) || (THERMISTORBED == 7)
+// 1025 entries, at most 0.06 degrees C from temptable_7 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_7_SHIFT 3
+const short temptable_uniform_7[] PROGMEM = {
+  15571, 15056, 14541, 14027, 13512, 12997, 12483, 11968,
+  11453, 10939, 10424, 9909, 9395, 8880, 8365, 7851,
+  7336, 6821, 6307, 5792, 5736, 5680, 5624, 5568,
+  5512, 5456, 5400, 5344, 5288, 5232, 5176, 5120,
+  5064, 5008, 4952, 4896, 4840, 4784, 4755, 4725,
+  4696, 4667, 4637, 4608, 4579, 4549, 4520, 4491,
+  4461, 4432, 4403, 4373, 4344, 4315, 4285, 4256,
+  4237, 4219, 4200, 4181, 4163, 4144, 4125, 4107,
+  4088, 4069, 4051, 4032, 4013, 3995, 3976, 3957,
+  3939, 3920, 3906, 3892, 3877, 3863, 3849, 3835,
+  3820, 3806, 3792, 3778, 3764, 3749, 3735, 3721,
+  3707, 3692, 3678, 3664, 3652, 3641, 3629, 3618,
+  3606, 3595, 3583, 3572, 3560, 3548, 3537, 3525,
+  3514, 3502, 3491, 3479, 3468, 3456, 3447, 3438,
+  3429, 3420, 3412, 3403, 3394, 3385, 3376, 3367,
+  3358, 3349, 3340, 3332, 3323, 3314, 3305, 3296,
+  3288, 3280, 3272, 3264, 3256, 3248, 3240, 3232,
+  3224, 3216, 3208, 3200, 3192, 3184, 3176, 3168,
+  3160, 3152, 3146, 3140, 3133, 3127, 3121, 3115,
+  3108, 3102, 3096, 3090, 3084, 3077, 3071, 3065,
+  3059, 3052, 3046, 3040, 3034, 3028, 3021, 3015,
+  3009, 3003, 2996, 2990, 2984, 2978, 2972, 2965,
+  2959, 2953, 2947, 2940, 2934, 2928, 2923, 2917,
+  2912, 2907, 2901, 2896, 2891, 2885, 2880, 2875,
+  2869, 2864, 2859, 2853, 2848, 2843, 2837, 2832,
+  2827, 2821, 2816, 2811, 2805, 2800, 2795, 2789,
+  2784, 2779, 2773, 2768, 2763, 2757, 2752, 2747,
+  2741, 2736, 2732, 2727, 2723, 2718, 2714, 2709,
+  2705, 2700, 2696, 2692, 2687, 2683, 2678, 2674,
+  2669, 2665, 2660, 2656, 2652, 2649, 2645, 2642,
+  2638, 2635, 2631, 2628, 2624, 2620, 2617, 2613,
+  2610, 2606, 2603, 2599, 2596, 2592, 2588, 2583,
+  2579, 2574, 2570, 2565, 2561, 2556, 2552, 2548,
+  2543, 2539, 2534, 2530, 2525, 2521, 2516, 2512,
+  2508, 2505, 2501, 2498, 2494, 2491, 2487, 2484,
+  2480, 2476, 2473, 2469, 2466, 2462, 2459, 2455,
+  2452, 2448, 2444, 2441, 2437, 2434, 2430, 2427,
+  2423, 2420, 2416, 2412, 2409, 2405, 2402, 2398,
+  2395, 2391, 2388, 2384, 2381, 2379, 2376, 2373,
+  2371, 2368, 2365, 2363, 2360, 2357, 2355, 2352,
+  2349, 2347, 2344, 2341, 2339, 2336, 2332, 2329,
+  2325, 2322, 2318, 2315, 2311, 2308, 2304, 2300,
+  2297, 2293, 2290, 2286, 2283, 2279, 2276, 2272,
+  2269, 2267, 2264, 2261, 2259, 2256, 2253, 2251,
+  2248, 2245, 2243, 2240, 2237, 2235, 2232, 2229,
+  2227, 2224, 2220, 2217, 2213, 2210, 2206, 2203,
+  2199, 2196, 2192, 2188, 2185, 2181, 2178, 2174,
+  2171, 2167, 2164, 2160, 2157, 2155, 2152, 2149,
+  2147, 2144, 2141, 2139, 2136, 2133, 2131, 2128,
+  2125, 2123, 2120, 2117, 2115, 2112, 2109, 2107,
+  2104, 2101, 2099, 2096, 2093, 2091, 2088, 2085,
+  2083, 2080, 2077, 2075, 2072, 2069, 2067, 2064,
+  2061, 2059, 2056, 2053, 2051, 2048, 2045, 2043,
+  2040, 2037, 2035, 2032, 2029, 2027, 2024, 2021,
+  2019, 2016, 2013, 2011, 2008, 2005, 2003, 2000,
+  1997, 1995, 1992, 1989, 1987, 1984, 1981, 1979,
+  1976, 1973, 1971, 1968, 1966, 1964, 1963, 1961,
+  1959, 1957, 1956, 1954, 1952, 1950, 1948, 1947,
+  1945, 1943, 1941, 1940, 1938, 1936, 1933, 1931,
+  1928, 1925, 1923, 1920, 1917, 1915, 1912, 1909,
+  1907, 1904, 1901, 1899, 1896, 1893, 1891, 1888,
+  1885, 1883, 1880, 1877, 1875, 1872, 1869, 1867,
+  1864, 1861, 1859, 1856, 1853, 1851, 1848, 1845,
+  1843, 1840, 1837, 1835, 1832, 1829, 1827, 1824,
+  1821, 1819, 1816, 1813, 1811, 1808, 1805, 1803,
+  1800, 1797, 1795, 1792, 1790, 1788, 1787, 1785,
+  1783, 1781, 1780, 1778, 1776, 1774, 1772, 1771,
+  1769, 1767, 1765, 1764, 1762, 1760, 1757, 1755,
+  1752, 1749, 1747, 1744, 1741, 1739, 1736, 1733,
+  1731, 1728, 1725, 1723, 1720, 1717, 1715, 1712,
+  1710, 1708, 1707, 1705, 1703, 1701, 1700, 1698,
+  1696, 1694, 1692, 1691, 1689, 1687, 1685, 1684,
+  1682, 1680, 1677, 1675, 1672, 1669, 1667, 1664,
+  1661, 1659, 1656, 1653, 1651, 1648, 1645, 1643,
+  1640, 1637, 1635, 1632, 1629, 1627, 1624, 1621,
+  1619, 1616, 1613, 1611, 1608, 1605, 1603, 1600,
+  1597, 1595, 1592, 1589, 1587, 1584, 1582, 1580,
+  1579, 1577, 1575, 1573, 1572, 1570, 1568, 1566,
+  1564, 1563, 1561, 1559, 1557, 1556, 1554, 1552,
+  1549, 1547, 1544, 1541, 1539, 1536, 1533, 1531,
+  1528, 1525, 1523, 1520, 1517, 1515, 1512, 1509,
+  1507, 1504, 1502, 1500, 1499, 1497, 1495, 1493,
+  1492, 1490, 1488, 1486, 1484, 1483, 1481, 1479,
+  1477, 1476, 1474, 1472, 1469, 1467, 1464, 1461,
+  1459, 1456, 1453, 1451, 1448, 1445, 1443, 1440,
+  1437, 1435, 1432, 1429, 1427, 1424, 1421, 1419,
+  1416, 1413, 1411, 1408, 1405, 1403, 1400, 1397,
+  1395, 1392, 1389, 1387, 1384, 1381, 1379, 1376,
+  1374, 1372, 1371, 1369, 1367, 1365, 1364, 1362,
+  1360, 1358, 1356, 1355, 1353, 1351, 1349, 1348,
+  1346, 1344, 1341, 1339, 1336, 1333, 1331, 1328,
+  1325, 1323, 1320, 1317, 1315, 1312, 1309, 1307,
+  1304, 1301, 1299, 1296, 1293, 1291, 1288, 1285,
+  1283, 1280, 1277, 1275, 1272, 1269, 1267, 1264,
+  1261, 1259, 1256, 1253, 1251, 1248, 1245, 1243,
+  1240, 1237, 1235, 1232, 1229, 1227, 1224, 1221,
+  1219, 1216, 1213, 1211, 1208, 1205, 1203, 1200,
+  1197, 1195, 1192, 1189, 1187, 1184, 1181, 1179,
+  1176, 1173, 1171, 1168, 1165, 1163, 1160, 1157,
+  1155, 1152, 1149, 1147, 1144, 1141, 1139, 1136,
+  1133, 1131, 1128, 1125, 1123, 1120, 1117, 1115,
+  1112, 1109, 1107, 1104, 1101, 1099, 1096, 1093,
+  1091, 1088, 1085, 1083, 1080, 1077, 1075, 1072,
+  1069, 1067, 1064, 1061, 1059, 1056, 1052, 1049,
+  1045, 1042, 1038, 1035, 1031, 1028, 1024, 1020,
+  1017, 1013, 1010, 1006, 1003, 999, 996, 992,
+  989, 987, 984, 981, 979, 976, 973, 971,
+  968, 965, 963, 960, 957, 955, 952, 949,
+  947, 944, 940, 937, 933, 930, 926, 923,
+  919, 916, 912, 908, 905, 901, 898, 894,
+  891, 887, 884, 880, 876, 873, 869, 866,
+  862, 859, 855, 852, 848, 844, 841, 837,
+  834, 830, 827, 823, 820, 816, 812, 807,
+  803, 798, 794, 789, 785, 780, 776, 772,
+  767, 763, 758, 754, 749, 745, 740, 736,
+  732, 727, 723, 718, 714, 709, 705, 700,
+  696, 692, 687, 683, 678, 674, 669, 665,
+  660, 656, 651, 645, 640, 635, 629, 624,
+  619, 613, 608, 603, 597, 592, 587, 581,
+  576, 571, 565, 560, 553, 546, 539, 532,
+  524, 517, 510, 503, 496, 489, 482, 475,
+  468, 460, 453, 446, 439, 432, 423, 414,
+  405, 396, 388, 379, 370, 361, 352, 343,
+  334, 325, 316, 308, 299, 290, 281, 272,
+  258, 244, 229, 215, 201, 187, 172, 158,
+  144, 130, 116, 101, 87, 73, 59, 44,
+  30, 16, 15, 14, 13, 11, 10, 9,
+  8, 7, 6, 5, 3, 2, 1, 0,
+  0
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 8) || (THERMISTORHEATER_1 == 8) || (THERMISTORHEATER_2 == 8) || (THERMISTORBED == 8)
+// 513 entries, at most 0.19 degrees C from temptable_8 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_8_SHIFT 4
+const short temptable_uniform_8[] PROGMEM = {
+  11411, 11117, 10822, 10527, 10233, 9938, 9643, 9349,
+  9054, 8760, 8465, 8170, 7876, 7581, 7286, 6992,
+  6697, 6402, 6108, 5813, 5518, 5224, 4929, 4635,
+  4340, 4045, 3751, 3456, 3431, 3406, 3382, 3357,
+  3332, 3307, 3283, 3258, 3233, 3208, 3184, 3159,
+  3134, 3109, 3085, 3060, 3035, 3010, 2986, 2961,
+  2936, 2911, 2887, 2862, 2837, 2812, 2793, 2779,
+  2765, 2751, 2738, 2724, 2710, 2696, 2682, 2668,
+  2654, 2640, 2626, 2613, 2599, 2585, 2571, 2557,
+  2543, 2529, 2515, 2501, 2488, 2474, 2460, 2446,
+  2432, 2423, 2414, 2405, 2396, 2387, 2378, 2369,
+  2360, 2350, 2341, 2332, 2323, 2314, 2305, 2296,
+  2287, 2278, 2269, 2260, 2251, 2242, 2233, 2224,
+  2215, 2206, 2197, 2188, 2181, 2174, 2167, 2159,
+  2152, 2145, 2138, 2130, 2123, 2116, 2109, 2101,
+  2094, 2087, 2080, 2072, 2065, 2058, 2051, 2043,
+  2036, 2029, 2022, 2014, 2007, 2000, 1994, 1988,
+  1982, 1976, 1970, 1964, 1958, 1952, 1946, 1940,
+  1934, 1928, 1922, 1915, 1909, 1903, 1897, 1891,
+  1885, 1879, 1873, 1867, 1861, 1855, 1849, 1843,
+  1837, 1832, 1826, 1821, 1816, 1810, 1805, 1799,
+  1794, 1788, 1783, 1778, 1772, 1767, 1761, 1756,
+  1750, 1745, 1739, 1734, 1729, 1723, 1718, 1712,
+  1707, 1701, 1696, 1692, 1688, 1683, 1679, 1675,
+  1671, 1666, 1662, 1658, 1654, 1650, 1645, 1641,
+  1637, 1633, 1628, 1624, 1620, 1616, 1611, 1607,
+  1603, 1599, 1595, 1590, 1586, 1582, 1577, 1572,
+  1567, 1562, 1557, 1553, 1548, 1543, 1538, 1533,
+  1528, 1524, 1519, 1514, 1509, 1504, 1499, 1495,
+  1490, 1485, 1480, 1475, 1470, 1466, 1461, 1456,
+  1452, 1449, 1445, 1442, 1438, 1434, 1431, 1427,
+  1423, 1420, 1416, 1413, 1409, 1405, 1402, 1398,
+  1394, 1391, 1387, 1384, 1380, 1376, 1373, 1369,
+  1365, 1362, 1358, 1354, 1349, 1345, 1341, 1337,
+  1333, 1328, 1324, 1320, 1316, 1311, 1307, 1303,
+  1299, 1294, 1290, 1286, 1282, 1278, 1273, 1269,
+  1265, 1261, 1256, 1252, 1248, 1244, 1240, 1235,
+  1231, 1227, 1223, 1218, 1214, 1210, 1206, 1202,
+  1197, 1193, 1189, 1185, 1180, 1176, 1172, 1168,
+  1163, 1159, 1155, 1151, 1147, 1142, 1138, 1134,
+  1131, 1127, 1123, 1120, 1116, 1112, 1109, 1105,
+  1102, 1098, 1094, 1091, 1087, 1083, 1080, 1076,
+  1073, 1069, 1065, 1062, 1058, 1054, 1051, 1047,
+  1044, 1040, 1036, 1032, 1027, 1023, 1019, 1015,
+  1010, 1006, 1002, 998, 994, 989, 985, 981,
+  977, 972, 968, 964, 960, 955, 951, 947,
+  943, 939, 934, 930, 926, 921, 916, 911,
+  906, 901, 897, 892, 887, 882, 877, 872,
+  868, 863, 858, 853, 848, 843, 839, 834,
+  829, 824, 819, 814, 810, 805, 800, 795,
+  790, 786, 781, 776, 771, 766, 761, 757,
+  752, 747, 742, 737, 732, 728, 723, 718,
+  713, 708, 703, 699, 694, 689, 684, 679,
+  674, 669, 662, 655, 649, 642, 635, 629,
+  622, 616, 609, 602, 596, 589, 582, 576,
+  569, 562, 556, 549, 542, 536, 529, 523,
+  516, 509, 503, 496, 488, 479, 471, 462,
+  454, 445, 437, 428, 420, 411, 403, 395,
+  386, 378, 369, 361, 352, 344, 335, 327,
+  318, 310, 302, 293, 285, 276, 267, 257,
+  246, 236, 226, 216, 205, 195, 185, 174,
+  164, 154, 144, 133, 123, 113, 103, 92,
+  82, 72, 62, 51, 41, 31, 21, 10,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 9) || (THERMISTORHEATER_1 == 9) || (THERMISTORHEATER_2 == 9) || (THERMISTORBED == 9)
+// 513 entries, at most 0.38 degrees C from temptable_9 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_9_SHIFT 4
+const short temptable_uniform_9[] PROGMEM = {
+  15267, 14685, 14104, 13522, 12941, 12359, 11778, 11196,
+  10615, 10033, 9452, 8870, 8289, 7707, 7126, 6544,
+  5963, 5381, 4800, 4751, 4701, 4652, 4603, 4553,
+  4504, 4454, 4405, 4356, 4306, 4257, 4208, 4158,
+  4109, 4059, 4010, 3961, 3923, 3898, 3872, 3846,
+  3821, 3795, 3770, 3744, 3718, 3693, 3667, 3642,
+  3616, 3590, 3565, 3539, 3514, 3488, 3471, 3453,
+  3436, 3419, 3401, 3384, 3366, 3349, 3332, 3314,
+  3297, 3280, 3262, 3245, 3227, 3210, 3193, 3178,
+  3165, 3152, 3139, 3126, 3114, 3101, 3088, 3075,
+  3062, 3050, 3037, 3024, 3011, 2998, 2986, 2973,
+  2960, 2949, 2938, 2927, 2916, 2905, 2894, 2883,
+  2872, 2861, 2850, 2839, 2828, 2817, 2806, 2795,
+  2784, 2773, 2763, 2754, 2745, 2736, 2727, 2718,
+  2709, 2699, 2690, 2681, 2672, 2663, 2654, 2645,
+  2635, 2626, 2617, 2608, 2601, 2593, 2586, 2579,
+  2571, 2564, 2557, 2549, 2542, 2535, 2528, 2520,
+  2513, 2506, 2498, 2491, 2484, 2476, 2469, 2462,
+  2454, 2447, 2440, 2432, 2425, 2418, 2411, 2403,
+  2396, 2389, 2381, 2374, 2367, 2359, 2352, 2346,
+  2339, 2333, 2326, 2320, 2314, 2307, 2301, 2294,
+  2288, 2282, 2275, 2269, 2262, 2256, 2250, 2243,
+  2237, 2232, 2226, 2221, 2215, 2210, 2204, 2199,
+  2193, 2188, 2182, 2177, 2171, 2166, 2160, 2155,
+  2149, 2144, 2139, 2133, 2128, 2122, 2117, 2111,
+  2106, 2100, 2095, 2089, 2084, 2078, 2073, 2067,
+  2062, 2056, 2051, 2045, 2040, 2034, 2029, 2023,
+  2018, 2012, 2007, 2001, 1996, 1990, 1985, 1979,
+  1974, 1968, 1963, 1957, 1952, 1947, 1943, 1938,
+  1934, 1929, 1925, 1920, 1915, 1911, 1906, 1902,
+  1897, 1893, 1888, 1883, 1879, 1874, 1870, 1865,
+  1861, 1856, 1851, 1847, 1842, 1838, 1833, 1829,
+  1824, 1819, 1815, 1810, 1806, 1801, 1797, 1792,
+  1787, 1783, 1778, 1774, 1769, 1765, 1760, 1755,
+  1751, 1746, 1742, 1737, 1733, 1728, 1723, 1719,
+  1714, 1710, 1705, 1701, 1696, 1691, 1687, 1682,
+  1678, 1673, 1669, 1664, 1659, 1655, 1650, 1646,
+  1641, 1637, 1632, 1627, 1623, 1618, 1614, 1609,
+  1605, 1600, 1595, 1591, 1586, 1582, 1577, 1573,
+  1568, 1563, 1559, 1554, 1550, 1545, 1541, 1536,
+  1531, 1527, 1522, 1518, 1513, 1509, 1504, 1499,
+  1495, 1490, 1486, 1481, 1477, 1472, 1467, 1463,
+  1458, 1454, 1449, 1445, 1440, 1435, 1431, 1426,
+  1422, 1417, 1413, 1408, 1403, 1399, 1394, 1389,
+  1384, 1378, 1373, 1367, 1362, 1356, 1351, 1345,
+  1340, 1334, 1329, 1323, 1318, 1312, 1307, 1301,
+  1296, 1291, 1287, 1282, 1278, 1273, 1269, 1264,
+  1259, 1255, 1250, 1246, 1241, 1237, 1232, 1227,
+  1223, 1218, 1213, 1208, 1202, 1197, 1191, 1186,
+  1180, 1175, 1169, 1164, 1158, 1153, 1147, 1142,
+  1136, 1131, 1125, 1120, 1114, 1107, 1101, 1094,
+  1088, 1082, 1075, 1069, 1062, 1056, 1050, 1043,
+  1037, 1030, 1024, 1018, 1011, 1005, 998, 992,
+  986, 979, 973, 966, 960, 954, 947, 941,
+  934, 928, 922, 915, 909, 902, 896, 889,
+  881, 874, 867, 859, 852, 845, 837, 830,
+  823, 816, 808, 801, 794, 786, 779, 772,
+  763, 754, 745, 736, 727, 718, 709, 699,
+  690, 681, 672, 663, 654, 645, 635, 626,
+  617, 608, 594, 581, 567, 553, 539, 526,
+  512, 498, 485, 471, 457, 443, 430, 416,
+  402, 389, 375, 356, 332, 308, 284, 260,
+  236, 212, 188, 164, 140, 116, 92, 73,
+  58, 44, 29, 15, 0, 0, 0, 0,
+  0
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 10) || (THERMISTORHEATER_1 == 10) || (THERMISTORHEATER_2 == 10) || (THERMISTORBED == 10)
+// 513 entries, at most 0.38 degrees C from temptable_10 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_10_SHIFT 4
+const short temptable_uniform_10[] PROGMEM = {
+  15152, 14576, 14000, 13424, 12848, 12272, 11696, 11120,
+  10544, 9968, 9392, 8816, 8240, 7664, 7088, 6512,
+  5936, 5360, 4784, 4736, 4687, 4639, 4590, 4542,
+  4493, 4445, 4396, 4348, 4299, 4251, 4203, 4154,
+  4106, 4057, 4009, 3960, 3923, 3896, 3870, 3843,
+  3817, 3790, 3764, 3737, 3711, 3684, 3658, 3631,
+  3605, 3578, 3552, 3525, 3499, 3472, 3455, 3437,
+  3420, 3403, 3385, 3368, 3350, 3333, 3316, 3298,
+  3281, 3264, 3246, 3229, 3211, 3194, 3177, 3162,
+  3149, 3136, 3123, 3110, 3098, 3085, 3072, 3059,
+  3046, 3034, 3021, 3008, 2995, 2982, 2970, 2957,
+  2944, 2934, 2924, 2914, 2904, 2894, 2884, 2874,
+  2864, 2853, 2843, 2833, 2823, 2813, 2803, 2793,
+  2783, 2773, 2763, 2754, 2745, 2736, 2727, 2718,
+  2709, 2699, 2690, 2681, 2672, 2663, 2654, 2645,
+  2635, 2626, 2617, 2608, 2600, 2592, 2583, 2575,
+  2567, 2559, 2550, 2542, 2534, 2526, 2517, 2509,
+  2501, 2493, 2485, 2476, 2468, 2461, 2454, 2448,
+  2442, 2435, 2429, 2422, 2416, 2410, 2403, 2397,
+  2390, 2384, 2378, 2371, 2365, 2358, 2352, 2346,
+  2339, 2333, 2326, 2320, 2314, 2307, 2301, 2294,
+  2288, 2282, 2275, 2269, 2262, 2256, 2250, 2243,
+  2237, 2232, 2226, 2221, 2215, 2210, 2204, 2199,
+  2193, 2188, 2182, 2177, 2171, 2166, 2160, 2155,
+  2149, 2144, 2139, 2133, 2128, 2122, 2117, 2111,
+  2106, 2100, 2095, 2089, 2084, 2078, 2073, 2067,
+  2062, 2056, 2051, 2045, 2040, 2034, 2029, 2023,
+  2018, 2012, 2007, 2001, 1996, 1990, 1985, 1979,
+  1974, 1968, 1963, 1957, 1952, 1947, 1943, 1938,
+  1934, 1929, 1925, 1920, 1915, 1911, 1906, 1902,
+  1897, 1893, 1888, 1883, 1879, 1874, 1870, 1865,
+  1861, 1856, 1851, 1847, 1842, 1838, 1833, 1829,
+  1824, 1819, 1815, 1810, 1806, 1801, 1797, 1792,
+  1787, 1783, 1778, 1774, 1769, 1765, 1760, 1755,
+  1751, 1746, 1742, 1737, 1733, 1728, 1723, 1719,
+  1714, 1710, 1705, 1701, 1696, 1691, 1687, 1682,
+  1678, 1673, 1669, 1664, 1659, 1655, 1650, 1646,
+  1641, 1637, 1632, 1627, 1623, 1618, 1614, 1609,
+  1605, 1600, 1595, 1591, 1586, 1582, 1577, 1573,
+  1568, 1563, 1559, 1554, 1549, 1544, 1538, 1533,
+  1527, 1522, 1516, 1511, 1505, 1500, 1494, 1489,
+  1483, 1478, 1472, 1467, 1461, 1456, 1451, 1447,
+  1442, 1438, 1433, 1429, 1424, 1419, 1415, 1410,
+  1406, 1401, 1397, 1392, 1387, 1383, 1378, 1374,
+  1369, 1365, 1360, 1355, 1351, 1346, 1342, 1337,
+  1333, 1328, 1323, 1319, 1314, 1310, 1305, 1301,
+  1296, 1291, 1287, 1282, 1278, 1273, 1269, 1264,
+  1259, 1255, 1250, 1246, 1241, 1237, 1232, 1227,
+  1223, 1218, 1213, 1208, 1202, 1197, 1191, 1186,
+  1180, 1175, 1169, 1164, 1158, 1153, 1147, 1142,
+  1136, 1131, 1125, 1120, 1114, 1107, 1101, 1094,
+  1088, 1082, 1075, 1069, 1062, 1056, 1050, 1043,
+  1037, 1030, 1024, 1018, 1011, 1005, 998, 992,
+  986, 979, 973, 966, 960, 954, 947, 941,
+  934, 928, 922, 915, 909, 902, 896, 889,
+  881, 874, 867, 859, 852, 845, 837, 830,
+  823, 816, 808, 801, 794, 786, 779, 772,
+  763, 754, 745, 736, 727, 718, 709, 699,
+  690, 681, 672, 663, 654, 645, 635, 626,
+  617, 608, 594, 581, 567, 553, 539, 526,
+  512, 498, 485, 471, 457, 443, 430, 416,
+  402, 389, 375, 356, 332, 308, 284, 260,
+  236, 212, 188, 164, 140, 116, 92, 73,
+  58, 44, 29, 15, 0, 0, 0, 0,
+  0
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 20) || (THERMISTORHEATER_1 == 20) || (THERMISTORHEATER_2 == 20) || (THERMISTORBED == 20)
+// 65 entries, at most 0.44 degrees C from temptable_20 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_20_SHIFT 7
+const short temptable_uniform_20[] PROGMEM = {
+  0, 1, 2, 3, 5, 6, 7, 8,
+  9, 10, 11, 12, 14, 15, 16, 236,
+  527, 828, 1140, 1449, 1751, 2060, 2380, 2700,
+  3020, 3340, 3669, 4000, 4331, 4672, 5013, 5355,
+  5696, 6057, 6400, 6766, 7131, 7497, 7863, 8239,
+  8621, 9003, 9385, 9778, 10184, 10590, 10997, 11410,
+  11830, 12249, 12669, 13109, 13558, 14007, 14458, 14924,
+  15389, 15855, 16345, 16847, 17349, 17600, 17600, 17600,
+  17600
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 51) || (THERMISTORHEATER_1 == 51) || (THERMISTORHEATER_2 == 51) || (THERMISTORBED == 51)
+// 513 entries, at most 0.38 degrees C from temptable_51 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_51_SHIFT 4
+const short temptable_uniform_51[] PROGMEM = {
+  5608, 5592, 5575, 5558, 5541, 5524, 5507, 5490,
+  5473, 5456, 5439, 5422, 5405, 5388, 5371, 5354,
+  5338, 5321, 5304, 5287, 5270, 5253, 5236, 5219,
+  5202, 5185, 5168, 5151, 5134, 5117, 5101, 5084,
+  5067, 5050, 5033, 5016, 4999, 4982, 4965, 4948,
+  4931, 4914, 4897, 4880, 4863, 4847, 4830, 4813,
+  4796, 4779, 4762, 4745, 4728, 4711, 4694, 4677,
+  4660, 4643, 4626, 4610, 4593, 4576, 4559, 4542,
+  4525, 4508, 4491, 4474, 4457, 4440, 4423, 4406,
+  4389, 4372, 4356, 4339, 4322, 4305, 4288, 4271,
+  4254, 4237, 4220, 4203, 4186, 4169, 4152, 4135,
+  4119, 4102, 4085, 4068, 4051, 4034, 4017, 4000,
+  3988, 3975, 3963, 3951, 3938, 3926, 3914, 3903,
+  3891, 3880, 3869, 3857, 3846, 3835, 3824, 3813,
+  3803, 3792, 3781, 3771, 3760, 3750, 3740, 3730,
+  3720, 3710, 3700, 3690, 3680, 3671, 3661, 3652,
+  3642, 3633, 3624, 3614, 3605, 3596, 3587, 3578,
+  3569, 3560, 3551, 3542, 3533, 3524, 3516, 3507,
+  3499, 3491, 3482, 3474, 3465, 3457, 3448, 3440,
+  3432, 3424, 3416, 3408, 3400, 3392, 3384, 3376,
+  3368, 3360, 3353, 3345, 3338, 3331, 3324, 3316,
+  3309, 3302, 3295, 3287, 3280, 3273, 3265, 3258,
+  3251, 3244, 3236, 3229, 3222, 3215, 3207, 3200,
+  3193, 3187, 3180, 3173, 3167, 3160, 3153, 3147,
+  3140, 3133, 3127, 3120, 3114, 3107, 3101, 3094,
+  3088, 3082, 3075, 3069, 3062, 3056, 3050, 3043,
+  3037, 3030, 3024, 3018, 3011, 3005, 2998, 2992,
+  2986, 2979, 2973, 2966, 2960, 2954, 2948, 2942,
+  2936, 2930, 2924, 2919, 2913, 2907, 2901, 2895,
+  2889, 2883, 2877, 2871, 2865, 2859, 2853, 2847,
+  2841, 2836, 2830, 2824, 2818, 2812, 2806, 2800,
+  2794, 2789, 2783, 2777, 2771, 2766, 2760, 2754,
+  2749, 2743, 2737, 2731, 2726, 2720, 2714, 2709,
+  2703, 2698, 2692, 2687, 2681, 2676, 2670, 2665,
+  2659, 2654, 2648, 2643, 2637, 2632, 2626, 2621,
+  2615, 2610, 2604, 2599, 2593, 2588, 2582, 2577,
+  2571, 2566, 2560, 2554, 2549, 2543, 2538, 2532,
+  2527, 2521, 2516, 2510, 2505, 2499, 2494, 2488,
+  2483, 2477, 2472, 2466, 2461, 2455, 2450, 2444,
+  2439, 2433, 2428, 2422, 2417, 2411, 2406, 2400,
+  2394, 2389, 2383, 2377, 2371, 2366, 2360, 2354,
+  2349, 2343, 2337, 2331, 2326, 2320, 2314, 2309,
+  2303, 2298, 2292, 2287, 2281, 2276, 2270, 2265,
+  2259, 2254, 2248, 2243, 2237, 2231, 2225, 2219,
+  2213, 2207, 2201, 2196, 2190, 2184, 2178, 2172,
+  2166, 2160, 2154, 2148, 2142, 2136, 2130, 2124,
+  2119, 2113, 2107, 2101, 2095, 2089, 2083, 2077,
+  2071, 2065, 2058, 2052, 2046, 2040, 2034, 2028,
+  2022, 2015, 2009, 2003, 1997, 1990, 1984, 1978,
+  1971, 1965, 1958, 1952, 1946, 1939, 1933, 1926,
+  1920, 1913, 1906, 1899, 1892, 1885, 1878, 1871,
+  1864, 1857, 1850, 1843, 1836, 1829, 1822, 1815,
+  1807, 1800, 1793, 1785, 1778, 1771, 1764, 1756,
+  1748, 1740, 1732, 1724, 1716, 1708, 1700, 1692,
+  1684, 1676, 1667, 1659, 1651, 1642, 1634, 1625,
+  1617, 1608, 1600, 1591, 1581, 1572, 1562, 1553,
+  1544, 1534, 1525, 1515, 1505, 1495, 1485, 1475,
+  1465, 1455, 1445, 1435, 1424, 1413, 1403, 1392,
+  1381, 1371, 1360, 1347, 1333, 1320, 1307, 1293,
+  1280, 1267, 1253, 1240, 1227, 1213, 1200, 1184,
+  1168, 1152, 1136, 1120, 1102, 1084, 1067, 1049,
+  1029, 1006, 983, 960, 937, 914, 891, 867,
+  840, 813, 784, 752, 720, 680, 640, 587,
+  533, 480, 427, 360, 280, 160, 0, -80,
+  -80
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 52) || (THERMISTORHEATER_1 == 52) || (THERMISTORHEATER_2 == 52) || (THERMISTORBED == 52)
+// 1025 entries, at most 0.06 degrees C from temptable_52 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_52_SHIFT 3
+const short temptable_uniform_52[] PROGMEM = {
+  8026, 8000, 7974, 7948, 7923, 7897, 7871, 7845,
+  7819, 7794, 7768, 7742, 7716, 7690, 7665, 7639,
+  7613, 7587, 7561, 7535, 7510, 7484, 7458, 7432,
+  7406, 7381, 7355, 7329, 7303, 7277, 7252, 7226,
+  7200, 7174, 7148, 7123, 7097, 7071, 7045, 7019,
+  6994, 6968, 6942, 6916, 6890, 6865, 6839, 6813,
+  6787, 6761, 6735, 6710, 6684, 6658, 6632, 6606,
+  6581, 6555, 6529, 6503, 6477, 6452, 6426, 6400,
+  6374, 6348, 6323, 6297, 6271, 6245, 6219, 6194,
+  6168, 6142, 6116, 6090, 6065, 6039, 6013, 5987,
+  5961, 5935, 5910, 5884, 5858, 5832, 5806, 5781,
+  5755, 5729, 5703, 5677, 5652, 5626, 5600, 5574,
+  5548, 5523, 5497, 5471, 5445, 5419, 5394, 5368,
+  5342, 5316, 5290, 5265, 5239, 5213, 5187, 5161,
+  5135, 5110, 5084, 5058, 5032, 5006, 4981, 4955,
+  4929, 4903, 4877, 4852, 4826, 4800, 4791, 4781,
+  4772, 4762, 4753, 4744, 4734, 4725, 4715, 4706,
+  4696, 4687, 4678, 4668, 4659, 4649, 4640, 4632,
+  4624, 4616, 4608, 4600, 4592, 4584, 4576, 4568,
+  4560, 4552, 4544, 4536, 4528, 4520, 4512, 4504,
+  4496, 4488, 4480, 4473, 4466, 4459, 4452, 4445,
+  4438, 4431, 4424, 4417, 4410, 4403, 4397, 4390,
+  4383, 4376, 4369, 4362, 4355, 4348, 4341, 4334,
+  4327, 4320, 4314, 4308, 4302, 4295, 4289, 4283,
+  4277, 4271, 4265, 4258, 4252, 4246, 4240, 4234,
+  4228, 4222, 4215, 4209, 4203, 4197, 4191, 4185,
+  4178, 4172, 4166, 4160, 4154, 4149, 4143, 4138,
+  4132, 4127, 4121, 4116, 4110, 4105, 4099, 4094,
+  4088, 4083, 4077, 4072, 4066, 4061, 4055, 4050,
+  4044, 4039, 4033, 4028, 4022, 4017, 4011, 4006,
+  4000, 3995, 3991, 3986, 3981, 3976, 3972, 3967,
+  3962, 3958, 3953, 3948, 3944, 3939, 3934, 3929,
+  3925, 3920, 3915, 3911, 3906, 3901, 3896, 3892,
+  3887, 3882, 3878, 3873, 3868, 3864, 3859, 3854,
+  3849, 3845, 3840, 3836, 3832, 3827, 3823, 3819,
+  3815, 3811, 3806, 3802, 3798, 3794, 3789, 3785,
+  3781, 3777, 3773, 3768, 3764, 3760, 3756, 3752,
+  3747, 3743, 3739, 3735, 3731, 3726, 3722, 3718,
+  3714, 3709, 3705, 3701, 3697, 3693, 3688, 3684,
+  3680, 3676, 3673, 3669, 3665, 3661, 3658, 3654,
+  3650, 3647, 3643, 3639, 3635, 3632, 3628, 3624,
+  3620, 3617, 3613, 3609, 3606, 3602, 3598, 3594,
+  3591, 3587, 3583, 3580, 3576, 3572, 3568, 3565,
+  3561, 3557, 3553, 3550, 3546, 3542, 3539, 3535,
+  3531, 3527, 3524, 3520, 3517, 3513, 3510, 3506,
+  3503, 3499, 3496, 3492, 3489, 3485, 3482, 3478,
+  3475, 3471, 3468, 3464, 3461, 3457, 3454, 3450,
+  3447, 3443, 3440, 3437, 3433, 3430, 3426, 3423,
+  3419, 3416, 3412, 3409, 3405, 3402, 3398, 3395,
+  3391, 3388, 3384, 3381, 3377, 3374, 3370, 3367,
+  3363, 3360, 3357, 3354, 3351, 3347, 3344, 3341,
+  3338, 3335, 3332, 3329, 3325, 3322, 3319, 3316,
+  3313, 3310, 3307, 3304, 3300, 3297, 3294, 3291,
+  3288, 3285, 3282, 3278, 3275, 3272, 3269, 3266,
+  3263, 3260, 3256, 3253, 3250, 3247, 3244, 3241,
+  3238, 3235, 3231, 3228, 3225, 3222, 3219, 3216,
+  3213, 3209, 3206, 3203, 3200, 3197, 3194, 3191,
+  3188, 3185, 3182, 3179, 3176, 3173, 3170, 3167,
+  3164, 3161, 3159, 3156, 3153, 3150, 3147, 3144,
+  3141, 3138, 3135, 3132, 3129, 3126, 3123, 3120,
+  3117, 3114, 3111, 3108, 3105, 3102, 3099, 3096,
+  3093, 3090, 3087, 3084, 3081, 3079, 3076, 3073,
+  3070, 3067, 3064, 3061, 3058, 3055, 3052, 3049,
+  3046, 3043, 3040, 3037, 3034, 3032, 3029, 3026,
+  3023, 3020, 3018, 3015, 3012, 3009, 3006, 3004,
+  3001, 2998, 2995, 2992, 2989, 2987, 2984, 2981,
+  2978, 2975, 2973, 2970, 2967, 2964, 2961, 2959,
+  2956, 2953, 2950, 2947, 2945, 2942, 2939, 2936,
+  2933, 2931, 2928, 2925, 2922, 2919, 2916, 2914,
+  2911, 2908, 2905, 2902, 2900, 2897, 2894, 2891,
+  2888, 2886, 2883, 2880, 2877, 2874, 2872, 2869,
+  2866, 2863, 2860, 2858, 2855, 2852, 2849, 2846,
+  2844, 2841, 2838, 2835, 2832, 2829, 2827, 2824,
+  2821, 2818, 2815, 2813, 2810, 2807, 2804, 2801,
+  2799, 2796, 2793, 2790, 2787, 2785, 2782, 2779,
+  2776, 2773, 2771, 2768, 2765, 2762, 2759, 2756,
+  2754, 2751, 2748, 2745, 2742, 2740, 2737, 2734,
+  2731, 2728, 2726, 2723, 2720, 2717, 2714, 2712,
+  2709, 2706, 2703, 2700, 2698, 2695, 2692, 2689,
+  2686, 2684, 2681, 2678, 2675, 2672, 2669, 2667,
+  2664, 2661, 2658, 2655, 2653, 2650, 2647, 2644,
+  2641, 2639, 2636, 2633, 2630, 2627, 2625, 2622,
+  2619, 2616, 2613, 2611, 2608, 2605, 2602, 2599,
+  2596, 2594, 2591, 2588, 2585, 2582, 2580, 2577,
+  2574, 2571, 2568, 2566, 2563, 2560, 2557, 2554,
+  2551, 2548, 2545, 2543, 2540, 2537, 2534, 2531,
+  2528, 2525, 2522, 2519, 2516, 2513, 2511, 2508,
+  2505, 2502, 2499, 2496, 2493, 2490, 2487, 2484,
+  2481, 2479, 2476, 2473, 2470, 2467, 2464, 2461,
+  2458, 2455, 2452, 2449, 2447, 2444, 2441, 2438,
+  2435, 2432, 2429, 2426, 2423, 2420, 2417, 2415,
+  2412, 2409, 2406, 2403, 2400, 2397, 2394, 2391,
+  2387, 2384, 2381, 2378, 2375, 2372, 2369, 2365,
+  2362, 2359, 2356, 2353, 2350, 2347, 2344, 2340,
+  2337, 2334, 2331, 2328, 2325, 2322, 2318, 2315,
+  2312, 2309, 2306, 2303, 2300, 2296, 2293, 2290,
+  2287, 2284, 2281, 2278, 2275, 2271, 2268, 2265,
+  2262, 2259, 2256, 2253, 2249, 2246, 2243, 2240,
+  2237, 2233, 2230, 2226, 2223, 2220, 2216, 2213,
+  2209, 2206, 2203, 2199, 2196, 2192, 2189, 2186,
+  2182, 2179, 2175, 2172, 2169, 2165, 2162, 2158,
+  2155, 2151, 2148, 2145, 2141, 2138, 2134, 2131,
+  2128, 2124, 2121, 2117, 2114, 2111, 2107, 2104,
+  2100, 2097, 2094, 2090, 2087, 2083, 2080, 2076,
+  2072, 2068, 2064, 2060, 2057, 2053, 2049, 2045,
+  2041, 2037, 2033, 2029, 2025, 2021, 2018, 2014,
+  2010, 2006, 2002, 1998, 1994, 1990, 1986, 1982,
+  1979, 1975, 1971, 1967, 1963, 1959, 1955, 1951,
+  1947, 1943, 1940, 1936, 1932, 1928, 1924, 1920,
+  1915, 1911, 1906, 1902, 1897, 1893, 1888, 1883,
+  1879, 1874, 1870, 1865, 1861, 1856, 1851, 1847,
+  1842, 1838, 1833, 1829, 1824, 1819, 1815, 1810,
+  1806, 1801, 1797, 1792, 1787, 1783, 1778, 1774,
+  1769, 1765, 1760, 1754, 1749, 1743, 1738, 1732,
+  1727, 1721, 1716, 1710, 1705, 1699, 1694, 1688,
+  1683, 1677, 1672, 1666, 1661, 1655, 1650, 1644,
+  1639, 1633, 1628, 1622, 1617, 1611, 1606, 1600,
+  1593, 1586, 1579, 1572, 1565, 1558, 1551, 1544,
+  1537, 1530, 1523, 1517, 1510, 1503, 1496, 1489,
+  1482, 1475, 1468, 1461, 1454, 1447, 1440, 1431,
+  1422, 1413, 1404, 1396, 1387, 1378, 1369, 1360,
+  1351, 1342, 1333, 1324, 1316, 1307, 1298, 1289,
+  1280, 1269, 1257, 1246, 1234, 1223, 1211, 1200,
+  1189, 1177, 1166, 1154, 1143, 1131, 1120, 1104,
+  1088, 1072, 1056, 1040, 1024, 1008, 992, 976,
+  960, 940, 920, 900, 880, 860, 840, 820,
+  800, 768, 736, 704, 672, 640, 600, 560,
+  520, 480, 400, 320, 240, 160, 0, 0,
+  0
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 55) || (THERMISTORHEATER_1 == 55) || (THERMISTORHEATER_2 == 55) || (THERMISTORBED == 55)
+// 1025 entries, at most 0.06 degrees C from temptable_55 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_55_SHIFT 3
+const short temptable_uniform_55[] PROGMEM = {
+  8043, 8000, 7957, 7915, 7872, 7829, 7787, 7744,
+  7701, 7659, 7616, 7573, 7531, 7488, 7445, 7403,
+  7360, 7317, 7275, 7232, 7189, 7147, 7104, 7061,
+  7019, 6976, 6933, 6891, 6848, 6805, 6763, 6720,
+  6677, 6635, 6592, 6549, 6507, 6464, 6421, 6379,
+  6336, 6293, 6251, 6208, 6165, 6123, 6080, 6037,
+  5995, 5952, 5909, 5867, 5824, 5781, 5739, 5696,
+  5653, 5611, 5568, 5525, 5483, 5440, 5397, 5355,
+  5312, 5269, 5227, 5184, 5141, 5099, 5056, 5013,
+  4971, 4928, 4885, 4843, 4800, 4785, 4771, 4756,
+  4742, 4727, 4713, 4698, 4684, 4669, 4655, 4640,
+  4628, 4615, 4603, 4591, 4578, 4566, 4554, 4542,
+  4529, 4517, 4505, 4492, 4480, 4469, 4457, 4446,
+  4434, 4423, 4411, 4400, 4389, 4377, 4366, 4354,
+  4343, 4331, 4320, 4311, 4301, 4292, 4282, 4273,
+  4264, 4254, 4245, 4235, 4226, 4216, 4207, 4198,
+  4188, 4179, 4169, 4160, 4152, 4145, 4137, 4130,
+  4122, 4114, 4107, 4099, 4091, 4084, 4076, 4069,
+  4061, 4053, 4046, 4038, 4030, 4023, 4015, 4008,
+  4000, 3993, 3986, 3979, 3972, 3965, 3958, 3951,
+  3944, 3937, 3930, 3923, 3917, 3910, 3903, 3896,
+  3889, 3882, 3875, 3868, 3861, 3854, 3847, 3840,
+  3834, 3828, 3822, 3816, 3810, 3804, 3799, 3793,
+  3787, 3781, 3775, 3769, 3763, 3757, 3751, 3745,
+  3739, 3733, 3727, 3721, 3716, 3710, 3704, 3698,
+  3692, 3686, 3680, 3675, 3670, 3665, 3660, 3655,
+  3650, 3645, 3640, 3635, 3630, 3625, 3620, 3615,
+  3610, 3605, 3600, 3595, 3590, 3585, 3580, 3575,
+  3570, 3565, 3560, 3555, 3550, 3545, 3540, 3535,
+  3530, 3525, 3520, 3516, 3511, 3507, 3503, 3498,
+  3494, 3490, 3485, 3481, 3477, 3472, 3468, 3464,
+  3459, 3455, 3451, 3446, 3442, 3438, 3434, 3429,
+  3425, 3421, 3416, 3412, 3408, 3403, 3399, 3395,
+  3390, 3386, 3382, 3377, 3373, 3369, 3364, 3360,
+  3356, 3352, 3348, 3344, 3340, 3337, 3333, 3329,
+  3325, 3321, 3317, 3313, 3309, 3305, 3301, 3298,
+  3294, 3290, 3286, 3282, 3278, 3274, 3270, 3266,
+  3262, 3259, 3255, 3251, 3247, 3243, 3239, 3235,
+  3231, 3227, 3223, 3220, 3216, 3212, 3208, 3204,
+  3200, 3197, 3193, 3190, 3186, 3183, 3180, 3176,
+  3173, 3169, 3166, 3163, 3159, 3156, 3152, 3149,
+  3146, 3142, 3139, 3135, 3132, 3129, 3125, 3122,
+  3118, 3115, 3111, 3108, 3105, 3101, 3098, 3094,
+  3091, 3088, 3084, 3081, 3077, 3074, 3071, 3067,
+  3064, 3060, 3057, 3054, 3050, 3047, 3043, 3040,
+  3037, 3034, 3031, 3028, 3025, 3022, 3018, 3015,
+  3012, 3009, 3006, 3003, 3000, 2997, 2994, 2991,
+  2988, 2985, 2982, 2978, 2975, 2972, 2969, 2966,
+  2963, 2960, 2957, 2954, 2951, 2948, 2945, 2942,
+  2938, 2935, 2932, 2929, 2926, 2923, 2920, 2917,
+  2914, 2911, 2908, 2905, 2902, 2898, 2895, 2892,
+  2889, 2886, 2883, 2880, 2877, 2874, 2871, 2869,
+  2866, 2863, 2860, 2857, 2854, 2851, 2849, 2846,
+  2843, 2840, 2837, 2834, 2831, 2829, 2826, 2823,
+  2820, 2817, 2814, 2811, 2809, 2806, 2803, 2800,
+  2797, 2794, 2791, 2789, 2786, 2783, 2780, 2777,
+  2774, 2771, 2769, 2766, 2763, 2760, 2757, 2754,
+  2751, 2749, 2746, 2743, 2740, 2737, 2734, 2731,
+  2729, 2726, 2723, 2720, 2717, 2715, 2712, 2709,
+  2707, 2704, 2701, 2699, 2696, 2693, 2691, 2688,
+  2685, 2683, 2680, 2677, 2675, 2672, 2669, 2667,
+  2664, 2661, 2659, 2656, 2653, 2651, 2648, 2645,
+  2643, 2640, 2637, 2635, 2632, 2629, 2627, 2624,
+  2621, 2619, 2616, 2613, 2611, 2608, 2605, 2603,
+  2600, 2597, 2595, 2592, 2589, 2587, 2584, 2581,
+  2579, 2576, 2573, 2571, 2568, 2565, 2563, 2560,
+  2557, 2555, 2552, 2550, 2547, 2545, 2542, 2540,
+  2537, 2535, 2532, 2530, 2527, 2524, 2522, 2519,
+  2517, 2514, 2512, 2509, 2507, 2504, 2502, 2499,
+  2497, 2494, 2491, 2489, 2486, 2484, 2481, 2479,
+  2476, 2474, 2471, 2469, 2466, 2463, 2461, 2458,
+  2456, 2453, 2451, 2448, 2446, 2443, 2441, 2438,
+  2436, 2433, 2430, 2428, 2425, 2423, 2420, 2418,
+  2415, 2413, 2410, 2408, 2405, 2403, 2400, 2397,
+  2395, 2392, 2390, 2387, 2385, 2382, 2379, 2377,
+  2374, 2372, 2369, 2366, 2364, 2361, 2359, 2356,
+  2354, 2351, 2348, 2346, 2343, 2341, 2338, 2335,
+  2333, 2330, 2328, 2325, 2323, 2320, 2317, 2315,
+  2312, 2310, 2307, 2305, 2302, 2299, 2297, 2294,
+  2292, 2289, 2286, 2284, 2281, 2279, 2276, 2274,
+  2271, 2268, 2266, 2263, 2261, 2258, 2255, 2253,
+  2250, 2248, 2245, 2243, 2240, 2237, 2235, 2232,
+  2230, 2227, 2224, 2222, 2219, 2216, 2214, 2211,
+  2209, 2206, 2203, 2201, 2198, 2195, 2193, 2190,
+  2188, 2185, 2182, 2180, 2177, 2174, 2172, 2169,
+  2167, 2164, 2161, 2159, 2156, 2153, 2151, 2148,
+  2146, 2143, 2140, 2138, 2135, 2132, 2130, 2127,
+  2125, 2122, 2119, 2117, 2114, 2111, 2109, 2106,
+  2104, 2101, 2098, 2096, 2093, 2090, 2088, 2085,
+  2083, 2080, 2077, 2074, 2072, 2069, 2066, 2063,
+  2060, 2058, 2055, 2052, 2049, 2046, 2044, 2041,
+  2038, 2035, 2032, 2029, 2027, 2024, 2021, 2018,
+  2015, 2013, 2010, 2007, 2004, 2001, 1999, 1996,
+  1993, 1990, 1987, 1985, 1982, 1979, 1976, 1973,
+  1971, 1968, 1965, 1962, 1959, 1956, 1954, 1951,
+  1948, 1945, 1942, 1940, 1937, 1934, 1931, 1928,
+  1926, 1923, 1920, 1917, 1914, 1911, 1908, 1905,
+  1902, 1898, 1895, 1892, 1889, 1886, 1883, 1880,
+  1877, 1874, 1871, 1868, 1865, 1862, 1858, 1855,
+  1852, 1849, 1846, 1843, 1840, 1837, 1834, 1831,
+  1828, 1825, 1822, 1818, 1815, 1812, 1809, 1806,
+  1803, 1800, 1797, 1794, 1791, 1788, 1785, 1782,
+  1778, 1775, 1772, 1769, 1766, 1763, 1760, 1756,
+  1753, 1749, 1746, 1742, 1739, 1735, 1732, 1728,
+  1724, 1721, 1717, 1714, 1710, 1707, 1703, 1700,
+  1696, 1692, 1689, 1685, 1682, 1678, 1675, 1671,
+  1668, 1664, 1660, 1657, 1653, 1650, 1646, 1643,
+  1639, 1636, 1632, 1628, 1625, 1621, 1618, 1614,
+  1611, 1607, 1604, 1600, 1596, 1592, 1587, 1583,
+  1579, 1575, 1571, 1566, 1562, 1558, 1554, 1549,
+  1545, 1541, 1537, 1533, 1528, 1524, 1520, 1516,
+  1512, 1507, 1503, 1499, 1495, 1491, 1486, 1482,
+  1478, 1474, 1469, 1465, 1461, 1457, 1453, 1448,
+  1444, 1440, 1435, 1430, 1425, 1419, 1414, 1409,
+  1404, 1399, 1394, 1388, 1383, 1378, 1373, 1368,
+  1363, 1357, 1352, 1347, 1342, 1337, 1332, 1326,
+  1321, 1316, 1311, 1306, 1301, 1295, 1290, 1285,
+  1280, 1274, 1267, 1261, 1254, 1248, 1242, 1235,
+  1229, 1222, 1216, 1210, 1203, 1197, 1190, 1184,
+  1178, 1171, 1165, 1158, 1152, 1146, 1139, 1133,
+  1126, 1120, 1111, 1102, 1093, 1084, 1076, 1067,
+  1058, 1049, 1040, 1031, 1022, 1013, 1004, 996,
+  987, 978, 969, 960, 949, 937, 926, 914,
+  903, 891, 880, 869, 857, 846, 834, 823,
+  811, 800, 784, 768, 752, 736, 720, 704,
+  688, 672, 656, 640, 617, 594, 571, 549,
+  526, 503, 480, 448, 416, 384, 352, 320,
+  267, 213, 160, 80, 0, 0, 0, 0,
+  0
+};
+#endif
+
+#if (THERMISTORHEATER_0 == 60) || (THERMISTORHEATER_1 == 60) || (THERMISTORHEATER_2 == 60) || (THERMISTORBED == 60)
+// 257 entries, at most 0.21 degrees C from temptable_60 between 20 and 350 degrees C
+#define TEMPTABLE_UNIFORM_60_SHIFT 5
+const short temptable_uniform_60[] PROGMEM = {
+  5494, 5405, 5315, 5226, 5136, 5046, 4957, 4867,
+  4778, 4688, 4598, 4509, 4419, 4330, 4240, 4150,
+  4075, 4005, 3936, 3872, 3808, 3754, 3702, 3651,
+  3600, 3549, 3509, 3473, 3436, 3400, 3364, 3327,
+  3291, 3257, 3227, 3197, 3167, 3137, 3107, 3077,
+  3047, 3022, 2999, 2975, 2952, 2929, 2905, 2882,
+  2859, 2840, 2821, 2802, 2782, 2763, 2744, 2725,
+  2706, 2686, 2668, 2652, 2636, 2620, 2604, 2588,
+  2572, 2556, 2540, 2524, 2508, 2494, 2480, 2465,
+  2451, 2436, 2422, 2408, 2393, 2379, 2365, 2352,
+  2339, 2326, 2314, 2301, 2288, 2275, 2262, 2250,
+  2237, 2227, 2216, 2205, 2195, 2184, 2173, 2163,
+  2152, 2141, 2131, 2120, 2109, 2099, 2088, 2077,
+  2067, 2056, 2045, 2035, 2024, 2013, 2003, 1990,
+  1978, 1966, 1960, 1954, 1942, 1930, 1918, 1912,
+  1906, 1894, 1882, 1870, 1864, 1858, 1846, 1834,
+  1822, 1816, 1810, 1798, 1786, 1774, 1768, 1762,
+  1750, 1738, 1726, 1720, 1714, 1702, 1690, 1678,
+  1672, 1666, 1654, 1642, 1630, 1624, 1618, 1611,
+  1605, 1597, 1584, 1571, 1563, 1557, 1549, 1536,
+  1523, 1515, 1509, 1501, 1488, 1475, 1467, 1461,
+  1454, 1448, 1442, 1430, 1418, 1406, 1400, 1394,
+  1382, 1370, 1358, 1352, 1346, 1334, 1322, 1310,
+  1304, 1298, 1286, 1274, 1261, 1248, 1235, 1227,
+  1221, 1213, 1200, 1187, 1174, 1162, 1150, 1144,
+  1138, 1126, 1114, 1101, 1088, 1075, 1062, 1050,
+  1037, 1024, 1011, 1003, 997, 989, 976, 963,
+  946, 926, 909, 896, 883, 870, 858, 845,
+  832, 819, 802, 782, 763, 744, 725, 706,
+  686, 667, 648, 629, 610, 590, 570, 544,
+  518, 490, 462, 433, 404, 375, 339, 301,
+  259, 208, 157, 82, 0, 0, 0, 0,
+  0
+};
+#endif
+
+#endif //THERMISTORTABLES_UNIFORM_H_
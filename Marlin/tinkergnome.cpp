@@ -4,6 +4,7 @@
 #include "Marlin.h"
 #include "cardreader.h"
 #include "temperature.h"
+#include "stepper.h"
 #include "lifetime_stats.h"
 #include "ConfigurationStore.h"
 #include "machinesettings.h"
@@ -93,7 +94,7 @@ void tinkergnome_init()
 #if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0)
         // read buildplate pid coefficients
         float pidBed[3];
-        eeprom_read_block(pidBed, (uint8_t*)EEPROM_PID_BED, sizeof(pidBed));
+        eeprom_journal_read_block(pidBed, (uint8_t*)EEPROM_PID_BED, sizeof(pidBed));
         bedKp = pidBed[0];
         bedKi = pidBed[1];
         bedKd = pidBed[2];
@@ -115,7 +116,7 @@ void tinkergnome_init()
         pidBed[1] = (DEFAULT_bedKi*PID_dT);
         pidBed[2] = (DEFAULT_bedKd/PID_dT);
 #endif
-        eeprom_write_block(pidBed, (uint8_t*)EEPROM_PID_BED, sizeof(pidBed));
+        eeprom_journal_write_block(pidBed, (uint8_t*)EEPROM_PID_BED, sizeof(pidBed));
 
         SET_STEPS_E2(axis_steps_per_unit[E_AXIS]);
     }
@@ -125,7 +126,7 @@ void tinkergnome_init()
         heater_check_temp = GET_HEATER_CHECK_TEMP();
         heater_check_time = GET_HEATER_CHECK_TIME();
 #if EXTRUDERS > 1
-        eeprom_read_block(pid2, (uint8_t*)EEPROM_PID_2, sizeof(pid2));
+        eeprom_journal_read_block(pid2, (uint8_t*)EEPROM_PID_2, sizeof(pid2));
 #endif
 #if EXTRUDERS > 1 && defined(MOTOR_CURRENT_PWM_E_PIN) && MOTOR_CURRENT_PWM_E_PIN > -1
         motor_current_e2 = GET_MOTOR_CURRENT_E2();
@@ -144,7 +145,7 @@ void tinkergnome_init()
         pid2[0] = Kp;
         pid2[1] = Ki;
         pid2[2] = Kd;
-        eeprom_write_block(pid2, (uint8_t*)EEPROM_PID_2, sizeof(pid2));
+        eeprom_journal_write_block(pid2, (uint8_t*)EEPROM_PID_2, sizeof(pid2));
 
 #if EXTRUDERS > 1 && defined(MOTOR_CURRENT_PWM_E_PIN) && MOTOR_CURRENT_PWM_E_PIN > -1
         motor_current_e2 = motor_current_setting[2];
@@ -166,13 +167,13 @@ void tinkergnome_init()
     if (version > 3)
     {
         // read axis limits from eeprom
-        eeprom_read_block(min_pos, (uint8_t*)EEPROM_AXIS_LIMITS, sizeof(min_pos));
-        eeprom_read_block(max_pos, (uint8_t*)(EEPROM_AXIS_LIMITS+sizeof(min_pos)), sizeof(max_pos));
+        eeprom_journal_read_block(min_pos, (uint8_t*)EEPROM_AXIS_LIMITS, sizeof(min_pos));
+        eeprom_journal_read_block(max_pos, (uint8_t*)(EEPROM_AXIS_LIMITS+sizeof(min_pos)), sizeof(max_pos));
     }
     else
     {
-        eeprom_write_block(min_pos, (uint8_t *)EEPROM_AXIS_LIMITS, sizeof(min_pos));
-        eeprom_write_block(max_pos, (uint8_t *)(EEPROM_AXIS_LIMITS+sizeof(min_pos)), sizeof(max_pos));
+        eeprom_journal_write_block(min_pos, (uint8_t *)EEPROM_AXIS_LIMITS, sizeof(min_pos));
+        eeprom_journal_write_block(max_pos, (uint8_t *)(EEPROM_AXIS_LIMITS+sizeof(min_pos)), sizeof(max_pos));
     }
     if (version > 2)
     {
@@ -225,6 +226,8 @@ void tinkergnome_init()
     {
         SET_EXPERT_VERSION(EXPERT_VERSION);
     }
+    // the PID coefficients of the second nozzle and the buildplate were loaded after tp_init()
+    updatePID();
 }
 
 void menu_printing_init()
@@ -481,7 +484,10 @@ static void _lcd_babystep(const uint8_t axis)
     if (diff)
     {
         FLOAT_SETTING(axis) += (float)diff/axis_steps_per_unit[axis];
+        // the stepper interrupt takes them
+        CRITICAL_SECTION_START
         babystepsTodo[axis] += diff;
+        CRITICAL_SECTION_END
         lcd_lib_encoder_pos = 0;
     }
 }
@@ -1429,7 +1435,7 @@ void lcd_menu_printing_tg()
     //                float mm_e = current_block->steps_e / axis_steps_per_unit[E_AXIS];
 
                 // calculate live extrusion rate from e speed and filament area
-                float speed_e = current_block->steps_e * current_block->nominal_rate / e_steps_per_unit(current_block->active_extruder) / current_block->step_event_count;
+                float speed_e = float(current_block->steps_e) * current_block->nominal_rate / e_steps_per_unit(current_block->active_extruder) / current_block->step_event_count;
                 float volume = (volume_to_filament_length[current_block->active_extruder] < 0.99) ? speed_e / volume_to_filament_length[current_block->active_extruder] : speed_e*DEFAULT_FILAMENT_AREA;
 
                 e_smoothed_speed[current_block->active_extruder] = (e_smoothed_speed[current_block->active_extruder]*LOW_PASS_SMOOTHING) + ( volume *(1.0-LOW_PASS_SMOOTHING));
@@ -1882,6 +1888,9 @@ static void lcd_recover_start()
     current_position[E_AXIS] = 0.0f;
     plan_set_e_position(current_position[E_AXIS], active_extruder, true);
     menu.replace_menu(menu_t(lcd_menu_recover_file));
+#ifdef RECOVER_LAYER_INDEX
+    recover_layer_select(recover_height);
+#endif
     card.startFileprint();
 }
 
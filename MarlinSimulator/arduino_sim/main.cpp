@@ -1,7 +1,9 @@
 #include <Arduino.h>
 
-int main(void)
+int main(int argc, char** argv)
 {
+	sim_argc = argc;
+	sim_argv = argv;
 	init();
 
 #if defined(USBCON)
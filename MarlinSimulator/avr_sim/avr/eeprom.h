@@ -41,6 +41,9 @@
 
 extern uint8_t __eeprom__storage[4096];
 
+#define eeprom_is_ready() (1)
+#define eeprom_busy_wait() do {} while (!eeprom_is_ready())
+
 static inline uint8_t eeprom_read_byte (const uint8_t *__p)
 {
     return __eeprom__storage[int(__p)];
@@ -16,6 +16,26 @@ typedef void (*sim_ms_callback_t)();
 
 void sim_check_interrupts();
 void sim_setup(sim_ms_callback_t callback);
+unsigned int sim_millis();//Wall clock time in the GUI build, simulated time in the headless build.
+
+void sim_print_interrupt_stats();
+
+//Cpu cycle clock that drives the timer and TWI interrupt events.
+// The headless build uses it as virtual clock, it only advances when the simulated firmware touches a register,
+// every register write is counted as SIM_CYCLES_PER_IO cpu cycles and each interrupt call as SIM_CYCLES_PER_INTERRUPT.
+// The GUI build moves it along with the wall clock.
+#ifdef SIM_HEADLESS
+#ifndef SIM_CYCLES_PER_IO
+#define SIM_CYCLES_PER_IO 32
+#endif
+#ifndef SIM_CYCLES_PER_INTERRUPT
+#define SIM_CYCLES_PER_INTERRUPT 64
+#endif
+#endif
+extern uint64_t sim_cycles;
+
+extern int sim_argc;
+extern char** sim_argv;
 
 class AVRRegistor
 {
@@ -47,7 +67,8 @@ public:
     AVRRegistor16(int index) : index(index) {}
     ~AVRRegistor16() {}
     
-    AVRRegistor16& operator = (const uint32_t v) { __reg_map[index] = v & 0xFF; __reg_map[index+1] = (v >> 8) & 0xFF; return *this; }
+    //Like the hardware the high byte only goes into a temporary register, the write happens with the low byte.
+    AVRRegistor16& operator = (const uint32_t v) { __reg_map[index+1].forceValue((v >> 8) & 0xFF); __reg_map[index] = v & 0xFF; return *this; }
     operator uint16_t() const { return uint16_t(__reg_map[index]) | (uint16_t(__reg_map[index+1])<<8); /*TODO*/}
 };
 
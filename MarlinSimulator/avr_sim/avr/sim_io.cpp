@@ -1,15 +1,23 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <stdio.h>
+#include <queue>
+#ifndef SIM_HEADLESS
 #include <SDL/SDL.h>
+#endif
 
-#include "../../Marlin/configuration.h"
+#include "../../Marlin/Configuration.h"
 #include "../../Marlin/pins.h"
 #include "../../Marlin/fastio.h"
 
-AVRRegistor __reg_map[__REG_MAP_SIZE];
+//The simulation is set up on the first register write, which can already happen from static constructors in the firmware.
+// So the register map needs to be constructed before any of those run.
+AVRRegistor __reg_map[__REG_MAP_SIZE] __attribute__((init_priority(101)));
 uint8_t __eeprom__storage[4096];
 sim_ms_callback_t ms_callback;
+int sim_argc;
+char** sim_argv;
+uint64_t sim_cycles;
 
 unsigned int __bss_end;
 unsigned int __heap_start;
@@ -19,85 +27,374 @@ extern void TWI_vect();
 extern void TIMER0_OVF_vect();
 extern void TIMER0_COMPB_vect();
 extern void TIMER1_COMPA_vect();
+#if TX_BUFFER_SIZE > 0
+extern void USART0_UDRE_vect();
+#endif
 
-unsigned int prevTicks = SDL_GetTicks();
-unsigned int twiIntStart = 0;
+unsigned int sim_millis()
+{
+#ifdef SIM_HEADLESS
+    return sim_cycles / (F_CPU / 1000);
+#else
+    return SDL_GetTicks();
+#endif
+}
 
-//After an interrupt we need to set the interrupt flag again, but do this without calling sim_check_interrupts so the interrupt does not fire recursively
-#define _sei() do { SREG.forceValue(SREG | _BV(SREG_I)); } while(0)
+//Interrupt sources of the event scheduler, in order of AVR interrupt priority (lowest vector number first).
+enum
+{
+    SIM_EVENT_TIMER1_COMPA,
+    SIM_EVENT_TIMER0_COMPB,
+    SIM_EVENT_TIMER0_OVF,
+    SIM_EVENT_USART0_UDRE,
+    SIM_EVENT_TWI,
+    SIM_EVENT_MS_CALLBACK,//Not an interrupt, updates the simulation components every simulated millisecond.
+    SIM_EVENT_COUNT
+};
 
-void sim_check_interrupts()
+struct simEvent
+{
+    uint64_t cycle;
+    int source;
+
+    //std::priority_queue keeps the largest element on top, so the earliest event compares as largest.
+    bool operator < (const simEvent& e) const { return cycle > e.cycle || (cycle == e.cycle && source > e.source); }
+};
+
+struct simInterruptSource
+{
+    const char* name;
+    bool scheduled;//The queue can still hold events that got rescheduled, only the one at 'cycle' is valid.
+    uint64_t cycle;
+    bool flag;//Interrupt flag, set when the event is due and cleared when the ISR is called.
+    uint64_t flagCycle;
+
+    uint32_t calls;
+    uint32_t lost;//Events that happened while the flag was still set, so the ISR only ran once for them.
+    uint32_t missed;//Compare matches missed because the compare register was set behind the counter.
+    uint64_t latencyTotal;
+    uint32_t latencyMax;
+    uint64_t durationTotal;
+    uint32_t durationMax;
+};
+
+static std::priority_queue<simEvent> eventQueue __attribute__((init_priority(101)));
+static simInterruptSource interruptSource[SIM_EVENT_COUNT] = {
+    {"TIMER1_COMPA"},
+    {"TIMER0_COMPB"},
+    {"TIMER0_OVF"},
+    {"USART0_UDRE"},
+    {"TWI"},
+    {"ms update"},
+};
+
+static void scheduleEvent(int source, uint64_t cycle)
+{
+    interruptSource[source].scheduled = true;
+    interruptSource[source].cycle = cycle;
+    simEvent e = {cycle, source};
+    eventQueue.push(e);
+}
+
+static void cancelEvent(int source)
+{
+    interruptSource[source].scheduled = false;
+}
+
+//Timer prescaler as shift, from the CSn2:0 clock select bits. -1 when the timer is stopped or externally clocked.
+static const int8_t clockSelectShift[8] = {-1, 0, 3, 6, 8, 10, -1, -1};
+
+//Timer1 runs in CTC mode for the stepper (counter cleared on OCR1A match) or normal mode for the servos.
+static int64_t timer1Start;//Cycle at which TCNT1 was 0
+static int8_t timer1Shift = -1;
+static bool timer1Wrapped;
+
+static bool timer1CTC()
+{
+    return (TCCR1B & (_BV(WGM13) | _BV(WGM12))) == _BV(WGM12);
+}
+
+static uint16_t timer1Count()
 {
-    if (!(SREG & _BV(SREG_I)))
+    int64_t now = sim_cycles;
+    if (now < timer1Start)//Still in the timer tick of the previous compare match
+        return OCR1A;
+    return (now - timer1Start) >> timer1Shift;
+}
+
+static void scheduleTimer1()
+{
+    if (timer1Shift < 0)
+    {
+        cancelEvent(SIM_EVENT_TIMER1_COMPA);
         return;
+    }
+    int64_t now = sim_cycles;
+    while(now - timer1Start >= (int64_t(0x10000) << timer1Shift))
+        timer1Start += int64_t(0x10000) << timer1Shift;
+    int32_t count = now < timer1Start ? -1 : (now - timer1Start) >> timer1Shift;
+    int32_t compare = uint16_t(OCR1A);
+    //Like the real hardware, a compare value the counter already passed only matches after the 16bit counter wrapped.
+    timer1Wrapped = compare <= count;
+    if (timer1Wrapped)
+        compare += 0x10000;
+    scheduleEvent(SIM_EVENT_TIMER1_COMPA, timer1Start + (int64_t(compare) << timer1Shift));
+}
 
-    unsigned int ticks = SDL_GetTicks();
-    int tickDiff = ticks - prevTicks;
-    prevTicks = ticks;
+static void timer1CompareMatch(uint64_t cycle)
+{
+    if (timer1Wrapped && timer1CTC())
+        interruptSource[SIM_EVENT_TIMER1_COMPA].missed++;
+    if (timer1CTC())
+        timer1Start = cycle + (1 << timer1Shift);
+    scheduleTimer1();
+}
 
-#ifdef ENABLE_ULTILCD2
-    if ((TWCR & _BV(TWEN)) && (TWCR & _BV(TWINT)) && (TWCR & _BV(TWIE)))
+//Timer0 runs in fast PWM mode with a fixed TOP of 0xFF, as set up by the arduino core for millis().
+static int64_t timer0Start;//Cycle at which TCNT0 was 0
+static int8_t timer0Shift = -1;
+
+static uint64_t timer0NextTick(int tick)
+{
+    int64_t count = (int64_t(sim_cycles) - timer0Start) >> timer0Shift;
+    int64_t next = (count & ~0xFF) + tick;
+    if (next <= count)
+        next += 0x100;
+    return timer0Start + (next << timer0Shift);
+}
+
+static void scheduleTimer0()
+{
+    if (timer0Shift < 0)
+    {
+        cancelEvent(SIM_EVENT_TIMER0_COMPB);
+        cancelEvent(SIM_EVENT_TIMER0_OVF);
+        return;
+    }
+    scheduleEvent(SIM_EVENT_TIMER0_COMPB, timer0NextTick(OCR0B));
+    scheduleEvent(SIM_EVENT_TIMER0_OVF, timer0NextTick(0x100));
+}
+
+//Cycles for one TWI byte transfer, 8 data bits and the ack at the SCL frequency set by TWBR and the TWSR prescaler.
+static uint32_t twiByteCycles()
+{
+    return 9 * (16 + 2 * uint32_t(TWBR) * (1 << (2 * (TWSR & (_BV(TWPS1) | _BV(TWPS0))))));
+}
+
+static uint64_t twiDoneCycle;
+
+//Called after each register write, to update the scheduled events when a timer or the TWI is reconfigured.
+static void registerWritten(AVRRegistor* reg, uint8_t oldValue)
+{
+    if (reg == &OCR1AL)//16bit registers are written with the low byte last, see AVRRegistor16
+    {
+        scheduleTimer1();
+    }else if (reg == &TCNT1L)
+    {
+        if (timer1Shift >= 0)
+            timer1Start = int64_t(sim_cycles) - (int64_t(uint16_t(TCNT1)) << timer1Shift);
+        scheduleTimer1();
+    }else if (reg == &TCCR1B)
     {
-        //Relay the TWI interrupt by 25ms one time till it gets disabled again. This fakes the LCD refresh rate.
-        if (twiIntStart == 0)
-            twiIntStart = SDL_GetTicks();
-        if (SDL_GetTicks() - twiIntStart > 25)
+        uint16_t count = TCNT1;
+        timer1Shift = clockSelectShift[TCCR1B & (_BV(CS12) | _BV(CS11) | _BV(CS10))];
+        if (timer1Shift >= 0)
+            timer1Start = int64_t(sim_cycles) - (int64_t(count) << timer1Shift);
+        scheduleTimer1();
+    }else if (reg == &TCCR0B)
+    {
+        uint8_t count = TCNT0;
+        timer0Shift = clockSelectShift[TCCR0B & (_BV(CS02) | _BV(CS01) | _BV(CS00))];
+        if (timer0Shift >= 0)
+            timer0Start = int64_t(sim_cycles) - (int64_t(count) << timer0Shift);
+        scheduleTimer0();
+    }else if (reg == &OCR0B)
+    {
+        if (timer0Shift >= 0)
+            scheduleEvent(SIM_EVENT_TIMER0_COMPB, timer0NextTick(OCR0B));
+    }else if (reg == &UCSR0B || reg == &UDR0)
+    {
+        //The simulated UART sends a byte the moment it is written (see serialSim), so the data register is always empty
+        // and the UDRE interrupt is pending whenever it is enabled.
+        simInterruptSource& source = interruptSource[SIM_EVENT_USART0_UDRE];
+        if (!(UCSR0B & _BV(UDRIE0)))
+        {
+            source.flag = false;
+        }else if (!source.flag)
+        {
+            source.flag = true;
+            source.flagCycle = sim_cycles;
+        }
+    }else if (reg == &TWCR)
+    {
+        //The i2c simulation completes a transfer right away and leaves TWINT set, so polling code never waits.
+        // The interrupt only fires after the time the transfer takes on the bus, this also gives the real LCD refresh rate.
+        bool onlyEnablesInterrupt = (oldValue ^ TWCR) == _BV(TWIE) && (TWCR & _BV(TWIE));
+        if ((TWCR & _BV(TWINT)) && (TWCR & _BV(TWEN)) && !onlyEnablesInterrupt)
+            twiDoneCycle = sim_cycles + twiByteCycles();
+        if ((TWCR & _BV(TWINT)) && (TWCR & _BV(TWEN)) && (TWCR & _BV(TWIE)))
         {
-            cli();
-            TWI_vect();
-            _sei();
+            if (!interruptSource[SIM_EVENT_TWI].scheduled && !interruptSource[SIM_EVENT_TWI].flag)
+                scheduleEvent(SIM_EVENT_TWI, twiDoneCycle > sim_cycles ? twiDoneCycle : sim_cycles);
+        }else{
+            cancelEvent(SIM_EVENT_TWI);
+            interruptSource[SIM_EVENT_TWI].flag = false;
         }
     }
-    if (!(TWCR & _BV(TWEN)) || !(TWCR & _BV(TWIE)))
+}
+
+//Timer counters are only stored as start cycle, update the registers so the firmware can read them.
+static void updateTimerCounters()
+{
+    if (timer1Shift >= 0)
     {
-        twiIntStart = 0;
+        uint16_t count = timer1Count();
+        TCNT1L.forceValue(count);
+        TCNT1H.forceValue(count >> 8);
     }
-#endif
+    if (timer0Shift >= 0)
+        TCNT0.forceValue((int64_t(sim_cycles) - timer0Start) >> timer0Shift);
+}
 
-    //if (tickDiff > 1)
-    //    printf("Ticks slow! %i\n", tickDiff);
-    if (tickDiff > 0)
+static bool interruptEnabled(int source)
+{
+    switch(source)
     {
-        ms_callback();
+    case SIM_EVENT_TIMER1_COMPA: return TIMSK1 & _BV(OCIE1A);
+    case SIM_EVENT_TIMER0_COMPB: return TIMSK0 & _BV(OCIE0B);
+    case SIM_EVENT_TIMER0_OVF: return TIMSK0 & _BV(TOIE0);
+    case SIM_EVENT_USART0_UDRE: return UCSR0B & _BV(UDRIE0);
+    case SIM_EVENT_TWI: return TWCR & _BV(TWIE);
+    }
+    return true;
+}
 
-        cli();
-        for(int n=0;n<tickDiff;n++)
+//Set the interrupt flag of an event that is due, and schedule the next event of periodic sources.
+// Events of a disabled interrupt do not set the flag, so enabling an interrupt does not fire it for an old event.
+static void raiseEvent(const simEvent& e)
+{
+    simInterruptSource& source = interruptSource[e.source];
+    if (!source.scheduled || source.cycle != e.cycle)
+        return;
+    source.scheduled = false;
+    if (interruptEnabled(e.source))
+    {
+        if (source.flag)
         {
-            if (TIMSK0 & _BV(OCIE0B))
-                TIMER0_COMPB_vect();
-            if (TIMSK0 & _BV(TOIE0))
-                TIMER0_OVF_vect();
+            source.lost++;
+        }else{
+            source.flag = true;
+            source.flagCycle = e.cycle;
         }
+    }
+    switch(e.source)
+    {
+    case SIM_EVENT_TIMER1_COMPA:
+        timer1CompareMatch(e.cycle);
+        break;
+    case SIM_EVENT_TIMER0_COMPB:
+    case SIM_EVENT_TIMER0_OVF:
+        scheduleEvent(e.source, e.cycle + (0x100 << timer0Shift));
+        break;
+    case SIM_EVENT_MS_CALLBACK:
+        scheduleEvent(e.source, e.cycle + F_CPU / 1000);
+        break;
+    }
+}
+
+//The interrupt flag is cleared and set again around an interrupt call without calling sim_check_interrupts,
+// so the interrupt does not fire recursively and the hardware doing this is not counted as register writes.
+#define _cli() do { SREG.forceValue(SREG & ~_BV(SREG_I)); } while(0)
+#define _sei() do { SREG.forceValue(SREG | _BV(SREG_I)); } while(0)
 
-        //Timer1 runs at 16Mhz / 8 ticks per second.
-//        unsigned int waveformMode = ((TCCR1B & (_BV(WGM13) | _BV(WGM12))) >> 1) | (TCCR1A & (_BV(WGM11) | _BV(WGM10)));
-        unsigned int clockSource = TCCR1B & (_BV(CS12) | _BV(CS11) | _BV(CS10));
-        unsigned int tickCount = F_CPU * tickDiff / 1000;
-        unsigned int ticks = TCNT1;
-        switch(clockSource)
+//Call the highest priority interrupt that has its flag set. Returns false when nothing was pending.
+static bool serviceInterrupt()
+{
+    for(int n=0; n<SIM_EVENT_COUNT; n++)
+    {
+        simInterruptSource& source = interruptSource[n];
+        if (!source.flag || !interruptEnabled(n))
+            continue;
+        source.flag = false;
+        if (n == SIM_EVENT_MS_CALLBACK)
         {
-        case 0: tickCount = 0; break;
-        case 1: break;
-        case 2: tickCount /= 8; break;
-        case 3: tickCount /= 64; break;
-        case 4: tickCount /= 256; break;
-        case 5: tickCount /= 1024; break;
-        case 6: tickCount = 0; break;
-        case 7: tickCount = 0; break;
+            ms_callback();
+            return true;
         }
 
-        if (tickCount > 0 && OCR1A > 0)
+        uint32_t latency = sim_cycles - source.flagCycle;
+        uint64_t start = sim_cycles;
+        _cli();
+#ifdef SIM_HEADLESS
+        sim_cycles += SIM_CYCLES_PER_INTERRUPT;
+#endif
+        switch(n)
         {
-            ticks += tickCount;
-            while(ticks > int(OCR1A))
-            {
-                ticks -= int(OCR1A);
-                if (TIMSK1 & _BV(OCIE1A))
-                    TIMER1_COMPA_vect();
-            }
-            TCNT1 = ticks;
+        case SIM_EVENT_TIMER1_COMPA: TIMER1_COMPA_vect(); break;
+        case SIM_EVENT_TIMER0_COMPB: TIMER0_COMPB_vect(); break;
+        case SIM_EVENT_TIMER0_OVF: TIMER0_OVF_vect(); break;
+#if TX_BUFFER_SIZE > 0
+        case SIM_EVENT_USART0_UDRE: USART0_UDRE_vect(); break;
+#endif
+#ifdef ENABLE_ULTILCD2
+        case SIM_EVENT_TWI: TWI_vect(); break;
+#endif
         }
         _sei();
+        uint32_t duration = sim_cycles - start;
+
+        source.calls++;
+        source.latencyTotal += latency;
+        if (latency > source.latencyMax)
+            source.latencyMax = latency;
+        source.durationTotal += duration;
+        if (duration > source.durationMax)
+            source.durationMax = duration;
+        return true;
+    }
+    return false;
+}
+
+void sim_check_interrupts()
+{
+#ifndef SIM_HEADLESS
+    uint64_t wallClockCycles = uint64_t(SDL_GetTicks()) * (F_CPU / 1000);
+#endif
+    while(true)
+    {
+        while(!eventQueue.empty() && eventQueue.top().cycle <= sim_cycles)
+        {
+            simEvent e = eventQueue.top();
+            eventQueue.pop();
+            raiseEvent(e);
+        }
+        updateTimerCounters();
+
+        if (!(SREG & _BV(SREG_I)))
+            return;
+        if (serviceInterrupt())
+            continue;
+#ifndef SIM_HEADLESS
+        //Interrupts take no simulated time in the GUI build, so run the clock from event to event till it catches up with the wall clock.
+        if (!eventQueue.empty() && eventQueue.top().cycle <= wallClockCycles)
+        {
+            sim_cycles = eventQueue.top().cycle;
+            continue;
+        }
+#endif
+        return;
+    }
+}
+
+void sim_print_interrupt_stats()
+{
+    printf("Interrupt        calls   lost  missed  latency avg/max  duration avg/max (cycles)\n");
+    for(int n=0; n<SIM_EVENT_MS_CALLBACK; n++)
+    {
+        simInterruptSource& source = interruptSource[n];
+        uint32_t calls = source.calls > 0 ? source.calls : 1;
+        printf("%-12s %9u %6u %7u %8u/%-8u %8u/%u\n", source.name, source.calls, source.lost, source.missed,
+            uint32_t(source.latencyTotal / calls), source.latencyMax, uint32_t(source.durationTotal / calls), source.durationMax);
     }
 }
 
@@ -108,21 +405,30 @@ AVRRegistor& AVRRegistor::operator = (const uint32_t v)
 {
     uint8_t n = v;
     if (!ms_callback) sim_setup_main();
+#ifdef SIM_HEADLESS
+    sim_cycles += SIM_CYCLES_PER_IO;
+#endif
+    uint8_t oldValue = value;
     callback(value, n);
     value = n;
+    registerWritten(this, oldValue);
     sim_check_interrupts();
     return *this;
 }
 
 void sim_setup(sim_ms_callback_t callback)
 {
+    //The headless build always starts from a blank EEPROM, so runs are repeatable.
+#ifndef SIM_HEADLESS
     FILE* f = fopen("eeprom.save", "rb");
     if (f)
     {
         fread(__eeprom__storage, sizeof(__eeprom__storage), 1, f);
         fclose(f);
     }
+#endif
     ms_callback = callback;
+    scheduleEvent(SIM_EVENT_MS_CALLBACK, sim_cycles + F_CPU / 1000);
 
     UCSR0A = 0;
 }
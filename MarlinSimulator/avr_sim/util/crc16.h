@@ -0,0 +1,20 @@
+#ifndef _SIM_CRC16_H
+#define _SIM_CRC16_H
+
+#include <stdint.h>
+
+//The C equivalent of the avr-libc assembly version, from its documentation.
+static inline uint16_t _crc16_update(uint16_t crc, uint8_t a)
+{
+    crc ^= a;
+    for(int i=0; i<8; i++)
+    {
+        if (crc & 1)
+            crc = (crc >> 1) ^ 0xA001;
+        else
+            crc = (crc >> 1);
+    }
+    return crc;
+}
+
+#endif//_SIM_CRC16_H
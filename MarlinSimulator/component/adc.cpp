@@ -6,7 +6,10 @@ adcSim::adcSim()
 {
     ADCSRA.setCallback(DELEGATE(registerDelegate, adcSim, *this, ADC_ADCSRA_callback));
     for(unsigned int n=0;n<16;n++)
+    {
         adcValue[n] = 0;
+        adcError[n] = 0;
+    }
 }
 
 adcSim::~adcSim()
@@ -21,6 +24,9 @@ void adcSim::ADC_ADCSRA_callback(uint8_t oldValue, uint8_t& newValue)
         if (ADCSRB & _BV(MUX5))
             idx += 8;
         
-        ADC = adcValue[idx];
+        float value = adcValue[idx] + adcError[idx];
+        int result = int(value + 0.5);
+        adcError[idx] = value - result;
+        ADC = result;
     }
 }
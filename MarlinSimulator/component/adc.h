@@ -9,9 +9,13 @@ public:
     adcSim();
     virtual ~adcSim();
     
-    int adcValue[16];
+    //Set by the sensor components. A conversion gives the nearest integer, with the rounding error carried over to the
+    // next conversion of the channel, so the oversampling in the firmware sees the fraction.
+    float adcValue[16];
     
 private:
+    float adcError[16];
+
     void ADC_ADCSRA_callback(uint8_t oldValue, uint8_t& newValue);
 };
 
@@ -116,6 +116,7 @@ void arduinoIOSim::IO_PORTL_callback(uint8_t oldValue, uint8_t& newValue)
 
 bool readOutput(int arduinoPinNr)
 {
+    if (arduinoPinNr < 0) return false;
 	uint8_t bit = digitalPinToBitMask(arduinoPinNr);
     uint8_t port = digitalPinToPort(arduinoPinNr);
 
@@ -128,6 +129,7 @@ bool readOutput(int arduinoPinNr)
 
 void writeInput(int arduinoPinNr, bool value)
 {
+    if (arduinoPinNr < 0) return;
 	uint8_t bit = digitalPinToBitMask(arduinoPinNr);
     uint8_t port = digitalPinToPort(arduinoPinNr);
 
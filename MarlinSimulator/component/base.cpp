@@ -1,10 +1,20 @@
-#include <SDL/SDL.h>
 #include "base.h"
 
+std::vector<simBaseComponent*> simComponentList __attribute__((init_priority(101)));//Filled during static construction, see __reg_map
+
+#ifdef SIM_HEADLESS
+//No screen in the headless build, all drawing is dropped.
+void drawString(const int x, const int y, const char* str, uint32_t color) {}
+void drawChar(const int x, const int y, const char c, uint32_t color) {}
+void drawStringSmall(const int x, const int y, const char* str, uint32_t color) {}
+void drawCharSmall(const int x, const int y, const char c, uint32_t color) {}
+void drawRect(const int x, const int y, const int w, const int h, uint32_t color) {}
+#else
+#include <SDL/SDL.h>
+
 #define DRAW_SCALE 3
 
 extern SDL_Surface *screen;
-std::vector<simBaseComponent*> simComponentList;
 
 static const uint8_t lcd_font[] = {
     // font data
@@ -207,3 +217,4 @@ void drawRect(const int x, const int y, const int w, const int h, uint32_t color
     if (rect.h == 0) rect.h = 1;
     SDL_FillRect(screen, &rect, color);
 }
+#endif//SIM_HEADLESS
@@ -5,7 +5,11 @@
 displaySDD1309Sim::displaySDD1309Sim(i2cSim* i2c, int id)
 {
     i2c->registerDevice(id, DELEGATE(i2cMessageDelegate, displaySDD1309Sim, *this, processMessage));
-    lcd_data_pos = 0;
+    addressing_mode = 2;
+    column = page = 0;
+    column_start = page_start = 0;
+    column_end = 127;
+    page_end = 7;
 }
 
 displaySDD1309Sim::~displaySDD1309Sim()
@@ -19,8 +23,19 @@ void displaySDD1309Sim::processMessage(uint8_t* message, int length)
         //Data
         for(int n=2;n<length;n++)
         {
-            lcd_data[lcd_data_pos] = message[n];
-            lcd_data_pos = (lcd_data_pos + 1) % 1024;
+            lcd_data[column + page * 128] = message[n];
+            if (addressing_mode == 2)
+            {
+                //Page addressing mode stays in the page
+                column = (column + 1) % 128;
+            }else if (column < column_end)
+            {
+                column++;
+            }else{
+                //Horizontal addressing mode wraps to the next page of the address window
+                column = column_start;
+                page = page < page_end ? page + 1 : page_start;
+            }
         }
     }else if (message[1] == 0x00)
     {
@@ -29,14 +44,24 @@ void displaySDD1309Sim::processMessage(uint8_t* message, int length)
         {
             if ((message[n] & 0xF0) == 0x00)
             {
-                lcd_data_pos = (lcd_data_pos & 0xFF0) | (message[n] & 0x0F);
+                if (addressing_mode == 2)
+                    column = (column & 0x70) | (message[n] & 0x0F);
             }else if ((message[n] & 0xF0) == 0x10)
             {
-                lcd_data_pos = (lcd_data_pos & 0xF8F) | ((message[n] & 0x07) << 4);
+                if (addressing_mode == 2)
+                    column = (column & 0x0F) | ((message[n] & 0x07) << 4);
             }else if ((message[n] & 0xF0) == 0xB0)
             {
-                lcd_data_pos = (lcd_data_pos & 0x07F) | ((message[n] & 0x0F) << 7);
+                if (addressing_mode == 2)
+                    page = message[n] & 0x07;
             }else if (message[n] == 0x20) { /*LCD_COMMAND_SET_ADDRESSING_MODE*/
+                addressing_mode = message[++n] & 0x03;
+            }else if (message[n] == 0x21) { /*LCD_COMMAND_SET_COLUMN_ADDRESS*/
+                column = column_start = message[++n] & 0x7F;
+                column_end = message[++n] & 0x7F;
+            }else if (message[n] == 0x22) { /*LCD_COMMAND_SET_PAGE_ADDRESS*/
+                page = page_start = message[++n] & 0x07;
+                page_end = message[++n] & 0x07;
             }else if (message[n] == 0x40) { /*Set start line*/
             }else if (message[n] == 0x81) { /*LCD_COMMAND_CONTRAST*/ n++;
             }else if (message[n] == 0xA1) { /*Segment remap*/
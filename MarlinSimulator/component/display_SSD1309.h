@@ -13,7 +13,10 @@ public:
 private:
     void processMessage(uint8_t* message, int length);
 
-    int lcd_data_pos;
+    int addressing_mode;//0 horizontal, 2 page (the reset default)
+    int column, page;
+    int column_start, column_end;//Address window of the horizontal addressing mode
+    int page_start, page_end;
     uint8_t lcd_data[1024];
 };
 
@@ -1,27 +1,124 @@
+#include <stdlib.h>
+#include <string.h>
 #include "heater.h"
 #include "arduinoIO.h"
+#include "../../Marlin/thermistortables.h"
 
-heaterSim::heaterSim(int heaterPinNr, adcSim* adc, int temperatureADCNr, float heaterStrength)
+bool heaterModel::set(const char* settings)
+{
+    while(*settings)
+    {
+        const char* value = strchr(settings, '=');
+        if (value == NULL)
+            return false;
+        char* end;
+        float f = strtod(value + 1, &end);
+        if (end == value + 1 || (*end != ',' && *end != '\0'))
+            return false;
+        size_t length = value - settings;
+        if (length == 5 && strncmp(settings, "power", 5) == 0)
+            power = f;
+        else if (length == 8 && strncmp(settings, "capacity", 8) == 0)
+            heatCapacity = f;
+        else if (length == 4 && strncmp(settings, "loss", 4) == 0)
+            loss = f;
+        else if (length == 3 && strncmp(settings, "fan", 3) == 0)
+            fanLoss = f;
+        else if (length == 3 && strncmp(settings, "lag", 3) == 0)
+            sensorLag = f;
+        else if (length == 4 && strncmp(settings, "dead", 4) == 0)
+            deadTime = f;
+        else if (length == 7 && strncmp(settings, "ambient", 7) == 0)
+            ambient = f;
+        else
+            return false;
+        settings = *end ? end + 1 : end;
+    }
+    return heatCapacity > 0 && sensorLag >= 0 && deadTime >= 0;
+}
+
+heaterSim::heaterSim(int heaterPinNr, adcSim* adc, int temperatureADCNr, int heaterNr, const heaterModel& model)
+: model(model)
 {
     this->heaterPinNr = heaterPinNr;
     this->adc = adc;
     this->temperatureADCNr = temperatureADCNr;
-    this->heaterStrength = heaterStrength;
 
-    this->temperature = 20;
+    switch(heaterNr)
+    {
+    case 0: table = HEATER_0_TEMPTABLE; tableShift = HEATER_0_TEMPTABLE_SHIFT; break;
+    case 1: table = HEATER_1_TEMPTABLE; tableShift = HEATER_1_TEMPTABLE_SHIFT; break;
+    case 2: table = HEATER_2_TEMPTABLE; tableShift = HEATER_2_TEMPTABLE_SHIFT; break;
+#if TEMP_SENSOR_BED != 0
+    case -1: table = BEDTEMPTABLE; tableShift = BEDTEMPTABLE_SHIFT; break;
+#endif
+    default: table = NULL; tableShift = 0; break;
+    }
+    tableIndex = 0;
+    dutyCycle = -1;
+    dutyAccumulator = 0;
+
+    reset(model.ambient);
 }
 
 heaterSim::~heaterSim()
 {
 }
 
+void heaterSim::reset(float temperature)
+{
+    this->temperature = temperature;
+    sensorTemperature = temperature;
+    delayLine.assign(int(model.deadTime * 1000) + 1, false);
+    delayPos = 0;
+}
+
+//Inverse of the firmware conversion: the ADC value (a fraction, the ADC simulation dithers it) at which analog2temp()
+// gives this temperature. The tables are monotonic, the search starts at the entry of the previous call.
+float heaterSim::adcForTemperature(float t)
+{
+    if (table == NULL)
+        return 231 + t * 81 / 100;//Not accurate, but accurate enough.
+    const unsigned int last = TEMPTABLE_UNIFORM_RAW_MAX >> tableShift;
+    t *= TEMPTABLE_UNIFORM_SCALE;
+    bool rising = table[last] > table[0];
+    while(tableIndex > 0 && (rising ? table[tableIndex] > t : table[tableIndex] < t))
+        tableIndex--;
+    while(tableIndex < last - 1 && (rising ? table[tableIndex + 1] <= t : table[tableIndex + 1] >= t))
+        tableIndex++;
+    float t0 = table[tableIndex];
+    float t1 = table[tableIndex + 1];
+    float f = (t1 != t0) ? (t - t0) / (t1 - t0) : 0;
+    if (f < 0) f = 0;
+    if (f > 1) f = 1;
+    return (tableIndex + f) * (1 << tableShift) / OVERSAMPLENR;
+}
+
 void heaterSim::tick()
 {
-    if (readOutput(heaterPinNr))
-        temperature += 0.03 * heaterStrength;
-    else if (temperature > 20)
-        temperature -= 0.03 * heaterStrength;
-    adc->adcValue[temperatureADCNr] = 231 + temperature * 81 / 100;//Not accurate, but accurate enough.
+    const float dt = 0.001;//Called every ms
+
+    if (dutyCycle < 0)
+    {
+        delayLine[delayPos] = readOutput(heaterPinNr);
+    }else{
+        //Spread the duty cycle over the ms ticks like the soft PWM of the temperature ISR does.
+        dutyAccumulator += dutyCycle;
+        delayLine[delayPos] = dutyAccumulator >= 128;
+        if (dutyAccumulator >= 128)
+            dutyAccumulator -= 128;
+    }
+    delayPos = (delayPos + 1) % delayLine.size();
+    float power = delayLine[delayPos] ? model.power : 0;
+
+    float loss = model.loss + model.fanLoss * fanSpeed / 255;
+    temperature += (power - loss * (temperature - model.ambient)) * dt / model.heatCapacity;
+    if (model.sensorLag > dt)
+        sensorTemperature += (temperature - sensorTemperature) * dt / model.sensorLag;
+    else
+        sensorTemperature = temperature;
+
+    adc->adcValue[temperatureADCNr] = adcForTemperature(sensorTemperature);
 }
 
 void heaterSim::draw(int x, int y)
@@ -1,24 +1,65 @@
 #ifndef HEATER_SIM_H
 #define HEATER_SIM_H
 
+#include <vector>
 #include "base.h"
 #include "adc.h"
 
+//First order plus dead time model of a heater block and its temperature sensor:
+//  heatCapacity * dT/dt = power * on(t - deadTime) - (loss + fanLoss * fan) * (T - ambient)
+//The sensor follows T with a first order lag of sensorLag seconds, fan is the print cooling fan speed from 0 to 1.
+struct heaterModel
+{
+    float power;        //W when the heater is on
+    float heatCapacity; //J/K
+    float loss;         //W/K to the ambient
+    float fanLoss;      //W/K extra with the fan at full speed
+    float sensorLag;    //s
+    float deadTime;     //s
+    float ambient;      //C
+
+    heaterModel(float power, float heatCapacity, float loss, float fanLoss, float sensorLag, float deadTime)
+    : power(power), heatCapacity(heatCapacity), loss(loss), fanLoss(fanLoss), sensorLag(sensorLag), deadTime(deadTime), ambient(20) {}
+
+    //Change values from a "name=value,name=value" list, with the names power, capacity, loss, fan, lag, dead and ambient.
+    // Returns false on a name or value it does not know.
+    bool set(const char* settings);
+};
+
 class heaterSim : public simBaseComponent
 {
 public:
-    heaterSim(int heaterPinNr, adcSim* adc, int temperatureADCNr, float heaterStrength = 1.0);
+    //heaterNr is the firmware heater (0, 1, 2 or -1 for the bed), its thermistor table converts the sensor temperature to the ADC value.
+    heaterSim(int heaterPinNr, adcSim* adc, int temperatureADCNr, int heaterNr, const heaterModel& model);
     virtual ~heaterSim();
-    
+
     virtual void tick();
     virtual void draw(int x, int y);
+
+    heaterModel& getModel() { return model; }
+    //Start over at a steady temperature, after the model is changed.
+    void reset(float temperature);
+    float getTemperature() { return temperature; }
+    //Drive the heater with this duty cycle (0..127, like soft_pwm) instead of the heater pin, -1 goes back to the pin.
+    void setDutyCycle(int duty) { dutyCycle = duty; }
 private:
+    heaterModel model;
     float temperature;
-    float heaterStrength;
+    float sensorTemperature;
+    //Heater output of the last deadTime ms, the block sees the oldest one.
+    std::vector<bool> delayLine;
+    unsigned int delayPos;
+    int dutyCycle;
+    int dutyAccumulator;
 
     int heaterPinNr;
     adcSim* adc;
     int temperatureADCNr;
+    const short* table;
+    uint8_t tableShift;
+    unsigned int tableIndex;
+
+    float adcForTemperature(float t);
 };
 
-#endif//I2C_SIM_H
+#endif//HEATER_SIM_H
@@ -28,7 +28,7 @@ void i2cSim::I2C_TWCR_callback(uint8_t oldValue, uint8_t& newValue)
             }
             i2cMessagePos = 0;
             i2cMessage[0] = 0xFF;
-            TWSR = 0x08;
+            TWSR.forceValue(0x08);
         } else if (newValue & _BV(TWSTO))
         {
             if (i2cDevice[i2cMessage[0]])
@@ -38,15 +38,15 @@ void i2cSim::I2C_TWCR_callback(uint8_t oldValue, uint8_t& newValue)
             i2cMessagePos = 0;
             newValue &=~_BV(TWINT);
             newValue &=~_BV(TWSTO);
-            TWSR = 0x00;
+            TWSR.forceValue(0x00);
         }else{
             i2cMessage[i2cMessagePos] = TWDR;
             i2cMessagePos++;
-            TWDR = 0x00;
+            TWDR.forceValue(0x00);
             if (TWSR == 0x08)
-                TWSR = 0x18;
+                TWSR.forceValue(0x18);
             else if (TWSR == 0x18)
-                TWSR = 0x28;
+                TWSR.forceValue(0x28);
         }
     }
 }
@@ -13,10 +13,26 @@ sdcardSimulation::sdcardSimulation(const char* basePath, int errorRate)
 
     sd_state = 0;
     sd_buffer_pos = 0;
+    image = NULL;
+    blockReads = 0;
 }
 
 sdcardSimulation::~sdcardSimulation()
 {
+    if (image)
+        fclose(image);
+}
+
+bool sdcardSimulation::openImage(const char* filename)
+{
+    if (image)
+        fclose(image);
+    image = fopen(filename, "r+b");
+    if (image == NULL)
+        image = fopen(filename, "rb");
+    if (image == NULL)
+        printf("Failed to open SD card image: %s\n", filename);
+    return image != NULL;
 }
 
 static const uint16_t crctab[] = {
@@ -63,7 +79,7 @@ static uint16_t CRC_CCITT(const uint8_t* data, size_t n) {
 
 FILE* simFile;
 //Total crappy fake FAT32 simulation, works for 1 file, sort of.
-void sdcardSimulation::read_sd_block(int nr)
+void sdcardSimulation::read_fake_fat_block(int nr)
 {
     memset(sd_buffer, 0, 512);
     switch(nr)
@@ -176,12 +192,34 @@ void sdcardSimulation::read_sd_block(int nr)
         }
         break;
     }
+}
+
+void sdcardSimulation::read_sd_block(int nr)
+{
+    blockReads++;
+    if (image)
+    {
+        //Past the end of the image reads as erased flash
+        if (fseek(image, long(nr) * 512, SEEK_SET) != 0 || fread(sd_buffer, 512, 1, image) != 1)
+            memset(sd_buffer, 0xFF, 512);
+    }
+    else
+    {
+        read_fake_fat_block(nr);
+    }
 
     uint16_t crc = CRC_CCITT(sd_buffer, 512);
     sd_buffer[512] = crc >> 8;
     sd_buffer[513] = crc;
 }
 
+bool sdcardSimulation::write_sd_block(int nr)
+{
+    if (!image)
+        return false;
+    return fseek(image, long(nr) * 512, SEEK_SET) == 0 && fwrite(sd_buffer, 512, 1, image) == 1 && fflush(image) == 0;
+}
+
 void sdcardSimulation::ISP_SPDR_callback(uint8_t oldValue, uint8_t& newValue)
 {
     if (errorRate && (rand() % errorRate) == 0)
@@ -218,6 +256,10 @@ void sdcardSimulation::ISP_SPDR_callback(uint8_t oldValue, uint8_t& newValue)
         case 0x0C://CMD12 - STOP_TRANSMISSION
             newValue = 0x01;         //Report R1_IDLE_STATE
             break;
+        case 0x0D://CMD13 - SEND_STATUS
+            newValue = 0x00;//R1_READY_STATE, the second byte of the R2 response follows
+            sd_state = 23;
+            break;
         case 0x11://CMD17 - READ_SINGLE_BLOCK
             newValue = 0x00;//R1_READY_STATE
             sd_read_block_nr = (sd_buffer[1] << 24) | (sd_buffer[2] << 16) | (sd_buffer[3] << 8) | (sd_buffer[4] << 0);
@@ -225,6 +267,12 @@ void sdcardSimulation::ISP_SPDR_callback(uint8_t oldValue, uint8_t& newValue)
             sd_state = 10;
             sd_buffer_pos = 0;
             break;
+        case 0x18://CMD24 - WRITE_BLOCK
+            newValue = 0x00;//R1_READY_STATE
+            sd_read_block_nr = (sd_buffer[1] << 24) | (sd_buffer[2] << 16) | (sd_buffer[3] << 8) | (sd_buffer[4] << 0);
+            sd_state = 20;
+            sd_buffer_pos = 0;
+            break;
         case 0x37://CMD55 - APP_CMD
             sd_state = 2;
             break;
@@ -260,6 +308,26 @@ void sdcardSimulation::ISP_SPDR_callback(uint8_t oldValue, uint8_t& newValue)
             sd_buffer_pos = 0;
         }
         break;
+    case 20://WRITE BLOCK, wait for the data token
+        if (newValue == 0xFE)//DATA_START_BLOCK
+            sd_state = 21;
+        newValue = 0xFF;
+        break;
+    case 21://WRITE BLOCK, data and crc
+        sd_buffer[sd_buffer_pos++] = newValue;
+        newValue = 0xFF;
+        if (sd_buffer_pos == 512 + 2)
+            sd_state = 22;
+        break;
+    case 22://WRITE BLOCK, data response
+        newValue = write_sd_block(sd_read_block_nr >> 9) ? 0x05 : 0x0D;//DATA_RES_ACCEPTED or write error
+        sd_state = 0;
+        sd_buffer_pos = 0;
+        break;
+    case 23://Second byte of the CMD13 response
+        newValue = 0x00;
+        sd_state = 0;
+        break;
     }
     //Introduce random errors in SD communication
     if (errorRate && (rand() % errorRate) == 0)
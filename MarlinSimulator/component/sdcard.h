@@ -10,15 +10,23 @@ private:
 public:
     sdcardSimulation(const char* basePath, int errorRate=0);
     virtual ~sdcardSimulation();
+
+    //Serve the blocks of a raw card image (see sdimage.py) instead of the fake FAT of basePath.
+    // Block writes go to the image when it is writable, the fake FAT is read only.
+    bool openImage(const char* filename);
     
     void ISP_SPDR_callback(uint8_t oldValue, uint8_t& newValue);
     void read_sd_block(int nr);
+    void read_fake_fat_block(int nr);
+    bool write_sd_block(int nr);
 
     int sd_state;
     uint8_t sd_buffer[1024];
     int sd_buffer_pos;
     int sd_read_block_nr;
     int errorRate;
+    FILE* image;
+    uint32_t blockReads;
 };
 
 #endif//SDCARD_SIM_H
@@ -2,6 +2,9 @@
 #include <string.h>
 
 #include "serial.h"
+#include "../../Marlin/binary_gcode.h"
+
+extern void USART0_RX_vect();
 
 serialSim::serialSim()
 {
@@ -13,6 +16,11 @@ serialSim::serialSim()
     recvLine = 0;
     recvPos = 0;
     memset(recvBuffer, '\0', sizeof(recvBuffer));
+
+    inputFile = NULL;
+    lineNr = 0;
+    nextLineNr = 1;
+    waitForOk = false;
 }
 
 serialSim::~serialSim()
@@ -30,6 +38,12 @@ void serialSim::UART_UDR0_callback(uint8_t oldValue, uint8_t& newValue)
     recvPos++;
     if (recvPos == 80 || newValue == '\n')
     {
+        if (strncmp(recvBuffer[recvLine], "ok", 2) == 0)
+            waitForOk = false;
+#ifdef SIM_HEADLESS
+        else
+            fwrite(recvBuffer[recvLine], recvPos, 1, stdout);
+#endif
         recvPos = 0;
         recvLine++;
         if (recvLine == SERIAL_LINE_COUNT)
@@ -42,6 +56,67 @@ void serialSim::UART_UDR0_callback(uint8_t oldValue, uint8_t& newValue)
     }
 }
 
+void serialSim::setInputFile(const char* filename)
+{
+    inputFile = fopen(filename, "rb");
+    if (inputFile == NULL)
+        printf("Failed to open: %s\n", filename);
+}
+
+void serialSim::sendByte(uint8_t c)
+{
+    UDR0.forceValue(c);
+    USART0_RX_vect();
+}
+
+void serialSim::tick()
+{
+    if (inputFile == NULL || waitForOk || !(UCSR0B & _BV(RXCIE0)))
+        return;
+
+    char line[128];
+    int next;
+    while((next = fgetc(inputFile)) != EOF)
+    {
+        if (next & BGCODE_MARKER)
+        {
+            //A binary record, sent as it is
+            uint8_t record[BGCODE_MAX_LENGTH];
+            uint8_t length = 0;
+            record[length++] = next;
+            while(!bgcode_length(record, length) && length < BGCODE_MAX_LENGTH && (next = fgetc(inputFile)) != EOF)
+                record[length++] = next;
+            for(uint8_t n=0; n<length; n++)
+                sendByte(record[n]);
+            waitForOk = true;
+            return;
+        }
+        ungetc(next, inputFile);
+        if (!fgets(line, sizeof(line), inputFile))
+            break;
+
+        lineNr = nextLineNr;
+        if (strchr(line, '\n'))
+            nextLineNr++;
+        //Strip comments and whitespace, the firmware does not acknowledge empty lines.
+        char* end = strchr(line, ';');
+        if (end == NULL)
+            end = line + strlen(line);
+        while(end > line && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '\n'))
+            end--;
+        if (end == line)
+            continue;
+
+        for(char* c = line; c < end; c++)
+            sendByte(*c);
+        sendByte('\n');
+        waitForOk = true;
+        return;
+    }
+    fclose(inputFile);
+    inputFile = NULL;
+}
+
 void serialSim::draw(int x, int y)
 {
     for(unsigned int n=0; n<SERIAL_LINE_COUNT;n++)
@@ -1,6 +1,7 @@
 #ifndef SERIAL_SIM_H
 #define SERIAL_SIM_H
 
+#include <stdio.h>
 #include "base.h"
 
 #define SERIAL_LINE_COUNT 30
@@ -10,12 +11,22 @@ public:
     serialSim();
     virtual ~serialSim();
     
+    virtual void tick();
     virtual void draw(int x, int y);
 
+    //Stream a g-code file into the firmware like a host would, one line or binary record per "ok".
+    void setInputFile(const char* filename);
+    bool inputFinished() { return inputFile == NULL && !waitForOk; }
+    int getLineNr() { return lineNr; }//Line number in the input file of the last line that was sent.
 private:
     int recvLine, recvPos;
     char recvBuffer[SERIAL_LINE_COUNT][80];
+
+    FILE* inputFile;
+    int lineNr, nextLineNr;
+    bool waitForOk;
     
+    void sendByte(uint8_t c);
     void UART_UCSR0A_callback(uint8_t oldValue, uint8_t& newValue);
     void UART_UDR0_callback(uint8_t oldValue, uint8_t& newValue);
 };
@@ -8,6 +8,8 @@ stepperSim::stepperSim(arduinoIOSim* arduinoIO, int enablePinNr, int stepPinNr,
     this->stepValue = 0;
     this->minEndstopPin = -1;
     this->maxEndstopPin = -1;
+    this->trace = NULL;
+    this->traceAxis = 0;
 
     this->invertDir = invertDir;
     this->enablePin = enablePinNr;
@@ -26,20 +28,38 @@ void stepperSim::stepPinUpdate(int pinNr, bool high)
         return;
     if (readOutput(enablePin))
         return;
+    int oldStepValue = stepValue;
     if (readOutput(dirPin) == invertDir)
         stepValue --;
     else
         stepValue ++;
-    if (minStepValue == -1)
-        return;
-    if (stepValue < minStepValue)
-        stepValue = minStepValue;
-    if (stepValue > maxStepValue)
-        stepValue = maxStepValue;
-    if (minEndstopPin > -1)
-        writeInput(minEndstopPin, stepValue != minStepValue);
-    if (maxEndstopPin > -1)
-        writeInput(maxEndstopPin, stepValue != maxStepValue);
+    if (minStepValue != -1)
+    {
+        if (stepValue < minStepValue)
+            stepValue = minStepValue;
+        if (stepValue > maxStepValue)
+            stepValue = maxStepValue;
+        if (minEndstopPin > -1)
+            writeInput(minEndstopPin, stepValue != minStepValue);
+        if (maxEndstopPin > -1)
+            writeInput(maxEndstopPin, stepValue != maxStepValue);
+    }
+    //Steps against an endstop do not move the axis, so they are not traced.
+    if (trace && stepValue != oldStepValue)
+        trace->write(STEP_TRACE_STEP, traceAxis, stepValue - oldStepValue);
+}
+
+void stepperSim::dirPinUpdate(int pinNr, bool high)
+{
+    trace->write(STEP_TRACE_DIRECTION, traceAxis, high != invertDir ? 1 : -1);
+}
+
+void stepperSim::setTrace(arduinoIOSim* arduinoIO, stepTrace* trace, int axis)
+{
+    this->trace = trace;
+    this->traceAxis = axis;
+    trace->header.startPosition[axis] = stepValue;
+    arduinoIO->registerPortCallback(dirPin, DELEGATE(ioDelegate, stepperSim, *this, dirPinUpdate));
 }
 
 void stepperSim::setEndstops(int minEndstopPinNr, int maxEndstopPinNr)
@@ -3,6 +3,7 @@
 
 #include "base.h"
 #include "arduinoIO.h"
+#include "steptrace.h"
 
 class stepperSim : public simBaseComponent
 {
@@ -13,6 +14,8 @@ private:
     bool invertDir;
     int enablePin, stepPin, dirPin;
     int minEndstopPin, maxEndstopPin;
+    stepTrace* trace;
+    int traceAxis;
 public:
     stepperSim(arduinoIOSim* arduinoIO, int enablePinNr, int stepPinNr, int dirPinNr, bool invertDir);
     virtual ~stepperSim();
@@ -21,9 +24,11 @@ public:
     
     void setRange(int minValue, int maxValue) { minStepValue = minValue; maxStepValue = maxValue; stepValue = (maxValue + minValue) / 2; }
     void setEndstops(int minEndstopPinNr, int maxEndstopPinNr);
+    void setTrace(arduinoIOSim* arduinoIO, stepTrace* trace, int axis);
     int getPosition() { return stepValue; }
 private:
     void stepPinUpdate(int pinNr, bool high);
+    void dirPinUpdate(int pinNr, bool high);
 };
 
 #endif//STEPPER_SIM_H
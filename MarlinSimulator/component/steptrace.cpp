@@ -0,0 +1,117 @@
+#include <avr/io.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "steptrace.h"
+
+#define STEP_TRACE_INITIAL_RECORDS (1024 * 1024)
+
+stepTrace::stepTrace(const char* filename)
+{
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "STRC", 4);
+    header.version = STEP_TRACE_VERSION;
+    header.headerSize = sizeof(header);
+    header.cpuFrequency = F_CPU;
+
+    records = NULL;
+    recordCount = 0;
+    recordCapacity = 0;
+    clockHigh = 0;
+#ifdef _WIN32
+    file = fopen(filename, "wb");
+    if (file)
+    {
+        fwrite(&header, sizeof(header), 1, file);
+        records = buffer;
+        recordCapacity = sizeof(buffer) / sizeof(buffer[0]);
+    }
+#else
+    map = NULL;
+    mapSize = 0;
+    fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0)
+        grow();
+#endif
+    if (records == NULL)
+        printf("Failed to open step trace: %s\n", filename);
+}
+
+stepTrace::~stepTrace()
+{
+    close();
+}
+
+#ifndef _WIN32
+void stepTrace::grow()
+{
+    uint32_t newCapacity = recordCapacity > 0 ? recordCapacity * 2 : STEP_TRACE_INITIAL_RECORDS;
+    size_t newSize = sizeof(header) + size_t(newCapacity) * sizeof(stepTraceRecord);
+
+    if (map)
+        munmap(map, mapSize);
+    records = NULL;
+    map = NULL;
+    if (ftruncate(fd, newSize) != 0)
+        return;
+    void* ptr = mmap(NULL, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED)
+        return;
+    map = (uint8_t*)ptr;
+    mapSize = newSize;
+    recordCapacity = newCapacity;
+    records = (stepTraceRecord*)(map + sizeof(header));
+}
+#endif
+
+void stepTrace::write(uint8_t type, uint8_t axis, int32_t value)
+{
+    if (records == NULL)
+        return;
+    if ((sim_cycles >> 32) != clockHigh)
+    {
+        clockHigh = sim_cycles >> 32;
+        write(STEP_TRACE_CLOCK, 0, clockHigh);
+    }
+    if (recordCount == recordCapacity)
+    {
+#ifdef _WIN32
+        fwrite(buffer, sizeof(stepTraceRecord), recordCount, file);
+        header.recordCount += recordCount;
+        recordCount = 0;
+#else
+        grow();
+        if (records == NULL)
+            return;
+#endif
+    }
+    stepTraceRecord& record = records[recordCount++];
+    record.cycle = sim_cycles;
+    record.data = type | (axis << 4) | (uint32_t(value) << 8);
+}
+
+void stepTrace::close()
+{
+    if (records == NULL)
+        return;
+#ifdef _WIN32
+    fwrite(buffer, sizeof(stepTraceRecord), recordCount, file);
+    header.recordCount += recordCount;
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, file);
+    fclose(file);
+#else
+    header.recordCount = recordCount;
+    memcpy(map, &header, sizeof(header));
+    munmap(map, mapSize);
+    if (ftruncate(fd, sizeof(header) + size_t(recordCount) * sizeof(stepTraceRecord)) != 0)
+        printf("Failed to truncate step trace\n");
+    ::close(fd);
+    map = NULL;
+#endif
+    records = NULL;
+}
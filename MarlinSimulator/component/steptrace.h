@@ -0,0 +1,72 @@
+#ifndef STEP_TRACE_H
+#define STEP_TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define STEP_TRACE_AXES 5//X, Y, Z, E0, E1
+#define STEP_TRACE_VERSION 1
+
+//Record types
+#define STEP_TRACE_STEP      1//Value is 1 for a step in positive direction, -1 for a step in negative direction.
+#define STEP_TRACE_DIRECTION 2//Value is the new direction, 1 for positive, -1 for negative.
+#define STEP_TRACE_LINE      3//Value is the line number of the g-code line that was just sent to the firmware.
+#define STEP_TRACE_POSITION  4//Value is the firmware step position of the axis. Only written when the planner is empty before a line is sent.
+#define STEP_TRACE_CLOCK     5//Value is bit 32 and up of the cpu cycle count for all following records.
+
+struct stepTraceRecord
+{
+    uint32_t cycle;//Low 32 bits of sim_cycles
+    int32_t data;//Record type in bit 0-3, axis in bit 4-7, signed value in bit 8-31
+};
+
+struct stepTraceHeader
+{
+    char magic[4];//"STRC"
+    uint16_t version;
+    uint16_t headerSize;//Records start at this file offset
+    uint32_t cpuFrequency;
+    uint32_t recordCount;
+    int32_t startPosition[STEP_TRACE_AXES];//Physical position in steps when the trace started
+    float stepsPerUnit[STEP_TRACE_AXES];
+
+    //Planner settings of the run, so traces of different firmware configurations can be compared.
+    uint32_t blockBufferSize;
+    float maxXYJerk;
+    float maxZJerk;
+    float maxEJerk;
+    float minimumPlannerSpeed;
+};
+
+//Binary log of all step and direction edges of the simulated steppers with their cpu cycle timestamp.
+// The file is memory mapped and grows in chunks, so recording every step costs next to nothing.
+// MarlinSimulator/steptrace.py reconstructs the motion from it and compares it with the g-code.
+class stepTrace
+{
+public:
+    stepTraceHeader header;//Filled by the simulation, written to the file on close
+
+    stepTrace(const char* filename);
+    ~stepTrace();
+
+    bool isOpen() { return records != NULL; }
+    void write(uint8_t type, uint8_t axis, int32_t value);
+    void close();
+private:
+    stepTraceRecord* records;
+    uint32_t recordCount;
+    uint32_t recordCapacity;
+    uint32_t clockHigh;
+#ifdef _WIN32
+    FILE* file;
+    stepTraceRecord buffer[1024];
+#else
+    int fd;
+    uint8_t* map;
+    size_t mapSize;
+
+    void grow();
+#endif
+};
+
+#endif//STEP_TRACE_H
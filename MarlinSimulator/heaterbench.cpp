@@ -0,0 +1,319 @@
+#ifdef HEATER_BENCHMARK
+#include <avr/io.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "heaterbench.h"
+#include "component/heater.h"
+#include "../Marlin/Marlin.h"
+#include "../Marlin/temperature.h"
+#include "../Marlin/preferences.h"
+
+//Simulated time of the step response
+#define STEP_RESPONSE_SECONDS 600
+#define STEP_RESPONSE_SECONDS_BED 1800
+//The temperature is within this band around the target once it settled
+#define SETTLE_BAND 1.0
+//The end of the step response that the steady state is taken from
+#define STEADY_SECONDS 60
+
+static uint8_t autotuneState;
+static float autotuneKp, autotuneKi, autotuneKd;
+
+static bool benchAutotuneCallback(uint8_t state, uint8_t cycle, float kp, float ki, float kd)
+{
+    if (state)
+    {
+        autotuneState = state;
+        autotuneKp = kp;
+        autotuneKi = ki;
+        autotuneKd = kd;
+    }
+    return true;
+}
+
+static void setTarget(int heaterNr, float temperature)
+{
+#if TEMP_SENSOR_BED != 0
+    if (heaterNr < 0)
+    {
+        setTargetBed(temperature);
+        return;
+    }
+#endif
+    target_temperature[heaterNr] = temperature;
+}
+
+static float readTemperature(int heaterNr)
+{
+#if TEMP_SENSOR_BED != 0
+    if (heaterNr < 0)
+        return degBed();
+#endif
+    return degHotend(heaterNr);
+}
+
+static void setGains(int heaterNr, float kp, float ki, float kd)
+{
+#if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0)
+    if (heaterNr < 0)
+    {
+        bedKp = kp;
+        bedKi = scalePID_i(ki);
+        bedKd = scalePID_d(kd);
+    }
+#endif
+#if EXTRUDERS > 1
+    if (heaterNr == 1)
+    {
+        pid2[0] = kp;
+        pid2[1] = scalePID_i(ki);
+        pid2[2] = scalePID_d(kd);
+    }
+#endif
+    if (heaterNr == 0)
+    {
+        Kp = kp;
+        Ki = scalePID_i(ki);
+        Kd = scalePID_d(kd);
+    }
+    updatePID();
+}
+
+//Let the firmware run with manage_heater() for the given simulated time, the heater model is updated every ms meanwhile.
+static void runHeater(unsigned long ms)
+{
+    unsigned long start = millis();
+    while(millis() - start < ms)
+        manage_heater();
+}
+
+//Temperature that updateTemperaturesFromRawValues() never gives, to see if manage_heater() took a new sample.
+#define NO_SAMPLE -1000.0
+
+//One manage_heater() call, returns true when it ran the PID loops on a new temperature sample.
+static bool manageHeaterSample(int heaterNr)
+{
+    float* input = &current_temperature[heaterNr < 0 ? 0 : heaterNr];
+#if TEMP_SENSOR_BED != 0
+    if (heaterNr < 0)
+        input = &current_temperature_bed;
+#endif
+    float last = *input;
+    *input = NO_SAMPLE;
+    manage_heater();
+    if (*input != NO_SAMPLE)
+        return true;
+    *input = last;
+    return false;
+}
+
+//The floating point PID of manage_heater() without PID_FIXED_POINT, with the gains the firmware has. It runs next to the
+// firmware on the same samples, or drives the heater model itself. There are no moves, so the feed forward term is left out.
+struct floatPid
+{
+    int heaterNr;
+    float iState;
+    float dState;
+    float dTerm;
+    bool reset;
+
+    floatPid(int heaterNr, float input) : heaterNr(heaterNr), iState(0), dState(input), dTerm(0), reset(true) {}
+
+    //Duty cycle (0..127, like soft_pwm) for a new temperature sample.
+    int update(float input, float target)
+    {
+        float kp = 0, ki = 0, kd = 0;
+        float maxOutput = PID_MAX;
+#if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0)
+        if (heaterNr < 0)
+        {
+            kp = bedKp; ki = bedKi; kd = bedKd;
+            maxOutput = MAX_BED_POWER;
+        }
+#endif
+#if EXTRUDERS > 1
+        if (heaterNr == 1)
+        {
+            kp = pid2[0]; ki = pid2[1]; kd = pid2[2];
+        }
+#endif
+        if (heaterNr == 0)
+        {
+            kp = Kp; ki = Ki; kd = Kd;
+        }
+
+        float error = target - input;
+        float output;
+        if (heaterNr >= 0 && error > PID_FUNCTIONAL_RANGE)
+        {
+            output = BANG_MAX;
+            reset = true;
+        }
+        else if (heaterNr >= 0 && (error < -PID_FUNCTIONAL_RANGE || target == 0))
+        {
+            output = 0;
+            reset = true;
+        }
+        else
+        {
+            if (reset)
+            {
+                iState = 0;
+                reset = false;
+            }
+            iState = constrain(iState + error, 0, PID_INTEGRAL_DRIVE_MAX / ki);
+            dTerm = kd * (input - dState) * (1.0 - K1) + K1 * dTerm;
+            output = constrain(kp * error + ki * iState - dTerm, 0, maxOutput);
+        }
+        dState = input;
+        return int(output) >> 1;
+    }
+};
+
+//Duty cycles of the firmware and the float PID compared on the same samples.
+struct pidCompare
+{
+    unsigned long samples;
+    unsigned long equal;
+    int maxDifference;
+};
+
+//Step response from a cold heater to the given temperature. The firmware PID controls the heater, or with drive the
+// float PID does while the firmware has no target. With compare the float PID runs next to the firmware.
+static void stepResponse(heaterSim* heater, int heaterNr, float temperature, bool drive, pidCompare* compare)
+{
+    heaterModel& model = heater->getModel();
+    setTarget(heaterNr, 0);
+    heater->reset(model.ambient);
+    runHeater(1000);
+    float start = readTemperature(heaterNr);
+    float low = start + (temperature - start) * 0.1;
+    float high = start + (temperature - start) * 0.9;
+    long duration = (heaterNr < 0 ? STEP_RESPONSE_SECONDS_BED : STEP_RESPONSE_SECONDS) * 1000L;
+    long riseStart = -1, riseEnd = -1, settled = 0;
+    float peak = start, steadyMin = 10000, steadyMax = -10000, steadySum = 0;
+    unsigned long steadyCount = 0;
+    floatPid pid(heaterNr, start);
+
+    if (drive)
+        heater->setDutyCycle(0);
+    else
+        setTarget(heaterNr, temperature);
+    unsigned long stepStart = millis();
+    for(long t = 0; t < duration; t += 100)
+    {
+        unsigned long sliceStart = millis();
+        while(millis() - sliceStart < 100)
+        {
+            if (!manageHeaterSample(heaterNr) || (!drive && compare == NULL))
+                continue;
+            int duty = pid.update(readTemperature(heaterNr), temperature);
+            if (drive)
+            {
+                heater->setDutyCycle(duty);
+                continue;
+            }
+            int difference = abs(duty - getHeaterPower(heaterNr));
+            compare->samples++;
+            if (difference == 0)
+                compare->equal++;
+            if (difference > compare->maxDifference)
+                compare->maxDifference = difference;
+        }
+        float input = readTemperature(heaterNr);
+        if (riseStart < 0 && input >= low)
+            riseStart = t;
+        if (riseEnd < 0 && input >= high)
+            riseEnd = t;
+        if (input > peak)
+            peak = input;
+        if (input < temperature - SETTLE_BAND || input > temperature + SETTLE_BAND)
+            settled = t + 100;
+        if (t >= duration - STEADY_SECONDS * 1000L)
+        {
+            if (input < steadyMin) steadyMin = input;
+            if (input > steadyMax) steadyMax = input;
+            steadySum += input;
+            steadyCount++;
+        }
+    }
+    setTarget(heaterNr, 0);
+    heater->setDutyCycle(-1);
+
+    printf("Step response %.1fC to %.1fC in %lus", start, temperature, (millis() - stepStart) / 1000);
+    if (drive)
+        printf(" (float PID)");
+#ifdef PID_FIXED_POINT
+    else if (compare)
+        printf(" (fixed point PID)");
+#endif
+    printf(":");
+    if (riseEnd < 0)
+        printf(" does not reach %.1fC\n", high);
+    else
+        printf(" rise time (10-90%%) %.1fs, overshoot %.2fC\n", (riseEnd - riseStart) / 1000.0, peak - temperature);
+    if (settled >= duration)
+        printf("  not within %.1fC at the end\n", SETTLE_BAND);
+    else
+        printf("  within %.1fC after %.1fs\n", SETTLE_BAND, settled / 1000.0);
+    printf("  last %ds: mean %.2fC, min %.2fC, max %.2fC\n", STEADY_SECONDS, steadySum / steadyCount, steadyMin, steadyMax);
+}
+
+int heater_bench_run(heaterSim* heater, int heaterNr, float temperature, int cycles, bool compare)
+{
+    if (heater == NULL || heaterNr >= EXTRUDERS || heaterNr < -1)
+    {
+        printf("No heater %d\n", heaterNr);
+        return 1;
+    }
+#if defined(PIDTEMPBED) && (TEMP_SENSOR_BED != 0)
+    if (compare && heaterNr < 0 && !pidTempBed())
+    {
+        //The bed is bang-bang unless its PID is switched on in the preferences menu.
+        control_flags |= FLAG_PID_BED;
+        printf("Bed PID switched on for the comparison\n");
+    }
+#else
+    if (compare && heaterNr < 0)
+    {
+        printf("The bed has no PID\n");
+        return 1;
+    }
+#endif
+    heaterModel& model = heater->getModel();
+    printf("Heater model: %.1fW, %.2fJ/K, loss %.4fW/K, fan %.4fW/K, sensor lag %.2fs, dead time %.2fs, ambient %.1fC\n",
+        model.power, model.heatCapacity, model.loss, model.fanLoss, model.sensorLag, model.deadTime, model.ambient);
+    printf("Steady state at full power: %.1fC\n", model.ambient + model.power / model.loss);
+
+    clock_t wallClockStart = clock();
+    unsigned long simulatedStart = millis();
+    if (cycles > 0)
+    {
+        heater->reset(model.ambient);
+        runHeater(1000);
+
+        autotuneState = 0;
+        PID_autotune(temperature, heaterNr, cycles, benchAutotuneCallback);
+        if (autotuneState != AUTOTUNE_OK)
+        {
+            printf("PID autotune failed: %02x\n", autotuneState);
+            return 1;
+        }
+        printf("PID autotune: Kp %.2f Ki %.3f Kd %.2f\n", autotuneKp, autotuneKi, autotuneKd);
+        setGains(heaterNr, autotuneKp, autotuneKi, autotuneKd);
+    }
+
+    pidCompare result = { 0, 0, 0 };
+    stepResponse(heater, heaterNr, temperature, false, compare ? &result : NULL);
+    if (compare)
+    {
+        stepResponse(heater, heaterNr, temperature, true, NULL);
+        printf("Float PID on the firmware samples: same duty cycle in %lu of %lu samples, max difference %d\n",
+            result.equal, result.samples, result.maxDifference);
+    }
+    printf("Simulated %lus in %.2fs wall clock time\n", (millis() - simulatedStart) / 1000, float(clock() - wallClockStart) / CLOCKS_PER_SEC);
+    return 0;
+}
+#endif//HEATER_BENCHMARK
@@ -0,0 +1,14 @@
+#ifndef HEATER_BENCH_H
+#define HEATER_BENCH_H
+
+class heaterSim;
+
+//Tune a heater against its thermal model (see heaterModel) faster than real time: PID_autotune() runs at the given
+// temperature, then the gains it found are used for a step response from the ambient to that temperature.
+// With 0 cycles only the step response runs, with the gains the firmware has.
+// With compare the floating point PID that the firmware has without PID_FIXED_POINT runs next to the firmware PID on
+// the same samples, and then controls a second step response by itself, to see what the fixed point PID changes.
+// heaterNr is the heater of M303: 0, 1 or -1 for the bed. Returns the process exit code.
+int heater_bench_run(heaterSim* heater, int heaterNr, float temperature, int cycles, bool compare);
+
+#endif//HEATER_BENCH_H
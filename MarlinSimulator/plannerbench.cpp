@@ -0,0 +1,331 @@
+#ifdef PLANNER_BENCHMARK
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+#include <avr/io.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#include "plannerbench.h"
+#include "../Marlin/planner.h"
+
+//Approximate cpu cycles of the avr-libc floating point routines, used to estimate the planner math on the AVR.
+// Register writes (critical sections, stepper enables) are not modelled here, those are counted by the simulation.
+#define AVR_CYCLES_FADD  110//Add or subtract
+#define AVR_CYCLES_FMUL  150
+#define AVR_CYCLES_FDIV  490
+#define AVR_CYCLES_FSQRT 500
+#define AVR_CYCLES_FCMP   50
+#define AVR_CYCLES_LTOF   80//long to float
+#define AVR_CYCLES_FTOL   90//float to long
+#define AVR_CYCLES_FCEIL 100
+#define AVR_CYCLES_LMUL   60//long multiply
+
+//Cost of the counted operations, from the float operations in the source of each of them.
+static const unsigned long operationCycles[PLANNER_BENCH_OPERATIONS] = {
+    //Block: loop and pointer handling of a pass plus the speed compare of the kernel
+    40 + AVR_CYCLES_FCMP,
+    //Junction: sqrt(v*v - 2*a*d) and the min() with the maximum speed
+    3 * AVR_CYCLES_FMUL + AVR_CYCLES_FADD + AVR_CYCLES_FSQRT + AVR_CYCLES_FCMP,
+    //Trapezoid: the two speed factors of the caller, the initial/final rate and two acceleration distances
+    2 * AVR_CYCLES_FDIV + 2 * (AVR_CYCLES_LTOF + AVR_CYCLES_FMUL + AVR_CYCLES_FCEIL + AVR_CYCLES_FTOL)
+#ifdef FAST_TRAPEZOID
+        + 3 * AVR_CYCLES_LMUL + AVR_CYCLES_LTOF + AVR_CYCLES_FDIV + 2 * (AVR_CYCLES_LTOF + AVR_CYCLES_FMUL + AVR_CYCLES_FCEIL + AVR_CYCLES_FTOL),
+#else
+        + 2 * (3 * AVR_CYCLES_LTOF + 3 * AVR_CYCLES_FMUL + AVR_CYCLES_FADD + AVR_CYCLES_FDIV + AVR_CYCLES_FCEIL + AVR_CYCLES_FTOL),
+#endif
+    //Intersection distance of a trapezoid without plateau
+#ifdef FAST_TRAPEZOID
+    2 * AVR_CYCLES_LTOF + AVR_CYCLES_FMUL + AVR_CYCLES_FADD + AVR_CYCLES_FMUL + AVR_CYCLES_FCEIL + AVR_CYCLES_FTOL,
+#else
+    4 * AVR_CYCLES_LTOF + 5 * AVR_CYCLES_FMUL + 2 * AVR_CYCLES_FADD + AVR_CYCLES_FDIV + AVR_CYCLES_FCEIL + AVR_CYCLES_FTOL,
+#endif
+};
+//Float operations of plan_buffer_line() itself, without the junction speed and trapezoid of the new block.
+#define AVR_CYCLES_PLAN_BUFFER_LINE (24 * AVR_CYCLES_FMUL + 12 * AVR_CYCLES_FDIV + 7 * AVR_CYCLES_FADD + 2 * AVR_CYCLES_FSQRT \
+    + 16 * AVR_CYCLES_FCMP + 21 * AVR_CYCLES_LTOF + 7 * AVR_CYCLES_FTOL + 2 * AVR_CYCLES_FCEIL)
+
+static const char* sectionName[PLANNER_BENCH_SECTIONS] = {
+    "", "plan_buffer_line", "reverse pass", "forward pass", "trapezoids"
+};
+
+unsigned long planner_bench_count[PLANNER_BENCH_SECTIONS][PLANNER_BENCH_OPERATIONS];
+uint8_t planner_bench_current;
+static unsigned long sectionCalls[PLANNER_BENCH_SECTIONS];
+static uint64_t sectionHostTime[PLANNER_BENCH_SECTIONS];
+static uint64_t sectionCycles[PLANNER_BENCH_SECTIONS];
+static uint64_t sectionStartHostTime;
+static uint64_t sectionStartCycles;
+
+static FILE* recordFile;
+
+static uint64_t hostNanoseconds()
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return uint64_t(counter.QuadPart / frequency.QuadPart) * 1000000000ULL + uint64_t(counter.QuadPart % frequency.QuadPart) * 1000000000ULL / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+void planner_bench_section(uint8_t section)
+{
+    uint64_t now = hostNanoseconds();
+    if (planner_bench_current != PLANNER_BENCH_NONE)
+    {
+        sectionHostTime[planner_bench_current] += now - sectionStartHostTime;
+        sectionCycles[planner_bench_current] += sim_cycles - sectionStartCycles;
+    }
+    if (section != PLANNER_BENCH_NONE)
+        sectionCalls[section]++;
+    planner_bench_current = section;
+    sectionStartHostTime = now;
+    sectionStartCycles = sim_cycles;
+}
+
+static void writeRecord(uint8_t type, uint8_t extruder, float x, float y, float z, float e, float feed_rate)
+{
+    if (recordFile == NULL)
+        return;
+    plannerBenchRecord record;
+    memset(&record, 0, sizeof(record));
+    record.type = type;
+    record.extruder = extruder;
+    record.value[0] = x;
+    record.value[1] = y;
+    record.value[2] = z;
+    record.value[3] = e;
+    record.value[4] = feed_rate;
+    fwrite(&record, sizeof(record), 1, recordFile);
+}
+
+void planner_bench_line(const float &x, const float &y, const float &z, const float &e, float feed_rate, uint8_t extruder)
+{
+    writeRecord(PLANNER_BENCH_RECORD_LINE, extruder, x, y, z, e * volume_to_filament_length[extruder], feed_rate);
+    planner_bench_section(PLANNER_BENCH_LINE);
+}
+
+void planner_bench_set_position(const float &x, const float &y, const float &z, const float &e, uint8_t extruder)
+{
+    writeRecord(PLANNER_BENCH_RECORD_SET_POSITION, extruder, x, y, z, e * volume_to_filament_length[extruder], 0);
+}
+
+void planner_bench_set_e_position(const float &e, uint8_t extruder)
+{
+    writeRecord(PLANNER_BENCH_RECORD_SET_E_POSITION, extruder, 0, 0, 0, e * volume_to_filament_length[extruder], 0);
+}
+
+bool planner_bench_record(const char* filename)
+{
+    recordFile = fopen(filename, "wb");
+    if (recordFile == NULL)
+    {
+        printf("Failed to open segment file: %s\n", filename);
+        return false;
+    }
+    plannerBenchHeader header;
+    memcpy(header.magic, "PSEG", 4);
+    header.version = PLANNER_BENCH_VERSION;
+    header.recordSize = sizeof(plannerBenchRecord);
+    fwrite(&header, sizeof(header), 1, recordFile);
+    return true;
+}
+
+void planner_bench_record_close()
+{
+    if (recordFile)
+        fclose(recordFile);
+    recordFile = NULL;
+}
+
+//The benchmark takes the place of the stepper: the block it executes is marked busy, and it is thrown away
+// as soon as the planner needs the room. So the planner always works on a full buffer, its worst case.
+static uint32_t planChecksum;
+static unsigned long plannedBlocks;
+
+static void discardBlock()
+{
+    block_t* block = &block_buffer[block_buffer_tail];
+    uint32_t values[] = {block->step_event_count, block->accelerate_until, block->decelerate_after,
+        block->initial_rate, block->final_rate, block->nominal_rate, uint32_t(block->acceleration_rate)};
+    for(unsigned int n=0; n<sizeof(values)/sizeof(values[0]); n++)
+        planChecksum = planChecksum * 31 + values[n];
+    plannedBlocks++;
+    plan_discard_current_block();
+}
+
+static void drainBlocks()
+{
+    while(blocks_queued())
+        discardBlock();
+}
+
+int planner_bench_run(const char* filename, unsigned int repeat)
+{
+    FILE* f = fopen(filename, "rb");
+    if (f == NULL)
+    {
+        printf("Failed to open segment file: %s\n", filename);
+        return 1;
+    }
+    plannerBenchHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 || memcmp(header.magic, "PSEG", 4) != 0
+        || header.version != PLANNER_BENCH_VERSION || header.recordSize != sizeof(plannerBenchRecord))
+    {
+        printf("Not a segment file: %s\n", filename);
+        fclose(f);
+        return 1;
+    }
+    std::vector<plannerBenchRecord> records;
+    plannerBenchRecord record;
+    while(fread(&record, sizeof(record), 1, f) == 1)
+        records.push_back(record);
+    fclose(f);
+
+    //No interrupts while the benchmark runs, so the stepper does not take blocks and only the planner is measured.
+    cli();
+#ifdef PREVENT_DANGEROUS_EXTRUDE
+    set_extrude_min_temp(0);
+#endif
+    memset(planner_bench_count, 0, sizeof(planner_bench_count));
+    memset(sectionCalls, 0, sizeof(sectionCalls));
+    memset(sectionHostTime, 0, sizeof(sectionHostTime));
+    memset(sectionCycles, 0, sizeof(sectionCycles));
+    planner_bench_current = PLANNER_BENCH_NONE;
+    planChecksum = 0;
+    plannedBlocks = 0;
+
+    unsigned long segments = 0;
+    uint64_t start = hostNanoseconds();
+    for(unsigned int r=0; r<repeat; r++)
+    {
+        plan_init();
+        for(unsigned int n=0; n<records.size(); n++)
+        {
+            const plannerBenchRecord& rec = records[n];
+            switch(rec.type)
+            {
+            case PLANNER_BENCH_RECORD_LINE:
+                if (movesplanned() == BLOCK_BUFFER_SIZE - 1)
+                    discardBlock();
+                plan_buffer_line(rec.value[0], rec.value[1], rec.value[2], rec.value[3], rec.value[4], rec.extruder);
+                planner_bench_section(PLANNER_BENCH_NONE);
+                plan_get_current_block();
+                segments++;
+                break;
+            case PLANNER_BENCH_RECORD_SET_POSITION:
+                //The firmware only sets the position after the moves are finished.
+                drainBlocks();
+                plan_set_position(rec.value[0], rec.value[1], rec.value[2], rec.value[3], rec.extruder, false);
+                break;
+            case PLANNER_BENCH_RECORD_SET_E_POSITION:
+                plan_set_e_position(rec.value[3], rec.extruder, false);
+                break;
+            }
+        }
+        drainBlocks();
+    }
+    uint64_t hostTime = hostNanoseconds() - start;
+    if (segments == 0)
+    {
+        printf("No segments in: %s\n", filename);
+        return 1;
+    }
+
+    printf("Planner benchmark: %lu segments in %u runs, %lu blocks planned, block buffer %d\n", segments, repeat, plannedBlocks, BLOCK_BUFFER_SIZE);
+    printf("Host: %.0f segments/s, %.0fns per segment\n", segments * 1e9 / hostTime, double(hostTime) / segments);
+    printf("Section              calls  host ns/call  AVR cycles/call (estimated)\n");
+    uint64_t totalHostTime = 0;
+    uint64_t totalCycles = 0;
+    for(unsigned int s=PLANNER_BENCH_LINE; s<PLANNER_BENCH_SECTIONS; s++)
+    {
+        uint64_t cycles = sectionCycles[s];
+        for(unsigned int op=0; op<PLANNER_BENCH_OPERATIONS; op++)
+            cycles += uint64_t(planner_bench_count[s][op]) * operationCycles[op];
+        if (s == PLANNER_BENCH_LINE)
+            cycles += uint64_t(sectionCalls[s]) * AVR_CYCLES_PLAN_BUFFER_LINE;
+        totalHostTime += sectionHostTime[s];
+        totalCycles += cycles;
+        unsigned long calls = sectionCalls[s] > 0 ? sectionCalls[s] : 1;
+        printf("%-16s %9lu %13.1f %16.0f\n", sectionName[s], sectionCalls[s], double(sectionHostTime[s]) / calls, double(cycles) / calls);
+    }
+    double cyclesPerSegment = double(totalCycles) / segments;
+    printf("Per segment: host %.0fns in the planner, AVR %.0f cycles estimated (%.0fus, %.0f segments/s at %dMHz)\n",
+        double(totalHostTime) / segments, cyclesPerSegment, cyclesPerSegment * 1e6 / F_CPU, F_CPU / cyclesPerSegment, int(F_CPU / 1000000));
+    printf("Plan checksum: %08x\n", planChecksum);
+    return 0;
+}
+//Largest difference in steps between the FAST_TRAPEZOID integer math and the float math that is still fine:
+// the two round the same distance, only a distance at a whole step can end up on either side.
+#define TRAPEZOID_MAX_DIFFERENCE 1
+
+int planner_bench_trapezoids()
+{
+#ifndef FAST_TRAPEZOID
+    printf("FAST_TRAPEZOID is off, the trapezoids only use the float math\n");
+    return 0;
+#else
+    //Steps/s^2 of a slow extruder up to a fast axis, blocks from a single step to the 16 bit maximum, and the
+    // entry/exit rates as a factor of the nominal rate (limited to the minimal step rate, like the planner does).
+    static const float accelerations[] = { 500, 4000, 40000, 400000, 2000000 };
+    static const uint16_t stepCounts[] = { 1, 10, 100, 1000, 10000, 65535 };
+    static const float rateFactors[] = { 0.0, 0.1, 0.5, 0.9, 1.0 };
+    const int accelerationCount = sizeof(accelerations) / sizeof(accelerations[0]);
+    const int stepCountCount = sizeof(stepCounts) / sizeof(stepCounts[0]);
+    const int rateFactorCount = sizeof(rateFactors) / sizeof(rateFactors[0]);
+
+    unsigned long cases = 0, integerCases = 0, failures = 0;
+    int32_t maxAccelerateDifference = 0, maxDecelerateDifference = 0;
+    //Every rate up to 1023 steps/s, so all of the rates with a square beyond 16 bits are in, then 1% apart up to
+    // the 16 bit maximum, past the 46340 steps/s where FAST_TRAPEZOID goes back to the float math.
+    for(unsigned long nominalRate = 32; nominalRate <= 65535; nominalRate = nominalRate < 1024 ? nominalRate + 1 : nominalRate + nominalRate / 100)
+    {
+        for(int a=0; a<accelerationCount; a++)
+        for(int c=0; c<stepCountCount; c++)
+        for(int i=0; i<rateFactorCount; i++)
+        for(int f=0; f<rateFactorCount; f++)
+        {
+            unsigned long initialRate = max(ceil(nominalRate * rateFactors[i]), 120);
+            unsigned long finalRate = max(ceil(nominalRate * rateFactors[f]), 120);
+            bool integerMath = nominalRate <= 46340 && initialRate <= 46340 && finalRate <= 46340;
+            int32_t integerAccelerate, integerDecelerate, floatAccelerate, floatDecelerate;
+            planner_bench_trapezoid(stepCounts[c], nominalRate, initialRate, finalRate, accelerations[a], integerMath, integerAccelerate, integerDecelerate);
+            planner_bench_trapezoid(stepCounts[c], nominalRate, initialRate, finalRate, accelerations[a], false, floatAccelerate, floatDecelerate);
+
+            int32_t accelerateDifference = abs(integerAccelerate - floatAccelerate);
+            int32_t decelerateDifference = abs(integerDecelerate - floatDecelerate);
+            maxAccelerateDifference = max(maxAccelerateDifference, accelerateDifference);
+            maxDecelerateDifference = max(maxDecelerateDifference, decelerateDifference);
+            if (accelerateDifference > TRAPEZOID_MAX_DIFFERENCE || decelerateDifference > TRAPEZOID_MAX_DIFFERENCE)
+            {
+                if (failures < 10)
+                    printf("Rates %lu/%lu/%lu steps/s, %.0f steps/s^2, %u steps: accelerate_until %ld/%ld, decelerate_after %ld/%ld (integer/float)\n",
+                        initialRate, nominalRate, finalRate, accelerations[a], stepCounts[c],
+                        long(integerAccelerate), long(floatAccelerate), long(integerDecelerate), long(floatDecelerate));
+                failures++;
+            }
+            cases++;
+            if (integerMath)
+                integerCases++;
+        }
+    }
+    printf("Trapezoids: %lu cases, %lu with the integer math\n", cases, integerCases);
+    printf("Largest difference to the float math: accelerate_until %ld, decelerate_after %ld steps\n", long(maxAccelerateDifference), long(maxDecelerateDifference));
+    if (failures)
+    {
+        printf("%lu cases more than %d step apart\n", failures, TRAPEZOID_MAX_DIFFERENCE);
+        return 1;
+    }
+    return 0;
+#endif
+}
+#endif//PLANNER_BENCHMARK
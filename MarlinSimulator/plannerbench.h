@@ -0,0 +1,41 @@
+#ifndef PLANNER_BENCH_H
+#define PLANNER_BENCH_H
+
+#include <stdint.h>
+
+#define PLANNER_BENCH_VERSION 1
+
+//Record types of a segment file
+#define PLANNER_BENCH_RECORD_LINE           1//plan_buffer_line(), value is x, y, z, e, feedrate
+#define PLANNER_BENCH_RECORD_SET_POSITION   2//plan_set_position(), value is x, y, z, e
+#define PLANNER_BENCH_RECORD_SET_E_POSITION 3//plan_set_e_position(), value[3] is e
+
+struct plannerBenchHeader
+{
+    char magic[4];//"PSEG"
+    uint16_t version;
+    uint16_t recordSize;
+};
+
+struct plannerBenchRecord
+{
+    uint8_t type;
+    uint8_t extruder;
+    uint8_t reserved[2];
+    float value[5];//Arguments of the planner call, e already scaled to filament length
+};
+
+//Write every call into the planner of the running simulation to a segment file.
+bool planner_bench_record(const char* filename);
+void planner_bench_record_close();
+
+//Replay a segment file straight into the planner, as fast as possible with a full block buffer,
+// and report the time spent per planner section. Returns the process exit code.
+int planner_bench_run(const char* filename, unsigned int repeat);
+
+//Sweep of the rates, accelerations and block lengths the trapezoids are calculated for, checking that the
+// accelerate_until and decelerate_after of the FAST_TRAPEZOID integer math stay within a step of the float math.
+// Returns the process exit code.
+int planner_bench_trapezoids();
+
+#endif//PLANNER_BENCH_H
@@ -0,0 +1,99 @@
+#ifdef SDCARD_BENCHMARK
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+#include <avr/io.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "sdcardbench.h"
+#include "component/sdcard.h"
+#include "component/arduinoIO.h"
+#include "../Marlin/Marlin.h"
+#include "../Marlin/cardreader.h"
+
+static uint64_t hostNanoseconds()
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return uint64_t(counter.QuadPart / frequency.QuadPart) * 1000000000ULL + uint64_t(counter.QuadPart % frequency.QuadPart) * 1000000000ULL / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+//Checksum over all commands, so a change of the read path that alters what ends up in the command buffer shows up.
+static uint32_t commandChecksum;
+static unsigned long commandCount;
+static unsigned long commandBytes;
+
+static void benchCommand(const char* cmd)
+{
+    for(; *cmd; cmd++)
+    {
+        commandChecksum = commandChecksum * 31 + uint8_t(*cmd);
+        commandBytes++;
+    }
+    commandChecksum = commandChecksum * 31 + '\n';
+    commandCount++;
+}
+
+int sdcard_bench_run(sdcardSimulation* sdcard, const char* image, const char* filename, unsigned int repeat)
+{
+    if (!sdcard->openImage(image))
+        return 1;
+    //No interrupts while the benchmark runs, so only the card reading is counted in the simulated cycles.
+    cli();
+    writeInput(SDCARDDETECT, false);
+    card.initsd();
+    if (!card.cardOK())
+    {
+        printf("No FAT volume in image: %s\n", image);
+        return 1;
+    }
+
+    commandChecksum = 0;
+    commandCount = 0;
+    commandBytes = 0;
+
+    unsigned long fileBytes = 0;
+    uint32_t startBlockReads = sdcard->blockReads;
+    uint64_t startCycles = sim_cycles;
+    uint64_t hostTime = 0;
+    for(unsigned int r=0; r<repeat; r++)
+    {
+        card.openFile(filename, true);
+        if (!card.isFileOpen())
+            return 1;
+        fileBytes += card.getFileSize();
+        card.startFileprint();
+
+        uint64_t start = hostNanoseconds();
+        while(card.sdprinting())
+            sdcard_bench_read(benchCommand);
+        hostTime += hostNanoseconds() - start;
+    }
+    uint64_t cycles = sim_cycles - startCycles;
+    uint32_t blockReads = sdcard->blockReads - startBlockReads;
+    if (fileBytes == 0 || commandCount == 0)
+    {
+        printf("No commands in: %s\n", filename);
+        return 1;
+    }
+
+    printf("SD card benchmark: %s, %lu bytes in %u runs, %lu commands (%lu bytes), %u blocks read\n",
+        filename, fileBytes, repeat, commandCount, commandBytes, blockReads);
+    printf("Host: %.0f bytes/s, %.0f lines/s\n", fileBytes * 1e9 / hostTime, commandCount * 1e9 / hostTime);
+    printf("AVR: %.1f cycles/byte of SPI transfers, %.0f bytes/s, %.0f lines/s at %dMHz (only the register accesses are counted)\n",
+        double(cycles) / fileBytes, fileBytes * double(F_CPU) / cycles, commandCount * double(F_CPU) / cycles, int(F_CPU / 1000000));
+    printf("Command checksum: %08x\n", commandChecksum);
+    return 0;
+}
+#endif//SDCARD_BENCHMARK
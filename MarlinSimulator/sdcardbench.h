@@ -0,0 +1,11 @@
+#ifndef SDCARD_BENCH_H
+#define SDCARD_BENCH_H
+
+class sdcardSimulation;
+
+//Print a file from a card image (see sdimage.py) without executing it: the commands are read from the card
+// by get_sdcard_commands() into the command buffer as fast as possible, and the read speed is reported.
+// Returns the process exit code.
+int sdcard_bench_run(sdcardSimulation* sdcard, const char* image, const char* filename, unsigned int repeat);
+
+#endif//SDCARD_BENCH_H
@@ -0,0 +1,106 @@
+#!/usr/bin/env python
+
+""" Create a FAT16 SD card image for the simulator.
+
+The image holds the given files in the root directory under their 8.3 names, stored contiguously
+with the cluster size of a real card, so reading it in the simulator walks the FAT like the printer does.
+
+    sdimage.py card.img print.gcode [more files]
+    UltiLCD2_Sim -s card.img PRINT.GCO
+
+An image dumped from a real card (dd if=/dev/sdX of=card.img) works as well.
+"""
+
+from __future__ import print_function
+
+import argparse
+import os
+import re
+import struct
+
+SECTOR_SIZE = 512
+RESERVED_SECTORS = 1
+FAT_COUNT = 2
+ROOT_ENTRIES = 512
+MIN_FAT16_CLUSTERS = 4085 + 16
+MAX_FAT16_CLUSTERS = 65524
+
+def short_name(filename, used):
+    """ The 8.3 name for a file, made unique with ~N like a PC does. """
+    base, ext = os.path.splitext(os.path.basename(filename))
+    base = re.sub(r'[^A-Z0-9_~-]', '', base.upper()) or 'FILE'
+    ext = re.sub(r'[^A-Z0-9_~-]', '', ext.upper())[:3]
+    name = base[:8]
+    n = 1
+    while (name, ext) in used:
+        suffix = '~%d' % n
+        name = base[:8 - len(suffix)] + suffix
+        n += 1
+    used.add((name, ext))
+    return name, ext
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('image', help='image file to write')
+    parser.add_argument('files', nargs='+', help='files to put in the root directory')
+    parser.add_argument('-c', '--cluster', type=int, default=64, help='sectors per cluster, power of 2 up to 128 (default=64, 32KB)')
+    args = parser.parse_args()
+
+    if args.cluster < 1 or args.cluster > 128 or args.cluster & (args.cluster - 1):
+        raise SystemExit('Cluster size must be a power of 2 up to 128 sectors')
+    if len(args.files) > ROOT_ENTRIES:
+        raise SystemExit('Too many files')
+    cluster_bytes = args.cluster * SECTOR_SIZE
+
+    contents = [open(f, 'rb').read() for f in args.files]
+    used_clusters = sum((len(c) + cluster_bytes - 1) // cluster_bytes for c in contents)
+    clusters = max(MIN_FAT16_CLUSTERS, used_clusters + 16)
+    if clusters > MAX_FAT16_CLUSTERS:
+        raise SystemExit('Files do not fit a FAT16 image, use a larger cluster size')
+
+    fat_sectors = ((clusters + 2) * 2 + SECTOR_SIZE - 1) // SECTOR_SIZE
+    root_sectors = ROOT_ENTRIES * 32 // SECTOR_SIZE
+    data_start = RESERVED_SECTORS + FAT_COUNT * fat_sectors + root_sectors
+    total_sectors = data_start + clusters * args.cluster
+
+    boot = bytearray(SECTOR_SIZE)
+    struct.pack_into('<3s8sHBHBHHBHHHII', boot, 0, b'\xEB\x3C\x90', b'MARLSIM ', SECTOR_SIZE, args.cluster,
+        RESERVED_SECTORS, FAT_COUNT, ROOT_ENTRIES, total_sectors if total_sectors < 0x10000 else 0, 0xF8,
+        fat_sectors, 63, 255, 0, total_sectors if total_sectors >= 0x10000 else 0)
+    struct.pack_into('<BBBI11s8s', boot, 36, 0x80, 0, 0x29, 0x12345678, b'SIMULATOR  ', b'FAT16   ')
+    boot[510] = 0x55
+    boot[511] = 0xAA
+
+    fat = bytearray(fat_sectors * SECTOR_SIZE)
+    struct.pack_into('<HH', fat, 0, 0xFFF8, 0xFFFF)
+    root = bytearray(root_sectors * SECTOR_SIZE)
+    data = bytearray()
+    used = set()
+    next_cluster = 2
+    for n, (filename, content) in enumerate(zip(args.files, contents)):
+        name, ext = short_name(filename, used)
+        count = (len(content) + cluster_bytes - 1) // cluster_bytes
+        first = next_cluster if count else 0
+        for c in range(count):
+            cluster = next_cluster + c
+            struct.pack_into('<H', fat, cluster * 2, 0xFFFF if c == count - 1 else cluster + 1)
+        next_cluster += count
+        struct.pack_into('<8s3sB10xHHHI', root, n * 32, name.ljust(8).encode(), ext.ljust(3).encode(), 0x20,
+            0, 0x21, first, len(content))
+        data += content
+        data += bytearray(count * cluster_bytes - len(content))
+        print('%s -> %s%s%s (%d bytes)' % (filename, name, '.' if ext else '', ext, len(content)))
+
+    out = open(args.image, 'wb')
+    out.write(boot)
+    for n in range(FAT_COUNT):
+        out.write(fat)
+    out.write(root)
+    out.write(data)
+    # The unused clusters stay a hole in the file
+    out.truncate(total_sectors * SECTOR_SIZE)
+    out.close()
+    print('%s: FAT16, %d clusters of %d bytes, %d bytes' % (args.image, clusters, cluster_bytes, total_sectors * SECTOR_SIZE))
+
+if __name__ == '__main__':
+    main()
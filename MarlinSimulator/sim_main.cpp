@@ -1,5 +1,8 @@
 
+#ifndef SIM_HEADLESS
 #include <SDL/SDL.h>
+#endif
+#include <time.h>
 #include <Arduino.h>
 
 #include <avr/io.h>
@@ -13,13 +16,16 @@
 #include "component/led_PCA9632.h"
 #include "component/arduinoIO.h"
 #include "component/stepper.h"
+#include "component/steptrace.h"
+#include "plannerbench.h"
+#include "sdcardbench.h"
+#include "heaterbench.h"
 
 #include "../Marlin/preferences.h"
 #include "../Marlin/UltiLCD2.h"
 #include "../Marlin/temperature.h"
 #include "../Marlin/stepper.h"
-
-SDL_Surface *screen;
+#include "../Marlin/planner.h"
 
 extern int8_t lcd_lib_encoder_pos_interrupt;
 extern int8_t encoderDiff;
@@ -28,6 +34,200 @@ extern uint8_t __eeprom__storage[4096];
 bool cardInserted = true;
 int stoppedValue;
 
+#ifdef SIM_HEADLESS
+serialSim* serial;
+arduinoIOSim* arduinoIO;
+sdcardSimulation* sdcard;
+stepperSim* steppers[STEP_TRACE_AXES];
+heaterSim* heaters[EXTRUDERS + 1];//Nozzles, then the bed
+#ifdef HEATER_BENCHMARK
+int heaterBenchNr;
+float heaterBenchTemperature;
+int heaterBenchCycles = -1;//-1 when there is no heater benchmark
+bool heaterBenchCompare;
+bool heaterBenchRunning;
+#endif
+stepTrace* trace;
+int tracedLineNr;
+unsigned int maxSimulatedTime;
+clock_t wallClockStart;
+
+void headlessReport()
+{
+    unsigned int simulatedTime = sim_millis();
+    float wallClockTime = float(clock() - wallClockStart) / CLOCKS_PER_SEC;
+    printf("Simulated %u.%03us in %.2fs wall clock time\n", simulatedTime / 1000, simulatedTime % 1000, wallClockTime);
+    sim_print_interrupt_stats();
+#ifdef STEPPER_ISR_PROFILE
+    st_profile_t profile;
+    st_profile_read(profile);
+    printf("Stepper ISR: %u stepping interrupts, cycles min/avg/max %u/%u/%u, min slack %d cycles, %u missed\n", profile.count,
+        profile.min_ticks * 8, profile.count ? profile.total_ticks / profile.count * 8 : 0, profile.max_ticks * 8, profile.min_slack * 8, profile.missed);
+    printf("  cycles histogram, 128 per bucket:");
+    for(unsigned int n=0; n<ST_PROFILE_BUCKETS; n++)
+        printf(" %u", profile.histogram[n]);
+    printf("\n  step loops 1:%u 2:%u 4:%u\n", profile.step_loops[0], profile.step_loops[1], profile.step_loops[2]);
+#endif
+
+    if (trace)
+    {
+        for(unsigned int n=0; n<STEP_TRACE_AXES; n++)
+            trace->header.stepsPerUnit[n] = axis_steps_per_unit[min(n, (unsigned int)E_AXIS)];
+        trace->header.blockBufferSize = BLOCK_BUFFER_SIZE;
+        trace->header.maxXYJerk = max_xy_jerk;
+        trace->header.maxZJerk = max_z_jerk;
+        trace->header.maxEJerk = max_e_jerk;
+        trace->header.minimumPlannerSpeed = MINIMUM_PLANNER_SPEED;
+        trace->close();
+    }
+#ifdef PLANNER_BENCHMARK
+    planner_bench_record_close();
+#endif
+}
+
+//Mark which g-code line is sent to the firmware. When the planner is empty the firmware position matches the
+// stepper positions, so the analysis can map the g-code coordinates on the steps (needed after G28 and G92).
+void headlessTraceLine()
+{
+    if (serial->getLineNr() == tracedLineNr)
+        return;
+    tracedLineNr = serial->getLineNr();
+    if (!blocks_queued())
+    {
+        for(unsigned int n=0; n<=Z_AXIS; n++)
+            trace->write(STEP_TRACE_POSITION, n, lround(current_position[n] * axis_steps_per_unit[n]));
+    }
+    trace->write(STEP_TRACE_LINE, 0, tracedLineNr);
+}
+
+//Simulation setup already happens during static initialization, before main() stored the arguments.
+// So the arguments are handled on the first update instead.
+void headlessStart()
+{
+    int argn = 1;
+#ifdef PLANNER_BENCHMARK
+    //The planner is set up by now, so the benchmark can run right away instead of the firmware.
+    if (argn + 1 < sim_argc && strcmp(sim_argv[argn], "-b") == 0)
+        exit(planner_bench_run(sim_argv[argn + 1], argn + 2 < sim_argc ? atoi(sim_argv[argn + 2]) : 1));
+    if (argn < sim_argc && strcmp(sim_argv[argn], "-a") == 0)
+        exit(planner_bench_trapezoids());
+#endif
+#ifdef SDCARD_BENCHMARK
+    if (argn + 2 < sim_argc && strcmp(sim_argv[argn], "-s") == 0)
+        exit(sdcard_bench_run(sdcard, sim_argv[argn + 1], sim_argv[argn + 2], argn + 3 < sim_argc ? atoi(sim_argv[argn + 3]) : 1));
+#endif
+    while(argn + 1 < sim_argc && sim_argv[argn][0] == '-')
+    {
+        if (strcmp(sim_argv[argn], "-m") == 0)
+        {
+            //-m <heater>:<model settings>, the heater numbered like M303 E (-1 is the bed)
+            char* settings;
+            int heaterNr = strtol(sim_argv[argn + 1], &settings, 10);
+            heaterSim* heater = (heaterNr >= -1 && heaterNr < EXTRUDERS) ? heaters[heaterNr < 0 ? EXTRUDERS : heaterNr] : NULL;
+            if (heater == NULL || *settings != ':' || !heater->getModel().set(settings + 1))
+            {
+                printf("Bad heater model: %s\n", sim_argv[argn + 1]);
+                exit(1);
+            }
+            heater->reset(heater->getModel().ambient);
+        }
+#ifdef HEATER_BENCHMARK
+        else if (argn + 2 < sim_argc && (strcmp(sim_argv[argn], "-p") == 0 || strcmp(sim_argv[argn], "-c") == 0))
+        {
+            //Started by headlessUpdate() once the firmware is done with its setup.
+            heaterBenchCompare = sim_argv[argn][1] == 'c';
+            heaterBenchNr = atoi(sim_argv[argn + 1]);
+            heaterBenchTemperature = atof(sim_argv[argn + 2]);
+            heaterBenchCycles = argn + 3 < sim_argc ? atoi(sim_argv[argn + 3]) : 5;
+            return;
+        }
+#endif
+        else if (strcmp(sim_argv[argn], "-t") == 0)
+        {
+            trace = new stepTrace(sim_argv[argn + 1]);
+            if (!trace->isOpen())
+                exit(1);
+            for(unsigned int n=0; n<STEP_TRACE_AXES; n++)
+                steppers[n]->setTrace(arduinoIO, trace, n);
+        }
+#ifdef PLANNER_BENCHMARK
+        else if (strcmp(sim_argv[argn], "-r") == 0)
+        {
+            if (!planner_bench_record(sim_argv[argn + 1]))
+                exit(1);
+        }
+#endif
+        else
+            break;
+        argn += 2;
+    }
+    if (argn >= sim_argc)
+    {
+        printf("Usage: %s [-m <heater>:<heater model>] [-t <step trace file>] [-r <segment file>] <gcode file> [max simulated seconds]\n", sim_argv[0]);
+#ifdef PLANNER_BENCHMARK
+        printf("       %s -b <segment file> [repeat count]\n", sim_argv[0]);
+        printf("       %s -a  (FAST_TRAPEZOID against the float trapezoid math)\n", sim_argv[0]);
+#endif
+#ifdef SDCARD_BENCHMARK
+        printf("       %s -s <card image> <file on card> [repeat count]\n", sim_argv[0]);
+#endif
+#ifdef HEATER_BENCHMARK
+        printf("       %s [-m <heater>:<heater model>] -p <heater> <temperature> [autotune cycles]\n", sim_argv[0]);
+        printf("       %s [-m <heater>:<heater model>] -c <heater> <temperature> [autotune cycles]  (float and fixed point PID)\n", sim_argv[0]);
+#endif
+        printf("Heater model: name=value,... with power (W), capacity (J/K), loss (W/K), fan (W/K), lag (s), dead (s), ambient (C)\n");
+        exit(1);
+    }
+    if (argn + 1 < sim_argc)
+        maxSimulatedTime = atoi(sim_argv[argn + 1]) * 1000;
+    serial->setInputFile(sim_argv[argn]);
+    wallClockStart = clock();
+}
+
+void headlessUpdate()
+{
+    static bool started = false;
+    if (!started)
+    {
+        //Set first, the benchmarks run inside headlessStart() and this callback can be called again from there.
+        started = true;
+        headlessStart();
+    }
+
+    for(unsigned int n=0; n<simComponentList.size(); n++)
+        simComponentList[n]->tick();
+#ifdef HEATER_BENCHMARK
+    //The first temperatures are measured by manage_heater() in the main loop, after the setup. The model keeps getting
+    // its ms updates from here while the benchmark runs, the g-code checks below do not apply.
+    if (heaterBenchRunning)
+        return;
+    if (heaterBenchCycles >= 0 && current_temperature[0] != 0)
+    {
+        heaterBenchRunning = true;
+        heaterSim* heater = (heaterBenchNr >= -1 && heaterBenchNr < EXTRUDERS) ? heaters[heaterBenchNr < 0 ? EXTRUDERS : heaterBenchNr] : NULL;
+        exit(heater_bench_run(heater, heaterBenchNr, heaterBenchTemperature, heaterBenchCycles, heaterBenchCompare));
+    }
+    if (heaterBenchCycles >= 0)
+        return;
+#endif
+    if (trace)
+        headlessTraceLine();
+
+    if (serial->inputFinished() && !blocks_queued())
+    {
+        headlessReport();
+        exit(0);
+    }
+    if (maxSimulatedTime && sim_millis() >= maxSimulatedTime)
+    {
+        printf("Simulated time limit reached\n");
+        headlessReport();
+        exit(1);
+    }
+}
+#else
+SDL_Surface *screen;
+
 void setupGui()
 {
     if ( SDL_Init(SDL_INIT_VIDEO) < 0 )
@@ -162,6 +362,7 @@ void guiUpdate()
 
     SDL_Flip(screen);
 }
+#endif//SIM_HEADLESS
 
 #define PRINTER_DOWN_SCALE 2
 class printerSim : public simBaseComponent
@@ -215,8 +416,12 @@ public:
 
 void sim_setup_main()
 {
+#ifdef SIM_HEADLESS
+    sim_setup(headlessUpdate);
+#else
     setupGui();
     sim_setup(guiUpdate);
+#endif
     adcSim* adc = new adcSim();
     arduinoIOSim* arduinoIO = new arduinoIOSim();
     stepperSim* xStep = new stepperSim(arduinoIO, X_ENABLE_PIN, X_STEP_PIN, X_DIR_PIN, INVERT_X_DIR);
@@ -235,11 +440,40 @@ void sim_setup_main()
     e0Step->setDrawPosition(130, 100);
     e1Step->setDrawPosition(130, 110);
 
-    (new heaterSim(HEATER_0_PIN, adc, TEMP_0_PIN))->setDrawPosition(130, 70);
-    (new heaterSim(HEATER_1_PIN, adc, TEMP_1_PIN))->setDrawPosition(130, 80);
-    (new heaterSim(HEATER_BED_PIN, adc, TEMP_BED_PIN, 0.2))->setDrawPosition(130, 90);
+#ifdef SIM_HEADLESS
+    ::arduinoIO = arduinoIO;
+    steppers[X_AXIS] = xStep;
+    steppers[Y_AXIS] = yStep;
+    steppers[Z_AXIS] = zStep;
+    steppers[E_AXIS] = e0Step;
+    steppers[E_AXIS + 1] = e1Step;
+#endif
+
+    //Roughly a UM2 hotend (heater cartridge in an aluminium block, PT100) and heated bed, change them with -m.
+    heaterModel hotend(35, 12, 0.045, 0.03, 1.5, 0.3);
+    heaterModel bed(150, 900, 0.75, 0, 6, 2);
+    heaterSim* heater0 = new heaterSim(HEATER_0_PIN, adc, TEMP_0_PIN, 0, hotend);
+    heaterSim* heater1 = new heaterSim(HEATER_1_PIN, adc, TEMP_1_PIN, 1, hotend);
+    heaterSim* heaterBed = new heaterSim(HEATER_BED_PIN, adc, TEMP_BED_PIN, -1, bed);
+    heater0->setDrawPosition(130, 70);
+    heater1->setDrawPosition(130, 80);
+    heaterBed->setDrawPosition(130, 90);
+#ifdef SIM_HEADLESS
+    heaters[0] = heater0;
+#if EXTRUDERS > 1
+    heaters[1] = heater1;
+#endif
+    heaters[EXTRUDERS] = heaterBed;
+
+    //No card in the headless build, the g-code is streamed over serial. The card is only inserted by the SD card benchmark.
+    sdcard = new sdcardSimulation("", 0);
+    writeInput(SDCARDDETECT, true);
+    writeInput(BTN_ENC, true);
+    serial = new serialSim();
+#else
     new sdcardSimulation("c:/models/", 5000);
     (new serialSim())->setDrawPosition(150, 0);
+#endif
 #if defined(ULTIBOARD_V2_CONTROLLER) || defined(ENABLE_ULTILCD2)
     i2cSim* i2c = new i2cSim();
     (new displaySDD1309Sim(i2c))->setDrawPosition(0, 0);
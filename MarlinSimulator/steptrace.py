@@ -0,0 +1,251 @@
+#!/usr/bin/env python
+
+""" Analyze a step trace of the headless simulator.
+
+Record a trace with:  UltiLCD2_Sim -t run.trc file.gcode
+Then run:             steptrace.py run.trc file.gcode
+
+The step edges are turned back into position, velocity, acceleration and jerk per axis,
+and the executed XYZ path is compared with the G0/G1 segments of the g-code file:
+how long each segment took compared to its feedrate, and how far the steps strayed from the line.
+See component/steptrace.h for the file format.
+"""
+
+from __future__ import print_function
+
+import argparse
+import math
+import mmap
+import re
+import struct
+from collections import deque
+
+HEADER_FORMAT = '<4sHHII5i5fI4f'
+RECORD_FORMAT = '<Ii'
+
+STEP_TRACE_STEP = 1
+STEP_TRACE_DIRECTION = 2
+STEP_TRACE_LINE = 3
+STEP_TRACE_POSITION = 4
+STEP_TRACE_CLOCK = 5
+
+AXIS_NAMES = ['X', 'Y', 'Z', 'E0', 'E1']
+
+class Segment:
+    def __init__(self, line, start, end, feedrate, steps_per_unit):
+        self.line = line
+        self.start = [start[n] / steps_per_unit[n] for n in range(3)]
+        self.end = [end[n] / steps_per_unit[n] for n in range(3)]
+        self.target = list(end)
+        self.feedrate = feedrate
+        self.length = math.sqrt(sum((self.end[n] - self.start[n]) ** 2 for n in range(3)))
+        self.start_time = None
+        self.end_time = None
+        self.max_error = 0.0
+
+    def error(self, pos):
+        # Distance from pos to the line piece between start and end
+        d = [self.end[n] - self.start[n] for n in range(3)]
+        p = [pos[n] - self.start[n] for n in range(3)]
+        f = 0.0
+        if self.length > 0:
+            f = min(max(sum(d[n] * p[n] for n in range(3)) / (self.length * self.length), 0.0), 1.0)
+        return math.sqrt(sum((p[n] - d[n] * f) ** 2 for n in range(3)))
+
+class Home:
+    def __init__(self, line):
+        self.line = line
+
+class GCodeInterpreter:
+    """ Turns g-code lines into segments in physical step coordinates, the same way the planner rounds them. """
+    def __init__(self, filename, header):
+        self.lines = open(filename).read().split('\n')
+        self.steps_per_unit = header['stepsPerUnit']
+        self.position = [0.0, 0.0, 0.0]
+        self.offset = header['startPosition'][0:3]
+        self.target = header['startPosition'][0:3]
+        self.feedrate = 1500.0
+        self.relative = False
+
+    def sync(self, axis, firmware_steps, physical_steps):
+        self.position[axis] = firmware_steps / self.steps_per_unit[axis]
+        self.offset[axis] = physical_steps - firmware_steps
+        self.target[axis] = physical_steps
+
+    def interpret(self, line_nr):
+        line = self.lines[line_nr - 1].split(';')[0].upper()
+        words = dict((m.group(1), float(m.group(2))) for m in re.finditer(r'([A-Z])\s*([-+]?[0-9]*\.?[0-9]+)', line))
+        if 'G' in words:
+            g = int(words['G'])
+            if g in (0, 1, 2, 3):
+                if 'F' in words and words['F'] > 0:
+                    self.feedrate = words['F']
+                for n in range(3):
+                    if 'XYZ'[n] in words:
+                        if self.relative:
+                            self.position[n] += words['XYZ'[n]]
+                        else:
+                            self.position[n] = words['XYZ'[n]]
+                target = [int(round(self.position[n] * self.steps_per_unit[n])) + self.offset[n] for n in range(3)]
+                if target == self.target:
+                    return None
+                segment = Segment(line_nr, self.target, target, self.feedrate / 60.0, self.steps_per_unit)
+                self.target = target
+                return segment
+            if g == 28:
+                return Home(line_nr)
+            if g == 90:
+                self.relative = False
+            if g == 91:
+                self.relative = True
+            if g == 92:
+                for n in range(3):
+                    if 'XYZ'[n] in words:
+                        self.position[n] = words['XYZ'[n]]
+                        self.offset[n] = self.target[n] - int(round(self.position[n] * self.steps_per_unit[n]))
+        return None
+
+def read_header(data):
+    values = struct.unpack_from(HEADER_FORMAT, data)
+    if values[0] != b'STRC':
+        raise SystemExit('Not a step trace file')
+    return {
+        'version': values[1], 'headerSize': values[2], 'cpuFrequency': values[3], 'recordCount': values[4],
+        'startPosition': list(values[5:10]), 'stepsPerUnit': list(values[10:15]),
+        'blockBufferSize': values[15], 'maxXYJerk': values[16], 'maxZJerk': values[17], 'maxEJerk': values[18],
+        'minimumPlannerSpeed': values[19],
+    }
+
+def records(data, header):
+    clock_high = 0
+    offset = header['headerSize']
+    # A trace that was cut off has fewer records than the header says
+    for n in range(min(header['recordCount'], (len(data) - offset) // 8)):
+        cycle, value = struct.unpack_from(RECORD_FORMAT, data, offset)
+        offset += 8
+        record_type = value & 0x0F
+        if record_type == STEP_TRACE_CLOCK:
+            clock_high = value >> 8
+            continue
+        yield (clock_high << 32) | cycle, record_type, (value >> 4) & 0x0F, value >> 8
+
+def derivative(values, dt):
+    return [(values[n + 1] - values[n]) / dt for n in range(len(values) - 1)]
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('trace', help='step trace file written by the simulator')
+    parser.add_argument('gcode', help='g-code file that was simulated')
+    parser.add_argument('-s', '--sample', type=float, default=10.0, help='sample time in ms for velocity, acceleration and jerk (default=10)')
+    parser.add_argument('-c', '--csv', help='write the sampled position, velocity, acceleration and jerk per axis to this file')
+    parser.add_argument('-n', '--slowest', type=int, default=5, help='number of slowest segments to list (default=5)')
+    args = parser.parse_args()
+
+    f = open(args.trace, 'rb')
+    data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    header = read_header(data)
+    steps_per_unit = header['stepsPerUnit']
+    cpu_frequency = float(header['cpuFrequency'])
+    sample_cycles = int(args.sample * cpu_frequency / 1000)
+
+    interpreter = GCodeInterpreter(args.gcode, header)
+    pending = deque()
+    done = []
+    unmatched = 0
+    position = list(header['startPosition'])
+    step_count = [0] * 5
+    samples = []
+    next_sample = 0
+    error_sum = 0.0
+    error_count = 0
+    error_max = 0.0
+    cycle = 0
+
+    for cycle, record_type, axis, value in records(data, header):
+        while cycle >= next_sample:
+            samples.append(list(position))
+            next_sample += sample_cycles
+
+        if record_type == STEP_TRACE_STEP:
+            position[axis] += value
+            step_count[axis] += 1
+            if axis > 2 or not pending or isinstance(pending[0], Home):
+                continue
+            segment = pending[0]
+            if segment.start_time is None:
+                segment.start_time = cycle
+            pos = [position[n] / steps_per_unit[n] for n in range(3)]
+            error = segment.error(pos)
+            segment.max_error = max(segment.max_error, error)
+            error_max = max(error_max, error)
+            error_sum += error * error
+            error_count += 1
+            while pending and not isinstance(pending[0], Home) and position[0:3] == pending[0].target:
+                segment = pending.popleft()
+                if segment.start_time is None:
+                    segment.start_time = cycle
+                segment.end_time = cycle
+                done.append(segment)
+        elif record_type == STEP_TRACE_POSITION:
+            # The planner is empty, everything still pending was never executed as commanded (or the homing finished).
+            unmatched += sum(1 for s in pending if isinstance(s, Segment))
+            pending.clear()
+            interpreter.sync(axis, value, position[axis])
+        elif record_type == STEP_TRACE_LINE:
+            segment = interpreter.interpret(value)
+            if segment is not None:
+                pending.append(segment)
+    unmatched += sum(1 for s in pending if isinstance(s, Segment))
+
+    print('Trace: %d records, %.3fs, block buffer %d, jerk XY %.1f Z %.1f E %.1f mm/s, minimum planner speed %.2f mm/s' % (
+        header['recordCount'], cycle / cpu_frequency, header['blockBufferSize'],
+        header['maxXYJerk'], header['maxZJerk'], header['maxEJerk'], header['minimumPlannerSpeed']))
+
+    dt = args.sample / 1000.0
+    velocity = []
+    acceleration = []
+    jerk = []
+    print('Axis      steps    max v(mm/s)  max a(mm/s2)  max j(mm/s3)')
+    for n in range(5):
+        p = [s[n] / steps_per_unit[n] for s in samples]
+        v = derivative(p, dt)
+        a = derivative(v, dt)
+        j = derivative(a, dt)
+        velocity.append(v)
+        acceleration.append(a)
+        jerk.append(j)
+        if step_count[n] > 0:
+            print('%-4s %10d %14.1f %13.0f %13.0f' % (AXIS_NAMES[n], step_count[n],
+                max([abs(x) for x in v] or [0]), max([abs(x) for x in a] or [0]), max([abs(x) for x in j] or [0])))
+
+    commanded_time = sum(s.length / s.feedrate for s in done)
+    executed_time = sum(s.end_time - s.start_time for s in done) / cpu_frequency
+    print('Segments: %d executed, %d not executed as commanded' % (len(done), unmatched))
+    if commanded_time > 0:
+        print('Segment time: %.3fs commanded, %.3fs executed (%.1f%%)' % (commanded_time, executed_time, executed_time * 100.0 / commanded_time))
+    if error_count > 0:
+        print('Path error: max %.4fmm, rms %.4fmm' % (error_max, math.sqrt(error_sum / error_count)))
+
+    slow = [s for s in done if s.length > 0 and s.end_time > s.start_time]
+    slow.sort(key=lambda s: s.length / s.feedrate / ((s.end_time - s.start_time) / cpu_frequency))
+    if args.slowest > 0 and slow:
+        print('Slowest segments:')
+        for s in slow[0:args.slowest]:
+            executed = (s.end_time - s.start_time) / cpu_frequency
+            print('  line %d: %.3fmm at %.1fmm/s commanded, %.1fmm/s executed' % (s.line, s.length, s.feedrate, s.length / executed))
+
+    if args.csv:
+        out = open(args.csv, 'w')
+        out.write('time')
+        for name in AXIS_NAMES:
+            out.write(',%s_pos,%s_v,%s_a,%s_j' % (name, name, name, name))
+        out.write('\n')
+        for i in range(len(samples) - 3):
+            out.write('%.4f' % (i * dt))
+            for n in range(5):
+                out.write(',%.4f,%.2f,%.1f,%.0f' % (samples[i][n] / steps_per_unit[n], velocity[n][i], acceleration[n][i], jerk[n][i]))
+            out.write('\n')
+        out.close()
+
+if __name__ == '__main__':
+    main()